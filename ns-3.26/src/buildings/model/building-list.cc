@@ -25,8 +25,12 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/assert.h"
+#include "ns3/abort.h"
 #include "building-list.h"
 #include "building.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ns3 {
 
@@ -47,6 +51,10 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  Ptr<Building> FindBuilding (const Vector &position);
+  void FindBuildingsCrossed (const Vector &a, const Vector &b,
+                             std::vector<Ptr<Building> > &buildings);
+  void Invalidate (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
@@ -54,9 +62,73 @@ private:
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  /**
+   * Index the footprints of the buildings in m_cellStart and
+   * m_cellBuildings, if they changed since the last call.
+   */
+  void BuildGrid (void);
+  /**
+   * \param x a coordinate along x
+   * \returns the column of the grid containing x, possibly out of range
+   */
+  int32_t GetColumn (double x) const;
+  /**
+   * \param y a coordinate along y
+   * \returns the row of the grid containing y, possibly out of range
+   */
+  int32_t GetRow (double y) const;
   std::vector<Ptr<Building> > m_buildings;
+
+  bool m_gridValid;         //!< whether the grid indexes the current buildings
+  double m_xMin;            //!< lower x bound of the grid
+  double m_xMax;            //!< upper x bound of the grid
+  double m_yMin;            //!< lower y bound of the grid
+  double m_yMax;            //!< upper y bound of the grid
+  double m_cellSize;        //!< side of the square cells of the grid
+  int32_t m_nColumns;       //!< number of cells along x
+  int32_t m_nRows;          //!< number of cells along y
+  /// first entry of each cell in m_cellBuildings, row by row, plus the end
+  std::vector<uint32_t> m_cellStart;
+  /// indices of the buildings overlapping each cell
+  std::vector<uint32_t> m_cellBuildings;
+  /// last query which visited each building, for FindBuildingsCrossed
+  std::vector<uint32_t> m_visited;
+  uint32_t m_query;         //!< the current FindBuildingsCrossed query
 };
 
+/// Incremented whenever a building is added or moved; never reset, so
+/// that it also changes across simulations.
+static uint32_t g_buildingListGeneration = 0;
+
+/**
+ * Clip the parameter range of a segment to a slab along one axis.
+ *
+ * \param origin the coordinate of the start of the segment
+ * \param direction the coordinate of the end minus the start
+ * \param lo the lower bound of the slab
+ * \param hi the upper bound of the slab
+ * \param t0 the start of the range, updated
+ * \param t1 the end of the range, updated
+ * \returns false if the range is empty
+ */
+static bool
+ClipToSlab (double origin, double direction, double lo, double hi, double &t0, double &t1)
+{
+  if (direction == 0)
+    {
+      return origin >= lo && origin <= hi;
+    }
+  double ta = (lo - origin) / direction;
+  double tb = (hi - origin) / direction;
+  if (ta > tb)
+    {
+      std::swap (ta, tb);
+    }
+  t0 = std::max (t0, ta);
+  t1 = std::min (t1, tb);
+  return t0 <= t1;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
 
 TypeId
@@ -100,6 +172,15 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_gridValid (false),
+    m_xMin (0),
+    m_xMax (0),
+    m_yMin (0),
+    m_yMax (0),
+    m_cellSize (1),
+    m_nColumns (0),
+    m_nRows (0),
+    m_query (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +199,7 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  Invalidate ();
   Object::DoDispose ();
 }
 
@@ -127,6 +209,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  Invalidate ();
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +238,242 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+void
+BuildingListPriv::Invalidate (void)
+{
+  m_gridValid = false;
+  ++g_buildingListGeneration;
+}
+
+int32_t
+BuildingListPriv::GetColumn (double x) const
+{
+  return static_cast<int32_t> (std::floor ((x - m_xMin) / m_cellSize));
+}
+
+int32_t
+BuildingListPriv::GetRow (double y) const
+{
+  return static_cast<int32_t> (std::floor ((y - m_yMin) / m_cellSize));
+}
+
+void
+BuildingListPriv::BuildGrid (void)
+{
+  if (m_gridValid)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << m_buildings.size ());
+  m_gridValid = true;
+  m_cellStart.clear ();
+  m_cellBuildings.clear ();
+  m_visited.assign (m_buildings.size (), 0);
+  m_query = 0;
+  m_nColumns = 0;
+  m_nRows = 0;
+  if (m_buildings.empty ())
+    {
+      return;
+    }
+
+  // the cells are about as large as the area per building, and not
+  // smaller than the average building, so that most cells overlap a
+  // few buildings and most buildings a few cells
+  m_xMin = std::numeric_limits<double>::max ();
+  m_xMax = -std::numeric_limits<double>::max ();
+  m_yMin = std::numeric_limits<double>::max ();
+  m_yMax = -std::numeric_limits<double>::max ();
+  double sides = 0;
+  for (std::vector<Ptr<Building> >::const_iterator it = m_buildings.begin ();
+       it != m_buildings.end (); ++it)
+    {
+      Box box = (*it)->GetBoundaries ();
+      m_xMin = std::min (m_xMin, box.xMin);
+      m_xMax = std::max (m_xMax, box.xMax);
+      m_yMin = std::min (m_yMin, box.yMin);
+      m_yMax = std::max (m_yMax, box.yMax);
+      sides += (box.xMax - box.xMin) + (box.yMax - box.yMin);
+    }
+  double n = m_buildings.size ();
+  double width = m_xMax - m_xMin;
+  double height = m_yMax - m_yMin;
+  m_cellSize = std::max (std::sqrt (width * height / n), sides / (2 * n));
+  if (!(m_cellSize > 0))
+    {
+      m_cellSize = 1;
+    }
+  // bound the memory used by degenerate layouts, e.g. buildings on a line
+  while (true)
+    {
+      m_nColumns = GetColumn (m_xMax) + 1;
+      m_nRows = GetRow (m_yMax) + 1;
+      if (static_cast<double> (m_nColumns) * m_nRows <= 4 * n + 16)
+        {
+          break;
+        }
+      m_cellSize *= 2;
+    }
+  NS_LOG_LOGIC ("grid of " << m_nColumns << "x" << m_nRows << " cells of " << m_cellSize << " m");
+
+  // two passes: count the buildings of each cell, then fill them
+  m_cellStart.assign (m_nColumns * m_nRows + 1, 0);
+  for (uint32_t pass = 0; pass < 2; ++pass)
+    {
+      for (uint32_t i = 0; i < m_buildings.size (); ++i)
+        {
+          Box box = m_buildings[i]->GetBoundaries ();
+          int32_t rowMax = GetRow (box.yMax);
+          int32_t columnMax = GetColumn (box.xMax);
+          for (int32_t row = GetRow (box.yMin); row <= rowMax; ++row)
+            {
+              for (int32_t column = GetColumn (box.xMin); column <= columnMax; ++column)
+                {
+                  uint32_t cell = row * m_nColumns + column;
+                  if (pass == 0)
+                    {
+                      ++m_cellStart[cell + 1];
+                    }
+                  else
+                    {
+                      m_cellBuildings[m_cellStart[cell]++] = i;
+                    }
+                }
+            }
+        }
+      if (pass == 0)
+        {
+          for (uint32_t cell = 1; cell < m_cellStart.size (); ++cell)
+            {
+              m_cellStart[cell] += m_cellStart[cell - 1];
+            }
+          m_cellBuildings.resize (m_cellStart.back ());
+        }
+    }
+  // the fill pass advanced the start of each cell to the start of the next one
+  for (uint32_t cell = m_cellStart.size () - 1; cell > 0; --cell)
+    {
+      m_cellStart[cell] = m_cellStart[cell - 1];
+    }
+  m_cellStart[0] = 0;
+}
+
+Ptr<Building>
+BuildingListPriv::FindBuilding (const Vector &position)
+{
+  NS_LOG_FUNCTION (this << position);
+  BuildGrid ();
+  int32_t column = GetColumn (position.x);
+  int32_t row = GetRow (position.y);
+  if (column < 0 || column >= m_nColumns || row < 0 || row >= m_nRows)
+    {
+      return 0;
+    }
+  uint32_t cell = row * m_nColumns + column;
+  Ptr<Building> found = 0;
+  for (uint32_t j = m_cellStart[cell]; j < m_cellStart[cell + 1]; ++j)
+    {
+      Ptr<Building> building = m_buildings[m_cellBuildings[j]];
+      if (building->IsInside (position))
+        {
+          NS_LOG_LOGIC ("position " << position << " falls inside building " << building->GetId ());
+          NS_ABORT_MSG_UNLESS (found == 0, " MobilityBuildingInfo already inside another building!");
+          found = building;
+        }
+    }
+  return found;
+}
+
+void
+BuildingListPriv::FindBuildingsCrossed (const Vector &a, const Vector &b,
+                                        std::vector<Ptr<Building> > &buildings)
+{
+  NS_LOG_FUNCTION (this << a << b);
+  buildings.clear ();
+  BuildGrid ();
+  double dx = b.x - a.x;
+  double dy = b.y - a.y;
+  double dz = b.z - a.z;
+  double t0 = 0;
+  double t1 = 1;
+  if (m_nColumns == 0
+      || !ClipToSlab (a.x, dx, m_xMin, m_xMax, t0, t1)
+      || !ClipToSlab (a.y, dy, m_yMin, m_yMax, t0, t1))
+    {
+      return;
+    }
+  if (++m_query == 0)
+    {
+      m_visited.assign (m_visited.size (), 0);
+      m_query = 1;
+    }
+
+  // walk the cells crossed by the segment, in order (Amanatides and Woo,
+  // "A fast voxel traversal algorithm for ray tracing", 1987)
+  int32_t column = std::min (std::max (GetColumn (a.x + t0 * dx), 0), m_nColumns - 1);
+  int32_t row = std::min (std::max (GetRow (a.y + t0 * dy), 0), m_nRows - 1);
+  int32_t stepColumn = (dx > 0) ? 1 : ((dx < 0) ? -1 : 0);
+  int32_t stepRow = (dy > 0) ? 1 : ((dy < 0) ? -1 : 0);
+  double inf = std::numeric_limits<double>::infinity ();
+  double tNextColumn = (dx == 0) ? inf : (m_xMin + (column + (dx > 0)) * m_cellSize - a.x) / dx;
+  double tNextRow = (dy == 0) ? inf : (m_yMin + (row + (dy > 0)) * m_cellSize - a.y) / dy;
+  double tColumn = (dx == 0) ? inf : m_cellSize / std::abs (dx);
+  double tRow = (dy == 0) ? inf : m_cellSize / std::abs (dy);
+
+  std::vector<std::pair<double, uint32_t> > crossed;
+  while (true)
+    {
+      uint32_t cell = row * m_nColumns + column;
+      for (uint32_t j = m_cellStart[cell]; j < m_cellStart[cell + 1]; ++j)
+        {
+          uint32_t i = m_cellBuildings[j];
+          if (m_visited[i] == m_query)
+            {
+              continue;
+            }
+          m_visited[i] = m_query;
+          Box box = m_buildings[i]->GetBoundaries ();
+          double enter = 0;
+          double exit = 1;
+          if (ClipToSlab (a.x, dx, box.xMin, box.xMax, enter, exit)
+              && ClipToSlab (a.y, dy, box.yMin, box.yMax, enter, exit)
+              && ClipToSlab (a.z, dz, box.zMin, box.zMax, enter, exit))
+            {
+              crossed.push_back (std::make_pair (enter, i));
+            }
+        }
+      if (tNextColumn < tNextRow)
+        {
+          if (tNextColumn > t1)
+            {
+              break;
+            }
+          column += stepColumn;
+          tNextColumn += tColumn;
+        }
+      else
+        {
+          if (tNextRow > t1)
+            {
+              break;
+            }
+          row += stepRow;
+          tNextRow += tRow;
+        }
+      if (column < 0 || column >= m_nColumns || row < 0 || row >= m_nRows)
+        {
+          break;
+        }
+    }
+
+  std::sort (crossed.begin (), crossed.end ());
+  for (std::vector<std::pair<double, uint32_t> >::const_iterator it = crossed.begin ();
+       it != crossed.end (); ++it)
+    {
+      buildings.push_back (m_buildings[it->second]);
+    }
+}
+
 }
 
 /**
@@ -189,5 +508,26 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+Ptr<Building>
+BuildingList::FindBuilding (const Vector &position)
+{
+  return BuildingListPriv::Get ()->FindBuilding (position);
+}
+void
+BuildingList::FindBuildingsCrossed (const Vector &a, const Vector &b,
+                                    std::vector<Ptr<Building> > &buildings)
+{
+  BuildingListPriv::Get ()->FindBuildingsCrossed (a, b, buildings);
+}
+uint32_t
+BuildingList::GetGeneration (void)
+{
+  return g_buildingListGeneration;
+}
+void
+BuildingList::NotifyBuildingChanged (void)
+{
+  BuildingListPriv::Get ()->Invalidate ();
+}
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,42 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+
+  /**
+   * Find the building containing a position
+   *
+   * The buildings are indexed in a 2D grid of their footprints, so that
+   * this does not iterate over all the buildings. The index is rebuilt
+   * after a building is added or its boundaries change.
+   *
+   * \param position some position
+   * \returns the building containing the position, or 0 if none does.
+   * It is a fatal error if several buildings contain it.
+   */
+  static Ptr<Building> FindBuilding (const Vector &position);
+  /**
+   * Find the buildings whose boundaries intersect a segment
+   *
+   * \param a one end of the segment
+   * \param b the other end of the segment
+   * \param buildings filled with the buildings intersecting the segment,
+   * in the order in which the segment enters them from a
+   */
+  static void FindBuildingsCrossed (const Vector &a, const Vector &b,
+                                    std::vector<Ptr<Building> > &buildings);
+  /**
+   * \returns a number incremented whenever a building is added or
+   * changed, so that users can tell whether the results of FindBuilding
+   * or FindBuildingsCrossed may have changed since they last called it.
+   */
+  static uint32_t GetGeneration (void);
+  /**
+   * Notify the list that a building changed.
+   *
+   * This method is called automatically from the setters of Building so
+   * the user has little reason to call it himself.
+   */
+  static void NotifyBuildingChanged (void);
 };
 
 } // namespace ns3
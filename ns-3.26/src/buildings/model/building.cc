@@ -28,6 +28,7 @@
 #include <ns3/log.h>
 #include <ns3/assert.h>
 #include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -140,6 +141,7 @@ Building::SetBoundaries (Box boundaries)
 {
   NS_LOG_FUNCTION (this << boundaries);
   m_buildingBounds = boundaries;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 void
@@ -147,6 +149,7 @@ Building::SetBuildingType (Building::BuildingType_t t)
 {
   NS_LOG_FUNCTION (this << t);
   m_buildingType = t;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 void 
@@ -154,6 +157,7 @@ Building::SetExtWallsType (Building::ExtWallsType_t t)
 {
   NS_LOG_FUNCTION (this << t);
   m_externalWalls = t;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 void
@@ -161,6 +165,7 @@ Building::SetNFloors (uint16_t nfloors)
 {
   NS_LOG_FUNCTION (this << nfloors);
   m_floors = nfloors;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 void
@@ -168,6 +173,7 @@ Building::SetNRoomsX (uint16_t nroomx)
 {
   NS_LOG_FUNCTION (this << nroomx);
   m_roomsX = nroomx;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 void
@@ -175,6 +181,7 @@ Building::SetNRoomsY (uint16_t nroomy)
 {
   NS_LOG_FUNCTION (this << nroomy);
   m_roomsY = nroomy;
+  BuildingList::NotifyBuildingChanged ();
 }
 
 Box
@@ -284,5 +291,67 @@ Building::GetFloor (Vector position) const
   return n;
 }
 
+/**
+ * \param x a coordinate
+ * \param min the lower bound of the building along the axis of x
+ * \param max the upper bound of the building along the axis of x
+ * \param n the number of rooms or floors along the axis of x
+ * \returns the index, from 0, of the room or floor containing x
+ */
+static int32_t
+GetSlice (double x, double min, double max, uint16_t n)
+{
+  if (!(max > min))
+    {
+      return 0;
+    }
+  int32_t i = static_cast<int32_t> (std::floor (n * (x - min) / (max - min)));
+  return std::min (std::max (i, 0), n - 1);
+}
+
+bool
+Building::CountWallsCrossed (Vector a, Vector b, uint32_t &externalWalls, uint32_t &internalWalls) const
+{
+  NS_LOG_FUNCTION (this << a << b);
+  double origin[3] = { a.x, a.y, a.z };
+  double direction[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+  double lo[3] = { m_buildingBounds.xMin, m_buildingBounds.yMin, m_buildingBounds.zMin };
+  double hi[3] = { m_buildingBounds.xMax, m_buildingBounds.yMax, m_buildingBounds.zMax };
+  uint16_t slices[3] = { m_roomsX, m_roomsY, m_floors };
+  // the part of the segment inside the box, from a + enter * (b - a)
+  // to a + exit * (b - a)
+  double enter = 0;
+  double exit = 1;
+  for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      if (direction[axis] == 0)
+        {
+          if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+            {
+              return false;
+            }
+          continue;
+        }
+      double t0 = (lo[axis] - origin[axis]) / direction[axis];
+      double t1 = (hi[axis] - origin[axis]) / direction[axis];
+      enter = std::max (enter, std::min (t0, t1));
+      exit = std::min (exit, std::max (t0, t1));
+    }
+  if (enter > exit)
+    {
+      return false;
+    }
+  externalWalls = (enter > 0) + (exit < 1);
+  internalWalls = 0;
+  for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      int32_t first = GetSlice (origin[axis] + enter * direction[axis], lo[axis], hi[axis], slices[axis]);
+      int32_t last = GetSlice (origin[axis] + exit * direction[axis], lo[axis], hi[axis], slices[axis]);
+      internalWalls += std::abs (last - first);
+    }
+  NS_LOG_LOGIC ("external walls " << externalWalls << " internal walls " << internalWalls);
+  return true;
+}
+
 
 } // namespace ns3
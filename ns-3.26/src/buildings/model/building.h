@@ -201,7 +201,24 @@ public:
    */
   uint16_t GetFloor (Vector position) const;
 
-
+  /**
+   * Count the walls of the building crossed by a segment
+   *
+   * The internal walls and the floors are counted as if the rooms and
+   * the floors were all the same size, as for GetRoomX, GetRoomY and
+   * GetFloor.
+   *
+   * \param a one end of the segment
+   * \param b the other end of the segment
+   * \param externalWalls set to the number of external walls, roof or
+   * ground crossed: 0 if both ends are inside the building, 1 if one is,
+   * 2 otherwise
+   * \param internalWalls set to the number of internal walls and floors
+   * crossed
+   * \return true if the segment intersects the building; if not, the
+   * counts are left unchanged
+   */
+  bool CountWallsCrossed (Vector a, Vector b, uint32_t &externalWalls, uint32_t &internalWalls) const;
 
 
 private:
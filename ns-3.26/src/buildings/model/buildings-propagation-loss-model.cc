@@ -102,9 +102,14 @@ BuildingsPropagationLossModel::BuildingsPropagationLossModel ()
 
 double
 BuildingsPropagationLossModel::ExternalWallLoss (Ptr<MobilityBuildingInfo> a) const
+{
+  return ExternalWallLoss (a->GetBuilding ());
+}
+
+double
+BuildingsPropagationLossModel::ExternalWallLoss (Ptr<Building> aBuilding) const
 {
   double loss = 0.0;
-  Ptr<Building> aBuilding = a->GetBuilding ();
   if (aBuilding->GetExtWallsType () == Building::Wood)
     {
       loss = 4;
@@ -73,6 +73,11 @@ public:
 
 protected:
   double ExternalWallLoss (Ptr<MobilityBuildingInfo> a) const;
+  /**
+   * \param building a building
+   * \returns the loss through an external wall of the building [dB]
+   */
+  double ExternalWallLoss (Ptr<Building> building) const;
   double HeightLoss (Ptr<MobilityBuildingInfo> n) const;
   double InternalWallsLoss (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
   
@@ -0,0 +1,214 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/itu-r-1411-los-propagation-loss-model.h"
+#include "ns3/itu-r-1411-nlos-over-rooftop-propagation-loss-model.h"
+#include "ns3/itu-r-1238-propagation-loss-model.h"
+#include <ns3/mobility-building-info.h>
+#include <ns3/building-list.h>
+
+#include "geometric-buildings-propagation-loss-model.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("GeometricBuildingsPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (GeometricBuildingsPropagationLossModel);
+
+
+GeometricBuildingsPropagationLossModel::GeometricBuildingsPropagationLossModel ()
+{
+  m_ituR1411Los = CreateObject<ItuR1411LosPropagationLossModel> ();
+  m_ituR1411NlosOverRooftop = CreateObject<ItuR1411NlosOverRooftopPropagationLossModel> ();
+  m_ituR1238 = CreateObject<ItuR1238PropagationLossModel> ();
+}
+
+GeometricBuildingsPropagationLossModel::~GeometricBuildingsPropagationLossModel ()
+{
+}
+
+TypeId
+GeometricBuildingsPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::GeometricBuildingsPropagationLossModel")
+    .SetParent<BuildingsPropagationLossModel> ()
+    .AddConstructor<GeometricBuildingsPropagationLossModel> ()
+    .SetGroupName ("Buildings")
+    .AddAttribute ("Frequency",
+                   "The Frequency  (default is 2.106 GHz).",
+                   DoubleValue (2160e6),
+                   MakeDoubleAccessor (&GeometricBuildingsPropagationLossModel::SetFrequency),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Environment",
+                   "Environment Scenario",
+                   EnumValue (UrbanEnvironment),
+                   MakeEnumAccessor (&GeometricBuildingsPropagationLossModel::SetEnvironment),
+                   MakeEnumChecker (UrbanEnvironment, "Urban",
+                                    SubUrbanEnvironment, "SubUrban",
+                                    OpenAreasEnvironment, "OpenAreas"))
+    .AddAttribute ("CitySize",
+                   "Dimension of the city",
+                   EnumValue (LargeCity),
+                   MakeEnumAccessor (&GeometricBuildingsPropagationLossModel::SetCitySize),
+                   MakeEnumChecker (SmallCity, "Small",
+                                    MediumCity, "Medium",
+                                    LargeCity, "Large"))
+    .AddAttribute ("RooftopLevel",
+                   "The height of the rooftop level in meters",
+                   DoubleValue (20.0),
+                   MakeDoubleAccessor (&GeometricBuildingsPropagationLossModel::SetRooftopHeight),
+                   MakeDoubleChecker<double> (0.0, 90.0))
+  ;
+  return tid;
+}
+
+void
+GeometricBuildingsPropagationLossModel::DoDispose (void)
+{
+  m_obstructions.clear ();
+  m_crossed.clear ();
+  BuildingsPropagationLossModel::DoDispose ();
+}
+
+void
+GeometricBuildingsPropagationLossModel::SetEnvironment (EnvironmentType env)
+{
+  m_ituR1411NlosOverRooftop->SetAttribute ("Environment", EnumValue (env));
+}
+
+void
+GeometricBuildingsPropagationLossModel::SetCitySize (CitySize size)
+{
+  m_ituR1411NlosOverRooftop->SetAttribute ("CitySize", EnumValue (size));
+}
+
+void
+GeometricBuildingsPropagationLossModel::SetFrequency (double freq)
+{
+  m_ituR1411Los->SetAttribute ("Frequency", DoubleValue (freq));
+  m_ituR1411NlosOverRooftop->SetAttribute ("Frequency", DoubleValue (freq));
+  m_ituR1238->SetAttribute ("Frequency", DoubleValue (freq));
+}
+
+void
+GeometricBuildingsPropagationLossModel::SetRooftopHeight (double rooftopHeight)
+{
+  m_ituR1411NlosOverRooftop->SetAttribute ("RooftopLevel", DoubleValue (rooftopHeight));
+}
+
+const GeometricBuildingsPropagationLossModel::Obstruction &
+GeometricBuildingsPropagationLossModel::GetObstruction (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  // the loss is symmetric, so is the key
+  if (b < a)
+    {
+      std::swap (a, b);
+    }
+  Vector aPosition = a->GetPosition ();
+  Vector bPosition = b->GetPosition ();
+  uint32_t generation = BuildingList::GetGeneration ();
+  std::pair<ObstructionMap::iterator, bool> ret =
+    m_obstructions.insert (std::make_pair (std::make_pair (a, b), Obstruction ()));
+  Obstruction &obstruction = ret.first->second;
+  if (!ret.second
+      && obstruction.generation == generation
+      && obstruction.a.x == aPosition.x && obstruction.a.y == aPosition.y && obstruction.a.z == aPosition.z
+      && obstruction.b.x == bPosition.x && obstruction.b.y == bPosition.y && obstruction.b.z == bPosition.z)
+    {
+      return obstruction;
+    }
+
+  obstruction.a = aPosition;
+  obstruction.b = bPosition;
+  obstruction.generation = generation;
+  obstruction.blocked = false;
+  obstruction.externalWallsLoss = 0;
+  obstruction.internalWalls = 0;
+  BuildingList::FindBuildingsCrossed (aPosition, bPosition, m_crossed);
+  for (std::vector<Ptr<Building> >::const_iterator it = m_crossed.begin (); it != m_crossed.end (); ++it)
+    {
+      uint32_t externalWalls = 0;
+      uint32_t internalWalls = 0;
+      (*it)->CountWallsCrossed (aPosition, bPosition, externalWalls, internalWalls);
+      if (externalWalls < 2)
+        {
+          // a node is inside: its external wall is accounted for by GetLoss
+          continue;
+        }
+      NS_LOG_LOGIC ("building " << (*it)->GetId () << " between " << aPosition << " and " << bPosition);
+      obstruction.blocked = true;
+      obstruction.externalWallsLoss += externalWalls * ExternalWallLoss (*it);
+      obstruction.internalWalls += internalWalls;
+    }
+  return obstruction;
+}
+
+double
+GeometricBuildingsPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG ((a->GetPosition ().z >= 0) && (b->GetPosition ().z >= 0), "GeometricBuildingsPropagationLossModel does not support underground nodes (placed at z < 0)");
+
+  Ptr<MobilityBuildingInfo> a1 = a->GetObject<MobilityBuildingInfo> ();
+  Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo> ();
+  NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "GeometricBuildingsPropagationLossModel only works with MobilityBuildingInfo");
+
+  double loss = 0.0;
+  if (a1->IsIndoor () && b1->IsIndoor () && a1->GetBuilding () == b1->GetBuilding ())
+    {
+      loss = m_ituR1238->GetLoss (a, b) + InternalWallsLoss (a1, b1);
+      NS_LOG_INFO (this << " I-I (same building) ITUR1238 : " << loss);
+    }
+  else
+    {
+      double penetration = 0.0;
+      if (a1->IsIndoor ())
+        {
+          penetration += ExternalWallLoss (a1) + HeightLoss (a1);
+        }
+      if (b1->IsIndoor ())
+        {
+          penetration += ExternalWallLoss (b1) + HeightLoss (b1);
+        }
+      loss = m_ituR1411Los->GetLoss (a, b) + penetration;
+      const Obstruction &obstruction = GetObstruction (a, b);
+      if (obstruction.blocked)
+        {
+          double through = loss + obstruction.externalWallsLoss + m_lossInternalWall * obstruction.internalWalls;
+          double over = m_ituR1411NlosOverRooftop->GetLoss (a, b) + penetration;
+          // an obstruction does not make the loss smaller than in line of sight
+          loss = std::max (loss, std::min (through, over));
+          NS_LOG_INFO (this << " NLOS through " << through << " over rooftops " << over << " : " << loss);
+        }
+      else
+        {
+          NS_LOG_INFO (this << " LOS ITUR1411 : " << loss);
+        }
+    }
+
+  loss = std::max (loss, 0.0);
+  return loss;
+}
+
+
+} // namespace ns3
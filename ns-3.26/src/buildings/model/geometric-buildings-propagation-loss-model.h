@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef GEOMETRIC_BUILDINGS_PROPAGATION_LOSS_MODEL_H_
+#define GEOMETRIC_BUILDINGS_PROPAGATION_LOSS_MODEL_H_
+
+#include <ns3/buildings-propagation-loss-model.h>
+#include <ns3/propagation-environment.h>
+#include <ns3/vector.h>
+#include <map>
+
+namespace ns3 {
+
+class ItuR1411LosPropagationLossModel;
+class ItuR1411NlosOverRooftopPropagationLossModel;
+class ItuR1238PropagationLossModel;
+
+/**
+ * \ingroup propagation
+ *
+ *  \brief A buildings propagation loss model deciding between line of
+ *  sight and non line of sight from the buildings actually between the
+ *  nodes.
+ *
+ *  The segment between the nodes is intersected with the buildings
+ *  (see BuildingList::FindBuildingsCrossed and
+ *  Building::CountWallsCrossed), ignoring the buildings in which the
+ *  nodes are. Then:
+ *  - nodes in the same building: ITU-R P.1238 plus the internal walls
+ *    between their rooms, as in HybridBuildingsPropagationLossModel;
+ *  - no building between the nodes: ITU-R P.1411 line of sight, at any
+ *    distance;
+ *  - buildings between the nodes: the smallest of the loss through
+ *    them, that is ITU-R P.1411 line of sight plus the external and
+ *    internal walls crossed, and of the loss over their rooftops, that
+ *    is ITU-R P.1411 non line of sight over rooftops.
+ *  In the last two cases, the external wall loss and the height gain of
+ *  the buildings of the indoor nodes are added.
+ *
+ *  The buildings between the nodes of a link are cached with the
+ *  positions of the nodes, and looked up again only when a node moves
+ *  or a building changes, so that the cost of the geometric query is
+ *  paid once for static links.
+ *
+ *  \warning This model works only with MobilityBuildingInfo
+ */
+class GeometricBuildingsPropagationLossModel : public BuildingsPropagationLossModel
+{
+
+public:
+  static TypeId GetTypeId (void);
+  GeometricBuildingsPropagationLossModel ();
+  ~GeometricBuildingsPropagationLossModel ();
+
+  /**
+   * set the environment type
+   *
+   * \param env
+   */
+  void SetEnvironment (EnvironmentType env);
+
+  /**
+   * set the size of the city
+   *
+   * \param size
+   */
+  void SetCitySize (CitySize size);
+
+  /**
+   * set the propagation frequency
+   *
+   * \param freq
+   */
+  void SetFrequency (double freq);
+
+  /**
+   * set the rooftop height
+   *
+   * \param rooftopHeight
+   */
+  void SetRooftopHeight (double rooftopHeight);
+
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \returns the propagation loss (in dBm)
+   */
+  virtual double GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /// The buildings between the nodes of a link
+  struct Obstruction
+  {
+    Vector a;                //!< the position of the first node of the key
+    Vector b;                //!< the position of the second node of the key
+    uint32_t generation;     //!< the BuildingList generation of the query
+    bool blocked;            //!< whether any building is between the nodes
+    double externalWallsLoss; //!< the loss of the external walls crossed [dB]
+    uint32_t internalWalls;  //!< the number of internal walls and floors crossed
+  };
+
+  /**
+   * Get the buildings between two nodes, from the cache if neither the
+   * nodes nor the buildings moved since the last call
+   * \param a the mobility model of a node
+   * \param b the mobility model of the other node
+   * \returns the buildings between the nodes
+   */
+  const Obstruction & GetObstruction (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+  Ptr<ItuR1411LosPropagationLossModel> m_ituR1411Los;
+  Ptr<ItuR1411NlosOverRooftopPropagationLossModel> m_ituR1411NlosOverRooftop;
+  Ptr<ItuR1238PropagationLossModel> m_ituR1238;
+
+  /// Container: the links, each with its nodes in increasing pointer order
+  typedef std::map<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel> >, Obstruction> ObstructionMap;
+  mutable ObstructionMap m_obstructions; //!< the buildings between the nodes of each link
+  mutable std::vector<Ptr<Building> > m_crossed; //!< scratch list of the buildings crossed
+};
+
+}
+
+#endif /* GEOMETRIC_BUILDINGS_PROPAGATION_LOSS_MODEL_H_ */
@@ -22,6 +22,7 @@
 #include <ns3/simulator.h>
 #include <ns3/position-allocator.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/building-list.h>
 #include <ns3/pointer.h>
 #include <ns3/log.h>
 #include <ns3/assert.h>
@@ -51,6 +52,8 @@ MobilityBuildingInfo::MobilityBuildingInfo ()
   m_nFloor = 1;
   m_roomX = 1;
   m_roomY = 1;
+  m_consistent = false;
+  m_generation = 0;
 }
 
 
@@ -62,6 +65,8 @@ MobilityBuildingInfo::MobilityBuildingInfo (Ptr<Building> building)
   m_nFloor = 1;
   m_roomX = 1;
   m_roomY = 1;
+  m_consistent = false;
+  m_generation = 0;
 }
 
 bool
@@ -82,6 +87,7 @@ void
 MobilityBuildingInfo::SetIndoor (Ptr<Building> building, uint8_t nfloor, uint8_t nroomx, uint8_t nroomy)
 {
   NS_LOG_FUNCTION (this);
+  m_consistent = false;
   m_indoor = true;
   m_myBuilding = building;
   m_nFloor = nfloor;
@@ -103,6 +109,7 @@ void
 MobilityBuildingInfo::SetIndoor (uint8_t nfloor, uint8_t nroomx, uint8_t nroomy)
 {
   NS_LOG_FUNCTION (this);
+  m_consistent = false;
   m_indoor = true;
   m_nFloor = nfloor;
   m_roomX = nroomx;
@@ -123,6 +130,7 @@ void
 MobilityBuildingInfo::SetOutdoor (void)
 {
   NS_LOG_FUNCTION (this);
+  m_consistent = false;
   m_indoor = false;
 }
 
@@ -155,5 +163,33 @@ MobilityBuildingInfo::GetBuilding ()
   return (m_myBuilding);
 }
 
+void
+MobilityBuildingInfo::MakeConsistent (Ptr<MobilityModel> mm)
+{
+  NS_LOG_FUNCTION (this << mm);
+  Vector pos = mm->GetPosition ();
+  uint32_t generation = BuildingList::GetGeneration ();
+  if (m_consistent && generation == m_generation
+      && pos.x == m_position.x && pos.y == m_position.y && pos.z == m_position.z)
+    {
+      NS_LOG_LOGIC ("position " << pos << " and buildings unchanged");
+      return;
+    }
+  Ptr<Building> building = BuildingList::FindBuilding (pos);
+  if (building != 0)
+    {
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << this << " pos " << pos << " falls inside building " << building->GetId ());
+      SetIndoor (building, building->GetFloor (pos), building->GetRoomX (pos), building->GetRoomY (pos));
+    }
+  else
+    {
+      NS_LOG_LOGIC ("MobilityBuildingInfo " << this << " pos " << pos << " is outdoor");
+      SetOutdoor ();
+    }
+  m_consistent = true;
+  m_position = pos;
+  m_generation = generation;
+}
+
   
 } // namespace
@@ -30,6 +30,7 @@
 #include <map>
 #include <ns3/building.h>
 #include <ns3/constant-velocity-helper.h>
+#include <ns3/mobility-model.h>
 
 
 
@@ -107,7 +108,18 @@ public:
    */
   Ptr<Building> GetBuilding ();
 
-
+  /**
+   * Update the indoor/outdoor state, building, floor and room from the
+   * current position of a mobility model, looking up the building
+   * containing it with BuildingList::FindBuilding.
+   *
+   * The state is not recomputed if neither the position nor the
+   * buildings changed since the last call, so that calling this method
+   * repeatedly on static nodes is cheap.
+   *
+   * \param mm the mobility model to which this instance is aggregated
+   */
+  void MakeConsistent (Ptr<MobilityModel> mm);
 
 private:
 
@@ -117,6 +129,10 @@ private:
   uint8_t m_roomX;
   uint8_t m_roomY;
 
+  bool m_consistent;          //!< whether m_position and m_generation are valid
+  Vector m_position;          //!< the position at the last MakeConsistent
+  uint32_t m_generation;      //!< the BuildingList generation at the last MakeConsistent
+
 };
 
 
@@ -25,9 +25,12 @@
 #include <ns3/mobility-building-info.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/building.h>
+#include <ns3/building-list.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/mobility-helper.h>
+#include <ns3/random-variable-stream.h>
 #include <ns3/simulator.h>
+#include <algorithm>
 
 using namespace ns3;
 
@@ -173,6 +176,166 @@ BuildingsHelperOneTestCase::DoRun ()
 
 
 
+/**
+ * Check the index of BuildingList against a linear scan of the
+ * buildings, in a random city, and the updates of MobilityBuildingInfo
+ * when a node or a building moves.
+ */
+class BuildingListIndexTestCase : public TestCase
+{
+public:
+  BuildingListIndexTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param p some position
+   * \returns the building containing p, found by a linear scan
+   */
+  Ptr<Building> ScanBuilding (Vector p);
+  /**
+   * \param a one end of a segment
+   * \param b the other end of the segment
+   * \returns the buildings intersecting the segment, found by a linear
+   * scan, in the order in which the segment enters them
+   */
+  std::vector<Ptr<Building> > ScanBuildingsCrossed (Vector a, Vector b);
+};
+
+BuildingListIndexTestCase::BuildingListIndexTestCase ()
+  : TestCase ("BuildingList index vs linear scan")
+{
+}
+
+Ptr<Building>
+BuildingListIndexTestCase::ScanBuilding (Vector p)
+{
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      if ((*bit)->IsInside (p))
+        {
+          return *bit;
+        }
+    }
+  return 0;
+}
+
+std::vector<Ptr<Building> >
+BuildingListIndexTestCase::ScanBuildingsCrossed (Vector a, Vector b)
+{
+  std::vector<std::pair<double, Ptr<Building> > > crossed;
+  for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+    {
+      Box box = (*bit)->GetBoundaries ();
+      double lo[3] = { box.xMin, box.yMin, box.zMin };
+      double hi[3] = { box.xMax, box.yMax, box.zMax };
+      double origin[3] = { a.x, a.y, a.z };
+      double direction[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+      double enter = 0;
+      double exit = 1;
+      for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+          if (direction[axis] == 0)
+            {
+              if (origin[axis] < lo[axis] || origin[axis] > hi[axis])
+                {
+                  exit = -1;
+                }
+              continue;
+            }
+          double t0 = (lo[axis] - origin[axis]) / direction[axis];
+          double t1 = (hi[axis] - origin[axis]) / direction[axis];
+          enter = std::max (enter, std::min (t0, t1));
+          exit = std::min (exit, std::max (t0, t1));
+        }
+      if (enter <= exit)
+        {
+          crossed.push_back (std::make_pair (enter, *bit));
+        }
+    }
+  std::sort (crossed.begin (), crossed.end ());
+  std::vector<Ptr<Building> > buildings;
+  for (uint32_t i = 0; i < crossed.size (); ++i)
+    {
+      buildings.push_back (crossed[i].second);
+    }
+  return buildings;
+}
+
+void
+BuildingListIndexTestCase::DoRun ()
+{
+  // blocks of 50 m with 10 m streets, each with a building of random size
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      for (uint32_t j = 0; j < 20; ++j)
+        {
+          double x = i * 60 + rand->GetValue (0, 10);
+          double y = j * 60 + rand->GetValue (0, 10);
+          Ptr<Building> b = CreateObject<Building> ();
+          b->SetBoundaries (Box (x, x + rand->GetValue (5, 40), y, y + rand->GetValue (5, 40), 0, rand->GetValue (3, 30)));
+        }
+    }
+
+  for (uint32_t n = 0; n < 1000; ++n)
+    {
+      Vector p (rand->GetValue (-10, 1210), rand->GetValue (-10, 1210), rand->GetValue (0, 30));
+      NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (p), ScanBuilding (p), "wrong building at " << p);
+    }
+
+  for (uint32_t n = 0; n < 100; ++n)
+    {
+      Vector a (rand->GetValue (-10, 1210), rand->GetValue (-10, 1210), rand->GetValue (0, 30));
+      Vector b (rand->GetValue (-10, 1210), rand->GetValue (-10, 1210), rand->GetValue (0, 30));
+      if (n % 10 == 0)
+        {
+          // axis-aligned segments
+          b.y = a.y;
+        }
+      std::vector<Ptr<Building> > crossed;
+      BuildingList::FindBuildingsCrossed (a, b, crossed);
+      std::vector<Ptr<Building> > expected = ScanBuildingsCrossed (a, b);
+      NS_TEST_ASSERT_MSG_EQ (crossed.size (), expected.size (), "wrong number of buildings crossed from " << a << " to " << b);
+      for (uint32_t i = 0; i < crossed.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (crossed[i], expected[i], "wrong building crossed from " << a << " to " << b);
+        }
+    }
+
+  // a node walking through the city, updated after each step
+  Ptr<ConstantPositionMobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+  mm->AggregateObject (buildingInfo);
+  for (double x = 0; x < 1200; x += 0.5)
+    {
+      Vector p (x, 0.4 * x + 13, 1.5);
+      mm->SetPosition (p);
+      BuildingsHelper::MakeConsistent (mm);
+      Ptr<Building> expected = ScanBuilding (p);
+      NS_TEST_ASSERT_MSG_EQ (buildingInfo->IsIndoor (), (expected != 0), "indoor/outdoor mismatch at " << p);
+      if (expected != 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (buildingInfo->GetBuilding (), expected, "building mismatch at " << p);
+        }
+    }
+
+  // a building moved onto a static node
+  Vector p (55, 55, 1);
+  mm->SetPosition (p);
+  BuildingsHelper::MakeConsistent (mm);
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->IsOutdoor (), true, "the streets are outdoor");
+  Ptr<Building> b = BuildingList::GetBuilding (0);
+  b->SetBoundaries (Box (50, 58, 50, 58, 0, 10));
+  BuildingsHelper::MakeConsistent (mm);
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->IsIndoor (), true, "the moved building was not found");
+  NS_TEST_ASSERT_MSG_EQ (buildingInfo->GetBuilding (), b, "wrong building");
+  NS_TEST_ASSERT_MSG_EQ (BuildingList::FindBuilding (Vector (5, 5, 1)), ScanBuilding (Vector (5, 5, 1)), "stale index");
+
+  Simulator::Destroy ();
+}
+
+
 class BuildingsHelperTestSuite : public TestSuite
 {
 public:
@@ -321,6 +484,8 @@ BuildingsHelperTestSuite::BuildingsHelperTestSuite ()
   q7.pos = vq7;
   q7.indoor = false;
   AddTestCase (new BuildingsHelperOneTestCase (q7, b2), TestCase::QUICK);     
+
+  AddTestCase (new BuildingListIndexTestCase, TestCase::QUICK);
 }
 
 static BuildingsHelperTestSuite buildingsHelperAntennaTestSuiteInstance;
@@ -30,6 +30,9 @@
 #include <ns3/enum.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/geometric-buildings-propagation-loss-model.h>
+#include <ns3/itu-r-1411-los-propagation-loss-model.h>
+#include <ns3/itu-r-1411-nlos-over-rooftop-propagation-loss-model.h>
 #include "buildings-pathloss-test.h"
 
 
@@ -123,6 +126,9 @@ BuildingsPathlossTestSuite::BuildingsPathlossTestSuite ()
   // (2 floors x 2 dB/floor = 4) -> 180.90 + 7 - 4 = 183.90
   AddTestCase (new BuildingsPathlossTestCase (freq, 9, 11, UrbanEnvironment, LargeCity, 183.90, "ITU1411 NLOS Indoor -> Outdoor"), TestCase::QUICK);
 
+  // Test #12 line of sight from the geometry of the buildings
+  AddTestCase (new GeometricBuildingsPathlossTestCase, TestCase::QUICK);
+
 
 }
 
@@ -270,3 +276,82 @@ BuildingsPathlossTestCase::CreateMobilityModel (uint16_t index)
   BuildingsHelper::MakeConsistent (mm); 
   return mm;
 }
+
+
+GeometricBuildingsPathlossTestCase::GeometricBuildingsPathlossTestCase ()
+  : TestCase ("Geometric line of sight")
+{
+}
+
+Ptr<MobilityModel>
+GeometricBuildingsPathlossTestCase::CreateMobilityModel (Vector position)
+{
+  Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+  mm->SetPosition (position);
+  mm->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+  BuildingsHelper::MakeConsistent (mm);
+  return mm;
+}
+
+void
+GeometricBuildingsPathlossTestCase::DoRun (void)
+{
+  double freq = 2.1140e9;
+  // a building with 2 rooms along x and 2 floors, in the way from a to c
+  Ptr<Building> building = CreateObject<Building> ();
+  building->SetBoundaries (Box (40, 60, -10, 10, 0, 20));
+  building->SetExtWallsType (Building::ConcreteWithWindows);
+  building->SetNRoomsX (2);
+  building->SetNFloors (2);
+
+  uint32_t externalWalls = 0;
+  uint32_t internalWalls = 0;
+  NS_TEST_ASSERT_MSG_EQ (building->CountWallsCrossed (Vector (0, 0, 1.5), Vector (100, 0, 1.5), externalWalls, internalWalls),
+                         true, "the building is crossed");
+  NS_TEST_ASSERT_MSG_EQ (externalWalls, 2, "wrong number of external walls");
+  NS_TEST_ASSERT_MSG_EQ (internalWalls, 1, "wrong number of internal walls");
+  NS_TEST_ASSERT_MSG_EQ (building->CountWallsCrossed (Vector (50, 0, 1.5), Vector (50, 0, 100), externalWalls, internalWalls),
+                         true, "the building is crossed");
+  NS_TEST_ASSERT_MSG_EQ (externalWalls, 1, "wrong number of external walls");
+  NS_TEST_ASSERT_MSG_EQ (internalWalls, 1, "wrong number of floors");
+  NS_TEST_ASSERT_MSG_EQ (building->CountWallsCrossed (Vector (0, 20, 1.5), Vector (100, 20, 1.5), externalWalls, internalWalls),
+                         false, "the building is not crossed");
+
+  // a is above the rooftops, the other nodes at the street level
+  Ptr<MobilityModel> a = CreateMobilityModel (Vector (0, 0, 30));
+  Ptr<MobilityModel> c = CreateMobilityModel (Vector (100, 0, 1.5));
+  Ptr<MobilityModel> d = CreateMobilityModel (Vector (0, 50, 1.5));
+  Ptr<MobilityModel> e = CreateMobilityModel (Vector (45, 0, 1.5));
+
+  Ptr<GeometricBuildingsPropagationLossModel> model = CreateObject<GeometricBuildingsPropagationLossModel> ();
+  model->SetAttribute ("Frequency", DoubleValue (freq));
+  Ptr<ItuR1411LosPropagationLossModel> los = CreateObject<ItuR1411LosPropagationLossModel> ();
+  los->SetAttribute ("Frequency", DoubleValue (freq));
+  Ptr<ItuR1411NlosOverRooftopPropagationLossModel> nlos = CreateObject<ItuR1411NlosOverRooftopPropagationLossModel> ();
+  nlos->SetAttribute ("Frequency", DoubleValue (freq));
+
+  // line of sight
+  NS_TEST_ASSERT_MSG_EQ_TOL (model->GetLoss (a, d), los->GetLoss (a, d), 1e-9, "a and d are in line of sight");
+
+  // through 2 external walls of 7 dB and an internal wall of 5 dB
+  // (between the 2 rooms; the segment stays on the upper floor), or over
+  // the rooftop
+  double blocked = std::max (los->GetLoss (a, c), std::min (los->GetLoss (a, c) + 2 * 7 + 5, nlos->GetLoss (a, c)));
+  NS_TEST_ASSERT_MSG_EQ_TOL (model->GetLoss (a, c), blocked, 1e-9, "a and c are not in line of sight");
+  NS_TEST_ASSERT_MSG_EQ_TOL (model->GetLoss (c, a), blocked, 1e-9, "the loss is not symmetric");
+  NS_TEST_ASSERT_MSG_GT (blocked, los->GetLoss (a, c) + 1, "the building has no effect");
+
+  // the building of an indoor node does not block it
+  NS_TEST_ASSERT_MSG_EQ_TOL (model->GetLoss (a, e), los->GetLoss (a, e) + 7, 1e-9, "e is indoor in line of sight");
+
+  // a node moving behind the building
+  d->SetPosition (Vector (100, 5, 1.5));
+  BuildingsHelper::MakeConsistent (d);
+  NS_TEST_ASSERT_MSG_GT (model->GetLoss (a, d), los->GetLoss (a, d) + 1, "d moved behind the building");
+
+  // the building moving out of the way
+  building->SetBoundaries (Box (40, 60, 100, 120, 0, 20));
+  NS_TEST_ASSERT_MSG_EQ_TOL (model->GetLoss (a, c), los->GetLoss (a, c), 1e-9, "the building moved away");
+
+  Simulator::Destroy ();
+}
@@ -56,5 +56,24 @@ private:
 
 };
 
+/**
+ * Test the choice between line of sight and non line of sight of
+ * GeometricBuildingsPropagationLossModel from the buildings between the
+ * nodes, and the update of its cache when a node or a building moves.
+ */
+class GeometricBuildingsPathlossTestCase : public TestCase
+{
+public:
+  GeometricBuildingsPathlossTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param position the position of the node
+   * \returns a mobility model with a MobilityBuildingInfo
+   */
+  Ptr<MobilityModel> CreateMobilityModel (Vector position);
+};
+
 
 #endif /* BUILDING_PATHLOSS_TEST_H */
@@ -23,13 +23,18 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
+#include "ns3/simulator.h"
+#include "ns3/abort.h"
 
-#include <limits>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("LteGlobalPathlossDatabase");
 
+LteGlobalPathlossDatabase::LteGlobalPathlossDatabase (void)
+{
+}
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase (void)
 {
 }
@@ -38,15 +43,14 @@ void
 LteGlobalPathlossDatabase::Print ()
 {
   NS_LOG_FUNCTION (this);
-  for (std::map<uint16_t, std::map<uint64_t, double> >::const_iterator cellIdIt = m_pathlossMap.begin ();
-       cellIdIt != m_pathlossMap.end ();
-       ++cellIdIt)
+  for (uint16_t cellId = 1; cellId <= m_pathloss.GetNCells (); ++cellId)
     {
-      for (std::map<uint64_t, double>::const_iterator imsiIt = cellIdIt->second.begin ();
-           imsiIt != cellIdIt->second.end ();
-           ++imsiIt)
+      for (uint64_t imsi = 1; imsi <= m_pathloss.GetNImsis (); ++imsi)
         {
-          std::cout << "CellId: " << cellIdIt->first << " IMSI: " << imsiIt->first << " pathloss: " << imsiIt->second << " dB" << std::endl;
+          if (m_pathloss.IsSet (cellId, imsi))
+            {
+              std::cout << "CellId: " << cellId << " IMSI: " << imsi << " pathloss: " << m_pathloss.Get (cellId, imsi) << " dB" << std::endl;
+            }
         }
     }
 }
@@ -56,17 +60,66 @@ double
 LteGlobalPathlossDatabase::GetPathloss (uint16_t cellId, uint64_t imsi)
 {
   NS_LOG_FUNCTION (this);
-  std::map<uint16_t, std::map<uint64_t, double> >::iterator cellIt = m_pathlossMap.find (cellId);
-  if (cellIt == m_pathlossMap.end())
+  return m_pathloss.Get (cellId, imsi);
+}
+
+const LtePathlossMatrix &
+LteGlobalPathlossDatabase::GetPathlossMatrix (void) const
+{
+  return m_pathloss;
+}
+
+void
+LteGlobalPathlossDatabase::EnableSnapshots (std::string fileName, Time interval)
+{
+  NS_LOG_FUNCTION (this << fileName << interval);
+  NS_ABORT_MSG_IF (m_snapshotFile.is_open (), "snapshots already enabled");
+  NS_ABORT_MSG_IF (!interval.IsStrictlyPositive (), "invalid snapshot interval " << interval);
+  m_snapshotFile.open (fileName.c_str (), std::ofstream::out | std::ofstream::binary);
+  NS_ABORT_MSG_IF (!m_snapshotFile.is_open (), "Can't open file " << fileName);
+  LtePathlossMatrix::WriteFileHeader (m_snapshotFile);
+  m_snapshotInterval = interval;
+  Simulator::Schedule (m_snapshotInterval, &LteGlobalPathlossDatabase::PeriodicSnapshot, this);
+}
+
+void
+LteGlobalPathlossDatabase::WriteSnapshot ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (!m_snapshotFile.is_open (), "snapshots not enabled");
+  m_pathloss.WriteSnapshot (m_snapshotFile, Simulator::Now ());
+  // a snapshot file is usually read while the simulation is running,
+  // or after it is interrupted
+  m_snapshotFile.flush ();
+}
+
+void
+LteGlobalPathlossDatabase::PeriodicSnapshot ()
+{
+  WriteSnapshot ();
+  Simulator::Schedule (m_snapshotInterval, &LteGlobalPathlossDatabase::PeriodicSnapshot, this);
+}
+
+uint16_t
+LteGlobalPathlossDatabase::GetCellId (Ptr<SpectrumPhy> phy)
+{
+  std::map<Ptr<SpectrumPhy>, uint64_t>::const_iterator it = m_phyIds.find (phy);
+  if (it == m_phyIds.end ())
     {
-      return std::numeric_limits<double>::infinity ();
+      it = m_phyIds.insert (std::make_pair (phy, phy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ())).first;
     }
-  std::map<uint64_t, double>::iterator ueIt = cellIt->second.find (imsi);
-  if (ueIt ==  cellIt->second.end())
+  return it->second;
+}
+
+uint64_t
+LteGlobalPathlossDatabase::GetImsi (Ptr<SpectrumPhy> phy)
+{
+  std::map<Ptr<SpectrumPhy>, uint64_t>::const_iterator it = m_phyIds.find (phy);
+  if (it == m_phyIds.end ())
     {
-      return std::numeric_limits<double>::infinity ();
+      it = m_phyIds.insert (std::make_pair (phy, phy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ())).first;
     }
-  return ueIt->second;
+  return it->second;
 }
  
 
@@ -77,9 +130,9 @@ DownlinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
-  uint16_t cellId = txPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  uint16_t imsi = rxPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  uint16_t cellId = GetCellId (txPhy);
+  uint64_t imsi = GetImsi (rxPhy);
+  m_pathloss.Set (cellId, imsi, lossDb);
 }
 
 
@@ -90,9 +143,9 @@ UplinkLteGlobalPathlossDatabase::UpdatePathloss (std::string context,
                                         double lossDb)
 {
   NS_LOG_FUNCTION (this << lossDb);
-  uint16_t imsi = txPhy->GetDevice ()->GetObject<LteUeNetDevice> ()->GetImsi ();
-  uint16_t cellId = rxPhy->GetDevice ()->GetObject<LteEnbNetDevice> ()->GetCellId ();
-  m_pathlossMap[cellId][imsi] = lossDb;
+  uint64_t imsi = GetImsi (txPhy);
+  uint16_t cellId = GetCellId (rxPhy);
+  m_pathloss.Set (cellId, imsi, lossDb);
 }
 
 
@@ -24,12 +24,15 @@
 
 #include <ns3/log.h>
 #include <ns3/ptr.h>
+#include <ns3/nstime.h>
+#include <ns3/lte-pathloss-matrix.h>
+#include <ns3/spectrum-phy.h>
 #include <string>
 #include <map>
+#include <fstream>
 
 namespace ns3 {
 
-class SpectrumPhy;
 
 /**
  * \ingroup lte
@@ -37,12 +40,16 @@ class SpectrumPhy;
  * Store the last pathloss value for each TX-RX pair. This is an
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work. 
- * 
+ *
+ * The values are stored in a dense LtePathlossMatrix, which can be
+ * saved periodically to a snapshot file, and then replayed by an
+ * LteStaticPathlossModel.
  */
 class LteGlobalPathlossDatabase
 {
 public:
 
+  LteGlobalPathlossDatabase (void);
   virtual ~LteGlobalPathlossDatabase (void);
 
   /** 
@@ -71,12 +78,60 @@ public:
    */
   void Print ();
 
+  /**
+   * \return the stored pathloss values
+   */
+  const LtePathlossMatrix & GetPathlossMatrix (void) const;
+
+  /**
+   * Save the stored pathloss values periodically to a snapshot file,
+   * in the format of LtePathlossMatrix. The first snapshot is taken
+   * after one interval.
+   *
+   * The snapshots are taken until the end of the simulation, which
+   * must be therefore stopped by Simulator::Stop, and the database must
+   * exist until then.
+   *
+   * \param fileName the name of the snapshot file
+   * \param interval the time between two snapshots
+   */
+  void EnableSnapshots (std::string fileName, Time interval);
+
+  /**
+   * Append a snapshot of the stored pathloss values to the snapshot
+   * file enabled by EnableSnapshots.
+   */
+  void WriteSnapshot ();
+
 protected:
   /**
-   * List of the last pathloss value for each UE by CellId.
-   * ( CELL ID,  ( IMSI,PATHLOSS ))
+   * \param phy the PHY of an eNB
+   * \return the cell ID of the eNB
    */
-  std::map<uint16_t, std::map<uint64_t, double> > m_pathlossMap;
+  uint16_t GetCellId (Ptr<SpectrumPhy> phy);
+  /**
+   * \param phy the PHY of a UE
+   * \return the IMSI of the UE
+   */
+  uint64_t GetImsi (Ptr<SpectrumPhy> phy);
+
+  /**
+   * The last pathloss value for each UE by CellId.
+   */
+  LtePathlossMatrix m_pathloss;
+
+private:
+  /// Periodically take a snapshot
+  void PeriodicSnapshot ();
+
+  /**
+   * The cell ID or IMSI of the PHYs already seen by the trace, which
+   * are cheaper to find than to get from their devices.
+   */
+  std::map<Ptr<SpectrumPhy>, uint64_t> m_phyIds;
+
+  std::ofstream m_snapshotFile;  //!< the snapshot file
+  Time m_snapshotInterval;       //!< the time between two snapshots
 };
 
 /**
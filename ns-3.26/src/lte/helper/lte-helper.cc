@@ -22,6 +22,7 @@
 
 #include "lte-helper.h"
 #include <ns3/string.h>
+#include <ns3/uinteger.h>
 #include <ns3/log.h>
 #include <ns3/abort.h>
 #include <ns3/pointer.h>
@@ -200,6 +201,13 @@ TypeId LteHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteHelper::m_usePdschForCqiGeneration),
                    MakeBooleanChecker ())
+    .AddAttribute ("SubframeThreads",
+                   "The number of threads running in parallel the schedulers of the eNBs "
+                   "starting a subframe at the same time. "
+                   "If 0, the scheduler of each eNB runs at the start of its subframe.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LteHelper::m_subframeThreads),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -210,6 +218,7 @@ LteHelper::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
+  m_subframeThreadPool = 0;
   Object::DoDispose ();
 }
 
@@ -452,6 +461,14 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n)
   ulPhy->SetAntenna (antenna);
 
   Ptr<LteEnbMac> mac = CreateObject<LteEnbMac> ();
+  if (m_subframeThreads > 0)
+    {
+      if (m_subframeThreadPool == 0)
+        {
+          m_subframeThreadPool = Create<LteSubframeThreadPool> (m_subframeThreads);
+        }
+      mac->SetSubframeThreadPool (m_subframeThreadPool);
+    }
   Ptr<FfMacScheduler> sched = m_schedulerFactory.Create<FfMacScheduler> ();
   Ptr<LteFfrAlgorithm> ffrAlgorithm = m_ffrAlgorithmFactory.Create<LteFfrAlgorithm> ();
   Ptr<LteHandoverAlgorithm> handoverAlgorithm = m_handoverAlgorithmFactory.Create<LteHandoverAlgorithm> ();
@@ -45,6 +45,7 @@ class LteUePhy;
 class LteEnbPhy;
 class SpectrumChannel;
 class EpcHelper;
+class LteSubframeThreadPool;
 class PropagationLossModel;
 class SpectrumPropagationLossModel;
 
@@ -732,6 +733,15 @@ private:
    */
   bool m_usePdschForCqiGeneration;
 
+  /**
+   * The `SubframeThreads` attribute. The number of threads running in
+   * parallel the schedulers of the eNBs starting a subframe at the same
+   * time, 0 to run the scheduler of each eNB at the start of its subframe.
+   */
+  uint32_t m_subframeThreads;
+  /// The pool of threads shared by the eNBs, if `SubframeThreads` is not 0
+  Ptr<LteSubframeThreadPool> m_subframeThreadPool;
+
 }; // end of `class LteHelper`
 
 
@@ -0,0 +1,365 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-stats-binary-file.h"
+
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteStatsBinaryFile");
+
+/// Number of blocks of the ring
+static const uint32_t RING_BLOCKS = 4;
+
+/// Percentiles of the aggregated records, after the mean and the minimum
+static const double PERCENTILES[] = {0.5, 0.95, 1.0};
+
+/// Suffixes of the columns of the aggregated records
+static const char * const AGGREGATE_SUFFIXES[] = {"_mean", "_min", "_p50", "_p95", "_max"};
+
+/// Number of columns of the aggregated records for each value column
+static const uint32_t N_AGGREGATES = sizeof (AGGREGATE_SUFFIXES) / sizeof (AGGREGATE_SUFFIXES[0]);
+
+/**
+ * Write the description of a column
+ * \param file the file
+ * \param type the type of the column
+ * \param name the name of the column
+ */
+static void
+WriteColumn (std::ofstream &file, char type, std::string name)
+{
+  uint8_t length = std::min<size_t> (name.size (), 255);
+  file.write (&type, 1);
+  file.write ((const char *) &length, 1);
+  file.write (name.data (), length);
+}
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * Wait until a condition is set. Unlike SystemCondition::Wait, this does
+ * not reset the condition before waiting, so that a Signal sent before the
+ * call is not missed: the caller resets it while checking its state.
+ * \param condition the condition
+ */
+static void
+WaitForCondition (SystemCondition &condition)
+{
+  while (condition.TimedWait (1000000000))
+    {
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+LteStatsBinaryFile::LteStatsBinaryFile (std::string filename, std::vector<std::string> keys,
+                                        std::vector<std::string> values, Time window, uint32_t blockRows)
+  : m_nKeys (keys.size ()),
+    m_nValues (values.size ()),
+    m_blockRows (std::max<uint32_t> (blockRows, 1)),
+    m_head (0),
+    m_window (window.GetNanoSeconds ()),
+    m_windowStart (0)
+#ifdef HAVE_PTHREAD_H
+    ,
+    m_tail (0),
+    m_nFull (0),
+    m_stop (false)
+#endif /* HAVE_PTHREAD_H */
+{
+  NS_LOG_FUNCTION (this << filename << window << blockRows);
+
+  // time, keys and, for the aggregated records, count
+  m_nU = 1 + m_nKeys + (m_window > 0 ? 1 : 0);
+  m_nD = m_nValues * (m_window > 0 ? N_AGGREGATES : 1);
+
+  m_file.open (filename.c_str (), std::ios_base::binary | std::ios_base::trunc);
+  if (!m_file.is_open ())
+    {
+      NS_LOG_ERROR ("Can't open file " << filename.c_str ());
+      return;
+    }
+
+  m_file.write ("LTESTATS", 8);
+  uint32_t version = 1;
+  m_file.write ((const char *) &version, sizeof (version));
+  uint32_t nColumns = m_nU + m_nD;
+  m_file.write ((const char *) &nColumns, sizeof (nColumns));
+  WriteColumn (m_file, 'u', "time");
+  for (uint32_t i = 0; i < m_nKeys; ++i)
+    {
+      WriteColumn (m_file, 'u', keys.at (i));
+    }
+  if (m_window > 0)
+    {
+      WriteColumn (m_file, 'u', "count");
+    }
+  for (uint32_t i = 0; i < m_nValues; ++i)
+    {
+      if (m_window > 0)
+        {
+          for (uint32_t j = 0; j < N_AGGREGATES; ++j)
+            {
+              WriteColumn (m_file, 'd', values.at (i) + AGGREGATE_SUFFIXES[j]);
+            }
+        }
+      else
+        {
+          WriteColumn (m_file, 'd', values.at (i));
+        }
+    }
+
+  m_ring.resize (RING_BLOCKS);
+  for (uint32_t i = 0; i < RING_BLOCKS; ++i)
+    {
+      m_ring[i].rows = 0;
+      m_ring[i].uColumns.resize (m_nU * m_blockRows);
+      m_ring[i].dColumns.resize (m_nD * m_blockRows);
+    }
+  m_key.resize (m_nKeys);
+  m_uRow.resize (m_nU);
+  m_dRow.resize (m_nD);
+
+#ifdef HAVE_PTHREAD_H
+  m_writer = Create<SystemThread> (MakeCallback (&LteStatsBinaryFile::DoWrite, this));
+  m_writer->Start ();
+#endif /* HAVE_PTHREAD_H */
+}
+
+LteStatsBinaryFile::~LteStatsBinaryFile ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+bool
+LteStatsBinaryFile::IsOpen (void) const
+{
+  return m_file.is_open ();
+}
+
+void
+LteStatsBinaryFile::Write (const uint64_t *keys, const double *values)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  if (m_window == 0)
+    {
+      m_uRow[0] = now;
+      std::copy (keys, keys + m_nKeys, m_uRow.begin () + 1);
+      AddRow (&m_uRow[0], values);
+      return;
+    }
+
+  if (now >= m_windowStart + m_window)
+    {
+      FlushWindow ();
+      m_windowStart = now - now % m_window;
+    }
+  std::copy (keys, keys + m_nKeys, m_key.begin ());
+  std::map<std::vector<uint64_t>, std::vector<std::vector<double> > >::iterator it = m_samples.find (m_key);
+  if (it == m_samples.end ())
+    {
+      it = m_samples.insert (std::make_pair (m_key, std::vector<std::vector<double> > (m_nValues))).first;
+    }
+  for (uint32_t i = 0; i < m_nValues; ++i)
+    {
+      it->second[i].push_back (values[i]);
+    }
+}
+
+void
+LteStatsBinaryFile::FlushWindow (void)
+{
+  NS_LOG_FUNCTION (this << m_windowStart);
+  for (std::map<std::vector<uint64_t>, std::vector<std::vector<double> > >::iterator it = m_samples.begin ();
+       it != m_samples.end ();
+       ++it)
+    {
+      uint64_t count = it->second.empty () ? 0 : it->second[0].size ();
+      if (count == 0)
+        {
+          // the key was not seen in this window
+          continue;
+        }
+      m_uRow[0] = m_windowStart;
+      std::copy (it->first.begin (), it->first.end (), m_uRow.begin () + 1);
+      m_uRow[m_nKeys + 1] = count;
+      for (uint32_t i = 0; i < m_nValues; ++i)
+        {
+          std::vector<double> &samples = it->second[i];
+          std::sort (samples.begin (), samples.end ());
+          double sum = 0;
+          for (std::vector<double>::const_iterator s = samples.begin (); s != samples.end (); ++s)
+            {
+              sum += *s;
+            }
+          double *aggregates = &m_dRow[i * N_AGGREGATES];
+          aggregates[0] = sum / count;
+          aggregates[1] = samples.front ();
+          for (uint32_t j = 0; j < N_AGGREGATES - 2; ++j)
+            {
+              // nearest rank
+              uint64_t rank = std::ceil (PERCENTILES[j] * count);
+              aggregates[2 + j] = samples[std::max<uint64_t> (rank, 1) - 1];
+            }
+          samples.clear ();
+        }
+      AddRow (&m_uRow[0], &m_dRow[0]);
+    }
+}
+
+void
+LteStatsBinaryFile::AddRow (const uint64_t *uValues, const double *dValues)
+{
+  Block &block = m_ring[m_head];
+  for (uint32_t i = 0; i < m_nU; ++i)
+    {
+      block.uColumns[i * m_blockRows + block.rows] = uValues[i];
+    }
+  for (uint32_t i = 0; i < m_nD; ++i)
+    {
+      block.dColumns[i * m_blockRows + block.rows] = dValues[i];
+    }
+  if (++block.rows == m_blockRows)
+    {
+      SubmitBlock ();
+    }
+}
+
+void
+LteStatsBinaryFile::SubmitBlock (void)
+{
+  NS_LOG_FUNCTION (this << m_head);
+#ifdef HAVE_PTHREAD_H
+  {
+    CriticalSection cs (m_mutex);
+    ++m_nFull;
+    m_full.SetCondition (true);
+  }
+  m_full.Signal ();
+  m_head = (m_head + 1) % RING_BLOCKS;
+  while (true)
+    {
+      {
+        CriticalSection cs (m_mutex);
+        if (m_nFull < RING_BLOCKS)
+          {
+            break;
+          }
+        m_free.SetCondition (false);
+      }
+      WaitForCondition (m_free);
+    }
+#else /* HAVE_PTHREAD_H */
+  WriteBlock (m_ring[m_head]);
+  m_ring[m_head].rows = 0;
+#endif /* HAVE_PTHREAD_H */
+}
+
+void
+LteStatsBinaryFile::WriteBlock (const Block &block)
+{
+  m_file.write ((const char *) &block.rows, sizeof (block.rows));
+  for (uint32_t i = 0; i < m_nU; ++i)
+    {
+      m_file.write ((const char *) &block.uColumns[i * m_blockRows], block.rows * sizeof (uint64_t));
+    }
+  for (uint32_t i = 0; i < m_nD; ++i)
+    {
+      m_file.write ((const char *) &block.dColumns[i * m_blockRows], block.rows * sizeof (double));
+    }
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+LteStatsBinaryFile::DoWrite (void)
+{
+  while (true)
+    {
+      bool idle;
+      {
+        CriticalSection cs (m_mutex);
+        if (m_nFull == 0 && m_stop)
+          {
+            return;
+          }
+        idle = (m_nFull == 0);
+        if (idle)
+          {
+            m_full.SetCondition (false);
+          }
+      }
+      if (idle)
+        {
+          WaitForCondition (m_full);
+          continue;
+        }
+      // the block is not touched by the simulation until it is released,
+      // and m_tail is only modified by this thread
+      Block &block = m_ring[m_tail];
+      WriteBlock (block);
+      block.rows = 0;
+      {
+        CriticalSection cs (m_mutex);
+        m_tail = (m_tail + 1) % RING_BLOCKS;
+        --m_nFull;
+        m_free.SetCondition (true);
+      }
+      m_free.Signal ();
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+void
+LteStatsBinaryFile::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_file.is_open ())
+    {
+      return;
+    }
+
+  if (m_window > 0)
+    {
+      FlushWindow ();
+    }
+#ifdef HAVE_PTHREAD_H
+  {
+    CriticalSection cs (m_mutex);
+    m_stop = true;
+    m_full.SetCondition (true);
+  }
+  m_full.Signal ();
+  m_writer->Join ();
+#endif /* HAVE_PTHREAD_H */
+  if (m_ring[m_head].rows > 0)
+    {
+      WriteBlock (m_ring[m_head]);
+      m_ring[m_head].rows = 0;
+    }
+  m_file.close ();
+}
+
+} // namespace ns3
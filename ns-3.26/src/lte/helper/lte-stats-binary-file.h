@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_STATS_BINARY_FILE_H
+#define LTE_STATS_BINARY_FILE_H
+
+#include <ns3/core-config.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/nstime.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/ptr.h>
+#include <ns3/system-thread.h>
+#include <ns3/system-mutex.h>
+#include <ns3/system-condition.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Buffered columnar binary output of the LTE stats calculators
+ *
+ * Each record is made of the time of the simulation, some integer key
+ * columns identifying its source (e.g., cell ID, IMSI and RNTI) and some
+ * real value columns. The records are collected in memory in blocks of a
+ * fixed number of rows, kept in a ring of blocks; the full blocks are
+ * written to the file by a background thread, while the simulation fills
+ * the next ones, and the simulation only waits when the ring is full.
+ * Without threading support, the blocks are written as soon as they are
+ * full.
+ *
+ * If an aggregation window is set, the samples are not written one by
+ * one; instead, at the end of each window a record is written for each
+ * key seen in it, with the number of samples and the mean, minimum,
+ * median, 95th percentile and maximum of each value column. The windows
+ * are aligned to multiples of their duration, and end when the first
+ * sample of a later window is written, or when the file is closed.
+ *
+ * The layout of the file, in the byte order of the host, is:
+ *
+ *   - the 8 characters "LTESTATS" and the version (uint32_t, 1);
+ *   - the number of columns (uint32_t), then for each column its type
+ *     (uint8_t, 'u' for uint64_t or 'd' for double), the length of its
+ *     name (uint8_t) and its name;
+ *   - blocks, each made of its number of rows (uint32_t) and then, for
+ *     each column, its values in the rows of the block (8 bytes each).
+ *
+ * The first column, "time", is the time of the sample, or the start of the
+ * window of the aggregated record, in nanoseconds; it is followed by the
+ * key columns, "count" for the aggregated records, and the value columns,
+ * whose names are suffixed by "_mean", "_min", "_p50", "_p95" and "_max"
+ * for the aggregated records.
+ */
+class LteStatsBinaryFile : public SimpleRefCount<LteStatsBinaryFile>
+{
+public:
+  /**
+   * Open the file and write its header
+   *
+   * \param filename the name of the file
+   * \param keys the names of the key columns
+   * \param values the names of the value columns
+   * \param window the aggregation window, or zero to write every sample
+   * \param blockRows the number of rows of a block
+   */
+  LteStatsBinaryFile (std::string filename, std::vector<std::string> keys,
+                      std::vector<std::string> values, Time window, uint32_t blockRows);
+  ~LteStatsBinaryFile ();
+
+  /**
+   * \return whether the file could be opened, and was not closed yet
+   */
+  bool IsOpen (void) const;
+
+  /**
+   * Write a sample, at the current time of the simulation
+   *
+   * \param keys the values of the key columns
+   * \param values the values of the value columns
+   */
+  void Write (const uint64_t *keys, const double *values);
+
+  /**
+   * Write the pending records and close the file
+   */
+  void Close (void);
+
+private:
+  /// Defined and unimplemented to avoid misuse
+  LteStatsBinaryFile (const LteStatsBinaryFile &);
+  /**
+   * Defined and unimplemented to avoid misuse
+   * \returns the file
+   */
+  LteStatsBinaryFile & operator = (const LteStatsBinaryFile &);
+
+  /// A block of records, stored by column
+  struct Block
+  {
+    uint32_t rows;                 ///< the number of rows filled
+    std::vector<uint64_t> uColumns; ///< the integer columns, one after the other
+    std::vector<double> dColumns;   ///< the real columns, one after the other
+  };
+
+  /**
+   * Add a row to the current block
+   * \param uValues the values of the integer columns, starting with the time
+   * \param dValues the values of the real columns
+   */
+  void AddRow (const uint64_t *uValues, const double *dValues);
+  /// Hand the current block to the writer and move to the next one
+  void SubmitBlock (void);
+  /**
+   * Write a block to the file
+   * \param block the block
+   */
+  void WriteBlock (const Block &block);
+  /// Add the aggregated records of the current window
+  void FlushWindow (void);
+
+  std::ofstream m_file;     ///< the file
+  uint32_t m_nKeys;         ///< the number of key columns
+  uint32_t m_nValues;       ///< the number of value columns
+  uint32_t m_nU;            ///< the number of integer columns
+  uint32_t m_nD;            ///< the number of real columns
+  uint32_t m_blockRows;     ///< the number of rows of a block
+
+  std::vector<Block> m_ring; ///< the ring of blocks
+  uint32_t m_head;           ///< the block being filled by the simulation
+
+  int64_t m_window;          ///< the aggregation window, in ns, or 0
+  int64_t m_windowStart;     ///< the start of the current window, in ns
+  /// the samples of the value columns of the current window, by key
+  std::map<std::vector<uint64_t>, std::vector<std::vector<double> > > m_samples;
+  std::vector<uint64_t> m_key;  ///< the key being looked up
+  std::vector<uint64_t> m_uRow; ///< the integer columns of a record
+  std::vector<double> m_dRow;   ///< the real columns of an aggregated record
+
+#ifdef HAVE_PTHREAD_H
+  /// The main loop of the writer thread
+  void DoWrite (void);
+
+  Ptr<SystemThread> m_writer;       ///< the writer thread
+  SystemMutex m_mutex;              ///< protects the fields below
+  SystemCondition m_full;           ///< set when a block is submitted
+  SystemCondition m_free;           ///< set when a block is written
+  uint32_t m_tail;                  ///< the next block to write
+  uint32_t m_nFull;                 ///< the blocks submitted and not written yet
+  bool m_stop;                      ///< whether the writer shall exit
+#endif /* HAVE_PTHREAD_H */
+};
+
+} // namespace ns3
+
+#endif /* LTE_STATS_BINARY_FILE_H */
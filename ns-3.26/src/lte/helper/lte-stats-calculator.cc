@@ -22,6 +22,9 @@
 
 #include <ns3/log.h>
 #include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+#include <ns3/simulator.h>
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-enb-net-device.h>
@@ -35,7 +38,9 @@ NS_OBJECT_ENSURE_REGISTERED (LteStatsCalculator);
 
 LteStatsCalculator::LteStatsCalculator ()
   : m_dlOutputFilename (""),
-    m_ulOutputFilename ("")
+    m_ulOutputFilename (""),
+    m_binaryOutput (false),
+    m_binaryBlockRows (4096)
 {
   // Nothing to do here
 
@@ -54,10 +59,96 @@ LteStatsCalculator::GetTypeId (void)
     .SetParent<Object> ()
     .SetGroupName("Lte")
     .AddConstructor<LteStatsCalculator> ()
+    .AddAttribute ("BinaryOutput",
+                   "If true, the statistics are written in buffered columnar "
+                   "binary files instead of text files.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteStatsCalculator::m_binaryOutput),
+                   MakeBooleanChecker ())
+    .AddAttribute ("AggregationWindow",
+                   "If not zero, the samples of each UE written in binary files "
+                   "are replaced by their count, mean, minimum, percentiles and "
+                   "maximum over windows of this duration.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&LteStatsCalculator::m_aggregationWindow),
+                   MakeTimeChecker ())
+    .AddAttribute ("BinaryBlockRows",
+                   "The number of rows buffered before they are written "
+                   "to a binary file.",
+                   UintegerValue (4096),
+                   MakeUintegerAccessor (&LteStatsCalculator::m_binaryBlockRows),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
 
+void
+LteStatsCalculator::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  CloseBinaryFiles ();
+  Object::DoDispose ();
+}
+
+bool
+LteStatsCalculator::IsBinaryOutput (void) const
+{
+  return m_binaryOutput;
+}
+
+/**
+ * \param names names separated by tabs
+ * \return the names
+ */
+static std::vector<std::string>
+SplitColumnNames (std::string names)
+{
+  std::vector<std::string> columns;
+  std::string::size_type start = 0;
+  while (start < names.size ())
+    {
+      std::string::size_type end = names.find ('\t', start);
+      if (end == std::string::npos)
+        {
+          end = names.size ();
+        }
+      columns.push_back (names.substr (start, end - start));
+      start = end + 1;
+    }
+  return columns;
+}
+
+Ptr<LteStatsBinaryFile>
+LteStatsCalculator::CreateBinaryFile (std::string filename, std::string keys,
+                                      std::string values, bool aggregate)
+{
+  NS_LOG_FUNCTION (this << filename << keys << values << aggregate);
+  Ptr<LteStatsBinaryFile> file = Create<LteStatsBinaryFile> (filename,
+                                                             SplitColumnNames (keys),
+                                                             SplitColumnNames (values),
+                                                             aggregate ? m_aggregationWindow : Seconds (0),
+                                                             m_binaryBlockRows);
+  if (m_binaryFiles.empty ())
+    {
+      // the calculators are usually not disposed before the end of the program
+      Simulator::ScheduleDestroy (&LteStatsCalculator::CloseBinaryFiles, Ptr<LteStatsCalculator> (this));
+    }
+  m_binaryFiles.push_back (file);
+  return file;
+}
+
+void
+LteStatsCalculator::CloseBinaryFiles (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Ptr<LteStatsBinaryFile> >::iterator it = m_binaryFiles.begin ();
+       it != m_binaryFiles.end ();
+       ++it)
+    {
+      (*it)->Close ();
+    }
+}
+
 
 void
 LteStatsCalculator::SetUlOutputFilename (std::string outputFilename)
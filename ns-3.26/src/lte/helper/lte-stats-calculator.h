@@ -23,7 +23,10 @@
 
 #include "ns3/object.h"
 #include "ns3/string.h"
+#include "ns3/nstime.h"
+#include "ns3/lte-stats-binary-file.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -33,6 +36,12 @@ namespace ns3 {
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
  * Also stores names of output files.
+ *
+ * If the BinaryOutput attribute is set, the statistics are written in
+ * buffered columnar binary files (see LteStatsBinaryFile) instead of text
+ * files, under the same names; the AggregationWindow attribute then
+ * allows to write, for each UE, statistics of its samples over windows of
+ * time instead of every sample.
  */
 
 class LteStatsCalculator : public Object
@@ -54,6 +63,11 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * \return whether the statistics are written in binary files
+   */
+  bool IsBinaryOutput (void) const;
+
   /**
    * Set the name of the file where the uplink statistics will be stored.
    *
@@ -123,6 +137,27 @@ public:
   uint16_t GetCellIdPath (std::string path);
 
 protected:
+  virtual void DoDispose (void);
+
+  /**
+   * Create a binary output file, with the block size and aggregation
+   * window given by the attributes. The file is closed when the calculator
+   * is disposed or when the simulator is destroyed.
+   *
+   * \param filename the name of the file
+   * \param keys the names of the key columns, separated by tabs
+   * \param values the names of the value columns, separated by tabs
+   * \param aggregate whether the samples shall be aggregated over the
+   *        aggregation window, if set
+   * \return the file
+   */
+  Ptr<LteStatsBinaryFile> CreateBinaryFile (std::string filename, std::string keys,
+                                            std::string values, bool aggregate);
+
+  /**
+   * Close the binary output files
+   */
+  virtual void CloseBinaryFiles (void);
 
   /**
    * Retrieves IMSI from Enb RLC path in the attribute system
@@ -204,6 +239,12 @@ private:
    * Name of the file where the uplink results will be saved
    */
   std::string m_ulOutputFilename;
+
+  bool m_binaryOutput;          ///< whether the statistics are written in binary files
+  Time m_aggregationWindow;     ///< the aggregation window of the binary files
+  uint32_t m_binaryBlockRows;   ///< the number of rows of the blocks of the binary files
+  /// the binary output files
+  std::vector<Ptr<LteStatsBinaryFile> > m_binaryFiles;
 };
 
 } // namespace ns3
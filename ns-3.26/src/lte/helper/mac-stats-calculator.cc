@@ -94,6 +94,19 @@ MacStatsCalculator::DlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb1 << sizeTb1 << (uint32_t) mcsTb2 << sizeTb2);
   NS_LOG_INFO ("Write DL Mac Stats in " << GetDlOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_dlBinaryFile == 0)
+        {
+          m_dlBinaryFile = CreateBinaryFile (GetDlOutputFilename (),
+                                             "cellId\tIMSI\tRNTI", "frame\tsframe\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2", true);
+        }
+      uint64_t keys[] = {cellId, imsi, rnti};
+      double values[] = {(double) frameNo, (double) subframeNo, (double) mcsTb1, (double) sizeTb1, (double) mcsTb2, (double) sizeTb2};
+      m_dlBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_dlFirstWrite == true )
     {
@@ -137,6 +150,19 @@ MacStatsCalculator::UlScheduling (uint16_t cellId, uint64_t imsi, uint32_t frame
   NS_LOG_FUNCTION (this << cellId << imsi << frameNo << subframeNo << rnti << (uint32_t) mcsTb << size);
   NS_LOG_INFO ("Write UL Mac Stats in " << GetUlOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_ulBinaryFile == 0)
+        {
+          m_ulBinaryFile = CreateBinaryFile (GetUlOutputFilename (),
+                                             "cellId\tIMSI\tRNTI", "frame\tsframe\tmcs\tsize", true);
+        }
+      uint64_t keys[] = {cellId, imsi, rnti};
+      double values[] = {(double) frameNo, (double) subframeNo, (double) mcsTb, (double) size};
+      m_ulBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_ulFirstWrite == true )
     {
@@ -168,6 +168,9 @@ private:
    */
   bool m_ulFirstWrite;
 
+  Ptr<LteStatsBinaryFile> m_dlBinaryFile; ///< the binary DL MAC statistics
+  Ptr<LteStatsBinaryFile> m_ulBinaryFile; ///< the binary UL MAC statistics
+
 };
 
 } // namespace ns3
@@ -95,6 +95,20 @@ PhyRxStatsCalculator::DlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write DL Rx Phy Stats in " << GetDlRxOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_dlRxBinaryFile == 0)
+        {
+          m_dlRxBinaryFile = CreateBinaryFile (GetDlRxOutputFilename (),
+                                               "cellId\tIMSI\tRNTI", "txMode\tlayer\tmcs\tsize\trv\tndi\tcorrect", true);
+        }
+      uint64_t keys[] = {params.m_cellId, params.m_imsi, params.m_rnti};
+      double values[] = {(double) params.m_txMode, (double) params.m_layer, (double) params.m_mcs, (double) params.m_size,
+                         (double) params.m_rv, (double) params.m_ndi, (double) params.m_correctness};
+      m_dlRxBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_dlRxFirstWrite == true )
     {
@@ -139,6 +153,20 @@ PhyRxStatsCalculator::UlPhyReception (PhyReceptionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi << params.m_correctness);
   NS_LOG_INFO ("Write UL Rx Phy Stats in " << GetUlRxOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_ulRxBinaryFile == 0)
+        {
+          m_ulRxBinaryFile = CreateBinaryFile (GetUlRxOutputFilename (),
+                                               "cellId\tIMSI\tRNTI", "layer\tmcs\tsize\trv\tndi\tcorrect", true);
+        }
+      uint64_t keys[] = {params.m_cellId, params.m_imsi, params.m_rnti};
+      double values[] = {(double) params.m_layer, (double) params.m_mcs, (double) params.m_size,
+                         (double) params.m_rv, (double) params.m_ndi, (double) params.m_correctness};
+      m_ulRxBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_ulRxFirstWrite == true )
     {
@@ -142,6 +142,9 @@ private:
    */
   bool m_ulRxFirstWrite;
 
+  Ptr<LteStatsBinaryFile> m_dlRxBinaryFile; ///< the binary DL RX PHY statistics
+  Ptr<LteStatsBinaryFile> m_ulRxBinaryFile; ///< the binary UL RX PHY statistics
+
 };
 
 } // namespace ns3
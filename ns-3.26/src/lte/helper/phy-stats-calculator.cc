@@ -22,6 +22,8 @@
 #include "ns3/string.h"
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <algorithm>
+#include <limits>
 
 namespace ns3 {
 
@@ -114,6 +116,19 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr (uint16_t cellId, uint64_t imsi, u
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << rsrp << sinr);
   NS_LOG_INFO ("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_rsrpSinrBinaryFile == 0)
+        {
+          m_rsrpSinrBinaryFile = CreateBinaryFile (GetCurrentCellRsrpSinrFilename (),
+                                                   "cellId\tIMSI\tRNTI", "rsrp\tsinr", true);
+        }
+      uint64_t keys[] = {cellId, imsi, rnti};
+      double values[] = {rsrp, sinr};
+      m_rsrpSinrBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_RsrpSinrFirstWrite == true )
     {
@@ -152,6 +167,19 @@ PhyStatsCalculator::ReportUeSinr (uint16_t cellId, uint64_t imsi, uint16_t rnti,
   NS_LOG_FUNCTION (this << cellId <<  imsi << rnti  << sinrLinear);
   NS_LOG_INFO ("Write SINR Linear Phy Stats in " << GetUeSinrFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_ueSinrBinaryFile == 0)
+        {
+          m_ueSinrBinaryFile = CreateBinaryFile (GetUeSinrFilename (),
+                                                 "cellId\tIMSI\tRNTI", "sinrLinear", true);
+        }
+      uint64_t keys[] = {cellId, imsi, rnti};
+      double values[] = {sinrLinear};
+      m_ueSinrBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_UeSinrFirstWrite == true )
     {
@@ -189,6 +217,29 @@ PhyStatsCalculator::ReportInterference (uint16_t cellId, Ptr<SpectrumValue> inte
   NS_LOG_FUNCTION (this << cellId <<  interference);
   NS_LOG_INFO ("Write Interference Phy Stats in " << GetInterferenceFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_interferenceBinaryFile == 0)
+        {
+          // one column per RB, with the bandwidth of the first report
+          std::ostringstream values;
+          for (size_t i = 0; i < interference->GetSpectrumModel ()->GetNumBands (); ++i)
+            {
+              values << (i > 0 ? "\t" : "") << "rb" << i;
+            }
+          m_interferenceBinaryFile = CreateBinaryFile (GetInterferenceFilename (),
+                                                       "cellId", values.str (), true);
+          m_interferenceValues.resize (interference->GetSpectrumModel ()->GetNumBands ());
+        }
+      // the RBs missing in a narrower bandwidth are reported as NaN
+      std::fill (m_interferenceValues.begin (), m_interferenceValues.end (), std::numeric_limits<double>::quiet_NaN ());
+      size_t rbs = std::min (m_interferenceValues.size (), interference->GetSpectrumModel ()->GetNumBands ());
+      std::copy (interference->ConstValuesBegin (), interference->ConstValuesBegin () + rbs, m_interferenceValues.begin ());
+      uint64_t keys[] = {cellId};
+      m_interferenceBinaryFile->Write (keys, &m_interferenceValues[0]);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_InterferenceFirstWrite == true )
     {
@@ -27,6 +27,7 @@
 #include "ns3/spectrum-value.h"
 #include <string>
 #include <fstream>
+#include <vector>
 
 namespace ns3 {
 
@@ -215,6 +216,11 @@ private:
    */
   std::string m_interferenceFilename;
 
+  Ptr<LteStatsBinaryFile> m_rsrpSinrBinaryFile;     ///< the binary RSRP/SINR statistics
+  Ptr<LteStatsBinaryFile> m_ueSinrBinaryFile;       ///< the binary UE SINR statistics
+  Ptr<LteStatsBinaryFile> m_interferenceBinaryFile; ///< the binary interference statistics
+  std::vector<double> m_interferenceValues;         ///< the interference of a binary record, by RB
+
 };
 
 } // namespace ns3
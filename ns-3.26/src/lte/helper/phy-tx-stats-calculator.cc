@@ -95,6 +95,20 @@ PhyTxStatsCalculator::DlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write DL Tx Phy Stats in " << GetDlTxOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_dlTxBinaryFile == 0)
+        {
+          m_dlTxBinaryFile = CreateBinaryFile (GetDlTxOutputFilename (),
+                                               "cellId\tIMSI\tRNTI", "layer\tmcs\tsize\trv\tndi", true);
+        }
+      uint64_t keys[] = {params.m_cellId, params.m_imsi, params.m_rnti};
+      double values[] = {(double) params.m_layer, (double) params.m_mcs, (double) params.m_size,
+                         (double) params.m_rv, (double) params.m_ndi};
+      m_dlTxBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_dlTxFirstWrite == true )
     {
@@ -139,6 +153,20 @@ PhyTxStatsCalculator::UlPhyTransmission (PhyTransmissionStatParameters params)
   NS_LOG_FUNCTION (this << params.m_cellId << params.m_imsi << params.m_timestamp << params.m_rnti << params.m_layer << params.m_mcs << params.m_size << params.m_rv << params.m_ndi);
   NS_LOG_INFO ("Write UL Tx Phy Stats in " << GetUlTxOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      if (m_ulTxBinaryFile == 0)
+        {
+          m_ulTxBinaryFile = CreateBinaryFile (GetUlTxOutputFilename (),
+                                               "cellId\tIMSI\tRNTI", "layer\tmcs\tsize\trv\tndi", true);
+        }
+      uint64_t keys[] = {params.m_cellId, params.m_imsi, params.m_rnti};
+      double values[] = {(double) params.m_layer, (double) params.m_mcs, (double) params.m_size,
+                         (double) params.m_rv, (double) params.m_ndi};
+      m_ulTxBinaryFile->Write (keys, values);
+      return;
+    }
+
   std::ofstream outFile;
   if ( m_ulTxFirstWrite == true )
     {
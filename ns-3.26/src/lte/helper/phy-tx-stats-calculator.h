@@ -143,6 +143,9 @@ private:
    */
   bool m_ulTxFirstWrite;
 
+  Ptr<LteStatsBinaryFile> m_dlTxBinaryFile; ///< the binary DL TX PHY statistics
+  Ptr<LteStatsBinaryFile> m_ulTxBinaryFile; ///< the binary UL TX PHY statistics
+
 };
 
 } // namespace ns3
@@ -32,6 +32,8 @@
 #include <ns3/packet-socket-address.h>
 #include <ns3/epc-enb-application.h>
 #include <ns3/epc-sgw-pgw-application.h>
+#include <ns3/epc-s1u-direct-link.h>
+#include <ns3/boolean.h>
 
 #include <ns3/lte-enb-rrc.h>
 #include <ns3/epc-x2.h>
@@ -129,6 +131,14 @@ PointToPointEpcHelper::GetTypeId (void)
                    UintegerValue (2000),
                    MakeUintegerAccessor (&PointToPointEpcHelper::m_s1uLinkMtu),
                    MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("S1uDirect",
+                   "If true, the user plane packets of the next S1-U link to be created are passed directly "
+                   "between the SGW/PGW and the eNB, with the data rate and the delay of the link, but without "
+                   "GTP-U/UDP/IP encapsulation, which speeds up the simulation. The point-to-point link is "
+                   "still created, and used by the other traffic.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointEpcHelper::m_s1uDirect),
+                   MakeBooleanChecker ())
     .AddAttribute ("X2LinkDataRate",
                    "The data rate to be used for the next X2 link to be created",
                    DataRateValue (DataRate ("10Gb/s")),
@@ -223,6 +233,15 @@ PointToPointEpcHelper::AddEnb (Ptr<Node> enb, Ptr<NetDevice> lteEnbNetDevice, ui
   NS_ASSERT_MSG (enb->GetApplication (0)->GetObject<EpcEnbApplication> () != 0, "cannot retrieve EpcEnbApplication");
   NS_LOG_LOGIC ("enb: " << enb << ", enb->GetApplication (0): " << enb->GetApplication (0));
 
+  if (m_s1uDirect)
+    {
+      NS_LOG_INFO ("create direct S1-U link");
+      Ptr<EpcS1uDirectLink> s1uDirectLink = CreateObject<EpcS1uDirectLink> ();
+      s1uDirectLink->SetAttribute ("DataRate", DataRateValue (m_s1uLinkDataRate));
+      s1uDirectLink->SetAttribute ("Delay", TimeValue (m_s1uLinkDelay));
+      enbApp->SetS1uDirectLink (s1uDirectLink);
+      m_sgwPgwApp->AddS1uDirectLink (enbAddress, s1uDirectLink);
+    }
   
   NS_LOG_INFO ("Create EpcX2 entity");
   Ptr<EpcX2> x2 = CreateObject<EpcX2> ();
@@ -135,6 +135,13 @@ private:
    */
   uint16_t m_s1uLinkMtu;
 
+  /**
+   * Whether the next S1-U link to be created shall carry the packets
+   * directly between the EPC applications, without GTP-U/UDP/IP
+   * encapsulation
+   */
+  bool m_s1uDirect;
+
   /**
    * UDP port where the GTP-U Socket is bound, fixed by the standard as 2152
    */
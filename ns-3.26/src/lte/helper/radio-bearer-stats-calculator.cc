@@ -102,6 +102,7 @@ RadioBearerStatsCalculator::DoDispose ()
     {
       ShowResults ();
     }
+  LteStatsCalculator::DoDispose ();
 }
 
 void 
@@ -216,6 +217,13 @@ RadioBearerStatsCalculator::ShowResults (void)
   NS_LOG_FUNCTION (this << GetUlOutputFilename ().c_str () << GetDlOutputFilename ().c_str ());
   NS_LOG_INFO ("Write Rlc Stats in " << GetUlOutputFilename ().c_str () << " and in " << GetDlOutputFilename ().c_str ());
 
+  if (IsBinaryOutput ())
+    {
+      WriteBinaryResults ();
+      m_pendingOutput = false;
+      return;
+    }
+
   std::ofstream ulOutFile;
   std::ofstream dlOutFile;
 
@@ -358,6 +366,62 @@ RadioBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
   outFile.close ();
 }
 
+void
+RadioBearerStatsCalculator::WriteBinaryResults (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_ulBinaryFile == 0)
+    {
+      // the time of a record is the end of its epoch
+      std::string keys = "CellId\tIMSI\tRNTI\tLCID";
+      std::string values = "start\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t"
+        "delay\tdelayStdDev\tdelayMin\tdelayMax\t"
+        "PduSize\tPduSizeStdDev\tPduSizeMin\tPduSizeMax";
+      m_ulBinaryFile = CreateBinaryFile (GetUlOutputFilename (), keys, values, false);
+      m_dlBinaryFile = CreateBinaryFile (GetDlOutputFilename (), keys, values, false);
+    }
+
+  for (Uint32Map::iterator it = m_ulTxPackets.begin (); it != m_ulTxPackets.end (); ++it)
+    {
+      ImsiLcidPair_t p = it->first;
+      uint64_t keys[] = {GetUlCellId (p.m_imsi, p.m_lcId), p.m_imsi, m_flowId[p].m_rnti, m_flowId[p].m_lcId};
+      std::vector<double> delay = GetUlDelayStats (p.m_imsi, p.m_lcId);
+      std::vector<double> pduSize = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
+      double values[] = {m_startTime.GetSeconds (),
+                         (double) GetUlTxPackets (p.m_imsi, p.m_lcId), (double) GetUlTxData (p.m_imsi, p.m_lcId),
+                         (double) GetUlRxPackets (p.m_imsi, p.m_lcId), (double) GetUlRxData (p.m_imsi, p.m_lcId),
+                         delay[0] * 1e-9, delay[1] * 1e-9, delay[2] * 1e-9, delay[3] * 1e-9,
+                         pduSize[0], pduSize[1], pduSize[2], pduSize[3]};
+      m_ulBinaryFile->Write (keys, values);
+    }
+
+  for (Uint32Map::iterator it = m_dlTxPackets.begin (); it != m_dlTxPackets.end (); ++it)
+    {
+      ImsiLcidPair_t p = it->first;
+      uint64_t keys[] = {GetDlCellId (p.m_imsi, p.m_lcId), p.m_imsi, m_flowId[p].m_rnti, m_flowId[p].m_lcId};
+      std::vector<double> delay = GetDlDelayStats (p.m_imsi, p.m_lcId);
+      std::vector<double> pduSize = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
+      double values[] = {m_startTime.GetSeconds (),
+                         (double) GetDlTxPackets (p.m_imsi, p.m_lcId), (double) GetDlTxData (p.m_imsi, p.m_lcId),
+                         (double) GetDlRxPackets (p.m_imsi, p.m_lcId), (double) GetDlRxData (p.m_imsi, p.m_lcId),
+                         delay[0] * 1e-9, delay[1] * 1e-9, delay[2] * 1e-9, delay[3] * 1e-9,
+                         pduSize[0], pduSize[1], pduSize[2], pduSize[3]};
+      m_dlBinaryFile->Write (keys, values);
+    }
+}
+
+void
+RadioBearerStatsCalculator::CloseBinaryFiles (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_pendingOutput)
+    {
+      ShowResults ();
+    }
+  LteStatsCalculator::CloseBinaryFiles ();
+}
+
 void
 RadioBearerStatsCalculator::ResetResults (void)
 {
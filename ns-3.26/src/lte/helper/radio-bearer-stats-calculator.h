@@ -373,6 +373,18 @@ private:
   void
   WriteDlResults (std::ofstream& outFile);
 
+  /**
+   * Writes collected statistics to the binary output files.
+   */
+  void
+  WriteBinaryResults (void);
+
+  /**
+   * Writes the pending statistics, and closes the binary output files.
+   */
+  virtual void
+  CloseBinaryFiles (void);
+
   /**
    * Erases collected statistics
    */
@@ -447,6 +459,9 @@ private:
    */
   std::string m_ulPdcpOutputFilename;
 
+  Ptr<LteStatsBinaryFile> m_ulBinaryFile; ///< the binary UL statistics
+  Ptr<LteStatsBinaryFile> m_dlBinaryFile; ///< the binary DL statistics
+
 };
 
 } // namespace ns3
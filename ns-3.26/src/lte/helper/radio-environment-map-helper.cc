@@ -28,7 +28,9 @@
 #include <ns3/uinteger.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
+#include <ns3/enum.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/antenna-model.h>
 #include <ns3/config.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/mobility-building-info.h>
@@ -37,9 +39,11 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
 
 #include <fstream>
 #include <limits>
+#include <sstream>
 
 namespace ns3 {
 
@@ -48,6 +52,7 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
+  : m_numPoints (0)
 {
 }
 
@@ -62,6 +67,7 @@ void
 RadioEnvironmentMapHelper::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_transmissions.clear ();
 }
 
 TypeId
@@ -144,6 +150,42 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("OutputFormat",
+                   "The format of the output file: either text, with one "
+                   "line of x, y, z and SINR per point, or a NumPy .npy "
+                   "array of doubles, with one row of x, y, z and SINR "
+                   "per point, in the same order.",
+                   EnumValue (RadioEnvironmentMapHelper::TEXT_OUTPUT),
+                   MakeEnumAccessor (&RadioEnvironmentMapHelper::m_outputFormat),
+                   MakeEnumChecker (RadioEnvironmentMapHelper::TEXT_OUTPUT, "Text",
+                                    RadioEnvironmentMapHelper::NPY_OUTPUT, "Npy"))
+    .AddAttribute ("Offline",
+                   "If true, no RemSpectrumPhy is attached to the channel: "
+                   "the transmissions of one subframe are recorded, and the "
+                   "SINR of every point is then computed at once from them "
+                   "and from the propagation models of the channel, "
+                   "which must support SpectrumChannel::CalcRxPowerSpectralDensity. "
+                   "MaxPointsPerIteration is then only the number of "
+                   "mobility models used for the points, like in the "
+                   "normal mode.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_offline),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Shards",
+                   "In offline mode, the number of shards, i.e., of "
+                   "contiguous ranges of x coordinates, in which the map is "
+                   "divided, so that each shard can be generated by a "
+                   "separate simulation process.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_shards),
+                   MakeUintegerChecker<uint32_t> (1,std::numeric_limits<uint32_t>::max ()))
+    .AddAttribute ("Shard",
+                   "In offline mode, the index of the shard to be generated, "
+                   "from 0 to Shards - 1. The points of all the shards, in "
+                   "order, are the points of the whole map.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_shard),
+                   MakeUintegerChecker<uint32_t> ())
   ;
   return tid;
 }
@@ -193,12 +235,27 @@ RadioEnvironmentMapHelper::Install ()
   m_channel = match.Get (0)->GetObject<SpectrumChannel> ();
   NS_ABORT_MSG_IF (m_channel == 0, "object at " << m_channelPath << "is not of type SpectrumChannel");
 
-  m_outFile.open (m_outputFile.c_str ());
+  NS_ABORT_MSG_IF (m_shard >= m_shards, "Shard " << m_shard << " of " << m_shards << " shards");
+  NS_ABORT_MSG_IF (m_shards > 1 && !m_offline, "Shards are only supported in offline mode");
+
+  if (m_outputFormat == NPY_OUTPUT)
+    {
+      m_outFile.open (m_outputFile.c_str (), std::ios_base::out | std::ios_base::binary);
+    }
+  else
+    {
+      m_outFile.open (m_outputFile.c_str ());
+    }
   if (!m_outFile.is_open ())
     {
       NS_FATAL_ERROR ("Can't open file " << (m_outputFile));
       return;
     }
+  if (m_outputFormat == NPY_OUTPUT)
+    {
+      // rewritten by Finalize with the number of points
+      WriteNpyHeader (0);
+    }
   
   double startDelay = 0.0026;
 
@@ -225,6 +282,15 @@ RadioEnvironmentMapHelper::DelayedInstall ()
     {
       m_maxPointsPerIteration = m_xRes * m_yRes;
     }
+
+  if (m_offline)
+    {
+      // same measurement window as the first iteration of the normal mode
+      m_channel->TraceConnectWithoutContext ("TxSigParams",
+                                             MakeCallback (&RadioEnvironmentMapHelper::CaptureTransmission, this));
+      Simulator::Schedule (Seconds (0.0006), &RadioEnvironmentMapHelper::RunOffline, this);
+      return;
+    }
   
   for (uint32_t i = 0; i < m_maxPointsPerIteration; ++i)
     {
@@ -331,11 +397,7 @@ RadioEnvironmentMapHelper::PrintAndReset ()
                     << pos.y << "\t" 
                     << pos.z << "\t" 
                     << it->phy->GetSinr (m_noisePower));
-      m_outFile << pos.x << "\t" 
-                << pos.y << "\t" 
-                << pos.z << "\t" 
-                << it->phy->GetSinr (m_noisePower)
-                << std::endl;
+      WritePoint (pos, it->phy->GetSinr (m_noisePower));
       it->phy->Reset ();
     }
 }
@@ -344,6 +406,11 @@ void
 RadioEnvironmentMapHelper::Finalize ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_outputFormat == NPY_OUTPUT)
+    {
+      m_outFile.seekp (0);
+      WriteNpyHeader (m_numPoints);
+    }
   m_outFile.close ();
   if (m_stopWhenDone)
     {
@@ -351,5 +418,133 @@ RadioEnvironmentMapHelper::Finalize ()
     }
 }
 
+void
+RadioEnvironmentMapHelper::CaptureTransmission (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  // the same transmissions as those counted by RemSpectrumPhy
+  bool counted = m_useDataChannel
+    ? DynamicCast<LteSpectrumSignalParametersDataFrame> (params) != 0
+    : DynamicCast<LteSpectrumSignalParametersDlCtrlFrame> (params) != 0;
+  if (counted)
+    {
+      // the transmitter may reuse its PSD for the next transmissions
+      m_transmissions.push_back (params->Copy ());
+    }
+}
+
+void
+RadioEnvironmentMapHelper::RunOffline ()
+{
+  NS_LOG_FUNCTION (this);
+  m_channel->TraceDisconnectWithoutContext ("TxSigParams",
+                                            MakeCallback (&RadioEnvironmentMapHelper::CaptureTransmission, this));
+  NS_LOG_LOGIC (m_transmissions.size () << " transmissions captured");
+
+  Ptr<const SpectrumModel> rxSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  uint32_t xBegin = (uint64_t) m_xRes * m_shard / m_shards;
+  uint32_t xEnd = (uint64_t) m_xRes * (m_shard + 1) / m_shards;
+
+  // like the RemSpectrumPhy instances of the normal mode, the mobility
+  // models are reused every MaxPointsPerIteration points, so that the
+  // propagation models see as many receivers
+  std::vector<Ptr<MobilityModel> > mobilities (m_maxPointsPerIteration);
+  uint32_t ix = 0;
+  for (double x = m_xMin; x < m_xMax + 0.5*m_xStep; x += m_xStep, ++ix)
+    {
+      if (ix < xBegin || ix >= xEnd)
+        {
+          continue;
+        }
+      uint32_t iy = 0;
+      for (double y = m_yMin; y < m_yMax + 0.5*m_yStep ; y += m_yStep, ++iy)
+        {
+          Ptr<MobilityModel> &mobility = mobilities[((uint64_t) ix * m_yRes + iy) % m_maxPointsPerIteration];
+          if (mobility == 0)
+            {
+              mobility = CreateObject<ConstantPositionMobilityModel> ();
+              mobility->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+            }
+          mobility->SetPosition (Vector (x, y, m_z));
+          BuildingsHelper::MakeConsistent (mobility);
+
+          double sumPower = 0;
+          double referenceSignalPower = 0;
+          for (std::vector<Ptr<const SpectrumSignalParameters> >::const_iterator it = m_transmissions.begin ();
+               it != m_transmissions.end ();
+               ++it)
+            {
+              Ptr<SpectrumValue> rxPsd = m_channel->CalcRxPowerSpectralDensity (*it, mobility, 0, rxSpectrumModel);
+              if (rxPsd == 0)
+                {
+                  // out of range
+                  continue;
+                }
+              double power = 0;
+              if (m_rbId >= 0)
+                {
+                  power = (*rxPsd)[m_rbId] * 180000;
+                }
+              else
+                {
+                  power = Integral (*rxPsd);
+                }
+              sumPower += power;
+              if (power > referenceSignalPower)
+                {
+                  referenceSignalPower = power;
+                }
+            }
+          WritePoint (mobility->GetPosition (),
+                      referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower));
+        }
+    }
+
+  m_transmissions.clear ();
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::WritePoint (const Vector &pos, double sinr)
+{
+  ++m_numPoints;
+  if (m_outputFormat == NPY_OUTPUT)
+    {
+      double row[4] = { pos.x, pos.y, pos.z, sinr };
+      m_outFile.write (reinterpret_cast<const char *> (row), sizeof (row));
+    }
+  else
+    {
+      m_outFile << pos.x << "\t"
+                << pos.y << "\t"
+                << pos.z << "\t"
+                << sinr
+                << "\n";
+    }
+}
+
+void
+RadioEnvironmentMapHelper::WriteNpyHeader (uint64_t rows)
+{
+  // format version 1.0 of the .npy files; the doubles are written in
+  // the byte order of the host. The header has always the same length,
+  // so that it can be rewritten once the number of rows is known.
+  static const uint16_t one = 1;
+  bool littleEndian = *reinterpret_cast<const uint8_t *> (&one) == 1;
+  std::ostringstream dict;
+  dict << "{'descr': '" << (littleEndian ? '<' : '>') << "f8', 'fortran_order': False, 'shape': ("
+       << rows << ", 4), }";
+  const uint16_t headerLength = 118;  // 10 bytes of preamble: 128 bytes in total
+  std::string header = dict.str ();
+  NS_ASSERT (header.size () < headerLength);
+  header.resize (headerLength - 1, ' ');
+  header += '\n';
+  const char preamble[8] = { '\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0 };
+  m_outFile.write (preamble, sizeof (preamble));
+  const char length[2] = { (char) (headerLength & 0xff), (char) (headerLength >> 8) };
+  m_outFile.write (length, sizeof (length));
+  m_outFile.write (header.data (), header.size ());
+}
+
 
 } // namespace ns3
@@ -24,7 +24,9 @@
 
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +37,7 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class SpectrumSignalParameters;
 
 /** 
  * \ingroup lte
@@ -58,6 +61,13 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /// The formats of the output file
+  enum OutputFormat_t
+  {
+    TEXT_OUTPUT, ///< one line per point, with x, y, z and SINR separated by tabs
+    NPY_OUTPUT   ///< a NumPy array of doubles, with one row of x, y, z and SINR per point
+  };
+
   /** 
    * \return the bandwidth (in num of RBs) over which SINR is calculated
    */
@@ -87,7 +97,8 @@ private:
    *
    * The method will divide the whole map into parts (each contains at most a
    * certain number of SINR listening points), and then call RunOneIteration()
-   * on each part, one by one.
+   * on each part, one by one. In offline mode, it rather starts recording
+   * the transmissions on the channel, and schedules RunOffline().
    */
   void DelayedInstall ();
 
@@ -108,6 +119,36 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Connected to the `TxSigParams` trace of the channel in offline
+   * mode, to record the transmissions of one subframe.
+   *
+   * \param params the parameters of a transmission
+   */
+  void CaptureTransmission (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Compute the whole map (or the shard of the map selected by the
+   * `Shard` attribute) in offline mode, from the transmissions captured
+   * by CaptureTransmission(), and then call Finalize().
+   */
+  void RunOffline ();
+
+  /**
+   * Write a point of the map to the output file.
+   *
+   * \param pos the position of the point
+   * \param sinr the SINR at the point
+   */
+  void WritePoint (const Vector &pos, double sinr);
+
+  /**
+   * Write the header of a NumPy array file.
+   *
+   * \param rows the number of rows of the array
+   */
+  void WriteNpyHeader (uint64_t rows);
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +193,16 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  OutputFormat_t m_outputFormat;  ///< The `OutputFormat` attribute.
+  uint64_t m_numPoints;  ///< Number of points written to the output file.
+
+  bool m_offline;     ///< The `Offline` attribute.
+  uint32_t m_shards;  ///< The `Shards` attribute.
+  uint32_t m_shard;   ///< The `Shard` attribute.
+
+  /// The transmissions captured in offline mode.
+  std::vector<Ptr<const SpectrumSignalParameters> > m_transmissions;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
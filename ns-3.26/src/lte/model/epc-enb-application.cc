@@ -26,6 +26,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/uinteger.h"
+#include "ns3/node.h"
 
 #include "epc-gtpu-header.h"
 #include "eps-bearer-tag.h"
@@ -73,6 +74,7 @@ EpcEnbApplication::DoDispose (void)
   NS_LOG_FUNCTION (this);
   m_lteSocket = 0;
   m_s1uSocket = 0;
+  m_s1uDirectLink = 0;
   delete m_s1SapProvider;
   delete m_s1apSapEnb;
 }
@@ -128,6 +130,14 @@ EpcEnbApplication::GetS1apSapEnb ()
   return m_s1apSapEnb;
 }
 
+void 
+EpcEnbApplication::SetS1uDirectLink (Ptr<EpcS1uDirectLink> link)
+{
+  NS_LOG_FUNCTION (this << link);
+  m_s1uDirectLink = link;
+  m_s1uDirectLink->SetEnb (GetNode ()->GetId (), MakeCallback (&EpcEnbApplication::RecvFromS1uDirectLink, this));
+}
+
 void 
 EpcEnbApplication::DoInitialUeMessage (uint64_t imsi, uint16_t rnti)
 {
@@ -259,7 +269,14 @@ EpcEnbApplication::RecvFromLteSocket (Ptr<Socket> socket)
       std::map<uint8_t, uint32_t>::iterator bidIt = rntiIt->second.find (bid);
       NS_ASSERT (bidIt != rntiIt->second.end ());
       uint32_t teid = bidIt->second;
-      SendToS1uSocket (packet, teid);
+      if (m_s1uDirectLink)
+        {
+          m_s1uDirectLink->SendToSgw (packet, teid);
+        }
+      else
+        {
+          SendToS1uSocket (packet, teid);
+        }
     }
 }
 
@@ -272,6 +289,13 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
   uint32_t teid = gtpu.GetTeid ();
+  RecvFromS1uDirectLink (packet, teid);
+}
+
+void 
+EpcEnbApplication::RecvFromS1uDirectLink (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
   std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
   NS_ASSERT (it != m_teidRbidMap.end ());
 
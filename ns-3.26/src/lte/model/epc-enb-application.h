@@ -34,6 +34,7 @@
 #include <ns3/eps-bearer.h>
 #include <ns3/epc-enb-s1-sap.h>
 #include <ns3/epc-s1ap-sap.h>
+#include <ns3/epc-s1u-direct-link.h>
 #include <map>
 
 namespace ns3 {
@@ -123,6 +124,22 @@ public:
    */
   void RecvFromS1uSocket (Ptr<Socket> socket);
 
+  /** 
+   * Set a direct S1-U link to the SGW, to be used instead of the S1-U
+   * socket, and connect its eNB end to RecvFromS1uDirectLink
+   * 
+   * \param link the direct S1-U link
+   */
+  void SetS1uDirectLink (Ptr<EpcS1uDirectLink> link);
+
+  /** 
+   * Method to be assigned to the eNB end of the direct S1-U link. It is called when the eNB receives a data packet from the SGW that is to be forwarded to the UE.
+   * 
+   * \param packet the packet, without GTP-U header
+   * \param teid the Tunnel Enpoint IDentifier
+   */
+  void RecvFromS1uDirectLink (Ptr<Packet> packet, uint32_t teid);
+
 
   struct EpsFlowId_t
   {
@@ -196,6 +213,11 @@ private:
    */
   Ptr<Socket> m_s1uSocket;
 
+  /**
+   * direct S1-U link to the SGW, used instead of the S1-U socket if set
+   */
+  Ptr<EpcS1uDirectLink> m_s1uDirectLink;
+
   /**
    * address of the eNB for S1-U communications
    */
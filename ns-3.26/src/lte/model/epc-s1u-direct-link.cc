@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "epc-s1u-direct-link.h"
+
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EpcS1uDirectLink");
+
+NS_OBJECT_ENSURE_REGISTERED (EpcS1uDirectLink);
+
+/**
+ * Bytes of the headers carried by the S1-U point-to-point link along with
+ * each packet: GTP-U (12), UDP (8), IPv4 (20) and PPP (2)
+ */
+static const uint32_t S1U_OVERHEAD = 12 + 8 + 20 + 2;
+
+EpcS1uDirectLink::EpcS1uDirectLink ()
+{
+  NS_LOG_FUNCTION (this);
+  m_downlink.nodeId = 0;
+  m_uplink.nodeId = 0;
+}
+
+EpcS1uDirectLink::~EpcS1uDirectLink ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+EpcS1uDirectLink::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::EpcS1uDirectLink")
+    .SetParent<Object> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<EpcS1uDirectLink> ()
+    .AddAttribute ("DataRate",
+                   "The data rate of each direction of the link",
+                   DataRateValue (DataRate ("10Gb/s")),
+                   MakeDataRateAccessor (&EpcS1uDirectLink::m_dataRate),
+                   MakeDataRateChecker ())
+    .AddAttribute ("Delay",
+                   "The propagation delay of the link",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&EpcS1uDirectLink::m_delay),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+void
+EpcS1uDirectLink::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_downlink.recv = MakeNullCallback<void, Ptr<Packet>, uint32_t> ();
+  m_uplink.recv = MakeNullCallback<void, Ptr<Packet>, uint32_t> ();
+  Object::DoDispose ();
+}
+
+void
+EpcS1uDirectLink::SetEnb (uint32_t nodeId, RecvCallback cb)
+{
+  NS_LOG_FUNCTION (this << nodeId);
+  m_downlink.nodeId = nodeId;
+  m_downlink.recv = cb;
+}
+
+void
+EpcS1uDirectLink::SetSgw (uint32_t nodeId, RecvCallback cb)
+{
+  NS_LOG_FUNCTION (this << nodeId);
+  m_uplink.nodeId = nodeId;
+  m_uplink.recv = cb;
+}
+
+void
+EpcS1uDirectLink::SendToEnb (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
+  Send (m_downlink, packet, teid);
+}
+
+void
+EpcS1uDirectLink::SendToSgw (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
+  Send (m_uplink, packet, teid);
+}
+
+void
+EpcS1uDirectLink::Send (Direction &direction, Ptr<Packet> packet, uint32_t teid)
+{
+  // the packet waits for the end of the serialization of the previous
+  // ones, then is received a delay after its own serialization
+  Time start = std::max (Simulator::Now (), direction.busyUntil);
+  direction.busyUntil = start + m_dataRate.CalculateBytesTxTime (packet->GetSize () + S1U_OVERHEAD);
+  Time rxTime = direction.busyUntil + m_delay - Simulator::Now ();
+  NS_LOG_LOGIC ("packet of " << packet->GetSize () << " bytes received in " << rxTime);
+  Simulator::ScheduleWithContext (direction.nodeId, rxTime, &EpcS1uDirectLink::Receive, this,
+                                  &direction == &m_downlink, packet, teid);
+}
+
+void
+EpcS1uDirectLink::Receive (bool downlink, Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << downlink << packet << teid);
+  Direction &direction = downlink ? m_downlink : m_uplink;
+  if (!direction.recv.IsNull ())
+    {
+      direction.recv (packet, teid);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,128 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EPC_S1U_DIRECT_LINK_H
+#define EPC_S1U_DIRECT_LINK_H
+
+#include <ns3/object.h>
+#include <ns3/packet.h>
+#include <ns3/callback.h>
+#include <ns3/data-rate.h>
+#include <ns3/nstime.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Direct S1-U link between an eNB and the SGW/PGW
+ *
+ * This link carries the user plane packets between the EpcEnbApplication
+ * of an eNB and the EpcSgwPgwApplication without building the GTP-U, UDP
+ * and IPv4 headers of the tunnel, nor going through the sockets and the
+ * IPv4 stacks of the two nodes: the TEID is handed over along with the
+ * packet. The timing of a point-to-point link is kept: each direction
+ * serializes its packets one after the other at the data rate of the link,
+ * accounting for the size of the headers which are not built, and delivers
+ * them after the delay of the link. Unlike a point-to-point link, there is
+ * no limit on the packets waiting to be serialized, nor on their size.
+ */
+class EpcS1uDirectLink : public Object
+{
+public:
+  /**
+   * Callback invoked at the end of the link with a received packet and
+   * its TEID
+   */
+  typedef Callback<void, Ptr<Packet>, uint32_t> RecvCallback;
+
+  EpcS1uDirectLink ();
+  virtual ~EpcS1uDirectLink ();
+
+  // inherited from Object
+  static TypeId GetTypeId (void);
+  virtual void DoDispose (void);
+
+  /**
+   * Set the eNB end of the link
+   *
+   * \param nodeId the ID of the node of the eNB, used as context of the
+   * received packets
+   * \param cb the callback receiving the downlink packets
+   */
+  void SetEnb (uint32_t nodeId, RecvCallback cb);
+
+  /**
+   * Set the SGW/PGW end of the link
+   *
+   * \param nodeId the ID of the node of the SGW/PGW, used as context of the
+   * received packets
+   * \param cb the callback receiving the uplink packets
+   */
+  void SetSgw (uint32_t nodeId, RecvCallback cb);
+
+  /**
+   * Send a downlink packet to the eNB
+   *
+   * \param packet the packet, without GTP-U header
+   * \param teid the Tunnel Endpoint IDentifier
+   */
+  void SendToEnb (Ptr<Packet> packet, uint32_t teid);
+
+  /**
+   * Send an uplink packet to the SGW/PGW
+   *
+   * \param packet the packet, without GTP-U header
+   * \param teid the Tunnel Endpoint IDentifier
+   */
+  void SendToSgw (Ptr<Packet> packet, uint32_t teid);
+
+private:
+  /// One direction of the link
+  struct Direction
+  {
+    uint32_t nodeId;    ///< the node receiving the packets
+    RecvCallback recv;  ///< the callback receiving the packets
+    Time busyUntil;     ///< the end of the serialization of the last packet
+  };
+
+  /**
+   * Serialize a packet in a direction, and schedule its reception
+   *
+   * \param direction the direction
+   * \param packet the packet
+   * \param teid the Tunnel Endpoint IDentifier
+   */
+  void Send (Direction &direction, Ptr<Packet> packet, uint32_t teid);
+
+  /**
+   * Deliver a packet at the end of a direction
+   *
+   * \param downlink whether the direction is the downlink
+   * \param packet the packet
+   * \param teid the Tunnel Endpoint IDentifier
+   */
+  void Receive (bool downlink, Ptr<Packet> packet, uint32_t teid);
+
+  DataRate m_dataRate;     ///< the data rate of the link
+  Time m_delay;            ///< the propagation delay of the link
+  Direction m_downlink;    ///< the direction from the SGW/PGW to the eNB
+  Direction m_uplink;      ///< the direction from the eNB to the SGW/PGW
+};
+
+} // namespace ns3
+
+#endif /* EPC_S1U_DIRECT_LINK_H */
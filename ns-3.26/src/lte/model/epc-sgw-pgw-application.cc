@@ -27,6 +27,7 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/epc-gtpu-header.h"
 #include "ns3/abort.h"
+#include "ns3/node.h"
 
 namespace ns3 {
 
@@ -111,6 +112,7 @@ EpcSgwPgwApplication::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_s1uSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s1uSocket = 0;
+  m_s1uDirectLinkByEnbAddr.clear ();
   delete (m_s11SapSgw);
 }
 
@@ -163,7 +165,15 @@ EpcSgwPgwApplication::RecvFromTunDevice (Ptr<Packet> packet, const Address& sour
         }
       else
         {
-          SendToS1uSocket (packet, enbAddr, teid);
+          std::map<Ipv4Address, Ptr<EpcS1uDirectLink> >::iterator linkIt = m_s1uDirectLinkByEnbAddr.find (enbAddr);
+          if (linkIt != m_s1uDirectLinkByEnbAddr.end ())
+            {
+              linkIt->second->SendToEnb (packet, teid);
+            }
+          else
+            {
+              SendToS1uSocket (packet, enbAddr, teid);
+            }
         }
     }
   // there is no reason why we should notify the TUN
@@ -186,6 +196,13 @@ EpcSgwPgwApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   SendToTunDevice (packet, teid);
 }
 
+void 
+EpcSgwPgwApplication::RecvFromS1uDirectLink (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
+  SendToTunDevice (packet, teid);
+}
+
 void 
 EpcSgwPgwApplication::SendToTunDevice (Ptr<Packet> packet, uint32_t teid)
 {
@@ -232,6 +249,14 @@ EpcSgwPgwApplication::AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address
   m_enbInfoByCellId[cellId] = enbInfo;
 }
 
+void 
+EpcSgwPgwApplication::AddS1uDirectLink (Ipv4Address enbAddr, Ptr<EpcS1uDirectLink> link)
+{
+  NS_LOG_FUNCTION (this << enbAddr << link);
+  m_s1uDirectLinkByEnbAddr[enbAddr] = link;
+  link->SetSgw (GetNode ()->GetId (), MakeCallback (&EpcSgwPgwApplication::RecvFromS1uDirectLink, this));
+}
+
 void 
 EpcSgwPgwApplication::AddUe (uint64_t imsi)
 {
@@ -36,6 +36,7 @@
 #include <ns3/application.h>
 #include <ns3/epc-s1ap-sap.h>
 #include <ns3/epc-s11-sap.h>
+#include <ns3/epc-s1u-direct-link.h>
 #include <map>
 
 namespace ns3 {
@@ -94,6 +95,16 @@ public:
    */
   void RecvFromS1uSocket (Ptr<Socket> socket);
 
+  /** 
+   * Method to be assigned to the SGW end of the direct S1-U links. It
+   * is called when the SGW/PGW receives a data packet from an eNB
+   * that is to be forwarded to the internet.
+   * 
+   * \param packet the packet, without GTP-U header
+   * \param teid the Tunnel Enpoint IDentifier
+   */
+  void RecvFromS1uDirectLink (Ptr<Packet> packet, uint32_t teid);
+
   /** 
    * Send a packet to the internet via the Gi interface of the SGW/PGW
    * 
@@ -135,6 +146,15 @@ public:
    */
   void AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgwAddr);
 
+  /** 
+   * Set a direct S1-U link to an eNB, to be used instead of the S1-U
+   * socket, and connect its SGW end to RecvFromS1uDirectLink
+   * 
+   * \param enbAddr the address of the eNB
+   * \param link the direct S1-U link
+   */
+  void AddS1uDirectLink (Ipv4Address enbAddr, Ptr<EpcS1uDirectLink> link);
+
   /** 
    * Let the SGW be aware of a new UE
    * 
@@ -247,6 +267,11 @@ public:
    */
   std::map<uint64_t, Ptr<UeInfo> > m_ueInfoByImsiMap;
 
+  /**
+   * Map telling for each eNB address the direct S1-U link to use, if any
+   */
+  std::map<Ipv4Address, Ptr<EpcS1uDirectLink> > m_s1uDirectLinkByEnbAddr;
+
   /**
    * UDP port to be used for GTP
    */
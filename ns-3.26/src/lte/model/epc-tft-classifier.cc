@@ -40,6 +40,33 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
 
+/// The maximum number of flows in the cache, which is cleared when full
+static const uint32_t MAX_CACHED_FLOWS = 1024;
+
+bool
+EpcTftClassifier::FlowId::operator == (const FlowId &other) const
+{
+  return localAddress == other.localAddress
+         && remoteAddress == other.remoteAddress
+         && localPort == other.localPort
+         && remotePort == other.remotePort
+         && protocol == other.protocol
+         && tos == other.tos
+         && direction == other.direction;
+}
+
+size_t
+EpcTftClassifier::FlowIdHash::operator () (const FlowId &flow) const
+{
+  // the flows of a classifier mostly differ by their remote address
+  // and by their ports
+  uint32_t h = flow.remoteAddress * 2654435761U;
+  h ^= flow.localAddress + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= ((uint32_t) flow.localPort << 16 | flow.remotePort) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= ((uint32_t) flow.protocol << 16 | (uint32_t) flow.tos << 8 | flow.direction) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
 EpcTftClassifier::EpcTftClassifier ()
 {
   NS_LOG_FUNCTION (this);
@@ -51,6 +78,7 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
   NS_LOG_FUNCTION (this << tft);
   
   m_tftMap[id] = tft;  
+  m_flowCache.clear ();
   
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -61,6 +89,7 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_flowCache.clear ();
 }
 
  
@@ -69,10 +98,8 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 {
   NS_LOG_FUNCTION (this << p << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
   Ipv4Header ipv4Header;
-  pCopy->RemoveHeader (ipv4Header);
+  p->PeekHeader (ipv4Header);
 
   Ipv4Address localAddress;
   Ipv4Address remoteAddress;
@@ -97,35 +124,28 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
   uint16_t localPort = 0;
   uint16_t remotePort = 0;
 
-  if (protocol == UdpL4Protocol::PROT_NUMBER)
+  if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
     {
-      UdpHeader udpHeader;
-      pCopy->RemoveHeader (udpHeader);
+      // both the UDP and the TCP headers start with the source and the
+      // destination ports, so they are read without deserializing the
+      // whole header
+      uint32_t ipv4HeaderSize = ipv4Header.GetSerializedSize ();
+      uint8_t data[60 + 4];
+      NS_ASSERT (ipv4HeaderSize + 4 <= sizeof (data));
+      uint32_t size = p->CopyData (data, ipv4HeaderSize + 4);
+      NS_ASSERT_MSG (size == ipv4HeaderSize + 4, "no room for the ports in the packet");
+      uint16_t sourcePort = (data[ipv4HeaderSize] << 8) | data[ipv4HeaderSize + 1];
+      uint16_t destinationPort = (data[ipv4HeaderSize + 2] << 8) | data[ipv4HeaderSize + 3];
 
       if (direction ==  EpcTft::UPLINK)
 	{
-	  localPort = udpHeader.GetSourcePort ();
-	  remotePort = udpHeader.GetDestinationPort ();
+	  localPort = sourcePort;
+	  remotePort = destinationPort;
 	}
       else
 	{
-	  remotePort = udpHeader.GetSourcePort ();
-	  localPort = udpHeader.GetDestinationPort ();
-	}
-    }
-  else if (protocol == TcpL4Protocol::PROT_NUMBER)
-    {
-      TcpHeader tcpHeader;
-      pCopy->RemoveHeader (tcpHeader);
-      if (direction ==  EpcTft::UPLINK)
-	{
-	  localPort = tcpHeader.GetSourcePort ();
-	  remotePort = tcpHeader.GetDestinationPort ();
-	}
-      else
-	{
-	  remotePort = tcpHeader.GetSourcePort ();
-	  localPort = tcpHeader.GetDestinationPort ();
+	  remotePort = sourcePort;
+	  localPort = destinationPort;
 	}
     }
   else
@@ -141,6 +161,33 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction)
 	       << " remotePort=" << remotePort 
 	       << " tos=0x" << (uint16_t) tos );
 
+  FlowId flow;
+  flow.localAddress = localAddress.Get ();
+  flow.remoteAddress = remoteAddress.Get ();
+  flow.localPort = localPort;
+  flow.remotePort = remotePort;
+  flow.protocol = protocol;
+  flow.tos = tos;
+  flow.direction = direction;
+  sgi::hash_map<FlowId, uint32_t, FlowIdHash>::const_iterator cacheIt = m_flowCache.find (flow);
+  if (cacheIt != m_flowCache.end ())
+    {
+      NS_LOG_LOGIC ("cached flow of TFT ID = " << cacheIt->second);
+      return cacheIt->second;
+    }
+  if (m_flowCache.size () >= MAX_CACHED_FLOWS)
+    {
+      m_flowCache.clear ();
+    }
+  uint32_t id = ScanTfts (direction, remoteAddress, localAddress, remotePort, localPort, tos);
+  m_flowCache[flow] = id;
+  return id;
+}
+
+uint32_t
+EpcTftClassifier::ScanTfts (EpcTft::Direction direction, Ipv4Address remoteAddress, Ipv4Address localAddress,
+                            uint16_t remotePort, uint16_t localPort, uint8_t tos) const
+{
   // now it is possible to classify the packet!
   // we use a reverse iterator since filter priority is not implemented properly.
   // This way, since the default bearer is expected to be added first, it will be evaluated last.
@@ -26,6 +26,7 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include "ns3/epc-tft.h"
+#include "ns3/sgi-hashmap.h"
 
 #include <map>
 
@@ -38,6 +39,13 @@ class Packet;
 /**
  * \brief classifies IP packets accoding to Traffic Flow Templates (TFTs)
  * 
+ * The result of the classification of each flow, identified by its
+ * direction, addresses, ports, protocol and ToS, is cached in a hash
+ * table, so that the TFTs are only scanned for the first packet of the
+ * flow. The cache is cleared when a TFT is added or deleted; hence the
+ * packet filters of a TFT shall not be changed after the TFT is added to
+ * the classifier.
+ *
  * \note this implementation works with IPv4 only.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
@@ -74,6 +82,60 @@ public:
 protected:
   
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap;
+
+private:
+
+  /**
+   * The fields of an IP packet on which it is classified
+   */
+  struct FlowId
+  {
+    uint32_t localAddress;   ///< the local IPv4 address
+    uint32_t remoteAddress;  ///< the remote IPv4 address
+    uint16_t localPort;      ///< the local port
+    uint16_t remotePort;     ///< the remote port
+    uint8_t protocol;        ///< the protocol
+    uint8_t tos;             ///< the type of service
+    uint8_t direction;       ///< the direction
+
+    /**
+     * \param other the other flow
+     * \return whether the two flows are the same
+     */
+    bool operator == (const FlowId &other) const;
+  };
+
+  /**
+   * Hash function of the flows
+   */
+  struct FlowIdHash
+  {
+    /**
+     * \param flow the flow
+     * \return the hash of the flow
+     */
+    size_t operator () (const FlowId &flow) const;
+  };
+
+  /**
+   * Scan the TFTs for the first one matching a packet
+   *
+   * \param direction the direction of the packet
+   * \param remoteAddress the remote address of the packet
+   * \param localAddress the local address of the packet
+   * \param remotePort the remote port of the packet
+   * \param localPort the local port of the packet
+   * \param tos the type of service of the packet
+   * \return the identifier (>0) of the first TFT that matches with the packet; 0 if no TFT matched.
+   */
+  uint32_t ScanTfts (EpcTft::Direction direction, Ipv4Address remoteAddress, Ipv4Address localAddress,
+                     uint16_t remotePort, uint16_t localPort, uint8_t tos) const;
+
+  /**
+   * The identifier of the TFT matching each flow classified since the
+   * last change of the TFTs, 0 if none
+   */
+  sgi::hash_map<FlowId, uint32_t, FlowIdHash> m_flowCache;
   
 };
 
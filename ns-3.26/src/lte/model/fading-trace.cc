@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/fading-trace.h>
+#include <ns3/core-config.h>
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <fstream>
+#include <cstring>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FadingTrace");
+
+/// The first bytes of a binary fading trace file
+static const char BINARY_MAGIC[8] = { 'N', 'S', '3', 'F', 'A', 'D', 'B', '1' };
+
+/// The header of a binary fading trace file
+struct BinaryHeader
+{
+  char magic[8];        //!< BINARY_MAGIC
+  uint32_t rbNum;       //!< number of RBs
+  uint32_t samplesNum;  //!< number of samples per RB
+};
+
+FadingTrace::Registry &
+FadingTrace::GetRegistry (void)
+{
+  static Registry registry;
+  return registry;
+}
+
+Ptr<const FadingTrace>
+FadingTrace::Get (std::string fileName, uint32_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (fileName << rbNum << samplesNum);
+  Registry &registry = GetRegistry ();
+  Registry::const_iterator it = registry.find (Key (fileName, std::make_pair (rbNum, samplesNum)));
+  if (it != registry.end ())
+    {
+      NS_LOG_LOGIC ("trace already loaded");
+      return it->second;
+    }
+  // the registry does not hold a reference, so that the trace is
+  // unloaded when its last user releases it
+  return Ptr<const FadingTrace> (new FadingTrace (fileName, rbNum, samplesNum), false);
+}
+
+FadingTrace::FadingTrace (std::string fileName, uint32_t rbNum, uint32_t samplesNum)
+  : m_key (fileName, std::make_pair (rbNum, samplesNum)),
+    m_rbNum (rbNum),
+    m_samplesNum (samplesNum),
+    m_samples (0),
+    m_mapping (0),
+    m_mappingSize (0)
+{
+  NS_LOG_FUNCTION (this << fileName << rbNum << samplesNum);
+  std::ifstream ifTraceFile (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ASSERT_MSG (ifTraceFile.good (), " Fading trace file not found");
+  char magic[sizeof (BINARY_MAGIC)];
+  ifTraceFile.read (magic, sizeof (magic));
+  bool binary = ifTraceFile.good () && std::memcmp (magic, BINARY_MAGIC, sizeof (magic)) == 0;
+  ifTraceFile.close ();
+  if (binary)
+    {
+      LoadBinary ();
+    }
+  else
+    {
+      LoadText ();
+    }
+  GetRegistry ().insert (std::make_pair (m_key, this));
+}
+
+FadingTrace::~FadingTrace ()
+{
+  NS_LOG_FUNCTION (this);
+  GetRegistry ().erase (m_key);
+#ifdef HAVE_SYS_MMAN_H
+  if (m_mapping != 0)
+    {
+      munmap (m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+void
+FadingTrace::LoadText (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::ifstream ifTraceFile (m_key.first.c_str (), std::ifstream::in);
+  m_buffer.resize (m_rbNum * m_samplesNum);
+  for (std::vector<double>::iterator it = m_buffer.begin (); it != m_buffer.end (); ++it)
+    {
+      ifTraceFile >> *it;
+    }
+  m_samples = m_buffer.empty () ? 0 : &m_buffer[0];
+}
+
+void
+FadingTrace::LoadBinary (void)
+{
+  NS_LOG_FUNCTION (this);
+  size_t dataSize = m_rbNum * m_samplesNum * sizeof (double);
+#ifdef HAVE_SYS_MMAN_H
+  int fd = open (m_key.first.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Cannot open fading trace " << m_key.first);
+  struct stat st;
+  NS_ABORT_MSG_IF (fstat (fd, &st) != 0, "Cannot stat fading trace " << m_key.first);
+  m_mappingSize = st.st_size;
+  NS_ABORT_MSG_IF (m_mappingSize != sizeof (BinaryHeader) + dataSize,
+                   "Fading trace " << m_key.first << " does not have the size of "
+                                   << m_rbNum << " RBs of " << m_samplesNum << " samples");
+  m_mapping = mmap (0, m_mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  NS_ABORT_MSG_IF (m_mapping == MAP_FAILED, "Cannot map fading trace " << m_key.first);
+  const BinaryHeader *header = static_cast<const BinaryHeader *> (m_mapping);
+  NS_ABORT_MSG_IF (header->rbNum != m_rbNum || header->samplesNum != m_samplesNum,
+                   "Fading trace " << m_key.first << " has " << header->rbNum << " RBs of "
+                                   << header->samplesNum << " samples");
+  m_samples = reinterpret_cast<const double *> (header + 1);
+#else
+  std::ifstream ifTraceFile (m_key.first.c_str (), std::ifstream::in | std::ifstream::binary);
+  BinaryHeader header;
+  ifTraceFile.read (reinterpret_cast<char *> (&header), sizeof (header));
+  NS_ABORT_MSG_IF (header.rbNum != m_rbNum || header.samplesNum != m_samplesNum,
+                   "Fading trace " << m_key.first << " has " << header.rbNum << " RBs of "
+                                   << header.samplesNum << " samples");
+  m_buffer.resize (m_rbNum * m_samplesNum);
+  ifTraceFile.read (reinterpret_cast<char *> (&m_buffer[0]), dataSize);
+  NS_ABORT_MSG_IF (!ifTraceFile.good (), "Fading trace " << m_key.first << " is truncated");
+  m_samples = &m_buffer[0];
+#endif
+}
+
+void
+FadingTrace::Write (std::string fileName) const
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ofstream ofTraceFile (fileName.c_str (), std::ofstream::out | std::ofstream::binary);
+  NS_ABORT_MSG_IF (!ofTraceFile.good (), "Cannot create fading trace " << fileName);
+  BinaryHeader header;
+  std::memcpy (header.magic, BINARY_MAGIC, sizeof (header.magic));
+  header.rbNum = m_rbNum;
+  header.samplesNum = m_samplesNum;
+  ofTraceFile.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  ofTraceFile.write (reinterpret_cast<const char *> (m_samples), m_rbNum * m_samplesNum * sizeof (double));
+  NS_ABORT_MSG_IF (!ofTraceFile.good (), "Cannot write fading trace " << fileName);
+}
+
+uint32_t
+FadingTrace::GetRbNum (void) const
+{
+  return m_rbNum;
+}
+
+uint32_t
+FadingTrace::GetSamplesNum (void) const
+{
+  return m_samplesNum;
+}
+
+bool
+FadingTrace::IsMapped (void) const
+{
+  return m_mapping != 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,145 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FADING_TRACE_H
+#define FADING_TRACE_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/assert.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief The samples of a fading trace file, shared by all its users
+ *
+ * A fading trace is a matrix of fading values in dB, with one row per
+ * RB and one column per time sample. It is read from either:
+ *
+ *  - a text file, with the values of each RB on one line, as generated
+ *    by src/lte/model/fading-traces/fading_trace_generator.m, which is
+ *    parsed once per process;
+ *  - a binary file, as written by Write, which is memory-mapped
+ *    read-only, so that its pages are shared by all the processes
+ *    reading it on the same host. It starts with the 8 characters
+ *    "NS3FADB1", followed by the number of RBs and the number of samples
+ *    per RB as 32-bit unsigned integers, and the samples, RB by RB, as
+ *    doubles. All the numbers are in the byte order of the host.
+ *
+ * Get returns the instance already loaded for the same file and
+ * dimensions, if any.
+ */
+class FadingTrace : public SimpleRefCount<FadingTrace>
+{
+public:
+  ~FadingTrace ();
+
+  /**
+   * Get the trace of a file, loading it if it is not loaded yet
+   * \param fileName the name of the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   * \return the trace
+   */
+  static Ptr<const FadingTrace> Get (std::string fileName, uint32_t rbNum, uint32_t samplesNum);
+
+  /**
+   * Write the trace in the binary format
+   * \param fileName the name of the file to write
+   */
+  void Write (std::string fileName) const;
+
+  /**
+   * \return the number of RBs of the trace
+   */
+  uint32_t GetRbNum (void) const;
+  /**
+   * \return the number of samples per RB of the trace
+   */
+  uint32_t GetSamplesNum (void) const;
+  /**
+   * \return true if the trace is a memory-mapped binary file
+   */
+  bool IsMapped (void) const;
+
+  /**
+   * \param rb the RB
+   * \param sample the index of the sample
+   * \return the fading [dB]
+   */
+  double GetValue (uint32_t rb, uint32_t sample) const
+  {
+    NS_ASSERT (rb < m_rbNum && sample < m_samplesNum);
+    return m_samples[rb * m_samplesNum + sample];
+  }
+
+private:
+  /**
+   * Load a trace file
+   * \param fileName the name of the trace file
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   */
+  FadingTrace (std::string fileName, uint32_t rbNum, uint32_t samplesNum);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  FadingTrace (const FadingTrace &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  FadingTrace & operator = (const FadingTrace &);
+
+  /**
+   * Parse a text trace file
+   */
+  void LoadText (void);
+  /**
+   * Map a binary trace file, or read it if memory mapping is not supported
+   */
+  void LoadBinary (void);
+
+  /// Key of the loaded traces: file name, number of RBs and of samples
+  typedef std::pair<std::string, std::pair<uint32_t, uint32_t> > Key;
+  /// Container: the loaded traces
+  typedef std::map<Key, FadingTrace *> Registry;
+  /**
+   * \return the loaded traces
+   */
+  static Registry & GetRegistry (void);
+
+  Key m_key;                    //!< the key of the trace in the registry
+  uint32_t m_rbNum;             //!< number of RBs
+  uint32_t m_samplesNum;        //!< number of samples per RB
+  const double *m_samples;      //!< the samples, RB by RB
+  std::vector<double> m_buffer; //!< the samples, if not memory-mapped
+  void *m_mapping;              //!< the memory-mapped file, or 0
+  size_t m_mappingSize;         //!< the size of the memory-mapped file
+};
+
+} // namespace ns3
+
+#endif /* FADING_TRACE_H */
@@ -129,3 +129,13 @@ end
 
 fclose(file);
 
+% binary version of the trace, which TraceFadingLossModel memory-maps
+% (see the documentation of ns3::FadingTrace)
+file = fopen(strcat('fading_trace_',tag,'.fadb'),'w');
+fwrite(file, 'NS3FADB1', 'char');
+fwrite(file, [numRBs len], 'uint32');
+for j=1:numRBs
+    fwrite(file, 10.*log10(ppssdd(j, 1:len)), 'double');
+end
+fclose(file);
+
@@ -0,0 +1,308 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/ff-mac-scheduler-ue.h>
+#include <ns3/log.h>
+#include <cfloat>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerUe");
+
+FfMacSchedulerUe::FfMacSchedulerUe (uint16_t rnti)
+  : m_rnti (rnti),
+    m_txMode (0),
+    m_lcConfigured (false),
+    m_p10CqiRxed (false),
+    m_p10Cqi (0),
+    m_p10CqiTimer (0),
+    m_a30CqiRxed (false),
+    m_a30CqiTimer (0),
+    m_ulCqiTimer (0),
+    m_bsrRxed (false),
+    m_bsr (0),
+    m_dlHarqCurrentProcessId (0),
+    m_dlHarqProcessesStatus (HARQ_PROC_NUM, 0),
+    m_dlHarqProcessesTimer (HARQ_PROC_NUM, 0),
+    m_dlHarqProcessesDciBuffer (HARQ_PROC_NUM),
+    m_dlHarqProcessesRlcPduListBuffer (2, RlcPduList_t (HARQ_PROC_NUM)),
+    m_ulHarqCurrentProcessId (0),
+    m_ulHarqProcessesStatus (HARQ_PROC_NUM, 0),
+    m_ulHarqProcessesDciBuffer (HARQ_PROC_NUM)
+{
+}
+
+void
+FfMacSchedulerUe::SetRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it = m_rlcBufferReq.begin ();
+  while (it != m_rlcBufferReq.end () && (*it).m_logicalChannelIdentity < params.m_logicalChannelIdentity)
+    {
+      it++;
+    }
+  if (it != m_rlcBufferReq.end () && (*it).m_logicalChannelIdentity == params.m_logicalChannelIdentity)
+    {
+      (*it) = params;
+    }
+  else
+    {
+      m_rlcBufferReq.insert (it, params);
+    }
+}
+
+void
+FfMacSchedulerUe::ReleaseLc (uint8_t lcId)
+{
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = m_rlcBufferReq.begin (); it != m_rlcBufferReq.end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == lcId)
+        {
+          m_rlcBufferReq.erase (it);
+          return;
+        }
+    }
+}
+
+FfMacSchedSapProvider::SchedDlRlcBufferReqParameters *
+FfMacSchedulerUe::FindRlcBufferReq (uint8_t lcId)
+{
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = m_rlcBufferReq.begin (); it != m_rlcBufferReq.end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == lcId)
+        {
+          return &(*it);
+        }
+    }
+  return 0;
+}
+
+int
+FfMacSchedulerUe::GetActiveLcs (void) const
+{
+  int lcActive = 0;
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::const_iterator it;
+  for (it = m_rlcBufferReq.begin (); it != m_rlcBufferReq.end (); it++)
+    {
+      if (((*it).m_rlcTransmissionQueueSize > 0)
+          || ((*it).m_rlcRetransmissionQueueSize > 0)
+          || ((*it).m_rlcStatusPduSize > 0))
+        {
+          lcActive++;
+        }
+    }
+  return lcActive;
+}
+
+void
+FfMacSchedulerUe::UpdateDlRlcBufferInfo (uint8_t lcId, uint16_t size)
+{
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = m_rlcBufferReq.begin (); it != m_rlcBufferReq.end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == lcId)
+        {
+          break;
+        }
+    }
+  if (it == m_rlcBufferReq.end ())
+    {
+      NS_LOG_ERROR ("Does not find DL RLC Buffer Report of UE " << m_rnti);
+      return;
+    }
+  NS_LOG_INFO ("UE " << m_rnti << " LC " << (uint16_t)lcId << " txqueue " << (*it).m_rlcTransmissionQueueSize << " retxqueue " << (*it).m_rlcRetransmissionQueueSize << " status " << (*it).m_rlcStatusPduSize << " decrease " << size);
+  // Update queues: RLC tx order Status, ReTx, Tx
+  // Update status queue
+  if (((*it).m_rlcStatusPduSize > 0) && (size >= (*it).m_rlcStatusPduSize))
+    {
+      (*it).m_rlcStatusPduSize = 0;
+    }
+  else if (((*it).m_rlcRetransmissionQueueSize > 0) && (size >= (*it).m_rlcRetransmissionQueueSize))
+    {
+      (*it).m_rlcRetransmissionQueueSize = 0;
+    }
+  else if ((*it).m_rlcTransmissionQueueSize > 0)
+    {
+      uint32_t rlcOverhead;
+      if (lcId == 1)
+        {
+          // for SRB1 (using RLC AM) it's better to
+          // overestimate RLC overhead rather than
+          // underestimate it and risk unneeded
+          // segmentation which increases delay
+          rlcOverhead = 4;
+        }
+      else
+        {
+          // minimum RLC overhead due to header
+          rlcOverhead = 2;
+        }
+      // update transmission queue
+      if ((*it).m_rlcTransmissionQueueSize <= size - rlcOverhead)
+        {
+          (*it).m_rlcTransmissionQueueSize = 0;
+        }
+      else
+        {
+          (*it).m_rlcTransmissionQueueSize -= size - rlcOverhead;
+        }
+    }
+}
+
+void
+FfMacSchedulerUe::UpdateUlRlcBufferInfo (uint16_t size)
+{
+  size = size - 2; // remove the minimum RLC overhead
+  if (!m_bsrRxed)
+    {
+      NS_LOG_ERROR ("Does not find BSR report info of UE " << m_rnti);
+      return;
+    }
+  NS_LOG_INFO ("UE " << m_rnti << " size " << size << " BSR " << m_bsr);
+  if (m_bsr >= size)
+    {
+      m_bsr -= size;
+    }
+  else
+    {
+      m_bsr = 0;
+    }
+}
+
+bool
+FfMacSchedulerUe::IsDlHarqProcessAvailable (void) const
+{
+  uint8_t i = m_dlHarqCurrentProcessId;
+  do
+    {
+      i = (i + 1) % HARQ_PROC_NUM;
+    }
+  while ((m_dlHarqProcessesStatus[i] != 0) && (i != m_dlHarqCurrentProcessId));
+  return (m_dlHarqProcessesStatus[i] == 0);
+}
+
+uint8_t
+FfMacSchedulerUe::UpdateDlHarqProcessId (void)
+{
+  uint8_t i = m_dlHarqCurrentProcessId;
+  do
+    {
+      i = (i + 1) % HARQ_PROC_NUM;
+    }
+  while ((m_dlHarqProcessesStatus[i] != 0) && (i != m_dlHarqCurrentProcessId));
+  if (m_dlHarqProcessesStatus[i] != 0)
+    {
+      NS_FATAL_ERROR ("No HARQ process available for RNTI " << m_rnti << " check before update with IsDlHarqProcessAvailable");
+    }
+  m_dlHarqCurrentProcessId = i;
+  m_dlHarqProcessesStatus[i] = 1;
+  return i;
+}
+
+void
+FfMacSchedulerUe::RefreshDlHarqProcesses (void)
+{
+  for (uint16_t i = 0; i < HARQ_PROC_NUM; i++)
+    {
+      if (m_dlHarqProcessesTimer[i] == HARQ_DL_TIMEOUT)
+        {
+          // reset HARQ process
+          NS_LOG_DEBUG ("Reset HARQ proc " << i << " for RNTI " << m_rnti);
+          m_dlHarqProcessesStatus[i] = 0;
+          m_dlHarqProcessesTimer[i] = 0;
+        }
+      else
+        {
+          m_dlHarqProcessesTimer[i]++;
+        }
+    }
+}
+
+void
+FfMacSchedulerUe::RefreshDlCqi (void)
+{
+  if (m_p10CqiRxed)
+    {
+      if (m_p10CqiTimer == 0)
+        {
+          NS_LOG_INFO ("P10-CQI expired for user " << m_rnti);
+          m_p10CqiRxed = false;
+        }
+      else
+        {
+          m_p10CqiTimer--;
+        }
+    }
+  if (m_a30CqiRxed)
+    {
+      if (m_a30CqiTimer == 0)
+        {
+          NS_LOG_INFO ("A30-CQI expired for user " << m_rnti);
+          m_a30CqiRxed = false;
+          m_a30Cqi.m_higherLayerSelected.clear ();
+        }
+      else
+        {
+          m_a30CqiTimer--;
+        }
+    }
+}
+
+void
+FfMacSchedulerUe::RefreshUlCqi (void)
+{
+  if (!m_ulCqi.empty ())
+    {
+      if (m_ulCqiTimer == 0)
+        {
+          NS_LOG_INFO ("UL-CQI expired for user " << m_rnti);
+          m_ulCqi.clear ();
+        }
+      else
+        {
+          m_ulCqiTimer--;
+        }
+    }
+}
+
+double
+FfMacSchedulerUe::EstimateUlSinr (uint16_t rb)
+{
+  if (m_ulCqi.empty ())
+    {
+      // no cqi info about this UE
+      return (NO_SINR);
+    }
+  // take the average SINR value among the available
+  double sinrSum = 0;
+  unsigned int sinrNum = 0;
+  for (uint32_t i = 0; i < m_ulCqi.size (); i++)
+    {
+      double sinr = m_ulCqi[i];
+      if (sinr != NO_SINR)
+        {
+          sinrSum += sinr;
+          sinrNum++;
+        }
+    }
+  double estimatedSinr = (sinrNum > 0) ? (sinrSum / sinrNum) : DBL_MAX;
+  // store the value
+  m_ulCqi[rb] = estimatedSinr;
+  return (estimatedSinr);
+}
+
+} // namespace ns3
@@ -0,0 +1,293 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_UE_H
+#define FF_MAC_SCHEDULER_UE_H
+
+#include <ns3/ff-mac-common.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/assert.h>
+#include <vector>
+
+// value for SINR outside the range defined by FF-API, used to indicate that there
+// is no CQI for this element
+#define NO_SINR -5000
+
+#define HARQ_PROC_NUM 8
+#define HARQ_DL_TIMEOUT 11
+
+namespace ns3 {
+
+typedef std::vector < uint8_t > DlHarqProcessesStatus_t;
+typedef std::vector < uint8_t > DlHarqProcessesTimer_t;
+typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t;
+typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; // vector of the LCs and layers per UE
+typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t; // vector of the 8 HARQ processes per UE
+
+typedef std::vector < UlDciListElement_s > UlHarqProcessesDciBuffer_t;
+typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
+
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief The state of a UE kept by an FF MAC scheduler
+ *
+ * All the per-RNTI state common to the FF MAC schedulers (the RLC
+ * buffer reports, the DL and UL CQIs, the BSR and the HARQ processes)
+ * is held in a single record, so that the scheduler finds it with one
+ * lookup instead of one lookup per map. The schedulers extend it with
+ * their own per-UE statistics, and keep the records of the UEs in an
+ * FfMacSchedulerUeTable.
+ */
+struct FfMacSchedulerUe
+{
+  /**
+   * Create the state of a new UE, with its HARQ processes available
+   * \param rnti the RNTI of the UE
+   */
+  FfMacSchedulerUe (uint16_t rnti);
+
+  /**
+   * Store an RLC buffer status report, keeping the reports sorted by LCID
+   * \param params the report
+   */
+  void SetRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  /**
+   * Forget the RLC buffer status of a logical channel
+   * \param lcId the LCID
+   */
+  void ReleaseLc (uint8_t lcId);
+  /**
+   * \param lcId the LCID
+   * \return the RLC buffer status report of the logical channel, 0 if none
+   */
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters * FindRlcBufferReq (uint8_t lcId);
+  /**
+   * \return the number of logical channels with data to transmit
+   */
+  int GetActiveLcs (void) const;
+  /**
+   * Update the RLC buffer status of a logical channel after a transmission
+   * opportunity
+   * \param lcId the LCID
+   * \param size the size of the transmission opportunity
+   */
+  void UpdateDlRlcBufferInfo (uint8_t lcId, uint16_t size);
+  /**
+   * Update the BSR after an UL grant
+   * \param size the size of the grant
+   */
+  void UpdateUlRlcBufferInfo (uint16_t size);
+
+  /**
+   * \return true if a DL HARQ process is available
+   */
+  bool IsDlHarqProcessAvailable (void) const;
+  /**
+   * Take the next available DL HARQ process, which must exist
+   * \return the ID of the process
+   */
+  uint8_t UpdateDlHarqProcessId (void);
+  /**
+   * Advance the timers of the DL HARQ processes by one TTI, and reset the
+   * processes which timed out
+   */
+  void RefreshDlHarqProcesses (void);
+
+  /**
+   * Advance the validity timers of the DL CQIs by one TTI, and forget the
+   * expired ones
+   */
+  void RefreshDlCqi (void);
+  /**
+   * Advance the validity timer of the UL CQI by one TTI, and forget it if
+   * expired
+   */
+  void RefreshUlCqi (void);
+  /**
+   * Estimate the UL SINR of an RB without CQI as the average over the RBs
+   * with a CQI, and store it
+   * \param rb the RB
+   * \return the estimated SINR, or NO_SINR without any UL CQI
+   */
+  double EstimateUlSinr (uint16_t rb);
+
+  uint16_t m_rnti;  ///< the RNTI
+  uint8_t m_txMode; ///< the transmission mode
+  bool m_lcConfigured; ///< whether a logical channel was configured, starting the statistics
+
+  /// the RLC buffer status reports of the logical channels, sorted by LCID
+  std::vector <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
+
+  bool m_p10CqiRxed;        ///< whether a DL CQI P10 was received
+  uint8_t m_p10Cqi;         ///< the DL CQI P10
+  uint32_t m_p10CqiTimer;   ///< the remaining TTIs of validity of the DL CQI P10
+  bool m_a30CqiRxed;        ///< whether a DL CQI A30 was received
+  SbMeasResult_s m_a30Cqi;  ///< the DL CQI A30
+  uint32_t m_a30CqiTimer;   ///< the remaining TTIs of validity of the DL CQI A30
+  std::vector <double> m_ulCqi; ///< the UL SINR per RB, empty if no UL CQI was received
+  uint32_t m_ulCqiTimer;    ///< the remaining TTIs of validity of the UL CQI
+  bool m_bsrRxed;           ///< whether a BSR was received
+  uint32_t m_bsr;           ///< the buffer size reported by the last BSR
+
+  uint8_t m_dlHarqCurrentProcessId; ///< the current DL HARQ process
+  /// the DL HARQ processes: 0 if available, else the transmission count
+  DlHarqProcessesStatus_t m_dlHarqProcessesStatus;
+  DlHarqProcessesTimer_t m_dlHarqProcessesTimer; ///< the timers of the DL HARQ processes
+  DlHarqProcessesDciBuffer_t m_dlHarqProcessesDciBuffer; ///< the DCIs of the DL HARQ processes
+  DlHarqRlcPduListBuffer_t m_dlHarqProcessesRlcPduListBuffer; ///< the RLC PDUs of the DL HARQ processes
+  uint8_t m_ulHarqCurrentProcessId; ///< the current UL HARQ process
+  /// the UL HARQ processes: 0 if available, else the transmission count
+  UlHarqProcessesStatus_t m_ulHarqProcessesStatus;
+  UlHarqProcessesDciBuffer_t m_ulHarqProcessesDciBuffer; ///< the DCIs of the UL HARQ processes
+};
+
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief The records of the UEs of an FF MAC scheduler, indexed by RNTI
+ *
+ * The records are stored contiguously in the order of their RNTIs, so
+ * that the scheduler visits the UEs in the same order as it visited the
+ * keys of its former per-RNTI maps, and an index from the RNTI to the
+ * slot of its record makes the lookups constant time. The records are
+ * moved by Add and Remove, which invalidate the pointers returned by
+ * Find: both are called on UE configuration and release only, never
+ * while scheduling a TTI.
+ *
+ * \tparam Ue the type of the records, derived from FfMacSchedulerUe
+ */
+template <class Ue>
+class FfMacSchedulerUeTable
+{
+public:
+  /// iterator over the records, in the order of their RNTIs
+  typedef typename std::vector<Ue>::iterator Iterator;
+
+  /**
+   * \param rnti an RNTI
+   * \return the record of the UE, or 0 if the UE is unknown
+   */
+  Ue * Find (uint16_t rnti)
+  {
+    if (rnti < m_slots.size () && m_slots[rnti] != 0)
+      {
+        return &m_ues[m_slots[rnti] - 1];
+      }
+    return 0;
+  }
+
+  /**
+   * Create the record of a new UE
+   * \param rnti the RNTI of the UE, which must be unknown
+   * \return the record
+   */
+  Ue & Add (uint16_t rnti)
+  {
+    NS_ASSERT_MSG (Find (rnti) == 0, "RNTI " << rnti << " already exists");
+    // the RNTIs are usually allocated in increasing order
+    uint32_t slot = m_ues.size ();
+    while (slot > 0 && m_ues[slot - 1].m_rnti > rnti)
+      {
+        --slot;
+      }
+    m_ues.insert (m_ues.begin () + slot, Ue (rnti));
+    if (rnti >= m_slots.size ())
+      {
+        m_slots.resize (rnti + 1, 0);
+      }
+    UpdateSlots (slot);
+    return m_ues[slot];
+  }
+
+  /**
+   * Remove the record of a UE, if any
+   * \param rnti the RNTI of the UE
+   */
+  void Remove (uint16_t rnti)
+  {
+    if (Find (rnti) == 0)
+      {
+        return;
+      }
+    uint32_t slot = m_slots[rnti] - 1;
+    m_slots[rnti] = 0;
+    m_ues.erase (m_ues.begin () + slot);
+    UpdateSlots (slot);
+  }
+
+  /// Remove all the records
+  void Clear (void)
+  {
+    m_ues.clear ();
+    m_slots.clear ();
+  }
+
+  /**
+   * \return the number of UEs
+   */
+  uint32_t GetN (void) const
+  {
+    return m_ues.size ();
+  }
+
+  /**
+   * \param slot the slot of a record, smaller than GetN ()
+   * \return the record
+   */
+  Ue & Get (uint32_t slot)
+  {
+    return m_ues[slot];
+  }
+
+  /**
+   * \return an iterator to the record of the smallest RNTI
+   */
+  Iterator Begin (void)
+  {
+    return m_ues.begin ();
+  }
+
+  /**
+   * \return an iterator past the record of the largest RNTI
+   */
+  Iterator End (void)
+  {
+    return m_ues.end ();
+  }
+
+private:
+  /**
+   * Index the records moved by an insertion or a removal
+   * \param first the slot of the first record moved
+   */
+  void UpdateSlots (uint32_t first)
+  {
+    for (uint32_t slot = first; slot < m_ues.size (); ++slot)
+      {
+        m_slots[m_ues[slot].m_rnti] = slot + 1;
+      }
+  }
+
+  std::vector<Ue> m_ues;          ///< the records, sorted by RNTI
+  std::vector<uint32_t> m_slots;  ///< the slot + 1 of the record of each RNTI, 0 if none
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_UE_H */
@@ -346,6 +346,7 @@ LteEnbMac::GetTypeId (void)
 
 
 LteEnbMac::LteEnbMac ()
+  : m_deferSchedIndications (false)
 {
   NS_LOG_FUNCTION (this);
   m_macSapProvider = new EnbMacMemberLteMacSapProvider<LteEnbMac> (this);
@@ -371,6 +372,10 @@ LteEnbMac::DoDispose ()
   m_dlInfoListReceived.clear ();
   m_ulInfoListReceived.clear ();
   m_miDlHarqProcessesPackets.clear ();
+  m_schedUlCqiInfoReqs.clear ();
+  m_schedDlConfigInds.clear ();
+  m_schedUlConfigInds.clear ();
+  m_subframeThreadPool = 0;
   delete m_macSapProvider;
   delete m_cmacSapProvider;
   delete m_schedSapUser;
@@ -435,6 +440,13 @@ LteEnbMac::SetLteEnbPhySapProvider (LteEnbPhySapProvider* s)
   m_enbPhySapProvider = s;
 }
 
+void
+LteEnbMac::SetSubframeThreadPool (Ptr<LteSubframeThreadPool> pool)
+{
+  NS_LOG_FUNCTION (this);
+  m_subframeThreadPool = pool;
+}
+
 
 LteEnbPhySapUser*
 LteEnbMac::GetLteEnbPhySapUser ()
@@ -538,12 +550,11 @@ LteEnbMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
       m_dlInfoListReceived.clear ();
     }
 
-  m_schedSapProvider->SchedDlTriggerReq (dlparams);
+  m_schedDlTriggerReq = dlparams;
 
 
   // --- UPLINK ---
   // Send UL-CQI info to the scheduler
-  std::vector <FfMacSchedSapProvider::SchedUlCqiInfoReqParameters>::iterator itCqi;
   for (uint16_t i = 0; i < m_ulCqiReceived.size (); i++)
     {
       if (subframeNo > 1)
@@ -554,18 +565,16 @@ LteEnbMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
         {
           m_ulCqiReceived.at (i).m_sfnSf = ((0x3FF & (frameNo - 1)) << 4) | (0xF & 10);
         }
-      m_schedSapProvider->SchedUlCqiInfoReq (m_ulCqiReceived.at (i));
     }
-    m_ulCqiReceived.clear ();
+  m_schedUlCqiInfoReqs.swap (m_ulCqiReceived);
+  m_ulCqiReceived.clear ();
   
   // Send BSR reports to the scheduler
+  m_schedUlMacCtrlInfoReq.m_macCeList.clear ();
   if (m_ulCeReceived.size () > 0)
     {
-      FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters ulMacReq;
-      ulMacReq.m_sfnSf = ((0x3FF & frameNo) << 4) | (0xF & subframeNo);
-      ulMacReq.m_macCeList.insert (ulMacReq.m_macCeList.begin (), m_ulCeReceived.begin (), m_ulCeReceived.end ());
-      m_ulCeReceived.erase (m_ulCeReceived.begin (), m_ulCeReceived.end ());
-      m_schedSapProvider->SchedUlMacCtrlInfoReq (ulMacReq);
+      m_schedUlMacCtrlInfoReq.m_sfnSf = ((0x3FF & frameNo) << 4) | (0xF & subframeNo);
+      m_schedUlMacCtrlInfoReq.m_macCeList.swap (m_ulCeReceived);
     }
 
 
@@ -593,8 +602,58 @@ LteEnbMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
       m_ulInfoListReceived.clear ();
     }
 
-  m_schedSapProvider->SchedUlTriggerReq (ulparams);
+  m_schedUlTriggerReq = ulparams;
+
+  if (m_subframeThreadPool == 0)
+    {
+      RunScheduler ();
+    }
+  else
+    {
+      m_subframeThreadPool->Add (MakeCallback (&LteEnbMac::RunScheduler, this),
+                                 MakeCallback (&LteEnbMac::DeliverSchedIndications, this));
+    }
+}
+
+void
+LteEnbMac::RunScheduler (void)
+{
+  // the allocations are processed in the main thread, after the
+  // schedulers of all the eNBs of the pool are done
+  m_deferSchedIndications = (m_subframeThreadPool != 0);
+
+  m_schedSapProvider->SchedDlTriggerReq (m_schedDlTriggerReq);
+  for (uint16_t i = 0; i < m_schedUlCqiInfoReqs.size (); i++)
+    {
+      m_schedSapProvider->SchedUlCqiInfoReq (m_schedUlCqiInfoReqs.at (i));
+    }
+  m_schedUlCqiInfoReqs.clear ();
+  if (m_schedUlMacCtrlInfoReq.m_macCeList.size () > 0)
+    {
+      m_schedSapProvider->SchedUlMacCtrlInfoReq (m_schedUlMacCtrlInfoReq);
+      m_schedUlMacCtrlInfoReq.m_macCeList.clear ();
+    }
+  m_schedSapProvider->SchedUlTriggerReq (m_schedUlTriggerReq);
+
+  m_deferSchedIndications = false;
+}
 
+void
+LteEnbMac::DeliverSchedIndications (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector <FfMacSchedSapUser::SchedDlConfigIndParameters> dlInds;
+  dlInds.swap (m_schedDlConfigInds);
+  std::vector <FfMacSchedSapUser::SchedUlConfigIndParameters> ulInds;
+  ulInds.swap (m_schedUlConfigInds);
+  for (uint16_t i = 0; i < dlInds.size (); i++)
+    {
+      DoSchedDlConfigInd (dlInds.at (i));
+    }
+  for (uint16_t i = 0; i < ulInds.size (); i++)
+    {
+      DoSchedUlConfigInd (ulInds.at (i));
+    }
 }
 
 
@@ -968,6 +1027,11 @@ LteEnbMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters
 void
 LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind)
 {
+  if (m_deferSchedIndications)
+    {
+      m_schedDlConfigInds.push_back (ind);
+      return;
+    }
   NS_LOG_FUNCTION (this);
   // Create DL PHY PDU
   Ptr<PacketBurst> pb = CreateObject<PacketBurst> ();
@@ -1095,6 +1159,11 @@ LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind
 void
 LteEnbMac::DoSchedUlConfigInd (FfMacSchedSapUser::SchedUlConfigIndParameters ind)
 {
+  if (m_deferSchedIndications)
+    {
+      m_schedUlConfigInds.push_back (ind);
+      return;
+    }
   NS_LOG_FUNCTION (this);
 
   for (unsigned int i = 0; i < ind.m_dciList.size (); i++)
@@ -31,6 +31,7 @@
 #include <ns3/ff-mac-csched-sap.h>
 #include <ns3/ff-mac-sched-sap.h>
 #include <ns3/lte-enb-phy-sap.h>
+#include <ns3/lte-subframe-thread-pool.h>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include <ns3/packet.h>
@@ -120,6 +121,18 @@ public:
   */
   void SetLteEnbPhySapProvider (LteEnbPhySapProvider* s);
 
+  /**
+   * \brief Run the scheduler in a pool of threads
+   *
+   * At each subframe, the scheduler is then triggered in parallel with the
+   * schedulers of the other eNBs sharing the pool, and the MAC processes
+   * its allocations after the schedulers of all the eNBs are done.
+   *
+   * \param pool the pool, or 0 to trigger the scheduler at the start of
+   *        the subframe
+   */
+  void SetSubframeThreadPool (Ptr<LteSubframeThreadPool> pool);
+
   /**
    * TracedCallback signature for DL scheduling events.
    *
@@ -203,6 +216,20 @@ private:
   void DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo);
   void DoReceiveRachPreamble (uint8_t prachId);
 
+  /**
+   * \brief Trigger the scheduler with the requests prepared by
+   * DoSubframeIndication
+   *
+   * With a subframe thread pool, this may run in a worker thread: the
+   * allocations of the scheduler are then kept until
+   * DeliverSchedIndications.
+   */
+  void RunScheduler (void);
+  /**
+   * \brief Process the allocations kept by RunScheduler
+   */
+  void DeliverSchedIndications (void);
+
 public:
   // legacy public for use the Phy callback
   void DoReceivePhyPdu (Ptr<Packet> p);
@@ -247,6 +274,15 @@ private:
 
   uint32_t m_frameNo;
   uint32_t m_subframeNo;
+
+  Ptr<LteSubframeThreadPool> m_subframeThreadPool; ///< the pool running the scheduler, if any
+  bool m_deferSchedIndications; ///< whether the allocations of the scheduler are kept for later
+  FfMacSchedSapProvider::SchedDlTriggerReqParameters m_schedDlTriggerReq; ///< DL trigger of the subframe
+  std::vector <FfMacSchedSapProvider::SchedUlCqiInfoReqParameters> m_schedUlCqiInfoReqs; ///< UL-CQIs of the subframe
+  FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters m_schedUlMacCtrlInfoReq; ///< BSRs of the subframe
+  FfMacSchedSapProvider::SchedUlTriggerReqParameters m_schedUlTriggerReq; ///< UL trigger of the subframe
+  std::vector <FfMacSchedSapUser::SchedDlConfigIndParameters> m_schedDlConfigInds; ///< DL allocations kept
+  std::vector <FfMacSchedSapUser::SchedUlConfigIndParameters> m_schedUlConfigInds; ///< UL allocations kept
   /**
    * Trace information regarding DL scheduling
    * Frame number, Subframe number, RNTI, MCS of TB1, size of TB1,
@@ -344,7 +344,7 @@ LteEnbPhy::SetMacChDelay (uint8_t delay)
     {
       Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
       m_packetBurstQueue.push_back (pb);
-      std::list<Ptr<LteControlMessage> > l;
+      std::vector<Ptr<LteControlMessage> > l;
       m_controlMessagesQueue.push_back (l);
       std::list<UlDciLteControlMessage> l1;
       m_ulDciQueue.push_back (l1);
@@ -520,10 +520,10 @@ LteEnbPhy::ReceiveLteControlMessage (Ptr<LteControlMessage> msg)
 }
 
 void
-LteEnbPhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgList)
+LteEnbPhy::ReceiveLteControlMessageList (const std::vector<Ptr<LteControlMessage> > &msgList)
 {
   NS_LOG_FUNCTION (this);
-  std::list<Ptr<LteControlMessage> >::iterator it;
+  std::vector<Ptr<LteControlMessage> >::const_iterator it;
   for (it = msgList.begin (); it != msgList.end (); it++)
     {
       switch ((*it)->GetMessageType ())
@@ -661,12 +661,12 @@ LteEnbPhy::StartSubFrame (void)
     }
 
   // process the current burst of control messages
-  std::list<Ptr<LteControlMessage> > ctrlMsg = GetControlMessages ();
+  std::vector<Ptr<LteControlMessage> > ctrlMsg = GetControlMessages ();
   m_dlDataRbMap.clear ();
   m_dlPowerAllocationMap.clear ();
   if (ctrlMsg.size () > 0)
     {
-      std::list<Ptr<LteControlMessage> >::iterator it;
+      std::vector<Ptr<LteControlMessage> >::iterator it;
       it = ctrlMsg.begin ();
       while (it != ctrlMsg.end ())
         {
@@ -765,7 +765,7 @@ LteEnbPhy::StartSubFrame (void)
 }
 
 void
-LteEnbPhy::SendControlChannels (std::list<Ptr<LteControlMessage> > ctrlMsgList)
+LteEnbPhy::SendControlChannels (const std::vector<Ptr<LteControlMessage> > &ctrlMsgList)
 {
   NS_LOG_FUNCTION (this << " eNB " << m_cellId << " start tx ctrl frame");
   // set the current tx power spectral density (full bandwidth)
@@ -792,7 +792,7 @@ LteEnbPhy::SendDataChannels (Ptr<PacketBurst> pb)
   SetDownlinkSubChannelsWithPowerAllocation (m_dlDataRbMap);
   // send the current burts of packets
   NS_LOG_LOGIC (this << " eNB start TX DATA");
-  std::list<Ptr<LteControlMessage> > ctrlMsgList;
+  std::vector<Ptr<LteControlMessage> > ctrlMsgList;
   ctrlMsgList.clear ();
   m_downlinkSpectrumPhy->StartTxDataFrame (pb, ctrlMsgList, DL_DATA_DURATION);
 }
@@ -222,7 +222,7 @@ public:
   * \brief Send the PDCCH and PCFICH in the first 3 symbols
   * \param ctrlMsgList the list of control messages of PDCCH
   */
-  void SendControlChannels (std::list<Ptr<LteControlMessage> > ctrlMsgList);
+  void SendControlChannels (const std::vector<Ptr<LteControlMessage> > &ctrlMsgList);
 
   /**
   * \brief Send the PDSCH
@@ -266,7 +266,7 @@ public:
   /**
   * \brief PhySpectrum received a new list of LteControlMessage
   */
-  virtual void ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> >);
+  virtual void ReceiveLteControlMessageList (const std::vector<Ptr<LteControlMessage> > &);
 
   // inherited from LtePhy
   virtual void GenerateCtrlCqiReport (const SpectrumValue& sinr);
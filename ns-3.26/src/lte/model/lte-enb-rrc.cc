@@ -39,6 +39,7 @@
 #include <ns3/lte-rlc-tm.h>
 #include <ns3/lte-rlc-um.h>
 #include <ns3/lte-rlc-am.h>
+#include <ns3/lte-rlc-fast.h>
 #include <ns3/lte-pdcp.h>
 
 
@@ -395,6 +396,10 @@ UeManager::SetupDataRadioBearer (EpsBearer bearer, uint8_t bearerId, uint32_t gt
     {
       drbInfo->m_rlcConfig.choice =  LteRrcSap::RlcConfig::AM;
     }
+  else if (rlcTypeId == LteRlcFast::GetTypeId ())
+    {
+      drbInfo->m_rlcConfig.choice =  LteRrcSap::RlcConfig::FAST;
+    }
   else
     {
       drbInfo->m_rlcConfig.choice =  LteRrcSap::RlcConfig::UM_BI_DIRECTIONAL;
@@ -1362,7 +1367,8 @@ LteEnbRrc::GetTypeId (void)
                    MakeEnumChecker (RLC_SM_ALWAYS, "RlcSmAlways",
                                     RLC_UM_ALWAYS, "RlcUmAlways",
                                     RLC_AM_ALWAYS, "RlcAmAlways",
-                                    PER_BASED,     "PacketErrorRateBased"))
+                                    PER_BASED,     "PacketErrorRateBased",
+                                    RLC_FAST_ALWAYS, "RlcFastAlways"))
     .AddAttribute ("SystemInformationPeriodicity",
                    "The interval for sending system information (Time value)",
                    TimeValue (MilliSeconds (80)),
@@ -2309,6 +2315,10 @@ LteEnbRrc::GetRlcType (EpsBearer bearer)
       return LteRlcAm::GetTypeId ();
       break;
 
+    case RLC_FAST_ALWAYS:
+      return LteRlcFast::GetTypeId ();
+      break;
+
     case PER_BASED:
       if (bearer.GetPacketErrorLossRate () > 1.0e-5)
         {
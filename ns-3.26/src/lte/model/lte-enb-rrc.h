@@ -818,7 +818,8 @@ public:
   enum LteEpsBearerToRlcMapping_t {RLC_SM_ALWAYS = 1,
                                    RLC_UM_ALWAYS = 2,
                                    RLC_AM_ALWAYS = 3,
-                                   PER_BASED = 4};
+                                   PER_BASED = 4,
+                                   RLC_FAST_ALWAYS = 5};
 
   /**
    * TracedCallback signature for new Ue Context events.
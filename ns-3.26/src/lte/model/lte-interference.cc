@@ -53,6 +53,7 @@ LteInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_batch = 0;
   Object::DoDispose ();
 } 
 
@@ -96,9 +97,19 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
       NS_LOG_LOGIC ("additional signal" << *m_rxSignal);
       // receiving multiple simultaneous signals, make sure they are synchronized
       NS_ASSERT (m_lastChangeTime == Now ());
-      // make sure they use orthogonal resource blocks
-      NS_ASSERT (Sum ((*rxPsd) * (*m_rxSignal)) == 0.0);
-      (*m_rxSignal) += (*rxPsd);
+      NS_ASSERT (rxPsd->GetSpectrumModel ()->GetUid () == m_rxSignal->GetSpectrumModel ()->GetUid ());
+      Values::const_iterator value = rxPsd->ConstValuesBegin ();
+      Values::iterator total = m_rxSignal->ValuesBegin ();
+      uint32_t bands = rxPsd->GetSpectrumModel ()->GetNumBands ();
+      for (uint32_t i = 0; i < bands; ++i)
+        {
+          if (value[i] != 0)
+            {
+              // make sure they use orthogonal resource blocks
+              NS_ASSERT (total[i] == 0.0);
+              total[i] += value[i];
+            }
+        }
     }
 }
 
@@ -135,18 +146,25 @@ void
 LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
 {
   NS_LOG_FUNCTION (this << *spd << duration);
-  DoAddSignal (spd);
-  uint32_t signalId = ++m_lastSignalId;
-  if (signalId == m_lastSignalIdBeforeReset)
+  if (m_batch == 0 || m_batchStart != Now () || m_batchDuration != duration)
     {
-      // This happens when m_lastSignalId eventually wraps around. Given that so
-      // many signals have elapsed since the last reset, we hope that by now there is
-      // no stale pending signal (i.e., a signal that was scheduled
-      // for subtraction before the reset). So we just move the
-      // boundary further.
-      m_lastSignalIdBeforeReset += 0x10000000;
+      // the first signal of a batch, which ends with it
+      m_batch = Create<SignalBatch> ();
+      m_batchStart = Now ();
+      m_batchDuration = duration;
+      uint32_t signalId = ++m_lastSignalId;
+      if (signalId == m_lastSignalIdBeforeReset)
+        {
+          // This happens when m_lastSignalId eventually wraps around. Given that so
+          // many signals have elapsed since the last reset, we hope that by now there is
+          // no stale pending signal (i.e., a signal that was scheduled
+          // for subtraction before the reset). So we just move the
+          // boundary further.
+          m_lastSignalIdBeforeReset += 0x10000000;
+        }
+      Simulator::Schedule (duration, &LteInterference::DoSubtractSignals, this, m_batch, signalId);
     }
-  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
+  DoAddSignal (spd);
 }
 
 
@@ -155,22 +173,42 @@ LteInterference::DoAddSignal  (Ptr<const SpectrumValue> spd)
 { 
   NS_LOG_FUNCTION (this << *spd);
   ConditionallyEvaluateChunk ();
-  (*m_allSignals) += (*spd);
+  NS_ASSERT (spd->GetSpectrumModel ()->GetUid () == m_allSignals->GetSpectrumModel ()->GetUid ());
+  // the zero values, e.g. the RBs not allocated to a UE, leave the total
+  // unchanged and are skipped
+  Values::const_iterator value = spd->ConstValuesBegin ();
+  Values::iterator total = m_allSignals->ValuesBegin ();
+  uint32_t bands = spd->GetSpectrumModel ()->GetNumBands ();
+  for (uint32_t i = 0; i < bands; ++i)
+    {
+      if (value[i] != 0)
+        {
+          total[i] += value[i];
+          m_batch->bands.push_back (i);
+          m_batch->values.push_back (value[i]);
+        }
+    }
 }
 
 void
-LteInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId)
+LteInterference::DoSubtractSignals  (Ptr<const SignalBatch> batch, uint32_t signalId)
 { 
-  NS_LOG_FUNCTION (this << *spd);
+  NS_LOG_FUNCTION (this << batch->values.size ());
   ConditionallyEvaluateChunk ();   
   int32_t deltaSignalId = signalId - m_lastSignalIdBeforeReset;
   if (deltaSignalId > 0)
     {   
-      (*m_allSignals) -= (*spd);
+      // in the order they were added, so that the total is the same as if
+      // the signals were subtracted one by one
+      Values::iterator total = m_allSignals->ValuesBegin ();
+      for (size_t i = 0; i < batch->values.size (); ++i)
+        {
+          total[batch->bands[i]] -= batch->values[i];
+        }
     }
   else
     {
-      NS_LOG_INFO ("ignoring signal scheduled for subtraction before last reset");
+      NS_LOG_INFO ("ignoring signals scheduled for subtraction before last reset");
     }
 }
 
@@ -225,6 +263,8 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // record the last SignalId so that we can ignore all signals that
   // were scheduled for subtraction before m_allSignal 
   m_lastSignalIdBeforeReset = m_lastSignalId;
+  // and start a new batch with the next signal
+  m_batch = 0;
 }
 
 void
@@ -28,6 +28,7 @@
 #include <ns3/spectrum-value.h>
 
 #include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -42,6 +43,11 @@ class LteChunkProcessor;
  * This class implements a gaussian interference model, i.e., all
  * incoming signals are added to the total interference.
  *
+ * The signals starting at the same time with the same duration, such as
+ * the UL transmissions of all the UEs in a subframe, are handled as a
+ * batch: only the non-zero values of their power spectral densities (i.e.,
+ * the RBs allocated to each UE) are added to the total, and they are
+ * subtracted together when they end.
  */
 class LteInterference : public Object
 {
@@ -115,9 +121,21 @@ public:
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
 private:
+  /// The signals starting at the same time with the same duration
+  struct SignalBatch : public SimpleRefCount<SignalBatch>
+  {
+    std::vector<uint32_t> bands; ///< the bands of the non-zero values of the signals
+    std::vector<double> values;  ///< the non-zero values of the signals, one signal after the other
+  };
+
   void ConditionallyEvaluateChunk ();
   void DoAddSignal  (Ptr<const SpectrumValue> spd);
-  void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
+  /**
+   * Subtract the signals of a batch from the total when they end
+   * \param batch the batch of signals
+   * \param signalId the ID of the batch
+   */
+  void DoSubtractSignals  (Ptr<const SignalBatch> batch, uint32_t signalId);
 
 
 
@@ -141,6 +159,10 @@ private:
   uint32_t m_lastSignalId;
   uint32_t m_lastSignalIdBeforeReset;
 
+  Ptr<SignalBatch> m_batch;  ///< the batch of the last signal added
+  Time m_batchStart;         ///< the start time of the signals of m_batch
+  Time m_batchDuration;      ///< the duration of the signals of m_batch
+
   /** all the processor instances that need to be notified whenever
   a new interference chunk is calculated */
   std::list<Ptr<LteChunkProcessor> > m_rsPowerChunkProcessorList;
@@ -36,6 +36,7 @@
 #include <ns3/pointer.h>
 #include <stdint.h>
 #include <cmath>
+#include <algorithm>
 #include <stdint.h>
 #include "stdlib.h"
 #include <ns3/lte-mi-error-model.h>
@@ -323,86 +324,147 @@ static const double cEcrTable [9][38] = {
 };
 
 
+/**
+ * The MI map of a modulation, whose SINR axis is uniformly spaced
+ */
+struct MiMap
+{
+  const double *mi;     ///< the MI values
+  const double *axis;   ///< the SINR values of the MI values
+  uint16_t size;        ///< the number of values
+  double scalingCoeff;  ///< the number of values per unit of SINR
+};
+
+/// the MI maps of QPSK, 16-QAM and 64-QAM
+static const MiMap g_miMaps[3] = {
+  { MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE,
+    (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]) },
+  { MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE,
+    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]) },
+  { MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE,
+    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]) }
+};
+
+/**
+ * \param mcs the MCS
+ * \return the MI map of the modulation of the MCS
+ */
+static inline const MiMap &
+GetMiMap (uint8_t mcs)
+{
+  if (mcs <= MI_QPSK_MAX_ID)
+    {
+      return g_miMaps[0];
+    }
+  else if (mcs <= MI_16QAM_MAX_ID)
+    {
+      return g_miMaps[1];
+    }
+  return g_miMaps[2];
+}
+
+/**
+ * \param miMap the MI map of the modulation
+ * \param sinrLin the SINR in linear units
+ * \return the MI of the SINR
+ */
+static inline double
+GetMi (const MiMap &miMap, double sinrLin)
+{
+  if (sinrLin > miMap.axis[miMap.size - 1])
+    {
+      return 1;
+    }
+  // since the values of the axis are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  double sinrIndexDouble = (sinrLin - miMap.axis[0]) * miMap.scalingCoeff + 1;
+  // truncating a positive index is the same as flooring it
+  uint32_t sinrIndex = sinrIndexDouble > 0 ? (uint32_t) sinrIndexDouble : 0;
+  NS_ASSERT_MSG (sinrIndex < miMap.size, "MI map out of data");
+  return miMap.mi[sinrIndex];
+}
+
+/**
+ * The parameters of the BLER curves, indexed by CB size and ECR, with
+ * the missing curves of a CB size replaced by the ones of the lowest
+ * larger CB size, and the index of the curves of each CB size
+ */
+class BlerCurveTable
+{
+public:
+  BlerCurveTable ()
+  {
+    for (uint32_t cbSize = 0; cbSize <= MAX_CB_SIZE; ++cbSize)
+      {
+        uint8_t cbIndex = 1;
+        while ((cbIndex < 9) && (cbMiSizeTable[cbIndex] <= cbSize))
+          {
+            cbIndex++;
+          }
+        m_cbIndex[cbSize] = cbIndex - 1;
+      }
+    for (uint8_t cbIndex = 0; cbIndex < 9; ++cbIndex)
+      {
+        for (uint8_t ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ++ecrId)
+          {
+            // take the lowest CB size including this CB for removing CB
+            // size quantization errors
+            double b = bEcrTable[cbIndex][ecrId];
+            for (uint8_t i = cbIndex; (i < 9) && (b < 0); )
+              {
+                b = bEcrTable[i++][ecrId];
+              }
+            double c = cEcrTable[cbIndex][ecrId];
+            for (uint8_t i = cbIndex; (i < 9) && (c < 0); )
+              {
+                c = cEcrTable[i++][ecrId];
+              }
+            m_b[cbIndex][ecrId] = b;
+            m_c[cbIndex][ecrId] = c;
+            m_sqrt2c[cbIndex][ecrId] = sqrt (2) * c;
+          }
+      }
+  }
+
+  /**
+   * \param cbSize the size of the CB
+   * \return the index of the curves of the CB size
+   */
+  uint8_t GetCbIndex (uint16_t cbSize) const
+  {
+    return m_cbIndex[cbSize < MAX_CB_SIZE ? cbSize : MAX_CB_SIZE];
+  }
+
+  static const uint16_t MAX_CB_SIZE = 6144; ///< the largest CB size with its own curves
+  uint8_t m_cbIndex[MAX_CB_SIZE + 1];       ///< the index of the curves of each CB size
+  double m_b[9][MI_64QAM_BLER_MAX_ID + 1];       ///< the mean of each curve
+  double m_c[9][MI_64QAM_BLER_MAX_ID + 1];       ///< the standard deviation of each curve
+  double m_sqrt2c[9][MI_64QAM_BLER_MAX_ID + 1];  ///< sqrt(2) times the standard deviation
+};
+
+/// the parameters of the BLER curves
+static const BlerCurveTable g_blerCurves;
+
+
+
 double 
 LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
   
-  double MI;
+  // the MI map is chosen once per TB, and the RBs are not logged one by
+  // one, so that the loop on the RBs is a plain table lookup
+  const MiMap &miMap = GetMiMap (mcs);
+  Values::const_iterator sinrBegin = sinr.ConstValuesBegin ();
+  const uint32_t nRbs = sinr.ConstValuesEnd () - sinrBegin;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
   
   for (uint32_t i = 0; i < map.size (); i++)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
-
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
-        {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
-        }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
-      MIsum += MI;
+      NS_ASSERT_MSG ((uint32_t) map[i] < nRbs, "RB " << map[i] << " out of the spectrum");
+      MIsum += GetMi (miMap, sinrBegin[map[i]]);
     }
-  MI = MIsum / map.size ();
+  double MI = MIsum / map.size ();
   NS_LOG_LOGIC (" MI = " << MI);
   return MI;
 }
@@ -412,42 +474,15 @@ double
 LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
 
   NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
-  int cbIndex = 1;
-  while ((cbIndex < 9)&&(cbMiSizeTable[cbIndex]<= cbSize))
-    {
-      cbIndex++;
-    }
-  cbIndex--;
+  uint8_t cbIndex = g_blerCurves.GetCbIndex (cbSize);
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  double b = g_blerCurves.m_b[cbIndex][ecrId];
+  double c = g_blerCurves.m_c[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
+  double bler = 0.5*( 1 - erf((mib-b)/g_blerCurves.m_sqrt2c[cbIndex][ecrId]) );
   NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
   return bler;
 }
@@ -460,42 +495,22 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
+      MI = GetMi (g_miMaps[0], *sinrIt);
       MIsum += MI;
       sinrIt++;
       rb++;
     }
   MI = MIsum / rb;
   // return to the effective SINR value
-  int j = 0;
+  // the MI map is increasing, so the first value not lower than MI is
+  // found by a binary search
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -523,12 +538,8 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb) - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -546,7 +557,7 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
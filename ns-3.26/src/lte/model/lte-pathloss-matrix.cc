@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/lte-pathloss-matrix.h>
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LtePathlossMatrix");
+
+/// The first bytes of a snapshot file
+static const char SNAPSHOT_MAGIC[8] = { 'N', 'S', '3', 'P', 'L', 'M', '0', '1' };
+
+/// The header of a snapshot
+struct SnapshotHeader
+{
+  double time;     //!< the time of the snapshot [s]
+  uint32_t nCells; //!< the number of cells
+  uint32_t nImsis; //!< the number of IMSIs
+};
+
+LtePathlossMatrix::LtePathlossMatrix ()
+  : m_nCells (0),
+    m_nImsis (0),
+    m_imsiCapacity (0)
+{
+}
+
+void
+LtePathlossMatrix::Resize (uint16_t nCells, uint64_t nImsis)
+{
+  NS_LOG_FUNCTION (this << nCells << nImsis);
+  nCells = std::max (nCells, m_nCells);
+  nImsis = std::max (nImsis, m_nImsis);
+  if (nImsis > m_imsiCapacity)
+    {
+      // the rows are lengthened by doubling, since the IMSIs are
+      // usually discovered one after the other
+      uint64_t imsiCapacity = std::max (nImsis, 2 * m_imsiCapacity);
+      std::vector<double> values (nCells * imsiCapacity, std::numeric_limits<double>::quiet_NaN ());
+      for (uint16_t cell = 0; cell < m_nCells; ++cell)
+        {
+          std::copy (m_values.begin () + cell * m_imsiCapacity,
+                     m_values.begin () + cell * m_imsiCapacity + m_nImsis,
+                     values.begin () + cell * imsiCapacity);
+        }
+      m_values.swap (values);
+      m_imsiCapacity = imsiCapacity;
+    }
+  else
+    {
+      m_values.resize (nCells * m_imsiCapacity, std::numeric_limits<double>::quiet_NaN ());
+    }
+  m_nCells = nCells;
+  m_nImsis = nImsis;
+}
+
+double
+LtePathlossMatrix::Get (uint16_t cellId, uint64_t imsi) const
+{
+  if (!IsSet (cellId, imsi))
+    {
+      return std::numeric_limits<double>::infinity ();
+    }
+  return m_values[(cellId - 1) * m_imsiCapacity + (imsi - 1)];
+}
+
+bool
+LtePathlossMatrix::IsSet (uint16_t cellId, uint64_t imsi) const
+{
+  return cellId > 0 && cellId <= m_nCells && imsi > 0 && imsi <= m_nImsis
+         && !std::isnan (m_values[(cellId - 1) * m_imsiCapacity + (imsi - 1)]);
+}
+
+uint16_t
+LtePathlossMatrix::GetNCells (void) const
+{
+  return m_nCells;
+}
+
+uint64_t
+LtePathlossMatrix::GetNImsis (void) const
+{
+  return m_nImsis;
+}
+
+void
+LtePathlossMatrix::WriteFileHeader (std::ostream &os)
+{
+  os.write (SNAPSHOT_MAGIC, sizeof (SNAPSHOT_MAGIC));
+}
+
+void
+LtePathlossMatrix::WriteSnapshot (std::ostream &os, Time time) const
+{
+  NS_LOG_FUNCTION (this << time);
+  SnapshotHeader header;
+  header.time = time.GetSeconds ();
+  header.nCells = m_nCells;
+  header.nImsis = m_nImsis;
+  NS_ABORT_MSG_IF (header.nImsis != m_nImsis, "too many IMSIs for a snapshot");
+  os.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  for (uint16_t cell = 0; cell < m_nCells; ++cell)
+    {
+      os.write (reinterpret_cast<const char *> (&m_values[cell * m_imsiCapacity]), m_nImsis * sizeof (double));
+    }
+}
+
+bool
+LtePathlossMatrix::ReadFileHeader (std::istream &is)
+{
+  char magic[sizeof (SNAPSHOT_MAGIC)];
+  is.read (magic, sizeof (magic));
+  return is.good () && std::memcmp (magic, SNAPSHOT_MAGIC, sizeof (magic)) == 0;
+}
+
+bool
+LtePathlossMatrix::ReadSnapshot (std::istream &is, Time &time)
+{
+  NS_LOG_FUNCTION (this);
+  SnapshotHeader header;
+  is.read (reinterpret_cast<char *> (&header), sizeof (header));
+  if (is.gcount () == 0)
+    {
+      return false;
+    }
+  NS_ABORT_MSG_IF (!is.good () || header.nCells > std::numeric_limits<uint16_t>::max (),
+                   "truncated or corrupted pathloss snapshot");
+  m_nCells = header.nCells;
+  m_nImsis = header.nImsis;
+  m_imsiCapacity = header.nImsis;
+  m_values.resize (m_nCells * m_imsiCapacity);
+  if (!m_values.empty ())
+    {
+      is.read (reinterpret_cast<char *> (&m_values[0]), m_values.size () * sizeof (double));
+      NS_ABORT_MSG_IF (!is.good (), "truncated pathloss snapshot");
+    }
+  time = Seconds (header.time);
+  return true;
+}
+
+void
+LtePathlossMatrix::Load (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::ifstream is (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_ABORT_MSG_IF (!is.good (), "Cannot open pathloss snapshot file " << fileName);
+  NS_ABORT_MSG_IF (!ReadFileHeader (is), fileName << " is not a pathloss snapshot file");
+  Time time;
+  uint32_t snapshots = 0;
+  while (ReadSnapshot (is, time))
+    {
+      ++snapshots;
+    }
+  NS_ABORT_MSG_IF (snapshots == 0, "No snapshot in " << fileName);
+  NS_LOG_LOGIC ("loaded the snapshot at " << time << " of " << fileName);
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_PATHLOSS_MATRIX_H
+#define LTE_PATHLOSS_MATRIX_H
+
+#include <ns3/nstime.h>
+#include <ns3/assert.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief A dense matrix of the pathloss between each cell and each UE
+ *
+ * The matrix has one row per cell ID and one column per IMSI, both
+ * starting at 1, and grows to the largest cell ID and IMSI which are
+ * set. The pathloss of the pairs which were never set is infinite.
+ *
+ * The matrix can be saved to a binary stream as a sequence of
+ * snapshots. A snapshot file starts with the 8 characters "NS3PLM01",
+ * and each snapshot consists of its time in seconds as a double, the
+ * number of cells and of IMSIs as 32-bit unsigned integers, and the
+ * pathloss values in dB as doubles, cell by cell, NaN standing for the
+ * pairs which were never set. All the numbers are in the byte order of
+ * the host.
+ */
+class LtePathlossMatrix
+{
+public:
+  LtePathlossMatrix ();
+
+  /**
+   * Set the pathloss between a cell and a UE
+   * \param cellId the cell ID, starting at 1
+   * \param imsi the IMSI of the UE, starting at 1
+   * \param lossDb the pathloss [dB]
+   */
+  void Set (uint16_t cellId, uint64_t imsi, double lossDb)
+  {
+    NS_ASSERT (cellId > 0 && imsi > 0);
+    if (cellId > m_nCells || imsi > m_nImsis)
+      {
+        Resize (cellId, imsi);
+      }
+    m_values[(cellId - 1) * m_imsiCapacity + (imsi - 1)] = lossDb;
+  }
+
+  /**
+   * \param cellId the cell ID
+   * \param imsi the IMSI of the UE
+   * \return the pathloss between the cell and the UE [dB], or infinity
+   * if it was never set
+   */
+  double Get (uint16_t cellId, uint64_t imsi) const;
+
+  /**
+   * \param cellId the cell ID
+   * \param imsi the IMSI of the UE
+   * \return true if the pathloss between the cell and the UE was set
+   */
+  bool IsSet (uint16_t cellId, uint64_t imsi) const;
+
+  /**
+   * \return the largest cell ID of the matrix
+   */
+  uint16_t GetNCells (void) const;
+  /**
+   * \return the largest IMSI of the matrix
+   */
+  uint64_t GetNImsis (void) const;
+
+  /**
+   * Write the header of a snapshot file
+   * \param os the stream to write
+   */
+  static void WriteFileHeader (std::ostream &os);
+  /**
+   * Append a snapshot of the matrix to a snapshot file
+   * \param os the stream to write
+   * \param time the time of the snapshot
+   */
+  void WriteSnapshot (std::ostream &os, Time time) const;
+  /**
+   * Read the header of a snapshot file
+   * \param is the stream to read
+   * \return true if the stream starts with the header of a snapshot file
+   */
+  static bool ReadFileHeader (std::istream &is);
+  /**
+   * Replace the matrix with the next snapshot of a snapshot file
+   * \param is the stream to read
+   * \param time the time of the snapshot
+   * \return false if there is no more snapshot to read
+   */
+  bool ReadSnapshot (std::istream &is, Time &time);
+  /**
+   * Replace the matrix with the last snapshot of a snapshot file
+   * \param fileName the name of the file
+   */
+  void Load (std::string fileName);
+
+private:
+  /**
+   * Grow the matrix
+   * \param nCells the minimum number of cells
+   * \param nImsis the minimum number of IMSIs
+   */
+  void Resize (uint16_t nCells, uint64_t nImsis);
+
+  uint16_t m_nCells;            //!< the number of cells
+  uint64_t m_nImsis;            //!< the number of IMSIs
+  uint64_t m_imsiCapacity;      //!< the length of the rows, at least m_nImsis
+  std::vector<double> m_values; //!< the values, cell by cell; NaN if not set
+};
+
+} // namespace ns3
+
+#endif /* LTE_PATHLOSS_MATRIX_H */
@@ -23,6 +23,7 @@
 #include <ns3/object-factory.h>
 #include <ns3/log.h>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include "ns3/spectrum-error-model.h"
 #include "lte-phy.h"
@@ -218,26 +219,16 @@ LtePhy::SetControlMessages (Ptr<LteControlMessage> m)
   m_controlMessagesQueue.at (m_controlMessagesQueue.size () - 1).push_back (m);
 }
 
-std::list<Ptr<LteControlMessage> >
+std::vector<Ptr<LteControlMessage> >
 LtePhy::GetControlMessages (void)
 {
   NS_LOG_FUNCTION (this);
-  if (m_controlMessagesQueue.at (0).size () > 0)
-    {
-      std::list<Ptr<LteControlMessage> > ret = m_controlMessagesQueue.at (0);
-      m_controlMessagesQueue.erase (m_controlMessagesQueue.begin ());
-      std::list<Ptr<LteControlMessage> > newlist;
-      m_controlMessagesQueue.push_back (newlist);
-      return (ret);
-    }
-  else
-    {
-      m_controlMessagesQueue.erase (m_controlMessagesQueue.begin ());
-      std::list<Ptr<LteControlMessage> > newlist;
-      m_controlMessagesQueue.push_back (newlist);
-      std::list<Ptr<LteControlMessage> > emptylist;
-      return (emptylist);
-    }
+  // the messages are moved out of the queue, whose emptied front goes to
+  // the back for the messages of the next subframes
+  std::vector<Ptr<LteControlMessage> > ret;
+  ret.swap (m_controlMessagesQueue.at (0));
+  std::rotate (m_controlMessagesQueue.begin (), m_controlMessagesQueue.begin () + 1, m_controlMessagesQueue.end ());
+  return ret;
 }
 
 
@@ -173,7 +173,7 @@ public:
   /**
   * \returns the list of control messages to be sent
   */
-  std::list<Ptr<LteControlMessage> > GetControlMessages (void);
+  std::vector<Ptr<LteControlMessage> > GetControlMessages (void);
 
 
   /** 
@@ -272,7 +272,7 @@ protected:
   /// A queue of packet bursts to be sent.
   std::vector< Ptr<PacketBurst> > m_packetBurstQueue;
   /// A queue of control messages to be sent.
-  std::vector< std::list<Ptr<LteControlMessage> > > m_controlMessagesQueue;
+  std::vector< std::vector<Ptr<LteControlMessage> > > m_controlMessagesQueue;
   /**
    * Delay between MAC and channel layer in terms of TTIs. It is the delay that
    * occurs between a scheduling decision in the MAC and the actual start of
@@ -0,0 +1,234 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include "ns3/lte-rlc-fast.h"
+#include "ns3/lte-rlc-tag.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteRlcFast");
+
+NS_OBJECT_ENSURE_REGISTERED (LteRlcFast);
+
+LteRlcFast::LteRlcFast ()
+  : m_maxTxBufferSize (10 * 1024),
+    m_txBufferSize (0),
+    m_txHeadSentBytes (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteRlcFast::~LteRlcFast ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+LteRlcFast::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteRlcFast")
+    .SetParent<LteRlc> ()
+    .SetGroupName("Lte")
+    .AddConstructor<LteRlcFast> ()
+    .AddAttribute ("MaxTxBufferSize",
+                   "Maximum Size of the Transmission Buffer (in Bytes)",
+                   UintegerValue (10 * 1024),
+                   MakeUintegerAccessor (&LteRlcFast::m_maxTxBufferSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+  return tid;
+}
+
+void
+LteRlcFast::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_rbsTimer.Cancel ();
+  m_txBuffer.clear ();
+
+  LteRlc::DoDispose ();
+}
+
+/**
+ * RLC SAP
+ */
+
+void
+LteRlcFast::DoTransmitPdcpPdu (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
+
+  if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
+    {
+      // the sender timestamp, for the delay measured by the receiver
+      RlcTag timeTag (Simulator::Now ());
+      p->AddPacketTag (timeTag);
+
+      TxSdu sdu;
+      sdu.packet = p;
+      sdu.arrivalTime = Simulator::Now ();
+      m_txBuffer.push_back (sdu);
+      m_txBufferSize += p->GetSize ();
+      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size ());
+      NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
+    }
+  else
+    {
+      // Discard full RLC SDU
+      NS_LOG_LOGIC ("TxBuffer is full. RLC SDU discarded");
+      NS_LOG_LOGIC ("MaxTxBufferSize = " << m_maxTxBufferSize);
+      NS_LOG_LOGIC ("txBufferSize    = " << m_txBufferSize);
+      NS_LOG_LOGIC ("packet size     = " << p->GetSize ());
+    }
+
+  /** Report Buffer Status */
+  DoReportBufferStatus ();
+  m_rbsTimer.Cancel ();
+}
+
+
+/**
+ * MAC SAP
+ */
+
+void
+LteRlcFast::DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId)
+{
+  NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << bytes);
+
+  if (m_txBuffer.empty ())
+    {
+      NS_LOG_LOGIC ("No data pending");
+      return;
+    }
+
+  LteMacSapProvider::TransmitPduParameters params;
+  params.rnti = m_rnti;
+  params.lcid = m_lcid;
+  params.layer = layer;
+  params.harqProcessId = harqId;
+
+  // each SDU or segment carried by the PDU takes 2 bytes of header
+  uint32_t available = (bytes > 2) ? (bytes - 2) : 0;
+  bool sent = false;
+  while ((available > 0) && !m_txBuffer.empty ())
+    {
+      uint32_t left = m_txBuffer.front ().packet->GetSize () - m_txHeadSentBytes;
+      if (left > available)
+        {
+          // only a segment of the SDU fits, the SDU is sent with its last
+          // segment
+          NS_LOG_LOGIC ("Segment of " << available << " bytes, " << left - available << " bytes left");
+          m_txHeadSentBytes += available;
+          m_txBufferSize -= available;
+          break;
+        }
+      available -= left;
+      m_txBufferSize -= left;
+      m_txHeadSentBytes = 0;
+      params.pdu = m_txBuffer.front ().packet;
+      m_txBuffer.pop_front ();
+      NS_LOG_LOGIC ("SDU of " << params.pdu->GetSize () << " bytes sent");
+      m_txPdu (m_rnti, m_lcid, params.pdu->GetSize ());
+      m_macSapProvider->TransmitPdu (params);
+      sent = true;
+      available = (available > 2) ? (available - 2) : 0;
+    }
+
+  if (!sent)
+    {
+      // the TB must reach the receiver anyway, for its HARQ feedback
+      params.pdu = Create<Packet> ();
+      m_macSapProvider->TransmitPdu (params);
+    }
+
+  if (! m_txBuffer.empty ())
+    {
+      m_rbsTimer.Cancel ();
+      m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcFast::ExpireRbsTimer, this);
+    }
+}
+
+void
+LteRlcFast::DoNotifyHarqDeliveryFailure ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LteRlcFast::DoReceivePdu (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
+
+  if (p->GetSize () == 0)
+    {
+      // PDU carrying only segments of SDUs
+      return;
+    }
+
+  // Receiver timestamp
+  RlcTag rlcTag;
+  bool found = p->RemovePacketTag (rlcTag);
+  NS_ASSERT_MSG (found, "RlcTag is missing");
+  Time delay = Simulator::Now () - rlcTag.GetSenderTimestamp ();
+  m_rxPdu (m_rnti, m_lcid, p->GetSize (), delay.GetNanoSeconds ());
+
+  m_rlcSapUser->ReceivePdcpPdu (p);
+}
+
+
+void
+LteRlcFast::DoReportBufferStatus (void)
+{
+  Time holDelay (0);
+  uint32_t queueSize = 0;
+
+  if (! m_txBuffer.empty ())
+    {
+      holDelay = Simulator::Now () - m_txBuffer.front ().arrivalTime;
+      queueSize = m_txBufferSize + 2 * m_txBuffer.size (); // Data in tx queue + estimated headers size
+    }
+
+  LteMacSapProvider::ReportBufferStatusParameters r;
+  r.rnti = m_rnti;
+  r.lcid = m_lcid;
+  r.txQueueSize = queueSize;
+  r.txQueueHolDelay = holDelay.GetMilliSeconds ();
+  r.retxQueueSize = 0;
+  r.retxQueueHolDelay = 0;
+  r.statusPduSize = 0;
+
+  NS_LOG_LOGIC ("Send ReportBufferStatus = " << r.txQueueSize << ", " << r.txQueueHolDelay );
+  m_macSapProvider->ReportBufferStatus (r);
+}
+
+void
+LteRlcFast::ExpireRbsTimer (void)
+{
+  NS_LOG_LOGIC ("RBS Timer expires");
+
+  if (! m_txBuffer.empty ())
+    {
+      DoReportBufferStatus ();
+      m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcFast::ExpireRbsTimer, this);
+    }
+}
+
+} // namespace ns3
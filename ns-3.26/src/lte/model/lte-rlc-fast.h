@@ -0,0 +1,90 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_RLC_FAST_H
+#define LTE_RLC_FAST_H
+
+#include "ns3/lte-rlc.h"
+
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <deque>
+
+namespace ns3 {
+
+/**
+ * LTE RLC fast mode: simulation-specific mode for capacity studies,
+ * which abstracts the RLC UM protocol to reduce the work done for each
+ * packet.
+ *
+ * The RLC SDUs are passed to the MAC as they are, without RLC header,
+ * segmentation nor reassembly. A transmission opportunity takes the bytes
+ * of the SDUs at the head of the transmission buffer, less 2 bytes of RLC
+ * header for each SDU or segment it carries, as the buffer status
+ * reports of RLC UM estimate them. Each SDU whose last byte is taken is
+ * sent to the MAC as one PDU; the segments which do not end an SDU are
+ * only accounted for, and a transmission opportunity which does not end
+ * any SDU sends an empty PDU, so that the TB still reaches the receiver
+ * and gets its HARQ feedback. An SDU is thus lost only when the TB of
+ * its last segment is lost.
+ *
+ * The same traces as the other RLC modes are fired for the SDUs, so the
+ * RLC statistics are still available.
+ */
+class LteRlcFast : public LteRlc
+{
+public:
+  LteRlcFast ();
+  virtual ~LteRlcFast ();
+  static TypeId GetTypeId (void);
+  virtual void DoDispose ();
+
+  /**
+   * RLC SAP
+   */
+  virtual void DoTransmitPdcpPdu (Ptr<Packet> p);
+
+  /**
+   * MAC SAP
+   */
+  virtual void DoNotifyTxOpportunity (uint32_t bytes, uint8_t layer, uint8_t harqId);
+  virtual void DoNotifyHarqDeliveryFailure ();
+  virtual void DoReceivePdu (Ptr<Packet> p);
+
+private:
+  /// Send a buffer status report to the MAC
+  void DoReportBufferStatus ();
+  /// Expire the timer of the buffer status reports
+  void ExpireRbsTimer (void);
+
+  /// An SDU waiting in the transmission buffer
+  struct TxSdu
+  {
+    Ptr<Packet> packet; ///< the SDU
+    Time arrivalTime;   ///< the time the SDU entered the buffer
+  };
+
+  uint32_t m_maxTxBufferSize;     ///< the maximum size of the transmission buffer
+  uint32_t m_txBufferSize;        ///< the bytes of the transmission buffer not sent yet
+  std::deque<TxSdu> m_txBuffer;   ///< the transmission buffer
+  uint32_t m_txHeadSentBytes;     ///< the bytes of the first SDU of the buffer already sent
+  EventId m_rbsTimer;             ///< the timer of the buffer status reports
+};
+
+
+} // namespace ns3
+
+#endif // LTE_RLC_FAST_H
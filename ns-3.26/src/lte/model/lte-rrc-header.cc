@@ -128,6 +128,10 @@ RrcAsn1Header::SerializeDrbToAddModList (std::list<LteRrcSap::DrbToAddMod> drbTo
           SerializeEnum (32,0);  // t-Reordering
           break;
 
+        case LteRrcSap::RlcConfig::FAST:
+          NS_FATAL_ERROR ("RLC fast mode has no ASN.1 encoding, it requires the ideal RRC protocol");
+          break;
+
         case LteRrcSap::RlcConfig::AM:
         default:
           // Serialize rlc-Config choice
@@ -96,7 +96,8 @@ public:
       AM,
       UM_BI_DIRECTIONAL,
       UM_UNI_DIRECTIONAL_UL,
-      UM_UNI_DIRECTIONAL_DL
+      UM_UNI_DIRECTIONAL_DL,
+      FAST ///< simulation-specific RLC fast mode, see LteRlcFast
     } choice;
   };
 
@@ -24,6 +24,7 @@
 #include <ns3/object-factory.h>
 #include <ns3/log.h>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include <ns3/trace-source-accessor.h>
 #include <ns3/antenna-model.h>
@@ -136,6 +137,7 @@ LteSpectrumPhy::~LteSpectrumPhy ()
   NS_LOG_FUNCTION (this);
   m_expectedTbs.clear ();
   m_txModeGain.clear ();
+  m_tbStatsCache.clear ();
 }
 
 void LteSpectrumPhy::DoDispose ()
@@ -150,7 +152,7 @@ void LteSpectrumPhy::DoDispose ()
   m_interferenceCtrl = 0;
   m_ltePhyRxDataEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyRxDataEndOkCallback    = MakeNullCallback< void, Ptr<Packet> >  ();
-  m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, std::list<Ptr<LteControlMessage> > > ();
+  m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, const std::vector<Ptr<LteControlMessage> > &> ();
   m_ltePhyRxCtrlEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyDlHarqFeedbackCallback = MakeNullCallback< void, DlInfoListElement_s > ();
   m_ltePhyUlHarqFeedbackCallback = MakeNullCallback< void, UlInfoListElement_s > ();
@@ -420,7 +422,7 @@ LteSpectrumPhy::SetHarqPhyModule (Ptr<LteHarqPhy> harq)
 
 
 bool
-LteSpectrumPhy::StartTxDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<LteControlMessage> > ctrlMsgList, Time duration)
+LteSpectrumPhy::StartTxDataFrame (Ptr<PacketBurst> pb, const std::vector<Ptr<LteControlMessage> > &ctrlMsgList, Time duration)
 {
   NS_LOG_FUNCTION (this << pb);
   NS_LOG_LOGIC (this << " state: " << m_state);
@@ -479,7 +481,7 @@ LteSpectrumPhy::StartTxDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<LteControlM
 }
 
 bool
-LteSpectrumPhy::StartTxDlCtrlFrame (std::list<Ptr<LteControlMessage> > ctrlMsgList, bool pss)
+LteSpectrumPhy::StartTxDlCtrlFrame (const std::vector<Ptr<LteControlMessage> > &ctrlMsgList, bool pss)
 {
   NS_LOG_FUNCTION (this << " PSS " << (uint16_t)pss);
   NS_LOG_LOGIC (this << " state: " << m_state);
@@ -928,6 +930,18 @@ LteSpectrumPhy::AddExpectedTb (uint16_t  rnti, uint8_t ndi, uint16_t size, uint8
 }
 
 
+/**
+ * \param a a SINR
+ * \param b another SINR
+ * \return true if the SINRs have the same values
+ */
+static bool
+IsSameSinr (const SpectrumValue& a, const SpectrumValue& b)
+{
+  return ((a.ConstValuesEnd () - a.ConstValuesBegin ()) == (b.ConstValuesEnd () - b.ConstValuesBegin ()))
+         && std::equal (a.ConstValuesBegin (), a.ConstValuesEnd (), b.ConstValuesBegin ());
+}
+
 void
 LteSpectrumPhy::EndRxData ()
 {
@@ -947,6 +961,14 @@ LteSpectrumPhy::EndRxData ()
   NS_LOG_DEBUG (this << " txMode " << (uint16_t)m_transmissionMode << " gain " << m_txModeGain.at (m_transmissionMode));
   NS_ASSERT (m_transmissionMode < m_txModeGain.size ());
   m_sinrPerceived *= m_txModeGain.at (m_transmissionMode);
+
+  if ((m_dataErrorModelEnabled)&&(m_rxPacketBurstList.size ()>0)
+      && !IsSameSinr (m_sinrPerceived, m_tbStatsCacheSinr))
+    {
+      // the decoding stats computed with a different SINR cannot be reused
+      m_tbStatsCache.clear ();
+      m_tbStatsCacheSinr = m_sinrPerceived;
+    }
   
   while (itTb!=m_expectedTbs.end ())
     {
@@ -967,7 +989,26 @@ LteSpectrumPhy::EndRxData ()
                   harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl ((*itTb).first.m_rnti, ulHarqId);
                 }
             }
-          TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*itTb).second.rbBitmap, (*itTb).second.size, (*itTb).second.mcs, harqInfoList);
+          TbStats_t tbStats;
+          std::map<TbId_t, TbStatsCacheEntry>::const_iterator itCache = m_tbStatsCache.find ((*itTb).first);
+          if ((harqInfoList.size () == 0) && (itCache != m_tbStatsCache.end ())
+              && ((*itCache).second.size == (*itTb).second.size) && ((*itCache).second.mcs == (*itTb).second.mcs)
+              && ((*itCache).second.rbBitmap == (*itTb).second.rbBitmap))
+            {
+              tbStats = (*itCache).second.tbStats;
+            }
+          else
+            {
+              tbStats = LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*itTb).second.rbBitmap, (*itTb).second.size, (*itTb).second.mcs, harqInfoList);
+              if (harqInfoList.size () == 0)
+                {
+                  TbStatsCacheEntry& entry = m_tbStatsCache[(*itTb).first];
+                  entry.rbBitmap = (*itTb).second.rbBitmap;
+                  entry.size = (*itTb).second.size;
+                  entry.mcs = (*itTb).second.mcs;
+                  entry.tbStats = tbStats;
+                }
+            }
           (*itTb).second.mi = tbStats.mi;
           (*itTb).second.corrupt = m_random->GetValue () > tbStats.tbler ? false : true;
           NS_LOG_DEBUG (this << "RNTI " << (*itTb).first.m_rnti << " size " << (*itTb).second.size << " mcs " << (uint32_t)(*itTb).second.mcs << " bitmap " << (*itTb).second.rbBitmap.size () << " layer " << (uint16_t)(*itTb).first.m_layer << " TBLER " << tbStats.tbler << " corrupted " << (*itTb).second.corrupt);
@@ -1116,7 +1157,7 @@ LteSpectrumPhy::EndRxData ()
     {
       if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
         {
-          m_ltePhyRxCtrlEndOkCallback (m_rxControlMessageList);
+          DeliverControlMessages ();
         }
     }
   ChangeState (IDLE);
@@ -1126,6 +1167,18 @@ LteSpectrumPhy::EndRxData ()
 }
 
 
+void
+LteSpectrumPhy::DeliverControlMessages (void)
+{
+  NS_LOG_FUNCTION (this << m_rxControlMessageList.size ());
+  // the PHY may reset this one while it handles the messages; the vectors
+  // are swapped, rather than copied, to keep their storage
+  m_deliveredControlMessageList.swap (m_rxControlMessageList);
+  m_ltePhyRxCtrlEndOkCallback (m_deliveredControlMessageList);
+  m_deliveredControlMessageList.clear ();
+}
+
+
 void
 LteSpectrumPhy::EndRxDlCtrl ()
 {
@@ -1159,7 +1212,7 @@ LteSpectrumPhy::EndRxDlCtrl ()
       if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
         {
           NS_LOG_DEBUG (this << " PCFICH-PDCCH Rxed OK");
-          m_ltePhyRxCtrlEndOkCallback (m_rxControlMessageList);
+          DeliverControlMessages ();
         }
     }
   else
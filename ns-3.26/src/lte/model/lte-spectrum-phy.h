@@ -41,6 +41,7 @@
 #include <ns3/ff-mac-common.h>
 #include <ns3/lte-harq-phy.h>
 #include <ns3/lte-common.h>
+#include <ns3/lte-mi-error-model.h>
 
 namespace ns3 {
 
@@ -112,7 +113,7 @@ typedef Callback< void, Ptr<Packet> > LtePhyRxDataEndOkCallback;
 *
 * @param packet the received Packet
 */
-typedef Callback< void, std::list<Ptr<LteControlMessage> > > LtePhyRxCtrlEndOkCallback;
+typedef Callback< void, const std::vector<Ptr<LteControlMessage> > &> LtePhyRxCtrlEndOkCallback;
 
 /**
 * This method is used by the LteSpectrumPhy to notify the PHY that a
@@ -222,7 +223,7 @@ public:
   * @return true if an error occurred and the transmission was not
   * started, false otherwise.
   */
-  bool StartTxDataFrame (Ptr<PacketBurst> pb, std::list<Ptr<LteControlMessage> > ctrlMsgList, Time duration);
+  bool StartTxDataFrame (Ptr<PacketBurst> pb, const std::vector<Ptr<LteControlMessage> > &ctrlMsgList, Time duration);
   
   /**
   * Start a transmission of control frame in DL
@@ -234,7 +235,7 @@ public:
   * @return true if an error occurred and the transmission was not
   * started, false otherwise.
   */
-  bool StartTxDlCtrlFrame (std::list<Ptr<LteControlMessage> > ctrlMsgList, bool pss);
+  bool StartTxDlCtrlFrame (const std::vector<Ptr<LteControlMessage> > &ctrlMsgList, bool pss);
   
   
   /**
@@ -427,6 +428,8 @@ private:
   void EndRxData ();
   void EndRxDlCtrl ();
   void EndRxUlSrs ();
+  /// Pass the received control messages to the PHY
+  void DeliverControlMessages (void);
   
   void SetTxModeGain (uint8_t txMode, double gain);
   
@@ -442,8 +445,9 @@ private:
   Ptr<PacketBurst> m_txPacketBurst;
   std::list<Ptr<PacketBurst> > m_rxPacketBurstList;
   
-  std::list<Ptr<LteControlMessage> > m_txControlMessageList;
-  std::list<Ptr<LteControlMessage> > m_rxControlMessageList;
+  std::vector<Ptr<LteControlMessage> > m_txControlMessageList;
+  std::vector<Ptr<LteControlMessage> > m_rxControlMessageList;
+  std::vector<Ptr<LteControlMessage> > m_deliveredControlMessageList; ///< the messages being passed to the PHY
   
   
   State m_state;
@@ -471,6 +475,22 @@ private:
   expectedTbs_t m_expectedTbs;
   SpectrumValue m_sinrPerceived;
 
+  /**
+   * The decoding stats of a TB without HARQ history, reused for an
+   * identical TB received with the same SINR (e.g., by a static UE)
+   */
+  struct TbStatsCacheEntry
+  {
+    std::vector<int> rbBitmap; ///< the RBs of the TB
+    uint16_t size;             ///< the size of the TB
+    uint8_t mcs;               ///< the MCS of the TB
+    TbStats_t tbStats;         ///< the decoding stats of the TB
+  };
+  /// the decoding stats of the TBs received with m_tbStatsCacheSinr
+  std::map<TbId_t, TbStatsCacheEntry> m_tbStatsCache;
+  /// the SINR of the TBs in m_tbStatsCache
+  SpectrumValue m_tbStatsCacheSinr;
+
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_random;
   bool m_dataErrorModelEnabled; // when true (default) the phy error model is enabled
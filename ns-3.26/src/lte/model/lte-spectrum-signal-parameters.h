@@ -87,7 +87,7 @@ struct LteSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
   */
   Ptr<PacketBurst> packetBurst;
   
-  std::list<Ptr<LteControlMessage> > ctrlMsgList;
+  std::vector<Ptr<LteControlMessage> > ctrlMsgList;
   
   uint16_t cellId;
 };
@@ -115,7 +115,7 @@ struct LteSpectrumSignalParametersDlCtrlFrame : public SpectrumSignalParameters
   LteSpectrumSignalParametersDlCtrlFrame (const LteSpectrumSignalParametersDlCtrlFrame& p);
 
 
-  std::list<Ptr<LteControlMessage> > ctrlMsgList;
+  std::vector<Ptr<LteControlMessage> > ctrlMsgList;
   
   uint16_t cellId;
   bool pss; // primary synchronization signal
@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/lte-static-pathloss-model.h>
+#include <ns3/log.h>
+#include <ns3/string.h>
+#include <ns3/double.h>
+#include <ns3/node.h>
+#include <ns3/mobility-model.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-net-device.h>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteStaticPathlossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (LteStaticPathlossModel);
+
+TypeId
+LteStaticPathlossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteStaticPathlossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<LteStaticPathlossModel> ()
+    .AddAttribute ("Filename",
+                   "The name of a file of pathloss snapshots, written by "
+                   "LteGlobalPathlossDatabase::EnableSnapshots, whose last "
+                   "snapshot is loaded.",
+                   StringValue (""),
+                   MakeStringAccessor (&LteStaticPathlossModel::SetFilename,
+                                       &LteStaticPathlossModel::GetFilename),
+                   MakeStringChecker ())
+    .AddAttribute ("DefaultLoss",
+                   "The loss in dB between the nodes whose pathloss is not "
+                   "known: pairs of cells and UEs which are not in the "
+                   "snapshot, or nodes which are neither eNBs nor UEs.",
+                   DoubleValue (std::numeric_limits<double>::infinity ()),
+                   MakeDoubleAccessor (&LteStaticPathlossModel::m_defaultLoss),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+LteStaticPathlossModel::LteStaticPathlossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteStaticPathlossModel::~LteStaticPathlossModel ()
+{
+}
+
+void
+LteStaticPathlossModel::SetPathlossMatrix (const LtePathlossMatrix &pathloss)
+{
+  NS_LOG_FUNCTION (this);
+  m_pathloss = pathloss;
+}
+
+void
+LteStaticPathlossModel::SetFilename (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_fileName = fileName;
+  if (!m_fileName.empty ())
+    {
+      m_pathloss.Load (m_fileName);
+    }
+}
+
+std::string
+LteStaticPathlossModel::GetFilename (void) const
+{
+  return m_fileName;
+}
+
+const LteStaticPathlossModel::Identity &
+LteStaticPathlossModel::GetIdentity (Ptr<MobilityModel> mobility) const
+{
+  std::map<Ptr<MobilityModel>, Identity>::const_iterator it = m_identities.find (mobility);
+  if (it != m_identities.end ())
+    {
+      return it->second;
+    }
+  Identity identity;
+  identity.cellId = 0;
+  identity.imsi = 0;
+  Ptr<Node> node = mobility->GetObject<Node> ();
+  for (uint32_t i = 0; node != 0 && i < node->GetNDevices (); ++i)
+    {
+      Ptr<NetDevice> device = node->GetDevice (i);
+      Ptr<LteEnbNetDevice> enbDevice = DynamicCast<LteEnbNetDevice> (device);
+      if (enbDevice != 0)
+        {
+          identity.cellId = enbDevice->GetCellId ();
+          break;
+        }
+      Ptr<LteUeNetDevice> ueDevice = DynamicCast<LteUeNetDevice> (device);
+      if (ueDevice != 0)
+        {
+          identity.imsi = ueDevice->GetImsi ();
+          break;
+        }
+    }
+  NS_LOG_LOGIC ("cell ID " << identity.cellId << " IMSI " << identity.imsi);
+  return m_identities.insert (std::make_pair (mobility, identity)).first->second;
+}
+
+double
+LteStaticPathlossModel::DoCalcRxPower (double txPowerDbm,
+                                       Ptr<MobilityModel> a,
+                                       Ptr<MobilityModel> b) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << a << b);
+  const Identity &ia = GetIdentity (a);
+  const Identity &ib = GetIdentity (b);
+  double lossDb = m_defaultLoss;
+  if (ia.cellId != 0 && ib.imsi != 0 && m_pathloss.IsSet (ia.cellId, ib.imsi))
+    {
+      lossDb = m_pathloss.Get (ia.cellId, ib.imsi);
+    }
+  else if (ib.cellId != 0 && ia.imsi != 0 && m_pathloss.IsSet (ib.cellId, ia.imsi))
+    {
+      lossDb = m_pathloss.Get (ib.cellId, ia.imsi);
+    }
+  NS_LOG_LOGIC ("loss " << lossDb << " dB");
+  return txPowerDbm - lossDb;
+}
+
+int64_t
+LteStaticPathlossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+} // namespace ns3
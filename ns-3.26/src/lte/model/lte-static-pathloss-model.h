@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_STATIC_PATHLOSS_MODEL_H
+#define LTE_STATIC_PATHLOSS_MODEL_H
+
+#include <ns3/propagation-loss-model.h>
+#include <ns3/lte-pathloss-matrix.h>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief A propagation loss model replaying a precomputed pathloss
+ * between each cell and each UE
+ *
+ * The pathloss is read from an LtePathlossMatrix, which is either set
+ * directly or loaded from the last snapshot of a file written by
+ * LteGlobalPathlossDatabase::EnableSnapshots, so that repeated runs of
+ * an identical deployment skip the computation of the propagation. The
+ * nodes are identified by the cell ID of their LteEnbNetDevice or the
+ * IMSI of their LteUeNetDevice, in both directions.
+ *
+ * The pathloss recorded by the PathLoss trace of the spectrum channels
+ * includes the gains of the antennas: the deployment replaying it
+ * should use isotropic antennas, not to count them twice.
+ */
+class LteStaticPathlossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LteStaticPathlossModel ();
+  virtual ~LteStaticPathlossModel ();
+
+  /**
+   * \param pathloss the pathloss between each cell and each UE
+   */
+  void SetPathlossMatrix (const LtePathlossMatrix &pathloss);
+
+  /**
+   * Load the last snapshot of a snapshot file
+   * \param fileName the name of the file
+   */
+  void SetFilename (std::string fileName);
+  /**
+   * \return the name of the snapshot file, if any
+   */
+  std::string GetFilename (void) const;
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  LteStaticPathlossModel (const LteStaticPathlossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  LteStaticPathlossModel & operator = (const LteStaticPathlossModel &);
+
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /// The LTE identity of a node
+  struct Identity
+  {
+    uint16_t cellId; //!< the cell ID if the node is an eNB, else 0
+    uint64_t imsi;   //!< the IMSI if the node is a UE, else 0
+  };
+
+  /**
+   * \param mobility the mobility model of a node
+   * \return the LTE identity of the node
+   */
+  const Identity & GetIdentity (Ptr<MobilityModel> mobility) const;
+
+  LtePathlossMatrix m_pathloss; //!< the pathloss between each cell and each UE
+  std::string m_fileName;       //!< the name of the snapshot file
+  double m_defaultLoss;         //!< the loss of the pairs not in the matrix [dB]
+  /// The identities of the nodes already seen
+  mutable std::map<Ptr<MobilityModel>, Identity> m_identities;
+};
+
+} // namespace ns3
+
+#endif /* LTE_STATIC_PATHLOSS_MODEL_H */
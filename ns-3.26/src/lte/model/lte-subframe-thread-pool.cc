@@ -0,0 +1,175 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-subframe-thread-pool.h"
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteSubframeThreadPool");
+
+LteSubframeThreadPool::LteSubframeThreadPool (uint32_t nThreads)
+  : m_nThreads (std::max (nThreads, (uint32_t) 1))
+{
+  NS_LOG_FUNCTION (this << nThreads);
+#ifdef HAVE_PTHREAD_H
+  m_next = 0;
+  m_busyWorkers = 0;
+  m_stop = false;
+#endif /* HAVE_PTHREAD_H */
+}
+
+LteSubframeThreadPool::~LteSubframeThreadPool ()
+{
+  NS_LOG_FUNCTION (this);
+#ifdef HAVE_PTHREAD_H
+  m_stop = true;
+  for (uint32_t i = 0; i < m_workers.size (); ++i)
+    {
+      m_start[i]->SetCondition (true);
+      m_start[i]->Signal ();
+      m_workers[i]->Join ();
+      delete m_start[i];
+    }
+#endif /* HAVE_PTHREAD_H */
+}
+
+uint32_t
+LteSubframeThreadPool::GetNThreads (void) const
+{
+  return m_nThreads;
+}
+
+void
+LteSubframeThreadPool::Add (Callback<void> parallel, Callback<void> serial)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_tasks.empty ())
+    {
+      Simulator::ScheduleNow (&LteSubframeThreadPool::Run, Ptr<LteSubframeThreadPool> (this));
+    }
+  Task task;
+  task.parallel = parallel;
+  task.serial = serial;
+  task.context = Simulator::GetContext ();
+  m_tasks.push_back (task);
+}
+
+void
+LteSubframeThreadPool::Run (void)
+{
+  NS_LOG_FUNCTION (this << m_tasks.size ());
+  m_batch.swap (m_tasks);
+#ifdef HAVE_PTHREAD_H
+  uint32_t nWorkers = std::min (m_nThreads, (uint32_t) m_batch.size ()) - 1;
+  if (nWorkers > 0)
+    {
+      while (m_workers.size () < m_nThreads - 1)
+        {
+          m_start.push_back (new SystemCondition ());
+          m_workers.push_back (Create<SystemThread> (MakeBoundCallback (&LteSubframeThreadPool::DoWork,
+                                                                        this, (uint32_t) m_workers.size ())));
+          m_workers.back ()->Start ();
+        }
+      // the workers are idle, waiting for their start condition
+      m_next = 0;
+      m_busyWorkers = m_workers.size ();
+      m_done.SetCondition (false);
+      for (uint32_t i = 0; i < m_workers.size (); ++i)
+        {
+          m_start[i]->SetCondition (true);
+          m_start[i]->Signal ();
+        }
+      RunParallel ();
+      WaitAndReset (&m_done);
+    }
+  else
+#endif /* HAVE_PTHREAD_H */
+    {
+      for (uint32_t i = 0; i < m_batch.size (); ++i)
+        {
+          m_batch[i].parallel ();
+        }
+    }
+  for (uint32_t i = 0; i < m_batch.size (); ++i)
+    {
+      Simulator::ScheduleWithContext (m_batch[i].context, Seconds (0),
+                                      &LteSubframeThreadPool::RunSerial, m_batch[i].serial);
+    }
+  m_batch.clear ();
+}
+
+void
+LteSubframeThreadPool::RunSerial (Callback<void> serial)
+{
+  serial ();
+}
+
+#ifdef HAVE_PTHREAD_H
+void
+LteSubframeThreadPool::RunParallel (void)
+{
+  while (true)
+    {
+      uint32_t i;
+      {
+        CriticalSection cs (m_mutex);
+        if (m_next >= m_batch.size ())
+          {
+            return;
+          }
+        i = m_next++;
+      }
+      m_batch[i].parallel ();
+    }
+}
+
+void
+LteSubframeThreadPool::WaitAndReset (SystemCondition *condition)
+{
+  // SystemCondition::Wait resets the condition before waiting, and would
+  // miss a Signal sent before it is called: TimedWait returns as soon as
+  // the condition is set, even if it was set before the call.
+  while (condition->TimedWait (1000000000))
+    {
+    }
+  condition->SetCondition (false);
+}
+
+void
+LteSubframeThreadPool::DoWork (LteSubframeThreadPool *pool, uint32_t index)
+{
+  while (true)
+    {
+      WaitAndReset (pool->m_start[index]);
+      if (pool->m_stop)
+        {
+          return;
+        }
+      pool->RunParallel ();
+      CriticalSection cs (pool->m_mutex);
+      if (--pool->m_busyWorkers == 0)
+        {
+          pool->m_done.SetCondition (true);
+          pool->m_done.Signal ();
+        }
+    }
+}
+#endif /* HAVE_PTHREAD_H */
+
+} // namespace ns3
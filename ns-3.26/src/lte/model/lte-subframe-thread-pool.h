@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_SUBFRAME_THREAD_POOL_H
+#define LTE_SUBFRAME_THREAD_POOL_H
+
+#include <ns3/core-config.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/callback.h>
+#include <vector>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#include <ns3/system-mutex.h>
+#include <ns3/system-condition.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Runs the work of the cells starting a subframe at the same
+ * time in parallel
+ *
+ * The work of a cell in a subframe is split in two parts. The parallel
+ * part must only touch the state of its cell, and is run by a pool of
+ * threads. Since the reference counts of ns-3 are not atomic, this
+ * includes them: the parallel part must not take or release a reference
+ * to an object shared with other cells, such as the channel or the
+ * propagation models. The serial part may interact with the rest of the
+ * simulation, and is run in the main thread once the parallel parts of
+ * all the cells are done. The serial parts are run in the order the cells were added,
+ * each as an event with the context of its cell, so that the simulation
+ * does not depend on the number of threads.
+ *
+ * The cells are added while the simulation processes the events of a
+ * timestamp; the pool runs them after the events of that timestamp which
+ * were scheduled before the first cell was added.
+ *
+ * Without threading support, the parallel parts are run sequentially.
+ */
+class LteSubframeThreadPool : public SimpleRefCount<LteSubframeThreadPool>
+{
+public:
+  /**
+   * \param nThreads the number of threads running the parallel parts,
+   *        including the main thread
+   */
+  LteSubframeThreadPool (uint32_t nThreads);
+  ~LteSubframeThreadPool ();
+
+  /**
+   * \return the number of threads running the parallel parts, including
+   *         the main thread
+   */
+  uint32_t GetNThreads (void) const;
+
+  /**
+   * Add the work of a cell in the current subframe
+   * \param parallel the part of the work which only touches the state of
+   *        the cell
+   * \param serial the part of the work run after the parallel parts of all
+   *        the cells
+   */
+  void Add (Callback<void> parallel, Callback<void> serial);
+
+private:
+  /// Defined and unimplemented to avoid misuse
+  LteSubframeThreadPool (const LteSubframeThreadPool &);
+  /**
+   * Defined and unimplemented to avoid misuse
+   * \returns the pool
+   */
+  LteSubframeThreadPool & operator = (const LteSubframeThreadPool &);
+
+  /// Run the work of the cells added at the current timestamp
+  void Run (void);
+  /**
+   * Run the serial part of the work of a cell
+   * \param serial the serial part
+   */
+  static void RunSerial (Callback<void> serial);
+
+  /// The work of a cell
+  struct Task
+  {
+    Callback<void> parallel; ///< the parallel part
+    Callback<void> serial;   ///< the serial part
+    uint32_t context;        ///< the context of the cell
+  };
+
+  uint32_t m_nThreads;        ///< the number of threads, including the main thread
+  std::vector<Task> m_tasks;  ///< the work added at the current timestamp
+  std::vector<Task> m_batch;  ///< the work being run
+
+#ifdef HAVE_PTHREAD_H
+  /// Run the parallel parts of the batch not taken yet
+  void RunParallel (void);
+  /**
+   * Wait until a condition is set, then reset it
+   * \param condition the condition
+   */
+  static void WaitAndReset (SystemCondition *condition);
+  /**
+   * The main loop of a worker thread
+   * \param pool the pool
+   * \param index the index of the worker
+   */
+  static void DoWork (LteSubframeThreadPool *pool, uint32_t index);
+
+  std::vector<Ptr<SystemThread> > m_workers; ///< the worker threads
+  std::vector<SystemCondition *> m_start;    ///< set when a batch starts, one per worker
+  SystemCondition m_done;                    ///< set when the workers are done
+  SystemMutex m_mutex;                       ///< protects the fields below
+  uint32_t m_next;                           ///< the next task to take in the batch
+  uint32_t m_busyWorkers;                    ///< the workers running the batch
+  bool m_stop;                               ///< whether the workers shall exit
+#endif /* HAVE_PTHREAD_H */
+};
+
+} // namespace ns3
+
+#endif /* LTE_SUBFRAME_THREAD_POOL_H */
@@ -34,6 +34,7 @@
 #include <ns3/lte-control-messages.h>
 #include <ns3/simulator.h>
 #include <ns3/lte-common.h>
+#include <algorithm>
 
 
 
@@ -153,6 +154,8 @@ public:
   virtual void ReceivePhyPdu (Ptr<Packet> p);
   virtual void SubframeIndication (uint32_t frameNo, uint32_t subframeNo);
   virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg);
+  virtual bool IsIdle ();
+  virtual void SkipSubframes (uint32_t frameNo, uint32_t subframeNo, uint32_t nSubframes);
 
 private:
   LteUeMac* m_mac;
@@ -182,6 +185,18 @@ UeMemberLteUePhySapUser::ReceiveLteControlMessage (Ptr<LteControlMessage> msg)
   m_mac->DoReceiveLteControlMessage (msg);
 }
 
+bool
+UeMemberLteUePhySapUser::IsIdle ()
+{
+  return m_mac->DoIsIdle ();
+}
+
+void
+UeMemberLteUePhySapUser::SkipSubframes (uint32_t frameNo, uint32_t subframeNo, uint32_t nSubframes)
+{
+  m_mac->DoSkipSubframes (frameNo, subframeNo, nSubframes);
+}
+
 
 
 
@@ -308,6 +323,7 @@ LteUeMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters
       m_ulBsrReceived.insert (std::pair<uint8_t, LteMacSapProvider::ReportBufferStatusParameters> (params.lcid, params));
     }
   m_freshUlBsr = true;
+  m_uePhySapProvider->ResumeSubframeIndications ();
 }
 
 
@@ -384,6 +400,8 @@ LteUeMac::SendRaPreamble (bool contention)
   // bypass the m_ulConfigured flag. This is reasonable, since In fact
   // the RACH preamble is sent on 6RB bandwidth so the uplink
   // bandwidth does not need to be configured. 
+  // refresh m_subframeNo if the PHY skipped the last subframes
+  m_uePhySapProvider->ResumeSubframeIndications ();
   NS_ASSERT (m_subframeNo > 0); // sanity check for subframe starting at 1
   m_raRnti = m_subframeNo - 1;
   m_uePhySapProvider->SendRachPreamble (m_raPreambleId, m_raRnti);
@@ -694,6 +712,7 @@ LteUeMac::DoReceiveLteControlMessage (Ptr<LteControlMessage> msg)
                             {
                               // resend BSR info for updating eNB peer MAC
                               m_freshUlBsr = true;
+                              m_uePhySapProvider->ResumeSubframeIndications ();
                             }
                         }
                       NS_LOG_LOGIC (this << "\t" << bytesPerActiveLc << "\t new queues " << (uint32_t)(*it).first << " statusQueue " << (*itBsr).second.statusPduSize << " retxQueue" << (*itBsr).second.retxQueueSize << " txQueue" <<  (*itBsr).second.txQueueSize);
@@ -787,6 +806,36 @@ LteUeMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
     }
 }
 
+bool
+LteUeMac::DoIsIdle ()
+{
+  if (m_freshUlBsr)
+    {
+      return false;
+    }
+  for (uint16_t i = 0; i < m_miUlHarqProcessesPacket.size (); i++)
+    {
+      if (m_miUlHarqProcessesPacket.at (i)->GetSize () > 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+LteUeMac::DoSkipSubframes (uint32_t frameNo, uint32_t subframeNo, uint32_t nSubframes)
+{
+  NS_LOG_FUNCTION (this << frameNo << subframeNo << nSubframes);
+  m_frameNo = frameNo;
+  m_subframeNo = subframeNo;
+  // the HARQ buffers are empty, only their timers keep running
+  for (uint16_t i = 0; i < m_miUlHarqProcessesPacketTimer.size (); i++)
+    {
+      m_miUlHarqProcessesPacketTimer.at (i) -= std::min<uint32_t> (m_miUlHarqProcessesPacketTimer.at (i), nSubframes);
+    }
+}
+
 int64_t
 LteUeMac::AssignStreams (int64_t stream)
 {
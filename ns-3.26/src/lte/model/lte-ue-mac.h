@@ -103,6 +103,18 @@ private:
   // forwarded from PHY SAP
   void DoReceivePhyPdu (Ptr<Packet> p);
   void DoReceiveLteControlMessage (Ptr<LteControlMessage> msg);
+  /**
+   * \return true if there is no buffer status report to send and no
+   * packet in the HARQ buffers
+   */
+  bool DoIsIdle ();
+  /**
+   * Account for the subframes skipped by the PHY while the MAC was idle
+   * \param frameNo frame number of the last skipped subframe
+   * \param subframeNo subframe number of the last skipped subframe
+   * \param nSubframes the number of skipped subframes
+   */
+  void DoSkipSubframes (uint32_t frameNo, uint32_t subframeNo, uint32_t nSubframes);
   
   // internal methods
   void RandomlySelectAndSendRaPreamble ();
@@ -60,6 +60,16 @@ public:
    */
   virtual void SendRachPreamble (uint32_t prachId, uint32_t raRnti) = 0;
 
+  /**
+   * \brief Resume the subframe indications, if the PHY stopped them
+   * while the MAC was idle
+   *
+   * To be called by the MAC before it relies on the current frame and
+   * subframe numbers, or when it has something to do at the next
+   * subframe indications.
+   */
+  virtual void ResumeSubframeIndications () = 0;
+
 };
 
 
@@ -95,6 +105,22 @@ public:
   */
   virtual void ReceiveLteControlMessage (Ptr<LteControlMessage> msg) = 0;
 
+  /**
+  * \brief Ask the MAC whether the PHY may stop the subframe indications
+  * \return true if the MAC has no pending buffer status report and no
+  * packet in its HARQ buffers
+  */
+  virtual bool IsIdle () = 0;
+
+  /**
+  * \brief Notify the MAC of the subframes which started while the PHY
+  * stopped the subframe indications
+  * \param frameNo frame number of the last skipped subframe
+  * \param subframeNo subframe number of the last skipped subframe
+  * \param nSubframes the number of skipped subframes
+  */
+  virtual void SkipSubframes (uint32_t frameNo, uint32_t subframeNo, uint32_t nSubframes) = 0;
+
 };
 
 
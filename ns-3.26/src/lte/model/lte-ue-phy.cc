@@ -80,6 +80,7 @@ public:
   virtual void SendMacPdu (Ptr<Packet> p);
   virtual void SendLteControlMessage (Ptr<LteControlMessage> msg);
   virtual void SendRachPreamble (uint32_t prachId, uint32_t raRnti);
+  virtual void ResumeSubframeIndications ();
 
 private:
   LteUePhy* m_phy;
@@ -108,6 +109,12 @@ UeMemberLteUePhySapProvider::SendRachPreamble (uint32_t prachId, uint32_t raRnti
   m_phy->DoSendRachPreamble (prachId, raRnti);
 }
 
+void
+UeMemberLteUePhySapProvider::ResumeSubframeIndications ()
+{
+  m_phy->DoResumeSubframeIndications ();
+}
+
 
 ////////////////////////////////////////
 // LteUePhy methods
@@ -153,7 +160,10 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_pssReceived (false),
     m_ueMeasurementsFilterPeriod (MilliSeconds (200)),
     m_ueMeasurementsFilterLast (MilliSeconds (0)),
-    m_rsrpSinrSampleCounter (0)
+    m_rsrpSinrSampleCounter (0),
+    m_subframesStopped (false),
+    m_nextFrameNo (0),
+    m_nextSubframeNo (0)
 {
   m_amc = CreateObject <LteAmc> ();
   m_powerControl = CreateObject <LteUePowerControl> ();
@@ -294,6 +304,15 @@ LteUePhy::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&LteUePhy::m_enableUplinkPowerControl),
                    MakeBooleanChecker ())
+    .AddAttribute ("SkipIdleSubframes",
+                   "If true, the UE stops its subframe indications while "
+                   "neither the PHY nor the MAC have anything to transmit, "
+                   "and resumes them at the next subframe boundary, with "
+                   "the frame and subframe numbers they would have had, "
+                   "once they have.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&LteUePhy::m_skipIdleSubframes),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -413,6 +432,7 @@ LteUePhy::DoSendMacPdu (Ptr<Packet> p)
   NS_LOG_FUNCTION (this);
 
   SetMacPdu (p);
+  DoResumeSubframeIndications ();
 }
 
 
@@ -657,6 +677,10 @@ void
 LteUePhy::ReportInterference (const SpectrumValue& interf)
 {
   NS_LOG_FUNCTION (this << interf);
+  if (m_subframesStopped)
+    {
+      SkipIdleSubframes ();
+    }
   m_rsInterferencePowerUpdated = true;
   m_rsInterferencePower = interf;
 }
@@ -674,6 +698,10 @@ void
 LteUePhy::ReportRsReceivedPower (const SpectrumValue& power)
 {
   NS_LOG_FUNCTION (this << power);
+  if (m_subframesStopped)
+    {
+      SkipIdleSubframes ();
+    }
   m_rsReceivedPowerUpdated = true;
   m_rsReceivedPower = power;
 
@@ -842,6 +870,7 @@ LteUePhy::DoSendLteControlMessage (Ptr<LteControlMessage> msg)
   NS_LOG_FUNCTION (this << msg);
 
   SetControlMessages (msg);
+  DoResumeSubframeIndications ();
 }
 
 void 
@@ -855,15 +884,16 @@ LteUePhy::DoSendRachPreamble (uint32_t raPreambleId, uint32_t raRnti)
   m_raPreambleId = raPreambleId;
   m_raRnti = raRnti;
   m_controlMessagesQueue.at (0).push_back (msg);
+  DoResumeSubframeIndications ();
 }
 
 
 void
-LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgList)
+LteUePhy::ReceiveLteControlMessageList (const std::vector<Ptr<LteControlMessage> > &msgList)
 {
   NS_LOG_FUNCTION (this);
 
-  std::list<Ptr<LteControlMessage> >::iterator it;
+  std::vector<Ptr<LteControlMessage> >::const_iterator it;
   for (it = msgList.begin (); it != msgList.end (); it++)
     {
       Ptr<LteControlMessage> msg = (*it);
@@ -1014,6 +1044,10 @@ void
 LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 {
   NS_LOG_FUNCTION (this << cellId << (*p));
+  if (m_subframesStopped)
+    {
+      SkipIdleSubframes ();
+    }
 
   double sum = 0.0;
   uint16_t nRB = 0;
@@ -1068,6 +1102,7 @@ void
 LteUePhy::QueueSubChannelsForTransmission (std::vector <int> rbMap)
 {
   m_subChannelsForTransmissionQueue.at (m_macChTtiDelay - 1) = rbMap;
+  DoResumeSubframeIndications ();
 }
 
 
@@ -1109,7 +1144,7 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
             }
         }
 
-      std::list<Ptr<LteControlMessage> > ctrlMsg = GetControlMessages ();
+      std::vector<Ptr<LteControlMessage> > ctrlMsg = GetControlMessages ();
       // send packets in queue
       NS_LOG_LOGIC (this << " UE - start slot for PUSCH + PUCCH - RNTI " << m_rnti << " CELLID " << m_cellId);
       // send the current burts of packets
@@ -1157,11 +1192,100 @@ LteUePhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
       subframeNo = 1;
     }
 
+  if (m_skipIdleSubframes && CanStopSubframeIndications ())
+    {
+      // wait for something to transmit, see DoResumeSubframeIndications
+      NS_LOG_LOGIC (this << " UE idle, stopping the subframe indications before frame " << frameNo << " subframe " << subframeNo);
+      m_subframesStopped = true;
+      m_nextSubframeTime = Simulator::Now () + Seconds (GetTti ());
+      m_nextFrameNo = frameNo;
+      m_nextSubframeNo = subframeNo;
+      return;
+    }
+
   // schedule next subframe indication
   Simulator::Schedule (Seconds (GetTti ()), &LteUePhy::SubframeIndication, this, frameNo, subframeNo);
 }
 
 
+bool
+LteUePhy::CanStopSubframeIndications ()
+{
+  if (m_srsConfigured)
+    {
+      return false;
+    }
+  for (uint8_t i = 0; i < m_macChTtiDelay; i++)
+    {
+      if ((m_packetBurstQueue.at (i)->GetSize () > 0)
+          || !m_controlMessagesQueue.at (i).empty ()
+          || !m_subChannelsForTransmissionQueue.at (i).empty ())
+        {
+          return false;
+        }
+    }
+  return m_uePhySapUser->IsIdle ();
+}
+
+
+void
+LteUePhy::SkipIdleSubframes ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_subframesStopped);
+  Time now = Simulator::Now ();
+  if (now < m_nextSubframeTime)
+    {
+      return;
+    }
+  // the subframes would have kept starting every TTI since the last one
+  int64_t tti = Seconds (GetTti ()).GetTimeStep ();
+  uint32_t nSubframes = (now - m_nextSubframeTime).GetTimeStep () / tti + 1;
+  uint32_t last = (m_nextFrameNo - 1) * 10 + (m_nextSubframeNo - 1) + nSubframes - 1;
+  uint32_t lastFrameNo = last / 10 + 1;
+  uint32_t lastSubframeNo = last % 10 + 1;
+  NS_LOG_LOGIC (this << " skipped " << nSubframes << " subframes until frame " << lastFrameNo << " subframe " << lastSubframeNo);
+
+  // what SubframeIndication does when there is nothing to transmit
+  m_rsReceivedPowerUpdated = false;
+  m_rsInterferencePowerUpdated = false;
+  m_pssReceived = false;
+  m_subframeNo = lastSubframeNo;
+  m_uePhySapUser->SkipSubframes (lastFrameNo, lastSubframeNo, nSubframes);
+
+  m_nextSubframeTime += TimeStep (nSubframes * tti);
+  m_nextFrameNo = (last + 1) / 10 + 1;
+  m_nextSubframeNo = (last + 1) % 10 + 1;
+}
+
+
+void
+LteUePhy::DoResumeSubframeIndications ()
+{
+  if (!m_subframesStopped)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  // like the subframe indications scheduled a subframe in advance, a
+  // subframe starting now is considered to be already indicated
+  SkipIdleSubframes ();
+  m_subframesStopped = false;
+  Time delay = m_nextSubframeTime - Simulator::Now ();
+  if (m_netDevice != 0 && m_netDevice->GetNode () != 0)
+    {
+      Simulator::ScheduleWithContext (m_netDevice->GetNode ()->GetId (), delay,
+                                      &LteUePhy::SubframeIndication, this,
+                                      m_nextFrameNo, m_nextSubframeNo);
+    }
+  else
+    {
+      Simulator::Schedule (delay, &LteUePhy::SubframeIndication, this,
+                           m_nextFrameNo, m_nextSubframeNo);
+    }
+}
+
+
 void
 LteUePhy::SendSrs ()
 {
@@ -1209,7 +1333,7 @@ LteUePhy::DoReset ()
     {
       Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
       m_packetBurstQueue.push_back (pb);
-      std::list<Ptr<LteControlMessage> > l;
+      std::vector<Ptr<LteControlMessage> > l;
       m_controlMessagesQueue.push_back (l);
     }
   std::vector <int> ulRb;
@@ -1336,6 +1460,7 @@ LteUePhy::DoSetSrsConfigurationIndex (uint16_t srcCi)
   // a guard time is needed for the case where the SRS periodicity is changed dynamically at run time
   // if we use a static one, we can have a 0ms guard time
   m_srsStartTime = Simulator::Now () + MilliSeconds (0);
+  DoResumeSubframeIndications ();
   NS_LOG_DEBUG (this << " UE SRS P " << m_srsPeriodicity << " RNTI " << m_rnti << " offset " << m_srsSubframeOffset << " cellId " << m_cellId << " CI " << srcCi);
 }
 
@@ -1427,6 +1552,7 @@ LteUePhy::ReceiveLteDlHarqFeedback (DlInfoListElement_s m)
   Ptr<DlHarqFeedbackLteControlMessage> msg = Create<DlHarqFeedbackLteControlMessage> ();
   msg->SetDlHarqFeedback (m);
   SetControlMessages (msg);
+  DoResumeSubframeIndications ();
 }
 
 void
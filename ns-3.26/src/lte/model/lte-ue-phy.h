@@ -196,7 +196,7 @@ public:
   virtual void ReportRsReceivedPower (const SpectrumValue& power);
 
   // callbacks for LteSpectrumPhy
-  virtual void ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> >);
+  virtual void ReceiveLteControlMessageList (const std::vector<Ptr<LteControlMessage> > &);
   virtual void ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p);
 
 
@@ -325,6 +325,19 @@ private:
   virtual void DoSendMacPdu (Ptr<Packet> p);
   virtual void DoSendLteControlMessage (Ptr<LteControlMessage> msg);
   virtual void DoSendRachPreamble (uint32_t prachId, uint32_t raRnti);
+  virtual void DoResumeSubframeIndications ();
+
+  /**
+   * \return true if neither the PHY nor the MAC have anything to do at
+   * the next subframes, so that the subframe indications can be stopped
+   */
+  bool CanStopSubframeIndications ();
+  /**
+   * Account for the subframes which started while the subframe
+   * indications were stopped, up to now included, as
+   * SubframeIndication would have
+   */
+  void SkipIdleSubframes ();
 
   /// A list of sub channels to use in TX.
   std::vector <int> m_subChannelsForTransmission;
@@ -473,6 +486,20 @@ private:
   Ptr<SpectrumValue> m_noisePsd; ///< Noise power spectral density for
                                  ///the configured bandwidth 
 
+  /**
+   * The `SkipIdleSubframes` attribute. If true, the subframe indications
+   * are stopped while the UE has nothing to transmit.
+   */
+  bool m_skipIdleSubframes;
+  /// True if the subframe indications are stopped.
+  bool m_subframesStopped;
+  /// While stopped, the start time of the next subframe not accounted for.
+  Time m_nextSubframeTime;
+  /// While stopped, the frame number of the next subframe.
+  uint32_t m_nextFrameNo;
+  /// While stopped, the subframe number of the next subframe.
+  uint32_t m_nextSubframeNo;
+
 }; // end of `class LteUePhy`
 
 
@@ -31,6 +31,7 @@
 #include <ns3/lte-rlc-tm.h>
 #include <ns3/lte-rlc-um.h>
 #include <ns3/lte-rlc-am.h>
+#include <ns3/lte-rlc-fast.h>
 #include <ns3/lte-pdcp.h>
 #include <ns3/lte-radio-bearer-info.h>
 
@@ -1229,6 +1230,10 @@ LteUeRrc::ApplyRadioResourceConfigDedicated (LteRrcSap::RadioResourceConfigDedic
                 case LteRrcSap::RlcConfig::UM_BI_DIRECTIONAL: 
                   rlcTypeId = LteRlcUm::GetTypeId ();
                   break;
+
+                case LteRrcSap::RlcConfig::FAST: 
+                  rlcTypeId = LteRlcFast::GetTypeId ();
+                  break;
           
                 default:
                   NS_FATAL_ERROR ("unsupported RLC configuration");
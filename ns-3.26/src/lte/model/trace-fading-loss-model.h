@@ -27,8 +27,10 @@
 #include <ns3/object.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <map>
+#include "ns3/sgi-hashmap.h"
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
+#include <ns3/fading-trace.h>
 
 namespace ns3 {
 
@@ -93,26 +95,36 @@ private:
   
   void LoadTrace ();
 
+  /// The fading state of a channel realization
+  struct ChannelRealization
+  {
+    ChannelRealizationId_t id; //!< the mobility models of the realization
+    Ptr<UniformRandomVariable> startVariable; //!< draws the window offsets
+    int windowOffset; //!< the offset of the current window [ms]
+  };
+
+  /// The sender and receiver mobility models of a realization
+  typedef std::pair<const MobilityModel *, const MobilityModel *> RealizationKey_t;
+
+  /// Hash function of the keys of the realizations
+  struct RealizationKeyHash
+  {
+    /**
+     * \param key the sender and receiver mobility models
+     * \return the hash of the key
+     */
+    size_t operator () (const RealizationKey_t &key) const;
+  };
+
+  /// the channel realizations, in creation order
+  mutable std::vector<ChannelRealization> m_realizations;
+  /// the indices in m_realizations, by sender and receiver mobility models
+  mutable sgi::hash_map<RealizationKey_t, uint32_t, RealizationKeyHash> m_realizationIndex;
 
-   
-  mutable std::map <ChannelRealizationId_t, int > m_windowOffsetsMap;
-  
-  mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap;
-  
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
-  /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
-   */
-  typedef std::vector<FadingTraceSample> FadingTrace;
-
-
-  
   std::string m_traceFile;
   
-  FadingTrace m_fadingTrace;
+  /// the fading trace, shared with the other models using the same file
+  Ptr<const FadingTrace> m_fadingTrace;
 
   
   Time m_traceLength;
@@ -0,0 +1,375 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef UE_TABLE_FF_MAC_SCHEDULER_H
+#define UE_TABLE_FF_MAC_SCHEDULER_H
+
+#include <ns3/lte-common.h>
+#include <ns3/ff-mac-csched-sap.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-ue.h>
+#include <ns3/lte-vendor-specific-parameters.h>
+#include <ns3/fatal-error.h>
+#include <vector>
+#include <map>
+
+namespace ns3 {
+
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Base class of the FF MAC schedulers keeping the state of their
+ * UEs in an FfMacSchedulerUeTable
+ *
+ * This class owns the records of the UEs and implements the part of the
+ * CSCHED and SCHED primitives which only maintains them: the configuration
+ * and release of the UEs and of their logical channels, the RLC buffer
+ * status reports, the DL and UL CQIs and the BSRs, together with the
+ * expiry of the CQIs and of the DL HARQ processes. The derived schedulers
+ * call these methods from their own primitives, and implement the
+ * scheduling of the subframes.
+ *
+ * The reports of the RNTIs without a record, i.e. of the UEs which were
+ * not configured by CschedUeConfigReq or were already released, are
+ * ignored.
+ *
+ * \tparam Ue the type of the records of the UEs, derived from FfMacSchedulerUe
+ */
+template <class Ue>
+class UeTableFfMacScheduler : public FfMacScheduler
+{
+public:
+  UeTableFfMacScheduler ()
+    : m_cqiTimersThreshold (0)
+  {
+  }
+
+  // inherited from Object
+  virtual void DoDispose (void)
+  {
+    m_ues.Clear ();
+    m_allocationMaps.clear ();
+    FfMacScheduler::DoDispose ();
+  }
+
+protected:
+  /**
+   * Create the record of a UE if needed, and set its transmission mode
+   * \param params the parameters of CschedUeConfigReq
+   * \return the record of the UE
+   */
+  Ue & ConfigureUe (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params)
+  {
+    Ue *ue = m_ues.Find (params.m_rnti);
+    if (ue == 0)
+      {
+        // generate the UE state, with its HARQ buffers
+        ue = &m_ues.Add (params.m_rnti);
+      }
+    ue->m_txMode = params.m_transmissionMode;
+    return *ue;
+  }
+
+  /**
+   * Forget the RLC buffer status of the released logical channels
+   * \param params the parameters of CschedLcReleaseReq
+   */
+  void ReleaseLcs (const struct FfMacCschedSapProvider::CschedLcReleaseReqParameters& params)
+  {
+    Ue *ue = m_ues.Find (params.m_rnti);
+    for (uint16_t i = 0; ue != 0 && i < params.m_logicalChannelIdentity.size (); i++)
+      {
+        ue->ReleaseLc (params.m_logicalChannelIdentity.at (i));
+      }
+  }
+
+  /**
+   * Remove the record of a UE
+   * \param params the parameters of CschedUeReleaseReq
+   */
+  void ReleaseUe (const struct FfMacCschedSapProvider::CschedUeReleaseReqParameters& params)
+  {
+    m_ues.Remove (params.m_rnti);
+  }
+
+  /**
+   * Store an RLC buffer status report
+   * \param params the parameters of SchedDlRlcBufferReq
+   * \return false if the RNTI is unknown
+   */
+  bool SetRlcBufferReq (const struct FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+  {
+    Ue *ue = m_ues.Find (params.m_rnti);
+    if (ue == 0)
+      {
+        return false;
+      }
+    ue->SetRlcBufferReq (params);
+    return true;
+  }
+
+  /**
+   * Store the DL CQIs, and restart their validity timers
+   * \param params the parameters of SchedDlCqiInfoReq
+   */
+  void UpdateDlCqi (const struct FfMacSchedSapProvider::SchedDlCqiInfoReqParameters& params)
+  {
+    for (unsigned int i = 0; i < params.m_cqiList.size (); i++)
+      {
+        Ue *ue = m_ues.Find (params.m_cqiList.at (i).m_rnti);
+        if (ue == 0)
+          {
+            continue;
+          }
+        if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::P10 )
+          {
+            // update the CQI value and refresh correspondent timer
+            ue->m_p10CqiRxed = true;
+            ue->m_p10Cqi = params.m_cqiList.at (i).m_wbCqi.at (0); // only codeword 0 at this stage (SISO)
+            ue->m_p10CqiTimer = m_cqiTimersThreshold;
+          }
+        else if ( params.m_cqiList.at (i).m_cqiType == CqiListElement_s::A30 )
+          {
+            // subband CQI reporting high layer configured
+            // update the CQI value and refresh correspondent timer
+            ue->m_a30CqiRxed = true;
+            ue->m_a30Cqi = params.m_cqiList.at (i).m_sbMeasResult;
+            ue->m_a30CqiTimer = m_cqiTimersThreshold;
+          }
+      }
+  }
+
+  /**
+   * Store the buffer sizes of the BSRs
+   * \param params the parameters of SchedUlMacCtrlInfoReq
+   */
+  void UpdateBsr (const struct FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters& params)
+  {
+    for (unsigned int i = 0; i < params.m_macCeList.size (); i++)
+      {
+        if ( params.m_macCeList.at (i).m_macCeType == MacCeListElement_s::BSR )
+          {
+            // buffer status report
+            // note that the schedulers do not differentiate the
+            // allocation according to which LCGs have more/less bytes
+            // to send.
+            // Hence the BSR of different LCGs are just summed up to get
+            // a total queue size that is used for allocation purposes.
+
+            uint32_t buffer = 0;
+            for (uint8_t lcg = 0; lcg < 4; ++lcg)
+              {
+                uint8_t bsrId = params.m_macCeList.at (i).m_macCeValue.m_bufferStatus.at (lcg);
+                buffer += BufferSizeLevelBsr::BsrId2BufferSize (bsrId);
+              }
+
+            Ue *ue = m_ues.Find (params.m_macCeList.at (i).m_rnti);
+            if (ue == 0)
+              {
+                continue;
+              }
+            // update the buffer size value
+            ue->m_bsrRxed = true;
+            ue->m_bsr = buffer;
+          }
+      }
+  }
+
+  /**
+   * Store the UL SINRs of an UL CQI accepted by the UL CQI filter, and
+   * restart their validity timer
+   * \param params the parameters of SchedUlCqiInfoReq
+   * \param ulBandwidth the UL bandwidth of the cell, in RBs
+   */
+  void UpdateUlCqi (const struct FfMacSchedSapProvider::SchedUlCqiInfoReqParameters& params, uint8_t ulBandwidth)
+  {
+    // retrieve the allocation for this subframe
+    switch (m_ulCqiFilter)
+      {
+      case FfMacScheduler::SRS_UL_CQI:
+        {
+          // filter all the CQIs that are not SRS based
+          if (params.m_ulCqi.m_type != UlCqi_s::SRS)
+            {
+              return;
+            }
+        }
+        break;
+      case FfMacScheduler::PUSCH_UL_CQI:
+        {
+          // filter all the CQIs that are not SRS based
+          if (params.m_ulCqi.m_type != UlCqi_s::PUSCH)
+            {
+              return;
+            }
+        }
+      case FfMacScheduler::ALL_UL_CQI:
+        break;
+
+      default:
+        NS_FATAL_ERROR ("Unknown UL CQI type");
+      }
+
+    switch (params.m_ulCqi.m_type)
+      {
+      case UlCqi_s::PUSCH:
+        {
+          std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
+          itMap = m_allocationMaps.find (params.m_sfnSf);
+          if (itMap == m_allocationMaps.end ())
+            {
+              return;
+            }
+          for (uint32_t i = 0; i < (*itMap).second.size (); i++)
+            {
+              // convert from fixed point notation Sxxxxxxxxxxx.xxx to double
+              double sinr = LteFfConverter::fpS11dot3toDouble (params.m_ulCqi.m_sinr.at (i));
+              Ue *ue = m_ues.Find ((*itMap).second.at (i));
+              if (ue == 0)
+                {
+                  // RB not allocated, or UE already released
+                  continue;
+                }
+              if (ue->m_ulCqi.empty ())
+                {
+                  // initialize with NO_SINR value.
+                  ue->m_ulCqi.resize (ulBandwidth, NO_SINR);
+                }
+              // update the value
+              ue->m_ulCqi.at (i) = sinr;
+              // update correspondent timer
+              ue->m_ulCqiTimer = m_cqiTimersThreshold;
+            }
+          // remove obsolete info on allocation
+          m_allocationMaps.erase (itMap);
+        }
+        break;
+      case UlCqi_s::SRS:
+        {
+          // get the RNTI from vendor specific parameters
+          uint16_t rnti = 0;
+          NS_ASSERT (params.m_vendorSpecificList.size () > 0);
+          for (uint16_t i = 0; i < params.m_vendorSpecificList.size (); i++)
+            {
+              if (params.m_vendorSpecificList.at (i).m_type == SRS_CQI_RNTI_VSP)
+                {
+                  Ptr<SrsCqiRntiVsp> vsp = DynamicCast<SrsCqiRntiVsp> (params.m_vendorSpecificList.at (i).m_value);
+                  rnti = vsp->GetRnti ();
+                }
+            }
+          Ue *ue = m_ues.Find (rnti);
+          if (ue == 0)
+            {
+              return;
+            }
+          // update the values
+          ue->m_ulCqi.resize (ulBandwidth);
+          for (uint32_t j = 0; j < ulBandwidth; j++)
+            {
+              ue->m_ulCqi.at (j) = LteFfConverter::fpS11dot3toDouble (params.m_ulCqi.m_sinr.at (j));
+            }
+          // update correspondent timer
+          ue->m_ulCqiTimer = m_cqiTimersThreshold;
+        }
+        break;
+      case UlCqi_s::PUCCH_1:
+      case UlCqi_s::PUCCH_2:
+      case UlCqi_s::PRACH:
+        {
+          NS_FATAL_ERROR (GetInstanceTypeId ().GetName () << " supports only PUSCH and SRS UL-CQIs");
+        }
+        break;
+      default:
+        NS_FATAL_ERROR ("Unknown type of UL-CQI");
+      }
+  }
+
+  /**
+   * Store the UEs allocated to the RBs of an UL subframe, to attribute
+   * the PUSCH UL CQIs of the subframe
+   * \param sfnSf the frame and subframe numbers of the subframe
+   * \param rbgAllocationMap the RNTI allocated to each RB, 0 if none
+   */
+  void SetUlAllocationMap (uint16_t sfnSf, const std::vector <uint16_t> &rbgAllocationMap)
+  {
+    m_allocationMaps.insert (std::pair <uint16_t, std::vector <uint16_t> > (sfnSf, rbgAllocationMap));
+  }
+
+  /**
+   * \return the valid UL SINRs of the UEs, per RNTI, as reported to the
+   * FFR algorithms
+   */
+  std::map <uint16_t, std::vector <double> > GetUlCqiMap (void)
+  {
+    std::map <uint16_t, std::vector <double> > ulCqiMap;
+    for (typename FfMacSchedulerUeTable<Ue>::Iterator it = m_ues.Begin (); it != m_ues.End (); it++)
+      {
+        if (!(*it).m_ulCqi.empty ())
+          {
+            ulCqiMap.insert (std::pair <uint16_t, std::vector <double> > ((*it).m_rnti, (*it).m_ulCqi));
+          }
+      }
+    return ulCqiMap;
+  }
+
+  /// Advance the validity timers of the DL CQIs by one TTI
+  void RefreshDlCqiMaps (void)
+  {
+    // refresh DL CQI P01 and A30 of each UE
+    for (typename FfMacSchedulerUeTable<Ue>::Iterator it = m_ues.Begin (); it != m_ues.End (); it++)
+      {
+        (*it).RefreshDlCqi ();
+      }
+  }
+
+  /// Advance the validity timers of the UL CQIs by one TTI
+  void RefreshUlCqiMaps (void)
+  {
+    // refresh UL CQI of each UE
+    for (typename FfMacSchedulerUeTable<Ue>::Iterator it = m_ues.Begin (); it != m_ues.End (); it++)
+      {
+        (*it).RefreshUlCqi ();
+      }
+  }
+
+  /// Refresh the DL HARQ processes according to their timers
+  void RefreshHarqProcesses (void)
+  {
+    for (typename FfMacSchedulerUeTable<Ue>::Iterator it = m_ues.Begin (); it != m_ues.End (); it++)
+      {
+        (*it).RefreshDlHarqProcesses ();
+      }
+  }
+
+  /// The state of the UEs, per RNTI
+  FfMacSchedulerUeTable<Ue> m_ues;
+
+  /// Number of TTIs for which a CQI can be considered valid
+  uint32_t m_cqiTimersThreshold;
+
+private:
+  /**
+   * Map of previous allocated UE per RBG
+   * (used to retrieve info from UL-CQI)
+   */
+  std::map <uint16_t, std::vector <uint16_t> > m_allocationMaps;
+};
+
+} // namespace ns3
+
+#endif /* UE_TABLE_FF_MAC_SCHEDULER_H */
@@ -0,0 +1,195 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/nstime.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/fading-trace.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <fstream>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteFadingTraceTest");
+
+/// Number of RBs of the test trace
+static const uint32_t RB_NUM = 3;
+/// Number of samples per RB of the test trace
+static const uint32_t SAMPLES_NUM = 1000;
+
+/**
+ * \param rb an RB
+ * \param sample a sample
+ * \return the fading of the test trace [dB]
+ */
+static double
+GetTestFading (uint32_t rb, uint32_t sample)
+{
+  return -3.0 * rb + 0.25 * (sample % 4);
+}
+
+/**
+ * Check that a text fading trace and its binary version are read
+ * identically and shared, and that TraceFadingLossModel applies them.
+ */
+class LteFadingTraceTestCase : public TestCase
+{
+public:
+  LteFadingTraceTestCase ();
+  virtual ~LteFadingTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the samples of a trace
+   * \param trace the trace
+   */
+  void CheckTrace (Ptr<const FadingTrace> trace);
+  /**
+   * Check the PSD received through a TraceFadingLossModel
+   * \param fileName the name of the trace file
+   */
+  void CheckModel (std::string fileName);
+};
+
+LteFadingTraceTestCase::LteFadingTraceTestCase ()
+  : TestCase ("Text and binary fading traces")
+{
+}
+
+LteFadingTraceTestCase::~LteFadingTraceTestCase ()
+{
+}
+
+void
+LteFadingTraceTestCase::CheckTrace (Ptr<const FadingTrace> trace)
+{
+  NS_TEST_ASSERT_MSG_EQ (trace->GetRbNum (), RB_NUM, "wrong number of RBs");
+  NS_TEST_ASSERT_MSG_EQ (trace->GetSamplesNum (), SAMPLES_NUM, "wrong number of samples");
+  for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+      for (uint32_t sample = 0; sample < SAMPLES_NUM; sample++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (trace->GetValue (rb, sample), GetTestFading (rb, sample),
+                                 "wrong fading for RB " << rb << " sample " << sample);
+        }
+    }
+}
+
+void
+LteFadingTraceTestCase::CheckModel (std::string fileName)
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (fileName));
+  model->SetAttribute ("TraceLength", TimeValue (Seconds (1)));
+  model->SetAttribute ("SamplesNum", UintegerValue (SAMPLES_NUM));
+  model->SetAttribute ("RbNum", UintegerValue (RB_NUM));
+  model->Initialize ();
+
+  Bands bands;
+  for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+      BandInfo bi;
+      bi.fl = 2.1e9 + rb * 180e3;
+      bi.fc = bi.fl + 90e3;
+      bi.fh = bi.fl + 180e3;
+      bands.push_back (bi);
+    }
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (Create<SpectrumModel> (bands));
+  *txPsd = 1e-16;
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  std::vector<Ptr<MobilityModel> > b;
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      b.push_back (CreateObject<ConstantPositionMobilityModel> ());
+    }
+  // many links, so that the table of the channel realizations grows,
+  // each queried twice
+  for (uint32_t n = 0; n < 2; n++)
+    {
+      for (uint32_t i = 0; i < b.size (); i++)
+        {
+          Ptr<SpectrumValue> rxPsd = model->CalcRxPowerSpectralDensity (txPsd, a, b[i]);
+          for (uint32_t rb = 0; rb < RB_NUM; rb++)
+            {
+              // the offset of the link is random, but the fading of an RB
+              // is one of 4 values
+              double fading = 10 * std::log10 ((*rxPsd)[rb] / (*txPsd)[rb]);
+              double quarters = (fading + 3.0 * rb) / 0.25;
+              NS_TEST_ASSERT_MSG_EQ_TOL (quarters, std::floor (quarters + 0.5), 1e-6,
+                                         "fading " << fading << " of RB " << rb << " is not in the trace");
+              NS_TEST_ASSERT_MSG_GT (quarters, -1e-6, "fading " << fading << " of RB " << rb << " is not in the trace");
+              NS_TEST_ASSERT_MSG_LT (quarters, 3 + 1e-6, "fading " << fading << " of RB " << rb << " is not in the trace");
+            }
+        }
+    }
+  model->Dispose ();
+}
+
+void
+LteFadingTraceTestCase::DoRun (void)
+{
+  std::string textFileName = CreateTempDirFilename ("fading_trace_test.fad");
+  std::ofstream textFile (textFileName.c_str ());
+  for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+      for (uint32_t sample = 0; sample < SAMPLES_NUM; sample++)
+        {
+          textFile << GetTestFading (rb, sample) << " ";
+        }
+      textFile << "\n";
+    }
+  textFile.close ();
+
+  Ptr<const FadingTrace> text = FadingTrace::Get (textFileName, RB_NUM, SAMPLES_NUM);
+  CheckTrace (text);
+  NS_TEST_EXPECT_MSG_EQ (FadingTrace::Get (textFileName, RB_NUM, SAMPLES_NUM), text, "trace not shared");
+  CheckModel (textFileName);
+
+  std::string binaryFileName = CreateTempDirFilename ("fading_trace_test.fadb");
+  text->Write (binaryFileName);
+  Ptr<const FadingTrace> binary = FadingTrace::Get (binaryFileName, RB_NUM, SAMPLES_NUM);
+  CheckTrace (binary);
+  CheckModel (binaryFileName);
+
+  text = 0;
+  binary = 0;
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite for the fading traces
+ */
+class LteFadingTraceTestSuite : public TestSuite
+{
+public:
+  LteFadingTraceTestSuite ();
+};
+
+LteFadingTraceTestSuite::LteFadingTraceTestSuite ()
+  : TestSuite ("lte-fading-trace", UNIT)
+{
+  AddTestCase (new LteFadingTraceTestCase, TestCase::QUICK);
+}
+
+static LteFadingTraceTestSuite g_lteFadingTraceTestSuite;
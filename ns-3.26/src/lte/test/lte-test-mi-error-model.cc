@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-mi-error-model.h>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteMiErrorModelTest");
+
+/**
+ * Check the decoding stats of a TB received with the same SINR on all
+ * its RBs against the values of the original implementation of the
+ * error model, which looked the curves up without precomputed tables.
+ */
+class LteMiErrorModelTbTestCase : public TestCase
+{
+public:
+  /**
+   * \param sinrDb the SINR of the RBs, in dB
+   * \param rbs the number of RBs of the TB
+   * \param mcs the MCS of the TB
+   * \param size the size of the TB, in bytes
+   * \param retx the number of previous transmissions of the TB
+   * \param tbler the expected TB error rate
+   * \param mi the expected MI of the TB
+   */
+  LteMiErrorModelTbTestCase (double sinrDb, uint16_t rbs, uint8_t mcs, uint16_t size, uint8_t retx,
+                             double tbler, double mi);
+  virtual ~LteMiErrorModelTbTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param sinrDb the SINR of the RBs, in dB
+   * \param rbs the number of RBs of the TB
+   * \param mcs the MCS of the TB
+   * \param size the size of the TB, in bytes
+   * \param retx the number of previous transmissions of the TB
+   * \return the name of the test case
+   */
+  static std::string BuildNameString (double sinrDb, uint16_t rbs, uint8_t mcs, uint16_t size, uint8_t retx);
+
+  double m_sinrDb;  ///< the SINR of the RBs, in dB
+  uint16_t m_rbs;   ///< the number of RBs of the TB
+  uint8_t m_mcs;    ///< the MCS of the TB
+  uint16_t m_size;  ///< the size of the TB
+  uint8_t m_retx;   ///< the number of previous transmissions of the TB
+  double m_tbler;   ///< the expected TB error rate
+  double m_mi;      ///< the expected MI of the TB
+};
+
+std::string
+LteMiErrorModelTbTestCase::BuildNameString (double sinrDb, uint16_t rbs, uint8_t mcs, uint16_t size, uint8_t retx)
+{
+  std::ostringstream oss;
+  oss << "SINR " << sinrDb << " dB, " << rbs << " RBs, MCS " << (uint32_t) mcs
+      << ", " << size << " bytes, " << (uint32_t) retx << " retx";
+  return oss.str ();
+}
+
+LteMiErrorModelTbTestCase::LteMiErrorModelTbTestCase (double sinrDb, uint16_t rbs, uint8_t mcs, uint16_t size, uint8_t retx,
+                                                      double tbler, double mi)
+  : TestCase (BuildNameString (sinrDb, rbs, mcs, size, retx)),
+    m_sinrDb (sinrDb),
+    m_rbs (rbs),
+    m_mcs (mcs),
+    m_size (size),
+    m_retx (retx),
+    m_tbler (tbler),
+    m_mi (mi)
+{
+}
+
+LteMiErrorModelTbTestCase::~LteMiErrorModelTbTestCase ()
+{
+}
+
+void
+LteMiErrorModelTbTestCase::DoRun (void)
+{
+  SpectrumValue sinr (LteSpectrumValueHelper::GetSpectrumModel (100, 100));
+  sinr = std::pow (10.0, m_sinrDb / 10);
+  std::vector<int> map;
+  for (uint16_t i = 0; i < m_rbs; ++i)
+    {
+      map.push_back (i);
+    }
+  HarqProcessInfoList_t history;
+  for (uint8_t i = 0; i < m_retx; ++i)
+    {
+      HarqProcessInfoElement_t tx;
+      tx.m_mi = 0.3;
+      tx.m_rv = i;
+      tx.m_infoBits = m_size * 8;
+      tx.m_codeBits = m_size * 16;
+      history.push_back (tx);
+    }
+  TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, m_size, m_mcs, history);
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, m_tbler, 1e-12, "wrong TB error rate");
+  NS_TEST_ASSERT_MSG_EQ_TOL (stats.mi, m_mi, 1e-12, "wrong MI");
+}
+
+
+/**
+ * Check the error rate of the PCFICH and PDCCH received with the same
+ * SINR on all the RBs.
+ */
+class LteMiErrorModelPdcchTestCase : public TestCase
+{
+public:
+  /**
+   * \param sinrDb the SINR of the RBs, in dB
+   * \param errorRate the expected error rate
+   */
+  LteMiErrorModelPdcchTestCase (double sinrDb, double errorRate);
+  virtual ~LteMiErrorModelPdcchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  double m_sinrDb;     ///< the SINR of the RBs, in dB
+  double m_errorRate;  ///< the expected error rate
+};
+
+LteMiErrorModelPdcchTestCase::LteMiErrorModelPdcchTestCase (double sinrDb, double errorRate)
+  : TestCase ("PCFICH and PDCCH error rate"),
+    m_sinrDb (sinrDb),
+    m_errorRate (errorRate)
+{
+}
+
+LteMiErrorModelPdcchTestCase::~LteMiErrorModelPdcchTestCase ()
+{
+}
+
+void
+LteMiErrorModelPdcchTestCase::DoRun (void)
+{
+  SpectrumValue sinr (LteSpectrumValueHelper::GetSpectrumModel (100, 50));
+  sinr = std::pow (10.0, m_sinrDb / 10);
+  double errorRate = LteMiErrorModel::GetPcfichPdcchError (sinr);
+  NS_TEST_ASSERT_MSG_EQ_TOL (errorRate, m_errorRate, 1e-12, "wrong error rate with SINR " << m_sinrDb << " dB");
+}
+
+
+/**
+ * Test suite for the lookup of the curves of LteMiErrorModel
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  // QPSK, 16-QAM and 64-QAM, with one and several code blocks
+  AddTestCase (new LteMiErrorModelTbTestCase (-5.75, 10, 2, 50, 0, 0.54836585486976186, 0.171519), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelTbTestCase (0.5, 25, 8, 400, 0, 0.36164507036154842, 0.52485500000000007), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelTbTestCase (6.25, 50, 14, 2000, 0, 0.76094164743767068, 0.54118000000000033), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelTbTestCase (14.25, 100, 22, 6000, 0, 0.1707914258365727, 0.71623499999999884), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelTbTestCase (19.75, 100, 28, 9422, 0, 0.40561803057079027, 0.94639399999999896), TestCase::QUICK);
+  // HARQ retransmission
+  AddTestCase (new LteMiErrorModelTbTestCase (-1, 25, 12, 300, 1, 0.50581349742326565, 0.19163599999999995), TestCase::QUICK);
+
+  AddTestCase (new LteMiErrorModelPdcchTestCase (-7, 0.30994699999999997), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelPdcchTestCase (-4, 0.037583999999999999), TestCase::QUICK);
+  AddTestCase (new LteMiErrorModelPdcchTestCase (-1, 0), TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite;
@@ -0,0 +1,228 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/string.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-global-pathloss-database.h>
+#include <ns3/lte-pathloss-matrix.h>
+#include <ns3/lte-static-pathloss-model.h>
+#include <fstream>
+#include <limits>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LtePathlossMatrixTest");
+
+/**
+ * Check the growth of an LtePathlossMatrix.
+ */
+class LtePathlossMatrixTestCase : public TestCase
+{
+public:
+  LtePathlossMatrixTestCase ();
+  virtual ~LtePathlossMatrixTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LtePathlossMatrixTestCase::LtePathlossMatrixTestCase ()
+  : TestCase ("LtePathlossMatrix growth")
+{
+}
+
+LtePathlossMatrixTestCase::~LtePathlossMatrixTestCase ()
+{
+}
+
+void
+LtePathlossMatrixTestCase::DoRun (void)
+{
+  LtePathlossMatrix matrix;
+  NS_TEST_ASSERT_MSG_EQ (matrix.Get (1, 1), std::numeric_limits<double>::infinity (), "empty matrix");
+  // IMSIs discovered one after the other, with cells in between
+  for (uint64_t imsi = 1; imsi <= 40; ++imsi)
+    {
+      for (uint16_t cellId = 1; cellId <= 1 + imsi / 10; ++cellId)
+        {
+          matrix.Set (cellId, imsi, 1000.0 * cellId + imsi);
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (matrix.GetNCells (), 5, "wrong number of cells");
+  NS_TEST_ASSERT_MSG_EQ (matrix.GetNImsis (), 40, "wrong number of IMSIs");
+  for (uint64_t imsi = 1; imsi <= 41; ++imsi)
+    {
+      for (uint16_t cellId = 1; cellId <= 6; ++cellId)
+        {
+          if (imsi <= 40 && cellId <= 1 + imsi / 10)
+            {
+              NS_TEST_ASSERT_MSG_EQ (matrix.Get (cellId, imsi), 1000.0 * cellId + imsi,
+                                     "wrong pathloss of cell " << cellId << " IMSI " << imsi);
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_EQ (matrix.IsSet (cellId, imsi), false,
+                                     "cell " << cellId << " IMSI " << imsi << " was not set");
+            }
+        }
+    }
+}
+
+
+/**
+ * Record the downlink pathloss of a deployment in snapshots, and check
+ * that an LteStaticPathlossModel replaying the last snapshot gives the
+ * same pathloss.
+ */
+class LteStaticPathlossTestCase : public TestCase
+{
+public:
+  LteStaticPathlossTestCase ();
+  virtual ~LteStaticPathlossTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run a deployment of 2 eNBs and 3 UEs for 45 ms, recording its
+   * downlink pathloss
+   * \param fileName the snapshot file to write
+   * \param replayFileName the snapshot file to replay, if not empty
+   * \param ueOffset the offset along x of the positions of the UEs
+   * \param pathloss the last pathloss recorded
+   */
+  void Run (std::string fileName, std::string replayFileName, double ueOffset, LtePathlossMatrix &pathloss);
+};
+
+LteStaticPathlossTestCase::LteStaticPathlossTestCase ()
+  : TestCase ("Pathloss snapshots and LteStaticPathlossModel")
+{
+}
+
+LteStaticPathlossTestCase::~LteStaticPathlossTestCase ()
+{
+}
+
+void
+LteStaticPathlossTestCase::Run (std::string fileName, std::string replayFileName, double ueOffset,
+                                LtePathlossMatrix &pathloss)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  if (!replayFileName.empty ())
+    {
+      lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::LteStaticPathlossModel"));
+      lteHelper->SetPathlossModelAttribute ("Filename", StringValue (replayFileName));
+    }
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  NodeContainer ueNodes;
+  ueNodes.Create (3);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (500.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (100.0 + ueOffset, 50.0, 1.5));
+  positionAlloc->Add (Vector (250.0 + ueOffset, -80.0, 1.5));
+  positionAlloc->Add (Vector (450.0 + ueOffset, 20.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  // the UEs receive the downlink once they are attached to a cell
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (0));
+  lteHelper->Attach (ueDevs.Get (1), enbDevs.Get (0));
+  lteHelper->Attach (ueDevs.Get (2), enbDevs.Get (1));
+
+  DownlinkLteGlobalPathlossDatabase dlPathlossDb;
+  // the DL channel is the first one created by LteHelper
+  Config::Connect ("/ChannelList/0/PathLoss",
+                   MakeCallback (&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlPathlossDb));
+  dlPathlossDb.EnableSnapshots (fileName, MilliSeconds (10));
+
+  Simulator::Stop (MilliSeconds (45));
+  Simulator::Run ();
+  pathloss = dlPathlossDb.GetPathlossMatrix ();
+  Simulator::Destroy ();
+}
+
+void
+LteStaticPathlossTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("pathloss.plm");
+  LtePathlossMatrix recorded;
+  Run (fileName, "", 0.0, recorded);
+  NS_TEST_ASSERT_MSG_EQ (recorded.GetNCells (), 2, "wrong number of cells");
+  NS_TEST_ASSERT_MSG_EQ (recorded.GetNImsis (), 3, "wrong number of IMSIs");
+
+  std::ifstream file (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_TEST_ASSERT_MSG_EQ (LtePathlossMatrix::ReadFileHeader (file), true, "not a snapshot file");
+  LtePathlossMatrix snapshot;
+  Time time;
+  uint32_t snapshots = 0;
+  while (snapshot.ReadSnapshot (file, time))
+    {
+      ++snapshots;
+      NS_TEST_ASSERT_MSG_EQ_TOL (time.GetSeconds (), 0.010 * snapshots, 1e-9, "wrong snapshot time");
+    }
+  NS_TEST_ASSERT_MSG_EQ (snapshots, 4, "wrong number of snapshots");
+  for (uint16_t cellId = 1; cellId <= 2; ++cellId)
+    {
+      for (uint64_t imsi = 1; imsi <= 3; ++imsi)
+        {
+          NS_TEST_ASSERT_MSG_EQ (recorded.IsSet (cellId, imsi), true, "no pathloss for cell " << cellId << " IMSI " << imsi);
+          NS_TEST_ASSERT_MSG_EQ (snapshot.Get (cellId, imsi), recorded.Get (cellId, imsi), "wrong snapshot");
+        }
+    }
+
+  // a replay sees the recorded pathloss, even if the UEs were moved
+  LtePathlossMatrix replayed;
+  Run (CreateTempDirFilename ("replay.plm"), fileName, 30.0, replayed);
+  for (uint16_t cellId = 1; cellId <= 2; ++cellId)
+    {
+      for (uint64_t imsi = 1; imsi <= 3; ++imsi)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (replayed.Get (cellId, imsi), recorded.Get (cellId, imsi), 1e-9,
+                                     "wrong replayed pathloss for cell " << cellId << " IMSI " << imsi);
+        }
+    }
+}
+
+
+/**
+ * Test suite for the pathloss matrix and LteStaticPathlossModel
+ */
+class LtePathlossMatrixTestSuite : public TestSuite
+{
+public:
+  LtePathlossMatrixTestSuite ();
+};
+
+LtePathlossMatrixTestSuite::LtePathlossMatrixTestSuite ()
+  : TestSuite ("lte-pathloss-matrix", SYSTEM)
+{
+  AddTestCase (new LtePathlossMatrixTestCase, TestCase::QUICK);
+  AddTestCase (new LteStaticPathlossTestCase, TestCase::QUICK);
+}
+
+static LtePathlossMatrixTestSuite g_ltePathlossMatrixTestSuite;
@@ -0,0 +1,212 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/double.h>
+#include <ns3/uinteger.h>
+#include <ns3/boolean.h>
+#include <ns3/enum.h>
+#include <ns3/node-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/radio-environment-map-helper.h>
+#include <fstream>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRadioEnvironmentMapTest");
+
+/**
+ * Check that the offline mode of RadioEnvironmentMapHelper, with its
+ * map split in shards written as NumPy arrays, gives the same map as
+ * the normal mode.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  LteRadioEnvironmentMapTestCase ();
+  virtual ~LteRadioEnvironmentMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Generate a map of two eNBs
+   * \param fileName the name of the output file
+   * \param offline the `Offline` attribute
+   * \param format the `OutputFormat` attribute
+   * \param shards the `Shards` attribute
+   * \param shard the `Shard` attribute
+   */
+  void Generate (std::string fileName, bool offline, RadioEnvironmentMapHelper::OutputFormat_t format,
+                 uint32_t shards, uint32_t shard);
+  /**
+   * Read a map in the text format
+   * \param fileName the name of the map file
+   * \param values the values of the map, appended by row
+   */
+  void ReadText (std::string fileName, std::vector<double> &values);
+  /**
+   * Read a map in the NumPy format
+   * \param fileName the name of the map file
+   * \param values the values of the map, appended by row
+   */
+  void ReadNpy (std::string fileName, std::vector<double> &values);
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase ()
+  : TestCase ("Offline and sharded REM vs REM")
+{
+}
+
+LteRadioEnvironmentMapTestCase::~LteRadioEnvironmentMapTestCase ()
+{
+}
+
+void
+LteRadioEnvironmentMapTestCase::Generate (std::string fileName, bool offline,
+                                          RadioEnvironmentMapHelper::OutputFormat_t format,
+                                          uint32_t shards, uint32_t shard)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (400.0, 100.0, 30.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue ("/ChannelList/0"));
+  remHelper->SetAttribute ("OutputFile", StringValue (fileName));
+  remHelper->SetAttribute ("XMin", DoubleValue (-100.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (500.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (7));
+  remHelper->SetAttribute ("YMin", DoubleValue (-50.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (150.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (5));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  // several iterations in the normal mode
+  remHelper->SetAttribute ("MaxPointsPerIteration", UintegerValue (8));
+  remHelper->SetAttribute ("Offline", BooleanValue (offline));
+  remHelper->SetAttribute ("OutputFormat", EnumValue (format));
+  remHelper->SetAttribute ("Shards", UintegerValue (shards));
+  remHelper->SetAttribute ("Shard", UintegerValue (shard));
+  remHelper->Install ();
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+LteRadioEnvironmentMapTestCase::ReadText (std::string fileName, std::vector<double> &values)
+{
+  std::ifstream file (fileName.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "cannot open " << fileName);
+  double value;
+  while (file >> value)
+    {
+      values.push_back (value);
+    }
+}
+
+void
+LteRadioEnvironmentMapTestCase::ReadNpy (std::string fileName, std::vector<double> &values)
+{
+  std::ifstream file (fileName.c_str (), std::ifstream::in | std::ifstream::binary);
+  NS_TEST_ASSERT_MSG_EQ (file.good (), true, "cannot open " << fileName);
+  char preamble[10];
+  file.read (preamble, sizeof (preamble));
+  NS_TEST_ASSERT_MSG_EQ (std::memcmp (preamble, "\x93NUMPY\x01\x00", 8), 0, "not a .npy file");
+  uint16_t headerLength = (uint8_t) preamble[8] | ((uint8_t) preamble[9] << 8);
+  NS_TEST_ASSERT_MSG_EQ ((sizeof (preamble) + headerLength) % 16, 0, "misaligned data");
+  std::string header (headerLength, ' ');
+  file.read (&header[0], headerLength);
+  std::string::size_type shape = header.find ("'shape': (");
+  NS_TEST_ASSERT_MSG_NE (shape, std::string::npos, "no shape in " << header);
+  uint32_t rows = std::atoi (header.c_str () + shape + std::strlen ("'shape': ("));
+  NS_TEST_ASSERT_MSG_NE (header.find (", 4)"), std::string::npos, "not 4 columns in " << header);
+  std::vector<double> data (rows * 4);
+  file.read (reinterpret_cast<char *> (&data[0]), data.size () * sizeof (double));
+  NS_TEST_ASSERT_MSG_EQ (file.gcount (), (std::streamsize) (data.size () * sizeof (double)), "truncated data");
+  NS_TEST_ASSERT_MSG_EQ (file.peek (), std::ifstream::traits_type::eof (), "data beyond the shape");
+  values.insert (values.end (), data.begin (), data.end ());
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  std::string normalFileName = CreateTempDirFilename ("rem.out");
+  Generate (normalFileName, false, RadioEnvironmentMapHelper::TEXT_OUTPUT, 1, 0);
+  std::vector<double> normal;
+  ReadText (normalFileName, normal);
+  NS_TEST_ASSERT_MSG_EQ (normal.size (), 7 * 5 * 4, "wrong number of values");
+
+  std::string offlineFileName = CreateTempDirFilename ("rem-offline.out");
+  Generate (offlineFileName, true, RadioEnvironmentMapHelper::TEXT_OUTPUT, 1, 0);
+  std::vector<double> offline;
+  ReadText (offlineFileName, offline);
+
+  std::vector<double> sharded;
+  for (uint32_t shard = 0; shard < 2; ++shard)
+    {
+      std::ostringstream shardFileName;
+      shardFileName << "rem-" << shard << ".npy";
+      std::string fileName = CreateTempDirFilename (shardFileName.str ());
+      Generate (fileName, true, RadioEnvironmentMapHelper::NPY_OUTPUT, 2, shard);
+      ReadNpy (fileName, sharded);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (offline.size (), normal.size (), "wrong number of values in offline mode");
+  NS_TEST_ASSERT_MSG_EQ (sharded.size (), normal.size (), "wrong number of values in the shards");
+  for (uint32_t i = 0; i < normal.size (); ++i)
+    {
+      // the text format has 6 significant digits
+      double tolerance = 1e-5 * std::fabs (normal[i]) + 1e-9;
+      NS_TEST_ASSERT_MSG_EQ_TOL (offline[i], normal[i], tolerance, "wrong value " << i << " in offline mode");
+      NS_TEST_ASSERT_MSG_EQ_TOL (sharded[i], normal[i], tolerance, "wrong value " << i << " in the shards");
+    }
+  // both eNBs are heard
+  NS_TEST_ASSERT_MSG_LT (normal[3], 1e6, "no interference");
+}
+
+
+/**
+ * Test suite for RadioEnvironmentMapHelper
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase, TestCase::QUICK);
+}
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
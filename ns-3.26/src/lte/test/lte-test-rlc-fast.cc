@@ -0,0 +1,278 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "ns3/lte-rlc-fast.h"
+
+#include "lte-test-entities.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRlcFastTest");
+
+/**
+ * Test of the RLC fast mode, with a transmitting and a receiving RLC
+ * entity connected through the loopback of the test MAC, which delivers
+ * the PDUs 100 ms after they are sent.
+ */
+class LteRlcFastTestCase : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test case
+   */
+  LteRlcFastTestCase (std::string name);
+  virtual ~LteRlcFastTestCase ();
+
+protected:
+  virtual void DoRun (void);
+
+  /**
+   * Check the last SDU received by the receiving PDCP entity
+   * \param time the time of the check
+   * \param shouldReceived the expected SDU
+   * \param assertMsg the message of the failed check
+   */
+  void CheckDataReceived (Time time, std::string shouldReceived, std::string assertMsg);
+  /**
+   * Check the number of PDUs sent by the transmitting MAC entity
+   * \param time the time of the check
+   * \param pdus the expected number of PDUs
+   */
+  void CheckTxPdus (Time time, uint32_t pdus);
+
+  Ptr<LteTestPdcp> txPdcp;  ///< the transmitting PDCP entity
+  Ptr<LteRlc> txRlc;        ///< the transmitting RLC entity
+  Ptr<LteTestMac> txMac;    ///< the transmitting MAC entity
+
+  Ptr<LteTestPdcp> rxPdcp;  ///< the receiving PDCP entity
+  Ptr<LteRlc> rxRlc;        ///< the receiving RLC entity
+  Ptr<LteTestMac> rxMac;    ///< the receiving MAC entity
+
+private:
+  /**
+   * \param shouldReceived the expected SDU
+   * \param assertMsg the message of the failed check
+   */
+  void DoCheckDataReceived (std::string shouldReceived, std::string assertMsg);
+  /**
+   * \param pdus the expected number of PDUs
+   */
+  void DoCheckTxPdus (uint32_t pdus);
+};
+
+LteRlcFastTestCase::LteRlcFastTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+LteRlcFastTestCase::~LteRlcFastTestCase ()
+{
+}
+
+void
+LteRlcFastTestCase::DoRun (void)
+{
+  uint16_t rnti = 1111;
+  uint8_t lcid = 222;
+
+  // Create the transmitting entities
+  txPdcp = CreateObject<LteTestPdcp> ();
+  txRlc = CreateObject<LteRlcFast> ();
+  txRlc->SetRnti (rnti);
+  txRlc->SetLcId (lcid);
+  txMac = CreateObject<LteTestMac> ();
+
+  // Create the receiving entities
+  rxPdcp = CreateObject<LteTestPdcp> ();
+  rxRlc = CreateObject<LteRlcFast> ();
+  rxRlc->SetRnti (rnti);
+  rxRlc->SetLcId (lcid);
+  rxMac = CreateObject<LteTestMac> ();
+
+  // Connect SAPs: PDCP (Tx) <-> RLC (Tx) <-> MAC (Tx) <-> MAC (Rx) <-> RLC (Rx) <-> PDCP (Rx)
+  txPdcp->SetLteRlcSapProvider (txRlc->GetLteRlcSapProvider ());
+  txRlc->SetLteRlcSapUser (txPdcp->GetLteRlcSapUser ());
+  txRlc->SetLteMacSapProvider (txMac->GetLteMacSapProvider ());
+  txMac->SetLteMacSapUser (txRlc->GetLteMacSapUser ());
+  txMac->SetLteMacLoopback (rxMac);
+
+  rxPdcp->SetLteRlcSapProvider (rxRlc->GetLteRlcSapProvider ());
+  rxRlc->SetLteRlcSapUser (rxPdcp->GetLteRlcSapUser ());
+  rxRlc->SetLteMacSapProvider (rxMac->GetLteMacSapProvider ());
+  rxMac->SetLteMacSapUser (rxRlc->GetLteMacSapUser ());
+  rxMac->SetLteMacLoopback (txMac);
+}
+
+void
+LteRlcFastTestCase::CheckDataReceived (Time time, std::string shouldReceived, std::string assertMsg)
+{
+  Simulator::Schedule (time, &LteRlcFastTestCase::DoCheckDataReceived, this, shouldReceived, assertMsg);
+}
+
+void
+LteRlcFastTestCase::DoCheckDataReceived (std::string shouldReceived, std::string assertMsg)
+{
+  NS_TEST_ASSERT_MSG_EQ (rxPdcp->GetDataReceived (), shouldReceived, assertMsg);
+}
+
+void
+LteRlcFastTestCase::CheckTxPdus (Time time, uint32_t pdus)
+{
+  Simulator::Schedule (time, &LteRlcFastTestCase::DoCheckTxPdus, this, pdus);
+}
+
+void
+LteRlcFastTestCase::DoCheckTxPdus (uint32_t pdus)
+{
+  NS_TEST_ASSERT_MSG_EQ (txMac->GetTxPdus (), pdus, "wrong number of PDUs sent");
+}
+
+
+/**
+ * One SDU is sent in one PDU, as it is
+ */
+class LteRlcFastOneSduTestCase : public LteRlcFastTestCase
+{
+public:
+  LteRlcFastOneSduTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRlcFastOneSduTestCase::LteRlcFastOneSduTestCase ()
+  : LteRlcFastTestCase ("One SDU, one PDU")
+{
+}
+
+void
+LteRlcFastOneSduTestCase::DoRun (void)
+{
+  LteRlcFastTestCase::DoRun ();
+
+  txPdcp->SendData (Seconds (0.100), "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  // 26 bytes of SDU and 2 bytes of RLC header
+  txMac->SendTxOpportunity (Seconds (0.150), 28);
+  CheckTxPdus (Seconds (0.200), 1);
+  CheckDataReceived (Seconds (0.300), "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "SDU is not OK");
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * One SDU sent over several transmission opportunities is delivered with
+ * its last segment
+ */
+class LteRlcFastSegmentationTestCase : public LteRlcFastTestCase
+{
+public:
+  LteRlcFastSegmentationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRlcFastSegmentationTestCase::LteRlcFastSegmentationTestCase ()
+  : LteRlcFastTestCase ("Segmentation")
+{
+}
+
+void
+LteRlcFastSegmentationTestCase::DoRun (void)
+{
+  LteRlcFastTestCase::DoRun ();
+
+  txPdcp->SendData (Seconds (0.100), "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  // the same segments as RLC UM: 8 + 8 + 8 + 2 bytes
+  txMac->SendTxOpportunity (Seconds (0.150), 10);
+  txMac->SendTxOpportunity (Seconds (0.200), 10);
+  txMac->SendTxOpportunity (Seconds (0.300), 10);
+  CheckTxPdus (Seconds (0.350), 3);
+  CheckDataReceived (Seconds (0.450), "", "SDU delivered before its last segment");
+
+  txMac->SendTxOpportunity (Seconds (0.500), 4);
+  CheckTxPdus (Seconds (0.550), 4);
+  CheckDataReceived (Seconds (0.650), "ABCDEFGHIJKLMNOPQRSTUVWXYZ", "SDU is not OK");
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Several SDUs sent in one transmission opportunity are sent as one PDU
+ * each
+ */
+class LteRlcFastConcatenationTestCase : public LteRlcFastTestCase
+{
+public:
+  LteRlcFastConcatenationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRlcFastConcatenationTestCase::LteRlcFastConcatenationTestCase ()
+  : LteRlcFastTestCase ("Concatenation")
+{
+}
+
+void
+LteRlcFastConcatenationTestCase::DoRun (void)
+{
+  LteRlcFastTestCase::DoRun ();
+
+  txPdcp->SendData (Seconds (0.100), "ABCDEFGH");
+  txPdcp->SendData (Seconds (0.100), "IJKLMNOP");
+  txPdcp->SendData (Seconds (0.100), "QRSTUVWX");
+  // 3 SDUs of 8 bytes, with 2 bytes of RLC header each, less 1 byte
+  txMac->SendTxOpportunity (Seconds (0.150), 29);
+  CheckTxPdus (Seconds (0.200), 2);
+  CheckDataReceived (Seconds (0.300), "IJKLMNOP", "second SDU is not OK");
+
+  txMac->SendTxOpportunity (Seconds (0.400), 3);
+  CheckTxPdus (Seconds (0.450), 3);
+  CheckDataReceived (Seconds (0.550), "QRSTUVWX", "third SDU is not OK");
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite of the RLC fast mode
+ */
+class LteRlcFastTestSuite : public TestSuite
+{
+public:
+  LteRlcFastTestSuite ();
+};
+
+LteRlcFastTestSuite::LteRlcFastTestSuite ()
+  : TestSuite ("lte-rlc-fast", SYSTEM)
+{
+  AddTestCase (new LteRlcFastOneSduTestCase (), TestCase::QUICK);
+  AddTestCase (new LteRlcFastSegmentationTestCase (), TestCase::QUICK);
+  AddTestCase (new LteRlcFastConcatenationTestCase (), TestCase::QUICK);
+}
+
+static LteRlcFastTestSuite g_lteRlcFastTestSuite;
@@ -0,0 +1,233 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/boolean.h>
+#include <ns3/callback.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-common.h>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteSkipIdleSubframesTest");
+
+/**
+ * Order the traced events by time, then by node
+ * \param a an event
+ * \param b another event
+ * \return true if a is earlier than b
+ */
+static bool
+EarlierEvent (const std::string &a, const std::string &b)
+{
+  int64_t ta = 0;
+  int64_t tb = 0;
+  std::istringstream (a) >> ta;
+  std::istringstream (b) >> tb;
+  return (ta < tb) || ((ta == tb) && (a < b));
+}
+
+/**
+ * Check that the UEs stopping their subframe indications while idle
+ * behave exactly as the UEs indicating every subframe, when they attach
+ * after being idle for a while, in the middle of a subframe or at its
+ * start.
+ */
+class LteSkipIdleSubframesTestCase : public TestCase
+{
+public:
+  LteSkipIdleSubframesTestCase ();
+  virtual ~LteSkipIdleSubframesTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the scenario
+   * \param skipIdleSubframes the value of LteUePhy::SkipIdleSubframes
+   * \return the events traced by the UEs
+   */
+  std::vector<std::string> Run (bool skipIdleSubframes);
+
+  /**
+   * Attach a UE to an eNB
+   * \param lteHelper the LTE helper
+   * \param ueDevice the UE device
+   * \param enbDevice the eNB device
+   */
+  static void Attach (Ptr<LteHelper> lteHelper, Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice);
+
+  /**
+   * Trace the establishment of an RRC connection
+   * \param context the context
+   * \param imsi the IMSI
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   */
+  void ConnectionEstablished (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  /**
+   * Trace an RSRP and SINR report
+   * \param context the context
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param rsrp the RSRP
+   * \param sinr the SINR
+   */
+  void RsrpSinr (std::string context, uint16_t cellId, uint16_t rnti, double rsrp, double sinr);
+  /**
+   * Trace an uplink transmission
+   * \param context the context
+   * \param params the parameters of the transmission
+   */
+  void UlPhyTransmission (std::string context, PhyTransmissionStatParameters params);
+
+  std::vector<std::string> m_events; ///< the events traced by the UEs
+  uint32_t m_connections;            ///< the number of RRC connections
+};
+
+LteSkipIdleSubframesTestCase::LteSkipIdleSubframesTestCase ()
+  : TestCase ("UEs skipping their idle subframes")
+{
+}
+
+LteSkipIdleSubframesTestCase::~LteSkipIdleSubframesTestCase ()
+{
+}
+
+void
+LteSkipIdleSubframesTestCase::Attach (Ptr<LteHelper> lteHelper, Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice)
+{
+  lteHelper->Attach (ueDevice, enbDevice);
+}
+
+void
+LteSkipIdleSubframesTestCase::ConnectionEstablished (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " IMSI " << imsi << " RNTI " << rnti << " connected";
+  m_events.push_back (oss.str ());
+  ++m_connections;
+}
+
+void
+LteSkipIdleSubframesTestCase::RsrpSinr (std::string context, uint16_t cellId, uint16_t rnti, double rsrp, double sinr)
+{
+  std::ostringstream oss;
+  oss.precision (17);
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " RNTI " << rnti << " RSRP " << rsrp << " SINR " << sinr;
+  m_events.push_back (oss.str ());
+}
+
+void
+LteSkipIdleSubframesTestCase::UlPhyTransmission (std::string context, PhyTransmissionStatParameters params)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " RNTI " << params.m_rnti
+      << " MCS " << (uint32_t) params.m_mcs << " size " << params.m_size;
+  m_events.push_back (oss.str ());
+}
+
+std::vector<std::string>
+LteSkipIdleSubframesTestCase::Run (bool skipIdleSubframes)
+{
+  Config::SetDefault ("ns3::LteUePhy::SkipIdleSubframes", BooleanValue (skipIdleSubframes));
+  m_events.clear ();
+  m_connections = 0;
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  NodeContainer ueNodes;
+  ueNodes.Create (4);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 30.0));
+  positionAlloc->Add (Vector (100.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (0.0, 200.0, 1.5));
+  positionAlloc->Add (Vector (-300.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (0.0, -400.0, 1.5));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  // both runs choose the same random access preambles
+  int64_t stream = lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1 + stream);
+
+  // the last UE stays idle for the whole simulation
+  lteHelper->Attach (ueDevs.Get (0), enbDevs.Get (0));
+  Simulator::Schedule (MicroSeconds (100300), &LteSkipIdleSubframesTestCase::Attach,
+                       lteHelper, ueDevs.Get (1), enbDevs.Get (0));
+  Simulator::Schedule (MilliSeconds (150), &LteSkipIdleSubframesTestCase::Attach,
+                       lteHelper, ueDevs.Get (2), enbDevs.Get (0));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionEstablished",
+                   MakeCallback (&LteSkipIdleSubframesTestCase::ConnectionEstablished, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUePhy/ReportCurrentCellRsrpSinr",
+                   MakeCallback (&LteSkipIdleSubframesTestCase::RsrpSinr, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUePhy/UlPhyTransmission",
+                   MakeCallback (&LteSkipIdleSubframesTestCase::UlPhyTransmission, this));
+
+  Simulator::Stop (MilliSeconds (300));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  NS_TEST_EXPECT_MSG_EQ (m_connections, 3, "wrong number of RRC connections");
+  // the order of the simultaneous events of different UEs is not
+  // deterministic, since the channel orders its receivers by address
+  std::stable_sort (m_events.begin (), m_events.end (), EarlierEvent);
+  return m_events;
+}
+
+void
+LteSkipIdleSubframesTestCase::DoRun (void)
+{
+  std::vector<std::string> reference = Run (false);
+  std::vector<std::string> skipping = Run (true);
+  NS_TEST_ASSERT_MSG_EQ (skipping.size (), reference.size (), "wrong number of events");
+  for (uint32_t i = 0; i < reference.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (skipping.at (i), reference.at (i), "different event");
+    }
+  Config::Reset ();
+}
+
+
+/**
+ * Test suite for LteUePhy::SkipIdleSubframes
+ */
+class LteSkipIdleSubframesTestSuite : public TestSuite
+{
+public:
+  LteSkipIdleSubframesTestSuite ();
+};
+
+LteSkipIdleSubframesTestSuite::LteSkipIdleSubframesTestSuite ()
+  : TestSuite ("lte-skip-idle-subframes", SYSTEM)
+{
+  AddTestCase (new LteSkipIdleSubframesTestCase, TestCase::QUICK);
+}
+
+static LteSkipIdleSubframesTestSuite g_lteSkipIdleSubframesTestSuite;
@@ -0,0 +1,218 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/lte-stats-binary-file.h>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <vector>
+#include <string>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteStatsBinaryFileTest");
+
+/**
+ * Write samples in a binary stats file, with blocks of 2 rows so that
+ * the ring of blocks wraps around, read the file back and check it.
+ */
+class LteStatsBinaryFileTestCase : public TestCase
+{
+public:
+  /**
+   * \param window the aggregation window
+   */
+  LteStatsBinaryFileTestCase (Time window);
+  virtual ~LteStatsBinaryFileTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Write a sample
+   * \param imsi the value of the key column
+   * \param value the value of the value column
+   */
+  void Write (uint64_t imsi, double value);
+
+  /**
+   * Read the file back
+   * \param filename the name of the file
+   */
+  void Read (std::string filename);
+
+  Time m_window;                        ///< the aggregation window
+  Ptr<LteStatsBinaryFile> m_file;       ///< the file
+  std::vector<std::string> m_names;     ///< the names of the columns read
+  std::vector<char> m_types;            ///< the types of the columns read
+  std::vector<std::vector<double> > m_columns; ///< the columns read, as doubles
+};
+
+LteStatsBinaryFileTestCase::LteStatsBinaryFileTestCase (Time window)
+  : TestCase (window.IsZero () ? "Every sample" : "Aggregated samples"),
+    m_window (window)
+{
+}
+
+LteStatsBinaryFileTestCase::~LteStatsBinaryFileTestCase ()
+{
+}
+
+void
+LteStatsBinaryFileTestCase::Write (uint64_t imsi, double value)
+{
+  uint64_t keys[] = {imsi};
+  double values[] = {value};
+  m_file->Write (keys, values);
+}
+
+void
+LteStatsBinaryFileTestCase::Read (std::string filename)
+{
+  std::ifstream file (filename.c_str (), std::ios_base::binary);
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "can't open " << filename);
+  char magic[8];
+  uint32_t version = 0;
+  uint32_t nColumns = 0;
+  file.read (magic, 8);
+  file.read ((char *) &version, sizeof (version));
+  file.read ((char *) &nColumns, sizeof (nColumns));
+  NS_TEST_ASSERT_MSG_EQ (std::string (magic, 8), "LTESTATS", "wrong magic");
+  NS_TEST_ASSERT_MSG_EQ (version, 1, "wrong version");
+  for (uint32_t i = 0; i < nColumns; ++i)
+    {
+      char type;
+      uint8_t length;
+      file.read (&type, 1);
+      file.read ((char *) &length, 1);
+      std::string name (length, ' ');
+      file.read (&name[0], length);
+      m_types.push_back (type);
+      m_names.push_back (name);
+    }
+  m_columns.resize (nColumns);
+  uint32_t rows;
+  while (file.read ((char *) &rows, sizeof (rows)))
+    {
+      for (uint32_t i = 0; i < nColumns; ++i)
+        {
+          for (uint32_t r = 0; r < rows; ++r)
+            {
+              char buf[8];
+              file.read (buf, 8);
+              if (m_types[i] == 'u')
+                {
+                  uint64_t u;
+                  std::memcpy (&u, buf, 8);
+                  m_columns[i].push_back (u);
+                }
+              else
+                {
+                  double d;
+                  std::memcpy (&d, buf, 8);
+                  m_columns[i].push_back (d);
+                }
+            }
+        }
+    }
+}
+
+void
+LteStatsBinaryFileTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("lte-stats.bin");
+  std::vector<std::string> keys (1, "IMSI");
+  std::vector<std::string> values (1, "sinr");
+  m_file = Create<LteStatsBinaryFile> (filename, keys, values, m_window, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_file->IsOpen (), true, "can't open " << filename);
+
+  // 10 samples of UE 1 in the first 10 ms, 1 sample of UE 2 at 5 ms,
+  // then 10 samples of UE 1 in the next 10 ms
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (i), &LteStatsBinaryFileTestCase::Write, this, 1, i + 1.0);
+    }
+  Simulator::Schedule (MicroSeconds (5500), &LteStatsBinaryFileTestCase::Write, this, 2, -1.0);
+  Simulator::Run ();
+  m_file->Close ();
+  Simulator::Destroy ();
+
+  Read (filename);
+  std::remove (filename.c_str ());
+
+  if (m_window.IsZero ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_names.size (), 3, "wrong number of columns");
+      NS_TEST_ASSERT_MSG_EQ (m_names[0], "time", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_names[1], "IMSI", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_names[2], "sinr", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0].size (), 21, "wrong number of rows");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0][6], 5500000, "wrong time");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[1][6], 2, "wrong key");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[2][6], -1, "wrong value");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0][20], 19000000, "wrong time");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[1][20], 1, "wrong key");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[2][20], 20, "wrong value");
+    }
+  else
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_names.size (), 8, "wrong number of columns");
+      NS_TEST_ASSERT_MSG_EQ (m_names[2], "count", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_names[3], "sinr_mean", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_names[6], "sinr_p95", "wrong column");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0].size (), 3, "wrong number of rows");
+      // first window, UE 1 and UE 2
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0][0], 0, "wrong window");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[1][0], 1, "wrong key");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[2][0], 10, "wrong count");
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_columns[3][0], 5.5, 1e-12, "wrong mean");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[4][0], 1, "wrong minimum");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[5][0], 5, "wrong median");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[6][0], 10, "wrong 95th percentile");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[7][0], 10, "wrong maximum");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[1][1], 2, "wrong key");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[2][1], 1, "wrong count");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[5][1], -1, "wrong median");
+      // second window, UE 1 only
+      NS_TEST_ASSERT_MSG_EQ (m_columns[0][2], 10000000, "wrong window");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[1][2], 1, "wrong key");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[2][2], 10, "wrong count");
+      NS_TEST_ASSERT_MSG_EQ_TOL (m_columns[3][2], 15.5, 1e-12, "wrong mean");
+      NS_TEST_ASSERT_MSG_EQ (m_columns[7][2], 20, "wrong maximum");
+    }
+}
+
+
+/**
+ * Test suite of the binary output of the LTE stats calculators
+ */
+class LteStatsBinaryFileTestSuite : public TestSuite
+{
+public:
+  LteStatsBinaryFileTestSuite ();
+};
+
+LteStatsBinaryFileTestSuite::LteStatsBinaryFileTestSuite ()
+  : TestSuite ("lte-stats-binary-file", UNIT)
+{
+  AddTestCase (new LteStatsBinaryFileTestCase (Seconds (0)), TestCase::QUICK);
+  AddTestCase (new LteStatsBinaryFileTestCase (MilliSeconds (10)), TestCase::QUICK);
+}
+
+static LteStatsBinaryFileTestSuite g_lteStatsBinaryFileTestSuite;
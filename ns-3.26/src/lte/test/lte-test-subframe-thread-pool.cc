@@ -0,0 +1,235 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/config.h>
+#include <ns3/uinteger.h>
+#include <ns3/callback.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/eps-bearer.h>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteSubframeThreadPoolTest");
+
+/**
+ * Order the traced events by time, then by node
+ * \param a an event
+ * \param b another event
+ * \return true if a is earlier than b
+ */
+static bool
+EarlierEvent (const std::string &a, const std::string &b)
+{
+  int64_t ta = 0;
+  int64_t tb = 0;
+  std::istringstream (a) >> ta;
+  std::istringstream (b) >> tb;
+  return (ta < tb) || ((ta == tb) && (a < b));
+}
+
+/**
+ * Check that running the schedulers of the eNBs in a pool of threads
+ * gives the same allocations as running them at the start of the
+ * subframe of each eNB, whatever the number of threads.
+ */
+class LteSubframeThreadPoolTestCase : public TestCase
+{
+public:
+  LteSubframeThreadPoolTestCase ();
+  virtual ~LteSubframeThreadPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the scenario
+   * \param subframeThreads the value of LteHelper::SubframeThreads
+   * \return the events traced by the eNBs and the UEs
+   */
+  std::vector<std::string> Run (uint32_t subframeThreads);
+
+  /**
+   * Trace a DL allocation
+   * \param context the context
+   * \param frameNo the frame number
+   * \param subframeNo the subframe number
+   * \param rnti the RNTI
+   * \param mcs0 the MCS of the first TB
+   * \param size0 the size of the first TB
+   * \param mcs1 the MCS of the second TB
+   * \param size1 the size of the second TB
+   */
+  void DlScheduling (std::string context, uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                     uint8_t mcs0, uint16_t size0, uint8_t mcs1, uint16_t size1);
+  /**
+   * Trace an UL allocation
+   * \param context the context
+   * \param frameNo the frame number
+   * \param subframeNo the subframe number
+   * \param rnti the RNTI
+   * \param mcs the MCS of the TB
+   * \param size the size of the TB
+   */
+  void UlScheduling (std::string context, uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                     uint8_t mcs, uint16_t size);
+  /**
+   * Trace an RSRP and SINR report
+   * \param context the context
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param rsrp the RSRP
+   * \param sinr the SINR
+   */
+  void RsrpSinr (std::string context, uint16_t cellId, uint16_t rnti, double rsrp, double sinr);
+
+  std::vector<std::string> m_events; ///< the events traced
+};
+
+LteSubframeThreadPoolTestCase::LteSubframeThreadPoolTestCase ()
+  : TestCase ("Schedulers of the eNBs run in a pool of threads")
+{
+}
+
+LteSubframeThreadPoolTestCase::~LteSubframeThreadPoolTestCase ()
+{
+}
+
+void
+LteSubframeThreadPoolTestCase::DlScheduling (std::string context, uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                                             uint8_t mcs0, uint16_t size0, uint8_t mcs1, uint16_t size1)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " " << frameNo << "/" << subframeNo
+      << " RNTI " << rnti << " MCS " << (uint32_t) mcs0 << " size " << size0
+      << " MCS " << (uint32_t) mcs1 << " size " << size1;
+  m_events.push_back (oss.str ());
+}
+
+void
+LteSubframeThreadPoolTestCase::UlScheduling (std::string context, uint32_t frameNo, uint32_t subframeNo, uint16_t rnti,
+                                             uint8_t mcs, uint16_t size)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " " << frameNo << "/" << subframeNo
+      << " RNTI " << rnti << " MCS " << (uint32_t) mcs << " size " << size;
+  m_events.push_back (oss.str ());
+}
+
+void
+LteSubframeThreadPoolTestCase::RsrpSinr (std::string context, uint16_t cellId, uint16_t rnti, double rsrp, double sinr)
+{
+  std::ostringstream oss;
+  oss.precision (17);
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " RNTI " << rnti << " RSRP " << rsrp << " SINR " << sinr;
+  m_events.push_back (oss.str ());
+}
+
+std::vector<std::string>
+LteSubframeThreadPoolTestCase::Run (uint32_t subframeThreads)
+{
+  m_events.clear ();
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("SubframeThreads", UintegerValue (subframeThreads));
+  lteHelper->SetSchedulerType ("ns3::PfFfMacScheduler");
+  NodeContainer enbNodes;
+  enbNodes.Create (4);
+  NodeContainer ueNodes;
+  ueNodes.Create (12);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (1000.0 * i, 0.0, 30.0));
+    }
+  for (uint32_t i = 0; i < ueNodes.GetN (); ++i)
+    {
+      positionAlloc->Add (Vector (1000.0 * (i % 4) + 50.0 * (i / 4 + 1), 30.0 * (i / 4), 1.5));
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  // all the runs choose the same random access preambles
+  int64_t stream = lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1 + stream);
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      lteHelper->Attach (ueDevs.Get (i), enbDevs.Get (i % 4));
+    }
+  // saturated bearers, whose RLC always has data to send
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/LteEnbMac/DlScheduling",
+                   MakeCallback (&LteSubframeThreadPoolTestCase::DlScheduling, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/LteEnbMac/UlScheduling",
+                   MakeCallback (&LteSubframeThreadPoolTestCase::UlScheduling, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUePhy/ReportCurrentCellRsrpSinr",
+                   MakeCallback (&LteSubframeThreadPoolTestCase::RsrpSinr, this));
+
+  Simulator::Stop (MilliSeconds (200));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  // the order of the simultaneous events of different UEs is not
+  // deterministic, since the channel orders its receivers by address
+  std::stable_sort (m_events.begin (), m_events.end (), EarlierEvent);
+  return m_events;
+}
+
+void
+LteSubframeThreadPoolTestCase::DoRun (void)
+{
+  std::vector<std::string> reference = Run (0);
+  NS_TEST_ASSERT_MSG_GT (reference.size (), 1000, "too few events");
+  uint32_t threads[] = { 1, 4 };
+  for (uint32_t t = 0; t < 2; ++t)
+    {
+      std::vector<std::string> pooled = Run (threads[t]);
+      NS_TEST_ASSERT_MSG_EQ (pooled.size (), reference.size (), "wrong number of events with " << threads[t] << " threads");
+      for (uint32_t i = 0; i < reference.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (pooled.at (i), reference.at (i), "different event with " << threads[t] << " threads");
+        }
+    }
+}
+
+
+/**
+ * Test suite for LteHelper::SubframeThreads
+ */
+class LteSubframeThreadPoolTestSuite : public TestSuite
+{
+public:
+  LteSubframeThreadPoolTestSuite ();
+};
+
+LteSubframeThreadPoolTestSuite::LteSubframeThreadPoolTestSuite ()
+  : TestSuite ("lte-subframe-thread-pool", SYSTEM)
+{
+  AddTestCase (new LteSubframeThreadPoolTestCase, TestCase::QUICK);
+}
+
+static LteSubframeThreadPoolTestSuite g_lteSubframeThreadPoolTestSuite;
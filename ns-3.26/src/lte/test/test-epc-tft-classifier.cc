@@ -131,6 +131,65 @@ EpcTftClassifierTestCase::DoRun (void)
   NS_LOG_LOGIC (this << *udpPacket);
   uint32_t obtainedTftId = m_c ->Classify (udpPacket, m_d);
   NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad classification of UDP packet");
+  // the second time, the flow is found in the cache of the classifier
+  obtainedTftId = m_c ->Classify (udpPacket, m_d);
+  NS_TEST_ASSERT_MSG_EQ (obtainedTftId, m_tftId, "bad cached classification of UDP packet");
+}
+
+
+/**
+ * Check that the flows cached by the classifier are classified again
+ * when a TFT is added or deleted
+ */
+class EpcTftClassifierCacheTestCase : public TestCase
+{
+public:
+  EpcTftClassifierCacheTestCase ();
+  virtual ~EpcTftClassifierCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierCacheTestCase::EpcTftClassifierCacheTestCase ()
+  : TestCase ("flow cache invalidated on TFT addition and deletion")
+{
+}
+
+EpcTftClassifierCacheTestCase::~EpcTftClassifierCacheTestCase ()
+{
+}
+
+void
+EpcTftClassifierCacheTestCase::DoRun (void)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (Ipv4Address ("9.1.1.1"));
+  ipHeader.SetDestination (Ipv4Address ("8.1.1.1"));
+  ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (4);
+  udpHeader.SetDestinationPort (1234);
+  Ptr<Packet> udpPacket = Create<Packet> ();
+  udpPacket->AddHeader (udpHeader);
+  udpPacket->AddHeader (ipHeader);
+
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (udpPacket, EpcTft::UPLINK), 1, "bad classification before the addition");
+
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.direction = EpcTft::UPLINK;
+  pf.remotePortStart = 1234;
+  pf.remotePortEnd = 1234;
+  tft->Add (pf);
+  c->Add (tft, 2);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (udpPacket, EpcTft::UPLINK), 2, "bad classification after the addition");
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (udpPacket, EpcTft::DOWNLINK), 1, "bad classification in the other direction");
+
+  c->Delete (2);
+  NS_TEST_ASSERT_MSG_EQ (c->Classify (udpPacket, EpcTft::UPLINK), 1, "bad classification after the deletion");
 }
 
 
@@ -328,4 +387,12 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),     9,     5897,     0,    2), TestCase::QUICK);
   AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, Ipv4Address ("9.1.1.1"), Ipv4Address ("8.1.1.1"),  5897,       10,     0,    2), TestCase::QUICK);
 
+
+
+  ///////////////////////////////////////////
+  // check the flow cache
+  ///////////////////////////////////////////
+
+  AddTestCase (new EpcTftClassifierCacheTestCase (), TestCase::QUICK);
+
 }
@@ -85,18 +85,20 @@ struct EnbTestData
 class LteEpcE2eDataTestCase : public TestCase
 {
 public:
-  LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v);
+  LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v, bool s1uDirect = false);
   virtual ~LteEpcE2eDataTestCase ();
 
 private:
   virtual void DoRun (void);
   std::vector<EnbTestData> m_enbTestData;
+  bool m_s1uDirect;
 };
 
 
-LteEpcE2eDataTestCase::LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v)
+LteEpcE2eDataTestCase::LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v, bool s1uDirect)
   : TestCase (name),
-    m_enbTestData (v)
+    m_enbTestData (v),
+    m_s1uDirect (s1uDirect)
 {
   NS_LOG_FUNCTION (this << name);
 }
@@ -122,6 +124,7 @@ LteEpcE2eDataTestCase::DoRun ()
 
   // allow jumbo frames on the S1-U link
   epcHelper->SetAttribute ("S1uLinkMtu", UintegerValue (30000));
+  epcHelper->SetAttribute ("S1uDirect", BooleanValue (m_s1uDirect));
 
   Ptr<Node> pgw = epcHelper->GetPgwNode ();
   
@@ -447,5 +450,9 @@ LteEpcE2eDataTestSuite::LteEpcE2eDataTestSuite ()
   v9.push_back (e9);
   AddTestCase (new LteEpcE2eDataTestCase ("1 eNB, 1UE with aggregation", v9), TestCase::EXTENSIVE);
 
+  AddTestCase (new LteEpcE2eDataTestCase ("1 eNB, 1UE with direct S1-U", v1, true), TestCase::QUICK);
+  AddTestCase (new LteEpcE2eDataTestCase ("3 eNBs with direct S1-U", v4, true), TestCase::EXTENSIVE);
+  AddTestCase (new LteEpcE2eDataTestCase ("1 eNB, 1UE with fragmentation and direct S1-U", v8, true), TestCase::EXTENSIVE);
+
 
 }
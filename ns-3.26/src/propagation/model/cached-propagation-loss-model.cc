@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cached-propagation-loss-model.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+size_t
+CachedPropagationLossModel::PairHash::operator () (const Pair &pair) const
+{
+  uint64_t h = static_cast<uint64_t> (reinterpret_cast<uintptr_t> (pair.first)) * 0x9e3779b97f4a7c15ULL;
+  h ^= static_cast<uint64_t> (reinterpret_cast<uintptr_t> (pair.second)) + 0x7f4a7c15ULL + (h << 6) + (h >> 2);
+  return static_cast<size_t> (h ^ (h >> 32));
+}
+
+/**
+ * \param mobility a mobility model
+ * \return true if the mobility model does not move between course changes
+ */
+static bool
+IsStatic (Ptr<const MobilityModel> mobility)
+{
+  Vector velocity = mobility->GetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+  : m_model (0)
+{
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  // The callbacks were made from a const pointer in GetEndpointIndex,
+  // and are only equal to callbacks made from a const pointer.
+  const CachedPropagationLossModel *self = this;
+  for (std::vector<Endpoint>::iterator it = m_endpoints.begin (); it != m_endpoints.end (); ++it)
+    {
+      it->mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                   MakeCallback (&CachedPropagationLossModel::CourseChanged, self));
+    }
+  m_endpoints.clear ();
+  m_endpointIndex.clear ();
+  m_cache.clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  m_model = model;
+  m_cache.clear ();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+uint32_t
+CachedPropagationLossModel::GetEndpointIndex (Ptr<MobilityModel> mobility) const
+{
+  EndpointIndex::const_iterator it = m_endpointIndex.find (PeekPointer (mobility));
+  if (it != m_endpointIndex.end ())
+    {
+      return it->second;
+    }
+  Endpoint endpoint;
+  endpoint.mobility = mobility;
+  endpoint.epoch = 0;
+  uint32_t index = m_endpoints.size ();
+  m_endpoints.push_back (endpoint);
+  m_endpointIndex.insert (std::make_pair (PeekPointer (mobility), index));
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&CachedPropagationLossModel::CourseChanged, this));
+  return index;
+}
+
+void
+CachedPropagationLossModel::CourseChanged (Ptr<const MobilityModel> mobility) const
+{
+  EndpointIndex::const_iterator it = m_endpointIndex.find (PeekPointer (mobility));
+  NS_ASSERT (it != m_endpointIndex.end ());
+  m_endpoints[it->second].epoch++;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  if (m_model == 0)
+    {
+      return txPowerDbm;
+    }
+  if (!IsStatic (a) || !IsStatic (b))
+    {
+      return m_model->CalcRxPower (txPowerDbm, a, b);
+    }
+  Pair pair (PeekPointer (a), PeekPointer (b));
+  Cache::iterator it = m_cache.find (pair);
+  if (it == m_cache.end ())
+    {
+      Entry newEntry = Entry ();
+      newEntry.aIndex = GetEndpointIndex (a);
+      newEntry.bIndex = GetEndpointIndex (b);
+      it = m_cache.insert (std::make_pair (pair, newEntry)).first;
+    }
+  else if (it->second.txPowerDbm == txPowerDbm
+           && m_endpoints[it->second.aIndex].epoch == it->second.aEpoch
+           && m_endpoints[it->second.bIndex].epoch == it->second.bEpoch)
+    {
+      NS_LOG_LOGIC ("cache hit, rx power=" << it->second.rxPowerDbm << "dBm");
+      return it->second.rxPowerDbm;
+    }
+  Entry *entry = &it->second;
+  entry->aEpoch = m_endpoints[entry->aIndex].epoch;
+  entry->bEpoch = m_endpoints[entry->bIndex].epoch;
+  entry->txPowerDbm = txPowerDbm;
+  entry->rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  NS_LOG_LOGIC ("cache miss, rx power=" << entry->rxPowerDbm << "dBm");
+  return entry->rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+} // namespace ns3
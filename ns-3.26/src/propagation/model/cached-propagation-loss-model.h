@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include <map>
+#include <vector>
+#include "ns3/sgi-hashmap.h"
+#include "propagation-loss-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Memoizes the result of a deterministic propagation loss model
+ *
+ * The model set with SetModel (and the models chained to it with
+ * PropagationLossModel::SetNext) is evaluated once per (source,
+ * destination) pair of mobility models; the received power is then
+ * stored and returned as long as neither endpoint reports a course
+ * change. Each mobility model seen by this model carries an epoch which
+ * is incremented by its "CourseChange" trace source, and a cached entry
+ * is only valid if the epochs of both endpoints are the ones recorded
+ * when it was computed. Since a mobility model with a non-zero velocity
+ * moves without notifying a course change, pairs with a moving endpoint
+ * are never cached.
+ *
+ * The models chained to this one with SetNext are evaluated on every
+ * call, so stochastic models (e.g., NakagamiPropagationLossModel) are
+ * meant to be chained here rather than to the cached model:
+ *
+ * \code
+ *   Ptr<CachedPropagationLossModel> loss = CreateObject<CachedPropagationLossModel> ();
+ *   loss->SetModel (CreateObject<LogDistancePropagationLossModel> ());
+ *   loss->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+ * \endcode
+ *
+ * The cached model must be a function of the transmit power and of the
+ * positions of the endpoints only. An entry is recomputed when it is
+ * looked up with a transmit power different from the one it was
+ * computed with.
+ *
+ * Entries are kept in a hash table keyed by the pair of mobility models,
+ * so that a hit costs one hash and a few comparisons. Entries are never
+ * removed: stale entries are overwritten in place.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the deterministic propagation loss model (or chain of
+   *        models) whose result is cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  /**
+   * \return the propagation loss model whose result is cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel & operator = (const CachedPropagationLossModel &);
+
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /// A mobility model seen by this propagation loss model
+  struct Endpoint
+  {
+    Ptr<MobilityModel> mobility; //!< the mobility model
+    uint32_t epoch;              //!< number of course changes notified so far
+  };
+
+  /// The key of the hash table: the source and destination mobility models
+  typedef std::pair<const MobilityModel *, const MobilityModel *> Pair;
+
+  /// Hash function of the pairs of mobility models
+  struct PairHash
+  {
+    /**
+     * \param pair the pair of mobility models
+     * \return the hash of the pair
+     */
+    size_t operator () (const Pair &pair) const;
+  };
+
+  /// An entry of the hash table
+  struct Entry
+  {
+    uint32_t aIndex;        //!< index of the source in m_endpoints
+    uint32_t bIndex;        //!< index of the destination in m_endpoints
+    uint32_t aEpoch;        //!< epoch of the source when the entry was computed
+    uint32_t bEpoch;        //!< epoch of the destination when the entry was computed
+    double txPowerDbm;      //!< transmit power the entry was computed with
+    double rxPowerDbm;      //!< cached receive power
+  };
+
+  /**
+   * \param mobility a mobility model
+   * \return the index of the mobility model in m_endpoints
+   *
+   * A mobility model seen for the first time is added to m_endpoints and
+   * its "CourseChange" trace source is connected.
+   */
+  uint32_t GetEndpointIndex (Ptr<MobilityModel> mobility) const;
+  /**
+   * Invalidate the entries involving the given mobility model.
+   *
+   * \param mobility the mobility model whose course changed
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility) const;
+
+  /// Typedef for the index of the endpoints
+  typedef std::map<const MobilityModel *, uint32_t> EndpointIndex;
+  /// Typedef for the hash table of the cached entries
+  typedef sgi::hash_map<Pair, Entry, PairHash> Cache;
+
+  Ptr<PropagationLossModel> m_model;        //!< the model whose result is cached
+  mutable std::vector<Endpoint> m_endpoints; //!< mobility models seen so far
+  mutable EndpointIndex m_endpointIndex;     //!< index of each mobility model in m_endpoints
+  mutable Cache m_cache;                     //!< cached entries, by pair of mobility models
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
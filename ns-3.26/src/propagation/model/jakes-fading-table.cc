@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "jakes-fading-table.h"
+#include "jakes-process.h"
+#include "ns3/log.h"
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("JakesFadingTable");
+
+JakesFadingTable::JakesFadingTable (Ptr<const JakesProcess> process, Time duration, Time resolution)
+  : m_resolution (resolution.GetSeconds ())
+{
+  NS_LOG_FUNCTION (this << process << duration << resolution);
+  NS_ASSERT (resolution.IsStrictlyPositive ());
+  uint32_t nSamples = static_cast<uint32_t> (std::ceil (duration.GetSeconds () / m_resolution));
+  NS_ASSERT_MSG (nSamples >= 2, "The fading table must be longer than its resolution");
+  m_samples.reserve (nSamples);
+  for (uint32_t i = 0; i < nSamples; i++)
+    {
+      m_samples.push_back (process->GetComplexGainAt (Seconds (i * m_resolution)));
+    }
+  m_duration = TimeStep (resolution.GetTimeStep () * nSamples);
+  NS_LOG_LOGIC ("generated " << nSamples << " samples");
+}
+
+Time
+JakesFadingTable::GetDuration (void) const
+{
+  return m_duration;
+}
+
+std::complex<double>
+JakesFadingTable::GetComplexGain (Time t) const
+{
+  double position = std::fmod (t.GetSeconds () / m_resolution, static_cast<double> (m_samples.size ()));
+  if (position < 0)
+    {
+      position += m_samples.size ();
+    }
+  uint32_t i = static_cast<uint32_t> (position);
+  if (i >= m_samples.size ())
+    {
+      // rounding of fmod for values just below the size
+      i = m_samples.size () - 1;
+    }
+  uint32_t next = (i + 1 == m_samples.size ()) ? 0 : i + 1;
+  double fraction = position - i;
+  return m_samples[i] + (m_samples[next] - m_samples[i]) * fraction;
+}
+
+} // namespace ns3
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef JAKES_FADING_TABLE_H
+#define JAKES_FADING_TABLE_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include <complex>
+#include <vector>
+
+namespace ns3
+{
+class JakesProcess;
+
+/**
+ * \ingroup fading
+ *
+ * \brief A realization of a JakesProcess sampled at a fixed resolution.
+ *
+ * The table is filled once, by summing the oscillators of a
+ * JakesProcess at each sample time, and then read by any number of
+ * links, each at its own time offset. Reading the table interpolates
+ * linearly the complex gain between the two nearest samples, which is
+ * much cheaper than summing the oscillators at each call.
+ *
+ * The table wraps around at its end, so its duration should be long
+ * with respect to the coherence time of the process (the inverse of the
+ * Doppler frequency) for the links to look independent, and its
+ * resolution short with respect to it for the interpolation to be
+ * accurate.
+ */
+class JakesFadingTable : public SimpleRefCount<JakesFadingTable>
+{
+public:
+  /**
+   * Sample a process
+   * \param process the process to sample
+   * \param duration the duration of the table
+   * \param resolution the time between two samples
+   */
+  JakesFadingTable (Ptr<const JakesProcess> process, Time duration, Time resolution);
+
+  /**
+   * \return the duration of the table
+   */
+  Time GetDuration (void) const;
+  /**
+   * Get the complex gain at a given time of the table
+   * \param t the time; the table wraps around after its duration
+   * \return the interpolated complex gain
+   */
+  std::complex<double> GetComplexGain (Time t) const;
+
+private:
+  std::vector<std::complex<double> > m_samples; //!< the samples of the process
+  double m_resolution; //!< the time between two samples [s]
+  Time m_duration; //!< the duration of the table
+};
+
+} // namespace ns3
+
+#endif /* JAKES_FADING_TABLE_H */
@@ -77,6 +77,13 @@ JakesProcess::SetPropagationLossModel (Ptr<const PropagationLossModel> propagati
   ConstructOscillators ();
 }
 
+void
+JakesProcess::SetFadingTable (Ptr<const JakesFadingTable> table, Time offset)
+{
+  m_table = table;
+  m_tableOffset = offset;
+}
+
 void
 JakesProcess::SetNOscillators (unsigned int nOscillators)
 {
@@ -128,15 +135,26 @@ void
 JakesProcess::DoDispose ()
 {
   m_jakes = 0;
+  m_table = 0;
 }
 
 std::complex<double>
 JakesProcess::GetComplexGain () const
+{
+  if (m_table != 0)
+    {
+      return m_table->GetComplexGain (Now () + m_tableOffset);
+    }
+  return GetComplexGainAt (Now ());
+}
+
+std::complex<double>
+JakesProcess::GetComplexGainAt (Time t) const
 {
   std::complex<double> sumAplitude = std::complex<double> (0, 0);
   for (unsigned int i = 0; i < m_oscillators.size (); i++)
     {
-      sumAplitude += m_oscillators[i].GetValueAt (Now ());
+      sumAplitude += m_oscillators[i].GetValueAt (t);
     }
   return sumAplitude;
 }
@@ -23,6 +23,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/jakes-fading-table.h"
 #include <complex>
 
 namespace ns3
@@ -69,6 +70,12 @@ public:
    * \return the channel complex gain
    */
   std::complex<double> GetComplexGain () const;
+  /**
+   * Get the channel complex gain at a given time, summing the oscillators
+   * \param t the time
+   * \return the channel complex gain
+   */
+  std::complex<double> GetComplexGainAt (Time t) const;
   /**
    * Get the channel gain in dB
    * \return the channel gain [dB]
@@ -80,6 +87,13 @@ public:
    * \param model the propagation model using this class
    */
   void SetPropagationLossModel (Ptr<const PropagationLossModel> model);
+  /**
+   * Read the gain from a fading table instead of summing oscillators.
+   * The process then needs no propagation model.
+   * \param table the fading table
+   * \param offset the time of the table corresponding to time 0
+   */
+  void SetFadingTable (Ptr<const JakesFadingTable> table, Time offset);
 private:
   /**
    * This class Represents a single oscillator
@@ -128,6 +142,8 @@ private:
   unsigned int m_nOscillators;  //!< number of oscillators
   Ptr<UniformRandomVariable> m_uniformVariable; //!< random stream
   Ptr<const JakesPropagationLossModel> m_jakes; //!< pointer to the propagation loss model
+  Ptr<const JakesFadingTable> m_table; //!< the fading table, if any
+  Time m_tableOffset; //!< the time of the fading table corresponding to time 0
 };
 } // namespace ns3
 #endif // DOPPLER_PROCESS_H
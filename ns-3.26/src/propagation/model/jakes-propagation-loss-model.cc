@@ -21,6 +21,7 @@
 #include "jakes-propagation-loss-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/nstime.h"
 
 namespace ns3
 {
@@ -47,6 +48,19 @@ JakesPropagationLossModel::GetTypeId ()
     .SetParent<PropagationLossModel> ()
     .SetGroupName ("Propagation")
     .AddConstructor<JakesPropagationLossModel> ()
+    .AddAttribute ("FadingTableDuration",
+                   "The duration of the fading table shared by all the links. "
+                   "If zero, each link sums the oscillators of its own JakesProcess "
+                   "at each call instead.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&JakesPropagationLossModel::m_tableDuration),
+                   MakeTimeChecker ())
+    .AddAttribute ("FadingTableResolution",
+                   "The time between two samples of the fading table. It should be "
+                   "small with respect to the inverse of the Doppler frequency.",
+                   TimeValue (MicroSeconds (100)),
+                   MakeTimeAccessor (&JakesPropagationLossModel::m_tableResolution),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
@@ -59,13 +73,34 @@ JakesPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   Ptr<JakesProcess> pathData = m_propagationCache.GetPathData (a, b, 0 /**Spectrum model uid is not used in PropagationLossModel*/);
   if (pathData == 0)
     {
-      pathData = CreateObject<JakesProcess> ();
-      pathData->SetPropagationLossModel (this);
+      pathData = CreateProcess ();
       m_propagationCache.AddPathData (pathData, a, b, 0 /**Spectrum model uid is not used in PropagationLossModel*/);
     }
   return txPowerDbm + pathData->GetChannelGainDb ();
 }
 
+Ptr<JakesProcess>
+JakesPropagationLossModel::CreateProcess () const
+{
+  Ptr<JakesProcess> process = CreateObject<JakesProcess> ();
+  if (m_tableDuration.IsZero ())
+    {
+      process->SetPropagationLossModel (this);
+      return process;
+    }
+  if (m_fadingTable == 0)
+    {
+      process->SetPropagationLossModel (this);
+      m_fadingTable = Create<JakesFadingTable> (process, m_tableDuration, m_tableResolution);
+      process->Dispose ();
+      process = CreateObject<JakesProcess> ();
+    }
+  // the random variable is uniform over [-pi, pi)
+  double offset = (m_uniformVariable->GetValue () + M_PI) / (2 * M_PI);
+  process->SetFadingTable (m_fadingTable, Seconds (m_fadingTable->GetDuration ().GetSeconds () * offset));
+  return process;
+}
+
 Ptr<UniformRandomVariable>
 JakesPropagationLossModel::GetUniformRandomVariable () const
 {
@@ -23,6 +23,7 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-cache.h"
 #include "ns3/jakes-process.h"
+#include "ns3/jakes-fading-table.h"
 
 namespace ns3
 {
@@ -31,6 +32,11 @@ namespace ns3
  *
  * \brief a  Jakes narrowband propagation model.
  * Symmetrical cache for JakesProcess
+ *
+ * When the FadingTableDuration attribute is not zero, a single
+ * realization of a JakesProcess is sampled in a JakesFadingTable the
+ * first time the model is used, and each link reads this table from a
+ * random offset instead of summing its own oscillators at each call.
  */
 
 class JakesPropagationLossModel : public PropagationLossModel
@@ -70,8 +76,16 @@ private:
    * \return the RNG stream
    */
   Ptr<UniformRandomVariable> GetUniformRandomVariable () const;
+  /**
+   * Create the process of a new link
+   * \return the process
+   */
+  Ptr<JakesProcess> CreateProcess () const;
 
   Ptr<UniformRandomVariable> m_uniformVariable; //!< random stream
+  Time m_tableDuration; //!< duration of the fading table, 0 if not used
+  Time m_tableResolution; //!< time between two samples of the fading table
+  mutable Ptr<JakesFadingTable> m_fadingTable; //!< the fading table shared by all links, created on first use
   mutable PropagationCache<JakesProcess> m_propagationCache; //!< Propagation cache
 };
 
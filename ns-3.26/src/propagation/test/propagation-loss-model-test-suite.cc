@@ -21,8 +21,13 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/string.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/cached-propagation-loss-model.h"
+#include "ns3/jakes-propagation-loss-model.h"
+#include "ns3/jakes-fading-table.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/simulator.h"
 
 using namespace ns3;
@@ -436,6 +441,134 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+  virtual ~CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase ()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  // A random model returns a different value on each call, unless its
+  // result is served from the cache
+  Ptr<RandomPropagationLossModel> random = CreateObject<RandomPropagationLossModel> ();
+  random->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+  Ptr<CachedPropagationLossModel> lossModel = CreateObject<CachedPropagationLossModel> ();
+  lossModel->SetModel (random);
+
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0,0,0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (100,0,0));
+
+  double txPwrdBm = 10.0;
+  double first = lossModel->CalcRxPower (txPwrdBm, a, b);
+  NS_TEST_EXPECT_MSG_EQ (lossModel->CalcRxPower (txPwrdBm, a, b), first, "Loss of a static pair not cached");
+  b->SetPosition (Vector (200,0,0));
+  double second = lossModel->CalcRxPower (txPwrdBm, a, b);
+  NS_TEST_EXPECT_MSG_NE (second, first, "Cache not invalidated by a course change");
+  NS_TEST_EXPECT_MSG_EQ (lossModel->CalcRxPower (txPwrdBm, a, b), second, "Loss not cached after a course change");
+  NS_TEST_EXPECT_MSG_NE (lossModel->CalcRxPower (txPwrdBm + 1, a, b), second + 1, "Cache not invalidated by a different tx power");
+
+  Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel> ();
+  c->SetPosition (Vector (0,100,0));
+  c->SetVelocity (Vector (1,0,0));
+  NS_TEST_EXPECT_MSG_NE (lossModel->CalcRxPower (txPwrdBm, a, c), lossModel->CalcRxPower (txPwrdBm, a, c),
+                         "Loss of a moving pair cached");
+
+  // The models chained to the cached model are not cached
+  Ptr<RandomPropagationLossModel> next = CreateObject<RandomPropagationLossModel> ();
+  next->SetAttribute ("Variable", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=100.0]"));
+  lossModel->SetNext (next);
+  NS_TEST_EXPECT_MSG_NE (lossModel->CalcRxPower (txPwrdBm, a, b), lossModel->CalcRxPower (txPwrdBm, a, b),
+                         "Loss of the chained model cached");
+
+  lossModel->Dispose ();
+  Simulator::Destroy ();
+}
+
+class JakesFadingTableTestCase : public TestCase
+{
+public:
+  JakesFadingTableTestCase ();
+  virtual ~JakesFadingTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+JakesFadingTableTestCase::JakesFadingTableTestCase ()
+  : TestCase ("Test JakesFadingTable")
+{
+}
+
+JakesFadingTableTestCase::~JakesFadingTableTestCase ()
+{
+}
+
+void
+JakesFadingTableTestCase::DoRun (void)
+{
+  Ptr<JakesPropagationLossModel> lossModel = CreateObject<JakesPropagationLossModel> ();
+  Ptr<JakesProcess> process = CreateObject<JakesProcess> ();
+  process->SetPropagationLossModel (lossModel);
+  Ptr<JakesFadingTable> table = Create<JakesFadingTable> (process, Seconds (1), MicroSeconds (100));
+  NS_TEST_EXPECT_MSG_EQ (table->GetDuration (), Seconds (1), "Wrong table duration");
+
+  // The table matches the process at the samples, is close to it
+  // between the samples, and wraps around after its duration
+  double tolerance = 0.01;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Time t = MicroSeconds (i * 730);
+      std::complex<double> expected = process->GetComplexGainAt (t);
+      std::complex<double> interpolated = table->GetComplexGain (t);
+      NS_TEST_EXPECT_MSG_EQ_TOL (interpolated.real (), expected.real (), tolerance, "Table differs from the process at " << t);
+      NS_TEST_EXPECT_MSG_EQ_TOL (interpolated.imag (), expected.imag (), tolerance, "Table differs from the process at " << t);
+      expected = process->GetComplexGainAt (t + MicroSeconds (50));
+      interpolated = table->GetComplexGain (t + MicroSeconds (50));
+      NS_TEST_EXPECT_MSG_EQ_TOL (interpolated.real (), expected.real (), tolerance, "Table differs from the process at " << t);
+      NS_TEST_EXPECT_MSG_EQ_TOL (interpolated.imag (), expected.imag (), tolerance, "Table differs from the process at " << t);
+      std::complex<double> wrapped = table->GetComplexGain (t + MicroSeconds (50) + Seconds (1));
+      NS_TEST_EXPECT_MSG_EQ_TOL (wrapped.real (), interpolated.real (), 1e-9, "Table does not wrap around at " << t);
+      NS_TEST_EXPECT_MSG_EQ_TOL (wrapped.imag (), interpolated.imag (), 1e-9, "Table does not wrap around at " << t);
+    }
+  process->Dispose ();
+
+  // The links of a model using a table have a unit mean power gain, and
+  // a link keeps its gain
+  lossModel->SetAttribute ("FadingTableDuration", TimeValue (Seconds (10)));
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  std::vector<Ptr<MobilityModel> > b;
+  double sum = 0;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      b.push_back (CreateObject<ConstantPositionMobilityModel> ());
+      sum += std::pow (10, lossModel->CalcRxPower (0, a, b.back ()) / 10);
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sum / b.size (), 1, 0.15, "Wrong mean power gain");
+  double first = lossModel->CalcRxPower (0, a, b[0]);
+  NS_TEST_EXPECT_MSG_EQ (lossModel->CalcRxPower (0, b[0], a), first, "Links are not symmetrical");
+  NS_TEST_EXPECT_MSG_NE (lossModel->CalcRxPower (0, a, b[1]), first, "Links share the same offset");
+
+  lossModel->Dispose ();
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +583,8 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new JakesFadingTableTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
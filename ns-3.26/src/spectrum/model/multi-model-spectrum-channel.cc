@@ -82,6 +82,7 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_maxDistance (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -95,6 +96,7 @@ MultiModelSpectrumChannel::DoDispose ()
   m_spectrumPropagationLoss = 0;
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_receiverGrids.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -119,6 +121,21 @@ MultiModelSpectrumChannel::GetTypeId (void)
                    DoubleValue (1.0e9),
                    MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxDistance",
+                   "If not zero, transmissions are not passed to the "
+                   "receivers farther than this distance in meters from "
+                   "the transmitter, and neither the path loss to these "
+                   "receivers is computed nor the PathLoss trace fired. "
+                   "The receivers are indexed by position, so that the "
+                   "receivers out of range are not even iterated over. "
+                   "Receivers without a MobilityModel always receive the "
+                   "transmissions. Like MaxLossDb, this value is to be "
+                   "tuned with care: it should be beyond the interference "
+                   "range of the transmitters.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::SetMaxDistance,
+                                       &MultiModelSpectrumChannel::GetMaxDistance),
+                   MakeDoubleChecker<double> (0))
     .AddTraceSource ("PathLoss",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The first and second parameters "
@@ -165,6 +182,10 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       if (phyIt !=  rxInfoIterator->second.m_rxPhySet.end ())
         {
           rxInfoIterator->second.m_rxPhySet.erase (phyIt);
+          if (m_maxDistance > 0)
+            {
+              m_receiverGrids[rxInfoIterator->first].Remove (phy);
+            }
           --m_numDevices;
           break; // there should be at most one entry
         }       
@@ -204,10 +225,54 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       NS_ASSERT (ret2.second);
     }
 
+  if (m_maxDistance > 0)
+    {
+      AddToReceiverGrid (rxSpectrumModelUid, phy);
+    }
+}
+
+void
+MultiModelSpectrumChannel::AddToReceiverGrid (SpectrumModelUid_t rxSpectrumModelUid, Ptr<SpectrumPhy> phy)
+{
+  SpectrumReceiverGrid &grid = m_receiverGrids[rxSpectrumModelUid];
+  if (grid.GetRange () != m_maxDistance)
+    {
+      grid.SetRange (m_maxDistance);
+    }
+  // sort the receivers as in m_rxPhySet
+  grid.Add (phy, reinterpret_cast<uintptr_t> (PeekPointer (phy)));
+}
+
+void
+MultiModelSpectrumChannel::SetMaxDistance (double maxDistance)
+{
+  NS_LOG_FUNCTION (this << maxDistance);
+  m_maxDistance = maxDistance;
+  m_receiverGrids.clear ();
+  if (m_maxDistance > 0)
+    {
+      for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+           rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+           ++rxInfoIterator)
+        {
+          for (std::set<Ptr<SpectrumPhy> >::const_iterator phyIt = rxInfoIterator->second.m_rxPhySet.begin ();
+               phyIt != rxInfoIterator->second.m_rxPhySet.end ();
+               ++phyIt)
+            {
+              AddToReceiverGrid (rxInfoIterator->first, *phyIt);
+            }
+        }
+    }
+}
+
+double
+MultiModelSpectrumChannel::GetMaxDistance (void) const
+{
+  return m_maxDistance;
 }
 
 
-TxSpectrumModelInfoMap_t::const_iterator
+TxSpectrumModelInfoMap_t::iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel)
 {
   NS_LOG_FUNCTION (this << txSpectrumModel);
@@ -259,13 +324,14 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_ASSERT (txParams->txPhy);
   NS_ASSERT (txParams->psd);
 
+  m_txSigParamsTrace (txParams);
 
   Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
   NS_LOG_LOGIC (" txSpectrumModelUid " << txSpectrumModelUid);
 
   //
-  TxSpectrumModelInfoMap_t::const_iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
+  TxSpectrumModelInfoMap_t::iterator txInfoIteratorerator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
   NS_ASSERT (txInfoIteratorerator != m_txSpectrumModelInfoMap.end ());
 
   NS_LOG_LOGIC ("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
@@ -279,6 +345,17 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
       NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
 
+      std::vector<Ptr<SpectrumPhy> > receiversInRange;
+      bool useGrid = m_maxDistance > 0 && txMobility;
+      if (useGrid)
+        {
+          m_receiverGrids[rxSpectrumModelUid].GetReceivers (txMobility->GetPosition (), receiversInRange);
+          if (receiversInRange.empty ())
+            {
+              continue;
+            }
+        }
+
       Ptr <SpectrumValue> convertedTxPowerSpectrum;
       if (txSpectrumModelUid == rxSpectrumModelUid)
         {
@@ -288,92 +365,192 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       else
         {
           NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          NS_ASSERT (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ());
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+          TxSpectrumModelInfo::ConvertedPsd &converted = txInfoIteratorerator->second.m_convertedPsdMap[rxSpectrumModelUid];
+          if (converted.txPsd != txParams->psd)
+            {
+              SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+              NS_ASSERT (rxConverterIterator != txInfoIteratorerator->second.m_spectrumConverterMap.end ());
+              converted.txPsd = txParams->psd;
+              converted.rxPsd = rxConverterIterator->second.Convert (txParams->psd);
+            }
+          convertedTxPowerSpectrum = converted.rxPsd;
         }
 
+      // SpectrumSignalParameters::Copy () gives each receiver a private
+      // copy of the PSD, which is scaled in place: have it copy the
+      // converted PSD rather than the transmitted one.
+      Ptr<SpectrumValue> txPsd = txParams->psd;
+      txParams->psd = convertedTxPowerSpectrum;
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
-           ++rxPhyIterator)
+      if (useGrid)
         {
-          NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
-                         "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
-
-          if ((*rxPhyIterator) != txParams->txPhy)
+          for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = receiversInRange.begin ();
+               rxPhyIterator != receiversInRange.end ();
+               ++rxPhyIterator)
+            {
+              StartTxToReceiver (txParams, txMobility, *rxPhyIterator);
+            }
+        }
+      else
+        {
+          for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
+               rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+               ++rxPhyIterator)
             {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
-
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
-
-              if (txMobility && receiverMobility)
-                {
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if ( pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
-
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
-
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
-                }
-
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
-                {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
-                }
-              else
-                {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
-                }
+              StartTxToReceiver (txParams, txMobility, *rxPhyIterator);
             }
         }
+      txParams->psd = txPsd;
+    }
+
+}
+
+void
+MultiModelSpectrumChannel::StartTxToReceiver (Ptr<SpectrumSignalParameters> txParams,
+                                              Ptr<MobilityModel> txMobility,
+                                              Ptr<SpectrumPhy> rxPhy)
+{
+  NS_ASSERT_MSG (rxPhy->GetRxSpectrumModel ()->GetUid () == txParams->psd->GetSpectrumModelUid (),
+                 "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
+
+  if (rxPhy == txParams->txPhy)
+    {
+      return;
+    }
+
+  Time delay = MicroSeconds (0);
+  Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility ();
+  Ptr<SpectrumSignalParameters> rxParams;
+
+  if (txMobility && receiverMobility)
+    {
+      // the path loss is computed first, so that nothing is copied for
+      // the receivers which are out of range
+      double pathLossDb = CalcPathLossDb (txParams, txMobility, receiverMobility, rxPhy->GetRxAntenna ());
+      m_pathLossTrace (txParams->txPhy, rxPhy, pathLossDb);
+      if ( pathLossDb > m_maxLossDb)
+        {
+          // beyond range
+          return;
+        }
+      NS_LOG_LOGIC (" copying signal parameters " << txParams);
+      rxParams = txParams->Copy ();
+      double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+      *(rxParams->psd) *= pathGainLinear;
+
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
+        }
+
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+        }
+    }
+  else
+    {
+      NS_LOG_LOGIC (" copying signal parameters " << txParams);
+      rxParams = txParams->Copy ();
+    }
+
+  Ptr<NetDevice> netDev = rxPhy->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                      rxParams, rxPhy);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                           rxParams, rxPhy);
+    }
+}
 
+double
+MultiModelSpectrumChannel::CalcPathLossDb (Ptr<const SpectrumSignalParameters> txParams,
+                                           Ptr<MobilityModel> txMobility,
+                                           Ptr<MobilityModel> rxMobility,
+                                           Ptr<AntennaModel> rxAntenna) const
+{
+  double pathLossDb = 0;
+  if (txParams->txAntenna != 0)
+    {
+      Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+      double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+      pathLossDb -= txAntennaGain;
     }
+  if (rxAntenna != 0)
+    {
+      Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+      pathLossDb -= rxAntennaGain;
+    }
+  if (m_propagationLoss)
+    {
+      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+      pathLossDb -= propagationGainDb;
+    }
+  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+  return pathLossDb;
+}
 
+Ptr<SpectrumValue>
+MultiModelSpectrumChannel::CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                                       Ptr<MobilityModel> rxMobility,
+                                                       Ptr<AntennaModel> rxAntenna,
+                                                       Ptr<const SpectrumModel> rxSpectrumModel)
+{
+  NS_LOG_FUNCTION (this << txParams << rxMobility);
+  NS_ASSERT (txParams->psd);
+  Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
+  NS_ASSERT_MSG (txMobility && rxMobility, "the transmitter and the receiver must have a MobilityModel");
+  if (m_maxDistance > 0 && txMobility->GetDistanceFrom (rxMobility) > m_maxDistance)
+    {
+      return 0;
+    }
+  double pathLossDb = CalcPathLossDb (txParams, txMobility, rxMobility, rxAntenna);
+  if (pathLossDb > m_maxLossDb)
+    {
+      return 0;
+    }
+  Ptr<SpectrumValue> rxPsd;
+  SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid ();
+  if (txParams->psd->GetSpectrumModelUid () == rxSpectrumModelUid)
+    {
+      rxPsd = txParams->psd->Copy ();
+    }
+  else
+    {
+      // the receiver is not necessarily attached to the channel, so
+      // the converter to its SpectrumModel may have to be created
+      TxSpectrumModelInfoMap_t::iterator txInfoIterator = FindAndEventuallyAddTxSpectrumModel (txParams->psd->GetSpectrumModel ());
+      TxSpectrumModelInfo::ConvertedPsd &converted = txInfoIterator->second.m_convertedPsdMap[rxSpectrumModelUid];
+      if (converted.txPsd != txParams->psd)
+        {
+          SpectrumConverterMap_t::iterator rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+          if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end ())
+            {
+              SpectrumConverter converter (txParams->psd->GetSpectrumModel (), rxSpectrumModel);
+              rxConverterIterator = txInfoIterator->second.m_spectrumConverterMap.insert (std::make_pair (rxSpectrumModelUid, converter)).first;
+            }
+          converted.txPsd = txParams->psd;
+          converted.rxPsd = rxConverterIterator->second.Convert (txParams->psd);
+        }
+      rxPsd = converted.rxPsd->Copy ();
+    }
+  *rxPsd *= std::pow (10.0, (-pathLossDb) / 10.0);
+  if (m_spectrumPropagationLoss)
+    {
+      rxPsd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, txMobility, rxMobility);
+    }
+  return rxPsd;
 }
 
 void
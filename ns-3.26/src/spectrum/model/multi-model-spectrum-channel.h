@@ -24,6 +24,7 @@
 
 #include <ns3/spectrum-value.h>
 #include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-receiver-grid.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
@@ -53,8 +54,22 @@ public:
    */
   TxSpectrumModelInfo (Ptr<const SpectrumModel> txSpectrumModel);
 
+  /**
+   * The last transmitted PSD which was converted to a given Rx
+   * SpectrumModel, and the result of the conversion. Transmitted PSDs
+   * are not modified once handed to the channel, hence a PHY sending
+   * the same PSD again (e.g., a SpectrumWifiPhy transmitting at
+   * constant power) is served the same converted PSD.
+   */
+  struct ConvertedPsd
+  {
+    Ptr<const SpectrumValue> txPsd; //!< the transmitted PSD
+    Ptr<SpectrumValue> rxPsd;       //!< the transmitted PSD converted to the Rx SpectrumModel
+  };
+
   Ptr<const SpectrumModel> m_txSpectrumModel;     //!< Tx Spectrum model.
   SpectrumConverterMap_t m_spectrumConverterMap;  //!< Spectrum converter.
+  std::map<SpectrumModelUid_t, ConvertedPsd> m_convertedPsdMap; //!< last conversion to each Rx SpectrumModel
 };
 
 
@@ -121,6 +136,10 @@ public:
   virtual void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
   virtual void AddRx (Ptr<SpectrumPhy> phy);
   virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+  virtual Ptr<SpectrumValue> CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                                         Ptr<MobilityModel> rxMobility,
+                                                         Ptr<AntennaModel> rxAntenna,
+                                                         Ptr<const SpectrumModel> rxSpectrumModel);
 
 
   // inherited from Channel
@@ -133,6 +152,15 @@ public:
    */
   virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
+  /**
+   * \param maxDistance the distance (m) beyond which receivers are
+   *        ignored, or zero to consider all the receivers
+   */
+  void SetMaxDistance (double maxDistance);
+  /**
+   * \return the distance (m) beyond which receivers are ignored
+   */
+  double GetMaxDistance (void) const;
 
 protected:
   void DoDispose ();
@@ -148,7 +176,7 @@ private:
    *
    * @return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
    */
-  TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
+  TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
 
   /**
    * Used internally to reschedule transmission after the propagation delay.
@@ -158,6 +186,42 @@ private:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Compute the single-frequency loss between a transmitter and a
+   * receiver, including the gains of their antennas.
+   *
+   * \param txParams the parameters of the transmission
+   * \param txMobility the mobility model of the transmitter
+   * \param rxMobility the mobility model of the receiver
+   * \param rxAntenna the antenna of the receiver, or 0
+   * \return the loss [dB]
+   */
+  double CalcPathLossDb (Ptr<const SpectrumSignalParameters> txParams,
+                         Ptr<MobilityModel> txMobility,
+                         Ptr<MobilityModel> rxMobility,
+                         Ptr<AntennaModel> rxAntenna) const;
+
+  /**
+   * Compute the path loss from the transmitter to a receiver and, if
+   * the receiver is in range, schedule the reception of the signal.
+   *
+   * @param txParams The signal parameters, whose PSD is already converted
+   * to the SpectrumModel of the receiver.
+   * @param txMobility The mobility model of the transmitter.
+   * @param rxPhy A pointer to the receiver SpectrumPhy.
+   */
+  void StartTxToReceiver (Ptr<SpectrumSignalParameters> txParams,
+                          Ptr<MobilityModel> txMobility,
+                          Ptr<SpectrumPhy> rxPhy);
+
+  /**
+   * Add a receiver to the grid of its Rx SpectrumModel.
+   *
+   * @param rxSpectrumModelUid The Uid of the Rx SpectrumModel of the receiver.
+   * @param phy A pointer to the receiver SpectrumPhy.
+   */
+  void AddToReceiverGrid (SpectrumModelUid_t rxSpectrumModelUid, Ptr<SpectrumPhy> phy);
+
   /**
    * Propagation delay model to be used with this channel.
    */
@@ -201,6 +265,17 @@ private:
    */
   double m_maxLossDb;
 
+  /**
+   * Maximum distance [m] of the receivers, zero if disabled.
+   */
+  double m_maxDistance;
+
+  /**
+   * Index of the positions of the receivers of each Rx SpectrumModel,
+   * used if m_maxDistance is not zero.
+   */
+  std::map<SpectrumModelUid_t, SpectrumReceiverGrid> m_receiverGrids;
+
   /**
    * \deprecated The non-const \c Ptr<SpectrumPhy> argument
    * is deprecated and will be changed to \c Ptr<const SpectrumPhy>
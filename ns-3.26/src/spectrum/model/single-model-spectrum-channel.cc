@@ -45,6 +45,7 @@ NS_LOG_COMPONENT_DEFINE ("SingleModelSpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED (SingleModelSpectrumChannel);
 
 SingleModelSpectrumChannel::SingleModelSpectrumChannel ()
+  : m_maxDistance (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -53,6 +54,7 @@ void
 SingleModelSpectrumChannel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_receiverGrid.Clear ();
   m_phyList.clear ();
   m_spectrumModel = 0;
   m_propagationDelay = 0;
@@ -83,6 +85,21 @@ SingleModelSpectrumChannel::GetTypeId (void)
                    DoubleValue (1.0e9),
                    MakeDoubleAccessor (&SingleModelSpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxDistance",
+                   "If not zero, transmissions are not passed to the "
+                   "receivers farther than this distance in meters from "
+                   "the transmitter, and neither the path loss to these "
+                   "receivers is computed nor the PathLoss trace fired. "
+                   "The receivers are indexed by position, so that the "
+                   "receivers out of range are not even iterated over. "
+                   "Receivers without a MobilityModel always receive the "
+                   "transmissions. Like MaxLossDb, this value is to be "
+                   "tuned with care: it should be beyond the interference "
+                   "range of the transmitters.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&SingleModelSpectrumChannel::SetMaxDistance,
+                                       &SingleModelSpectrumChannel::GetMaxDistance),
+                   MakeDoubleChecker<double> (0))
     .AddTraceSource ("PathLoss",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The first and second parameters "
@@ -107,6 +124,32 @@ SingleModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
   m_phyList.push_back (phy);
+  if (m_maxDistance > 0)
+    {
+      m_receiverGrid.Add (phy, m_phyList.size () - 1);
+    }
+}
+
+void
+SingleModelSpectrumChannel::SetMaxDistance (double maxDistance)
+{
+  NS_LOG_FUNCTION (this << maxDistance);
+  m_maxDistance = maxDistance;
+  m_receiverGrid.Clear ();
+  if (m_maxDistance > 0)
+    {
+      m_receiverGrid.SetRange (m_maxDistance);
+      for (uint32_t i = 0; i < m_phyList.size (); ++i)
+        {
+          m_receiverGrid.Add (m_phyList[i], i);
+        }
+    }
+}
+
+double
+SingleModelSpectrumChannel::GetMaxDistance (void) const
+{
+  return m_maxDistance;
 }
 
 
@@ -129,13 +172,22 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
       NS_ASSERT (*(txParams->psd->GetSpectrumModel ()) == *m_spectrumModel);
     }
 
+  m_txSigParamsTrace (txParams);
+
 
 
 
   Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility ();
+  const PhyList *receivers = &m_phyList;
+  PhyList receiversInRange;
+  if (m_maxDistance > 0 && senderMobility)
+    {
+      m_receiverGrid.GetReceivers (senderMobility->GetPosition (), receiversInRange);
+      receivers = &receiversInRange;
+    }
 
-  for (PhyList::const_iterator rxPhyIterator = m_phyList.begin ();
-       rxPhyIterator != m_phyList.end ();
+  for (PhyList::const_iterator rxPhyIterator = receivers->begin ();
+       rxPhyIterator != receivers->end ();
        ++rxPhyIterator)
     {
       if ((*rxPhyIterator) != txParams->txPhy)
@@ -143,40 +195,21 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
           Time delay  = MicroSeconds (0);
 
           Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
-          NS_LOG_LOGIC ("copying signal parameters " << txParams);
-          Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+          Ptr<SpectrumSignalParameters> rxParams;
 
           if (senderMobility && receiverMobility)
             {
-              double pathLossDb = 0;
-              if (rxParams->txAntenna != 0)
-                {
-                  Angles txAngles (receiverMobility->GetPosition (), senderMobility->GetPosition ());
-                  double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                  NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                  pathLossDb -= txAntennaGain;
-                }
-              Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-              if (rxAntenna != 0)
-                {
-                  Angles rxAngles (senderMobility->GetPosition (), receiverMobility->GetPosition ());
-                  double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                  NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                  pathLossDb -= rxAntennaGain;
-                }
-              if (m_propagationLoss)
-                {
-                  double propagationGainDb = m_propagationLoss->CalcRxPower (0, senderMobility, receiverMobility);
-                  NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                  pathLossDb -= propagationGainDb;
-                }                    
-              NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
+              // the path loss is computed first, so that nothing is
+              // copied for the receivers which are out of range
+              double pathLossDb = CalcPathLossDb (txParams, senderMobility, receiverMobility, (*rxPhyIterator)->GetRxAntenna ());
               m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
               if ( pathLossDb > m_maxLossDb)
                 {
                   // beyond range
                   continue;
                 }
+              NS_LOG_LOGIC ("copying signal parameters " << txParams);
+              rxParams = txParams->Copy ();
               double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
               *(rxParams->psd) *= pathGainLinear;              
 
@@ -190,6 +223,11 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                   delay = m_propagationDelay->GetDelay (senderMobility, receiverMobility);
                 }
             }
+          else
+            {
+              NS_LOG_LOGIC ("copying signal parameters " << txParams);
+              rxParams = txParams->Copy ();
+            }
 
 
           Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
@@ -210,6 +248,67 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
 }
 
+double
+SingleModelSpectrumChannel::CalcPathLossDb (Ptr<const SpectrumSignalParameters> txParams,
+                                            Ptr<MobilityModel> txMobility,
+                                            Ptr<MobilityModel> rxMobility,
+                                            Ptr<AntennaModel> rxAntenna) const
+{
+  double pathLossDb = 0;
+  if (txParams->txAntenna != 0)
+    {
+      Angles txAngles (rxMobility->GetPosition (), txMobility->GetPosition ());
+      double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+      pathLossDb -= txAntennaGain;
+    }
+  if (rxAntenna != 0)
+    {
+      Angles rxAngles (txMobility->GetPosition (), rxMobility->GetPosition ());
+      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+      pathLossDb -= rxAntennaGain;
+    }
+  if (m_propagationLoss)
+    {
+      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, rxMobility);
+      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+      pathLossDb -= propagationGainDb;
+    }
+  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+  return pathLossDb;
+}
+
+Ptr<SpectrumValue>
+SingleModelSpectrumChannel::CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                                        Ptr<MobilityModel> rxMobility,
+                                                        Ptr<AntennaModel> rxAntenna,
+                                                        Ptr<const SpectrumModel> rxSpectrumModel)
+{
+  NS_LOG_FUNCTION (this << txParams << rxMobility);
+  NS_ASSERT (txParams->psd);
+  Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
+  NS_ASSERT_MSG (txMobility && rxMobility, "the transmitter and the receiver must have a MobilityModel");
+  if (m_maxDistance > 0 && txMobility->GetDistanceFrom (rxMobility) > m_maxDistance)
+    {
+      return 0;
+    }
+  double pathLossDb = CalcPathLossDb (txParams, txMobility, rxMobility, rxAntenna);
+  if (pathLossDb > m_maxLossDb)
+    {
+      return 0;
+    }
+  NS_ASSERT_MSG (*(txParams->psd->GetSpectrumModel ()) == *rxSpectrumModel,
+                 "SingleModelSpectrumChannel does not convert between SpectrumModels");
+  Ptr<SpectrumValue> rxPsd = txParams->psd->Copy ();
+  *rxPsd *= std::pow (10.0, (-pathLossDb) / 10.0);
+  if (m_spectrumPropagationLoss)
+    {
+      rxPsd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxPsd, txMobility, rxMobility);
+    }
+  return rxPsd;
+}
+
 void
 SingleModelSpectrumChannel::StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver)
 {
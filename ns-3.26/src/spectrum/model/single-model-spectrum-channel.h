@@ -24,6 +24,7 @@
 
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-model.h>
+#include <ns3/spectrum-receiver-grid.h>
 #include <ns3/traced-callback.h>
 
 namespace ns3 {
@@ -55,6 +56,10 @@ public:
   virtual void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
   virtual void AddRx (Ptr<SpectrumPhy> phy);
   virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+  virtual Ptr<SpectrumValue> CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                                         Ptr<MobilityModel> rxMobility,
+                                                         Ptr<AntennaModel> rxAntenna,
+                                                         Ptr<const SpectrumModel> rxSpectrumModel);
 
 
   // inherited from Channel
@@ -70,6 +75,16 @@ public:
    */
   virtual Ptr<SpectrumPropagationLossModel> GetSpectrumPropagationLossModel (void);
 
+  /**
+   * \param maxDistance the distance (m) beyond which receivers are
+   *        ignored, or zero to consider all the receivers
+   */
+  void SetMaxDistance (double maxDistance);
+  /**
+   * \return the distance (m) beyond which receivers are ignored
+   */
+  double GetMaxDistance (void) const;
+
 private:
   virtual void DoDispose ();
 
@@ -81,6 +96,21 @@ private:
    */
   void StartRx (Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+  /**
+   * Compute the single-frequency loss between a transmitter and a
+   * receiver, including the gains of their antennas.
+   *
+   * \param txParams the parameters of the transmission
+   * \param txMobility the mobility model of the transmitter
+   * \param rxMobility the mobility model of the receiver
+   * \param rxAntenna the antenna of the receiver, or 0
+   * \return the loss [dB]
+   */
+  double CalcPathLossDb (Ptr<const SpectrumSignalParameters> txParams,
+                         Ptr<MobilityModel> txMobility,
+                         Ptr<MobilityModel> rxMobility,
+                         Ptr<AntennaModel> rxAntenna) const;
+
   /**
    * List of SpectrumPhy instances attached to the channel.
    */
@@ -116,6 +146,17 @@ private:
    */
   double m_maxLossDb;
 
+  /**
+   * Maximum distance [m] of the receivers, zero if disabled.
+   */
+  double m_maxDistance;
+
+  /**
+   * Index of the positions of the receivers, used if m_maxDistance is
+   * not zero.
+   */
+  SpectrumReceiverGrid m_receiverGrid;
+
   /**
    * \deprecated The non-const \c Ptr<SpectrumPhy> argument
    * is deprecated and will be changed to \c Ptr<const SpectrumPhy>
@@ -19,6 +19,9 @@
  */
 
 #include "spectrum-channel.h"
+#include <ns3/spectrum-value.h>
+#include <ns3/abort.h>
+#include <ns3/trace-source-accessor.h>
 
 
 namespace ns3 {
@@ -32,6 +35,13 @@ SpectrumChannel::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SpectrumChannel")
     .SetParent<Channel> ()
     .SetGroupName ("Spectrum")
+    .AddTraceSource ("TxSigParams",
+                     "This trace is fired by StartTx for each transmission "
+                     "started on the channel, with its signal parameters. "
+                     "The parameters are those of the transmitter: "
+                     "they are not to be modified.",
+                     MakeTraceSourceAccessor (&SpectrumChannel::m_txSigParamsTrace),
+                     "ns3::SpectrumChannel::SignalParametersTracedCallback")
   ;
   return tid;
 }
@@ -40,4 +50,14 @@ SpectrumChannel::~SpectrumChannel ()
 {
 }
 
+Ptr<SpectrumValue>
+SpectrumChannel::CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                             Ptr<MobilityModel> rxMobility,
+                                             Ptr<AntennaModel> rxAntenna,
+                                             Ptr<const SpectrumModel> rxSpectrumModel)
+{
+  NS_FATAL_ERROR ("CalcRxPowerSpectralDensity is not supported by " << GetInstanceTypeId ().GetName ());
+  return 0;
+}
+
 } // namespace
@@ -26,6 +26,7 @@
 #include <ns3/nstime.h>
 #include <ns3/channel.h>
 #include <ns3/spectrum-signal-parameters.h>
+#include <ns3/traced-callback.h>
 
 namespace ns3 {
 
@@ -36,6 +37,9 @@ class SpectrumPhy;
 class SpectrumPropagationLossModel;
 class PropagationLossModel;
 class PropagationDelayModel;
+class MobilityModel;
+class AntennaModel;
+class SpectrumModel;
 
 /**
  * \ingroup spectrum
@@ -99,6 +103,29 @@ public:
    */
   virtual void AddRx (Ptr<SpectrumPhy> phy) = 0;
 
+  /**
+   * Compute the power spectral density which a receiver would get from
+   * a transmission, applying the same antenna gains, propagation loss
+   * models and range limits as StartTx, but without scheduling any
+   * reception. The receiver does not need to be attached to the
+   * channel. This is meant for the tools which probe the channel at
+   * many positions, like a radio environment map.
+   *
+   * The default implementation aborts: channels supporting this
+   * operation override it.
+   *
+   * \param txParams the parameters of the transmission, as passed to StartTx
+   * \param rxMobility the mobility model of the receiver
+   * \param rxAntenna the antenna of the receiver, or 0 for an isotropic antenna
+   * \param rxSpectrumModel the SpectrumModel of the receiver
+   * \return the received power spectral density, or 0 if the receiver
+   * is out of the range of the transmitter
+   */
+  virtual Ptr<SpectrumValue> CalcRxPowerSpectralDensity (Ptr<const SpectrumSignalParameters> txParams,
+                                                         Ptr<MobilityModel> rxMobility,
+                                                         Ptr<AntennaModel> rxAntenna,
+                                                         Ptr<const SpectrumModel> rxSpectrumModel);
+
   /**
    * TracedCallback signature for path loss calculation events.
    *
@@ -112,7 +139,21 @@ public:
   typedef void (* LossTracedCallback)
     (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy,
      double lossDb);
-  
+
+  /**
+   * TracedCallback signature for the transmissions started on the channel.
+   *
+   * \param [in] params The parameters of the transmission.
+   */
+  typedef void (* SignalParametersTracedCallback)
+    (Ptr<SpectrumSignalParameters> params);
+
+protected:
+  /**
+   * The trace source fired by StartTx for each transmission,
+   * before it is passed to the receivers.
+   */
+  TracedCallback<Ptr<SpectrumSignalParameters> > m_txSigParamsTrace;
 };
 
 
@@ -39,23 +39,27 @@ SpectrumConverter::SpectrumConverter (Ptr<const SpectrumModel> fromSpectrumModel
   m_fromSpectrumModel = fromSpectrumModel;
   m_toSpectrumModel = toSpectrumModel;
 
+  m_rowStart.reserve (toSpectrumModel->GetNumBands () + 1);
   for (Bands::const_iterator toit = toSpectrumModel->Begin (); toit != toSpectrumModel->End (); ++toit)
     {
-      std::vector<double> coeffs;
-
-      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit)
+      m_rowStart.push_back (m_conversionValues.size ());
+      size_t column = 0;
+      for (Bands::const_iterator fromit = fromSpectrumModel->Begin (); fromit != fromSpectrumModel->End (); ++fromit, ++column)
         {
           double c = GetCoefficient (*fromit, *toit);
           NS_LOG_LOGIC ("(" << fromit->fl << ","  << fromit->fh << ")"
                             << " --> " <<
                         "(" << toit->fl << "," << toit->fh << ")"
                             << " = " << c);
-          coeffs.push_back (c);
+          if (c > 0)
+            {
+              m_conversionColumns.push_back (column);
+              m_conversionValues.push_back (c);
+            }
         }
-
-      m_conversionMatrix.push_back (coeffs);
     }
-
+  m_rowStart.push_back (m_conversionValues.size ());
+  NS_LOG_LOGIC ("non-zero coefficients: " << m_conversionValues.size ());
 }
 
 
@@ -78,23 +82,17 @@ SpectrumConverter::Convert (Ptr<const SpectrumValue> fvvf) const
   Ptr<SpectrumValue> tvvf = Create<SpectrumValue> (m_toSpectrumModel);
 
   Values::iterator tvit = tvvf->ValuesBegin ();
+  Values::const_iterator fvit = fvvf->ConstValuesBegin ();
+  const size_t *columns = m_conversionColumns.empty () ? 0 : &m_conversionColumns[0];
+  const double *coeffs = m_conversionValues.empty () ? 0 : &m_conversionValues[0];
 
-
-  for (std::vector<std::vector<double> >::const_iterator toit = m_conversionMatrix.begin ();
-       toit != m_conversionMatrix.end ();
-       ++toit)
+  for (size_t row = 0; row + 1 < m_rowStart.size (); ++row)
     {
       NS_ASSERT (tvit != tvvf->ValuesEnd ());
-      Values::const_iterator fvit = fvvf->ConstValuesBegin ();
-
       double sum = 0;
-      for (std::vector<double>::const_iterator fromit = toit->begin ();
-           fromit != toit->end ();
-           ++fromit)
+      for (size_t k = m_rowStart[row]; k < m_rowStart[row + 1]; ++k)
         {
-          NS_ASSERT (fvit != fvvf->ConstValuesEnd ());
-          sum += (*fvit) * (*fromit);
-          ++fvit;
+          sum += fvit[columns[k]] * coeffs[k];
         }
       *tvit = sum;
       ++tvit;
@@ -78,7 +78,19 @@ private:
    */
   double GetCoefficient (const BandInfo& from, const BandInfo& to) const;
 
-  std::vector<std::vector<double> > m_conversionMatrix; //!< matrix of conversion coefficients
+  /*
+   * The conversion matrix is stored in compressed sparse row format:
+   * since only overlapping bands contribute, each row has a handful of
+   * non-zero coefficients, whatever the size of the SpectrumModels.
+   * The non-zero coefficients of row i (i.e., of the "to" band i) are
+   * m_conversionValues[m_rowStart[i]] to
+   * m_conversionValues[m_rowStart[i+1] - 1], and they multiply the
+   * values of the "from" bands m_conversionColumns[m_rowStart[i]] to
+   * m_conversionColumns[m_rowStart[i+1] - 1].
+   */
+  std::vector<size_t> m_rowStart;            //!< index of the first non-zero coefficient of each row, plus the total number of non-zero coefficients
+  std::vector<size_t> m_conversionColumns;   //!< index of the "from" band of each non-zero coefficient
+  std::vector<double> m_conversionValues;    //!< non-zero conversion coefficients
   Ptr<const SpectrumModel> m_fromSpectrumModel;  //!<  the SpectrumModel this SpectrumConverter instance can convert from
   Ptr<const SpectrumModel> m_toSpectrumModel;    //!<  the SpectrumModel this SpectrumConverter instance can convert to
 
@@ -0,0 +1,286 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "spectrum-receiver-grid.h"
+#include <ns3/log.h>
+#include <ns3/mobility-model.h>
+#include <ns3/spectrum-phy.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumReceiverGrid");
+
+/**
+ * \param mobility a mobility model
+ * \return true if the mobility model does not move between course changes
+ */
+static bool
+IsStatic (Ptr<const MobilityModel> mobility)
+{
+  Vector velocity = mobility->GetVelocity ();
+  return velocity.x == 0 && velocity.y == 0 && velocity.z == 0;
+}
+
+SpectrumReceiverGrid::SpectrumReceiverGrid ()
+  : m_range (1.0)
+{
+}
+
+SpectrumReceiverGrid::~SpectrumReceiverGrid ()
+{
+  Clear ();
+}
+
+void
+SpectrumReceiverGrid::SetRange (double range)
+{
+  NS_LOG_FUNCTION (this << range);
+  NS_ASSERT (range > 0);
+  m_range = range;
+  m_cells.clear ();
+  m_moving.clear ();
+  for (Receivers::iterator it = m_receivers.begin (); it != m_receivers.end (); ++it)
+    {
+      if (it->second.mobility != 0)
+        {
+          Locate (it->second);
+        }
+    }
+}
+
+double
+SpectrumReceiverGrid::GetRange (void) const
+{
+  return m_range;
+}
+
+SpectrumReceiverGrid::CellId
+SpectrumReceiverGrid::GetCellId (const Vector &position) const
+{
+  return CellId (static_cast<int64_t> (std::floor (position.x / m_range)),
+                 static_cast<int64_t> (std::floor (position.y / m_range)));
+}
+
+void
+SpectrumReceiverGrid::Add (Ptr<SpectrumPhy> phy, uint64_t order)
+{
+  NS_LOG_FUNCTION (this << phy << order);
+  Remove (phy);
+  Receiver &receiver = m_receivers[PeekPointer (phy)];
+  receiver.phy = phy;
+  receiver.order = order;
+  receiver.inGrid = false;
+  Ptr<MobilityModel> mobility = phy->GetMobility ();
+  if (mobility != 0)
+    {
+      Attach (receiver, mobility);
+    }
+  else
+    {
+      m_pending.insert (PeekPointer (phy));
+    }
+}
+
+void
+SpectrumReceiverGrid::Remove (Ptr<SpectrumPhy> phy)
+{
+  Receivers::iterator it = m_receivers.find (PeekPointer (phy));
+  if (it == m_receivers.end ())
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << phy);
+  Receiver &receiver = it->second;
+  if (receiver.mobility == 0)
+    {
+      m_pending.erase (PeekPointer (phy));
+    }
+  else
+    {
+      Unlocate (receiver);
+      MobilityUsers::iterator usersIt = m_mobilityUsers.find (PeekPointer (receiver.mobility));
+      NS_ASSERT (usersIt != m_mobilityUsers.end ());
+      std::vector<const SpectrumPhy *> &users = usersIt->second;
+      users.erase (std::find (users.begin (), users.end (), PeekPointer (phy)));
+      if (users.empty ())
+        {
+          m_mobilityUsers.erase (usersIt);
+          receiver.mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                            MakeCallback (&SpectrumReceiverGrid::CourseChanged, this));
+        }
+    }
+  m_receivers.erase (it);
+}
+
+void
+SpectrumReceiverGrid::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (MobilityUsers::iterator it = m_mobilityUsers.begin (); it != m_mobilityUsers.end (); ++it)
+    {
+      Receivers::iterator receiverIt = m_receivers.find (it->second.front ());
+      NS_ASSERT (receiverIt != m_receivers.end ());
+      receiverIt->second.mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                                  MakeCallback (&SpectrumReceiverGrid::CourseChanged, this));
+    }
+  m_mobilityUsers.clear ();
+  m_receivers.clear ();
+  m_cells.clear ();
+  m_moving.clear ();
+  m_pending.clear ();
+}
+
+void
+SpectrumReceiverGrid::Attach (Receiver &receiver, Ptr<MobilityModel> mobility)
+{
+  receiver.mobility = mobility;
+  std::vector<const SpectrumPhy *> &users = m_mobilityUsers[PeekPointer (mobility)];
+  if (users.empty ())
+    {
+      mobility->TraceConnectWithoutContext ("CourseChange",
+                                            MakeCallback (&SpectrumReceiverGrid::CourseChanged, this));
+    }
+  users.push_back (PeekPointer (receiver.phy));
+  Locate (receiver);
+}
+
+void
+SpectrumReceiverGrid::Locate (Receiver &receiver)
+{
+  if (IsStatic (receiver.mobility))
+    {
+      receiver.inGrid = true;
+      receiver.position = receiver.mobility->GetPosition ();
+      receiver.cell = GetCellId (receiver.position);
+      m_cells[receiver.cell].push_back (PeekPointer (receiver.phy));
+    }
+  else
+    {
+      receiver.inGrid = false;
+      m_moving.insert (PeekPointer (receiver.phy));
+    }
+}
+
+void
+SpectrumReceiverGrid::Unlocate (Receiver &receiver)
+{
+  if (receiver.inGrid)
+    {
+      Cells::iterator cellIt = m_cells.find (receiver.cell);
+      NS_ASSERT (cellIt != m_cells.end ());
+      std::vector<const SpectrumPhy *> &phys = cellIt->second;
+      phys.erase (std::find (phys.begin (), phys.end (), PeekPointer (receiver.phy)));
+      if (phys.empty ())
+        {
+          m_cells.erase (cellIt);
+        }
+    }
+  else
+    {
+      m_moving.erase (PeekPointer (receiver.phy));
+    }
+}
+
+void
+SpectrumReceiverGrid::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  MobilityUsers::const_iterator usersIt = m_mobilityUsers.find (PeekPointer (mobility));
+  NS_ASSERT (usersIt != m_mobilityUsers.end ());
+  for (std::vector<const SpectrumPhy *>::const_iterator it = usersIt->second.begin ();
+       it != usersIt->second.end ();
+       ++it)
+    {
+      Receiver &receiver = m_receivers[*it];
+      Unlocate (receiver);
+      Locate (receiver);
+    }
+}
+
+void
+SpectrumReceiverGrid::GetReceivers (const Vector &position, std::vector<Ptr<SpectrumPhy> > &receivers)
+{
+  NS_LOG_FUNCTION (this << position);
+  m_found.clear ();
+
+  // the mobility model of a SpectrumPhy is often set after the
+  // SpectrumPhy is attached to the channel
+  std::vector<Receiver *> located;
+  for (std::set<const SpectrumPhy *>::const_iterator it = m_pending.begin (); it != m_pending.end (); ++it)
+    {
+      Receiver &receiver = m_receivers[*it];
+      Ptr<MobilityModel> mobility = receiver.phy->GetMobility ();
+      if (mobility != 0)
+        {
+          receiver.mobility = mobility;
+          located.push_back (&receiver);
+        }
+      else
+        {
+          m_found.push_back (std::make_pair (receiver.order, *it));
+        }
+    }
+  for (std::vector<Receiver *>::const_iterator it = located.begin (); it != located.end (); ++it)
+    {
+      m_pending.erase (PeekPointer ((*it)->phy));
+      Attach (**it, (*it)->mobility);
+    }
+
+  for (std::set<const SpectrumPhy *>::const_iterator it = m_moving.begin (); it != m_moving.end (); ++it)
+    {
+      const Receiver &receiver = m_receivers[*it];
+      if (CalculateDistance (receiver.mobility->GetPosition (), position) <= m_range)
+        {
+          m_found.push_back (std::make_pair (receiver.order, *it));
+        }
+    }
+
+  CellId center = GetCellId (position);
+  for (int64_t x = center.first - 1; x <= center.first + 1; ++x)
+    {
+      for (int64_t y = center.second - 1; y <= center.second + 1; ++y)
+        {
+          Cells::const_iterator cellIt = m_cells.find (CellId (x, y));
+          if (cellIt == m_cells.end ())
+            {
+              continue;
+            }
+          for (std::vector<const SpectrumPhy *>::const_iterator it = cellIt->second.begin ();
+               it != cellIt->second.end ();
+               ++it)
+            {
+              const Receiver &receiver = m_receivers[*it];
+              if (CalculateDistance (receiver.position, position) <= m_range)
+                {
+                  m_found.push_back (std::make_pair (receiver.order, *it));
+                }
+            }
+        }
+    }
+
+  std::sort (m_found.begin (), m_found.end ());
+  receivers.clear ();
+  for (std::vector<std::pair<uint64_t, const SpectrumPhy *> >::const_iterator it = m_found.begin ();
+       it != m_found.end ();
+       ++it)
+    {
+      receivers.push_back (m_receivers[it->second].phy);
+    }
+  NS_LOG_LOGIC (receivers.size () << " of " << m_receivers.size () << " receivers in range");
+}
+
+} // namespace ns3
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPECTRUM_RECEIVER_GRID_H
+#define SPECTRUM_RECEIVER_GRID_H
+
+#include <ns3/ptr.h>
+#include <ns3/vector.h>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ns3 {
+
+class SpectrumPhy;
+class MobilityModel;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Spatial index of the receivers attached to a SpectrumChannel
+ *
+ * This class is used by the SpectrumChannel implementations to find the
+ * receivers within a given range of a transmitter without iterating over
+ * all the receivers. Receivers are stored in a grid of square cells (in
+ * the x-y plane) whose side is the range, so that the receivers within
+ * range of a position are found in the 3x3 cells around it.
+ *
+ * The position of a receiver is read from the MobilityModel of its
+ * SpectrumPhy, and updated when the MobilityModel notifies a course
+ * change. Receivers moving at a non-zero velocity are not stored in the
+ * grid but checked at each lookup, and receivers whose SpectrumPhy has
+ * no MobilityModel (yet) are always returned.
+ */
+class SpectrumReceiverGrid
+{
+public:
+  SpectrumReceiverGrid ();
+  ~SpectrumReceiverGrid ();
+
+  /**
+   * \param range the distance (m) within which receivers are looked up
+   */
+  void SetRange (double range);
+  /**
+   * \return the distance (m) within which receivers are looked up
+   */
+  double GetRange (void) const;
+  /**
+   * Add a receiver to the index
+   *
+   * \param phy the receiver
+   * \param order the key according to which the receivers are sorted
+   *        by GetReceivers
+   */
+  void Add (Ptr<SpectrumPhy> phy, uint64_t order);
+  /**
+   * Remove a receiver from the index, if present
+   *
+   * \param phy the receiver
+   */
+  void Remove (Ptr<SpectrumPhy> phy);
+  /**
+   * Remove all the receivers from the index
+   */
+  void Clear (void);
+  /**
+   * \param position the position of the transmitter
+   * \param receivers filled with the receivers within range of the
+   *        position and the receivers without a MobilityModel, in
+   *        increasing order of the key given to Add
+   */
+  void GetReceivers (const Vector &position, std::vector<Ptr<SpectrumPhy> > &receivers);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  SpectrumReceiverGrid (const SpectrumReceiverGrid &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  SpectrumReceiverGrid & operator = (const SpectrumReceiverGrid &);
+
+  /// Coordinates of a cell of the grid
+  typedef std::pair<int64_t, int64_t> CellId;
+
+  /// A receiver in the index
+  struct Receiver
+  {
+    Ptr<SpectrumPhy> phy;             //!< the receiver
+    uint64_t order;                   //!< the sort key of the receiver
+    Ptr<MobilityModel> mobility;      //!< the mobility model of the receiver, 0 if not known yet
+    bool inGrid;                      //!< true if the receiver is in m_cells, false if in m_moving
+    CellId cell;                      //!< the cell of the receiver, if in m_cells
+    Vector position;                  //!< the position of the receiver, if in m_cells
+  };
+
+  /**
+   * \param position a position
+   * \return the cell containing the position
+   */
+  CellId GetCellId (const Vector &position) const;
+  /**
+   * Record the mobility model of a receiver, connect its course change
+   * trace source and locate the receiver
+   *
+   * \param receiver the receiver
+   * \param mobility its mobility model
+   */
+  void Attach (Receiver &receiver, Ptr<MobilityModel> mobility);
+  /**
+   * Insert a receiver with a known mobility model in m_cells or m_moving
+   *
+   * \param receiver the receiver
+   */
+  void Locate (Receiver &receiver);
+  /**
+   * Remove a receiver with a known mobility model from m_cells or m_moving
+   *
+   * \param receiver the receiver
+   */
+  void Unlocate (Receiver &receiver);
+  /**
+   * Relocate the receivers using a mobility model
+   *
+   * \param mobility the mobility model whose course changed
+   */
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+
+  /// Container: receivers indexed by their SpectrumPhy
+  typedef std::map<const SpectrumPhy *, Receiver> Receivers;
+  /// Container: SpectrumPhy instances of the receivers in a cell
+  typedef std::map<CellId, std::vector<const SpectrumPhy *> > Cells;
+  /// Container: SpectrumPhy instances of the receivers using a mobility model
+  typedef std::map<const MobilityModel *, std::vector<const SpectrumPhy *> > MobilityUsers;
+
+  double m_range;                             //!< side of the cells (m)
+  Receivers m_receivers;                      //!< all the receivers
+  Cells m_cells;                              //!< the receivers which do not move
+  std::set<const SpectrumPhy *> m_moving;     //!< the receivers moving at a non-zero velocity
+  std::set<const SpectrumPhy *> m_pending;    //!< the receivers without a mobility model
+  MobilityUsers m_mobilityUsers;              //!< the receivers of each mobility model
+  std::vector<std::pair<uint64_t, const SpectrumPhy *> > m_found; //!< scratch space of GetReceivers
+};
+
+} // namespace ns3
+
+#endif /* SPECTRUM_RECEIVER_GRID_H */
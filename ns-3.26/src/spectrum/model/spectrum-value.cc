@@ -228,19 +228,6 @@ SpectrumValue::Divide (double s)
 
 
 
-void
-SpectrumValue::ChangeSign ()
-{
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = -(*it1);
-      ++it1;
-    }
-}
-
-
 void
 SpectrumValue::ShiftLeft (int n)
 {
@@ -437,130 +424,6 @@ operator << (std::ostream& os, const SpectrumValue& pvf)
 
 
 
-SpectrumValue
-operator+ (const SpectrumValue& lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator+ (const SpectrumValue& lhs, double rhs)
-{
-  SpectrumValue res = lhs;
-  res.Add (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator+ (double lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.Add (lhs);
-  return res;
-}
-
-
-SpectrumValue
-operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
-  return res;
-}
-
-
-
-SpectrumValue
-operator- (const SpectrumValue& lhs, double rhs)
-{
-  SpectrumValue res = lhs;
-  res.Subtract (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator- (double lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.Subtract (lhs);
-  return res;
-}
-
-SpectrumValue
-operator* (const SpectrumValue& lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator* (const SpectrumValue& lhs, double rhs)
-{
-  SpectrumValue res = lhs;
-  res.Multiply (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator* (double lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.Multiply (lhs);
-  return res;
-}
-
-
-SpectrumValue
-operator/ (const SpectrumValue& lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator/ (const SpectrumValue& lhs, double rhs)
-{
-  SpectrumValue res = lhs;
-  res.Divide (rhs);
-  return res;
-}
-
-
-SpectrumValue
-operator/ (double lhs, const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.Divide (lhs);
-  return res;
-}
-
-
-SpectrumValue
-operator+ (const SpectrumValue& rhs)
-{
-  return rhs;
-}
-
-SpectrumValue
-operator- (const SpectrumValue& rhs)
-{
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  return res;
-}
-
-
 SpectrumValue
 Pow (double lhs, const SpectrumValue& rhs)
 {
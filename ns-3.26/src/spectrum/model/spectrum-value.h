@@ -21,6 +21,7 @@
 #ifndef SPECTRUM_VALUE_H
 #define SPECTRUM_VALUE_H
 
+#include <ns3/assert.h>
 #include <ns3/ptr.h>
 #include <ns3/simple-ref-count.h>
 #include <ns3/spectrum-model.h>
@@ -33,6 +34,44 @@ namespace ns3 {
 /// Container for element values
 typedef std::vector<double> Values;
 
+/**
+ * \ingroup spectrum
+ *
+ * \brief Base class of the element-wise expressions on SpectrumValue
+ *
+ * The arithmetic operators on SpectrumValue do not compute their
+ * result; they return a lightweight object describing the operation
+ * (an expression template), which is evaluated band by band, in a
+ * single loop and without temporaries, when it is assigned to a
+ * SpectrumValue. For instance
+ *
+ * \code
+ *   SpectrumValue sinr = signal / (interference + noise);
+ * \endcode
+ *
+ * reads each operand once and allocates only the result. Every
+ * expression E derives from SpectrumValueExpression<E> and provides
+ * GetSpectrumModel () and an element accessor operator[] (size_t).
+ *
+ * Expressions hold references to the SpectrumValue instances they
+ * operate on, so they must be evaluated within the full-expression
+ * that creates them: convert them to a SpectrumValue rather than
+ * storing them (e.g., with \c auto) or passing them to templates which
+ * copy their arguments, such as Simulator::Schedule.
+ */
+template <class E>
+class SpectrumValueExpression
+{
+public:
+  /**
+   * \return the expression as its actual type
+   */
+  const E& GetExpression (void) const
+  {
+    return static_cast<const E&> (*this);
+  }
+};
+
 /**
  * \ingroup spectrum
  *
@@ -55,7 +94,8 @@ typedef std::vector<double> Values;
  * things, such as power spectral densities, frequency-dependent
  * propagation losses, spectral masks, etc.
  */
-class SpectrumValue : public SimpleRefCount<SpectrumValue>
+class SpectrumValue : public SimpleRefCount<SpectrumValue>,
+                      public SpectrumValueExpression<SpectrumValue>
 {
 public:
   /**
@@ -80,6 +120,13 @@ public:
 
   SpectrumValue ();
 
+  /**
+   * Evaluate an expression on SpectrumValue instances
+   *
+   * @param expr the expression
+   */
+  template <class E>
+  SpectrumValue (const SpectrumValueExpression<E>& expr);
 
   /**
    * Access value at given frequency index
@@ -159,145 +206,6 @@ public:
 
 
 
-  /**
-   *  addition operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs + rhs
-   */
-  friend SpectrumValue operator+ (const SpectrumValue& lhs, const SpectrumValue& rhs);
-
-
-  /**
-   *  addition operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs + rhs
-   */
-  friend SpectrumValue operator+ (const SpectrumValue& lhs, double rhs);
-
-  /**
-   *  addition operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs + rhs
-   */
-  friend SpectrumValue operator+ (double lhs, const SpectrumValue& rhs);
-
-
-  /**
-   *  subtraction operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs - rhs
-   */
-  friend SpectrumValue operator- (const SpectrumValue& lhs, const SpectrumValue& rhs);
-
-  /**
-   *  subtraction operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs - rhs
-   */
-  friend SpectrumValue operator- (const SpectrumValue& lhs, double rhs);
-
-  /**
-   *  subtraction operator
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs - rhs
-   */
-  friend SpectrumValue operator- (double lhs, const SpectrumValue& rhs);
-
-  /**
-   *  multiplication component-by-component (Schur product)
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs * rhs
-   */
-  friend SpectrumValue operator* (const SpectrumValue& lhs, const SpectrumValue& rhs);
-
-  /**
-   *  multiplication by a scalar
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs * rhs
-   */
-  friend SpectrumValue operator* (const SpectrumValue& lhs, double rhs);
-
-  /**
-   *  multiplication of a scalar
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs * rhs
-   */
-  friend SpectrumValue operator* (double lhs, const SpectrumValue& rhs);
-
-  /**
-   *  division component-by-component
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of lhs / rhs
-   */
-  friend SpectrumValue operator/ (const SpectrumValue& lhs, const SpectrumValue& rhs);
-
-  /**
-   * division by a scalar
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of *this / rhs
-   */
-  friend SpectrumValue operator/ (const SpectrumValue& lhs, double rhs);
-
-  /**
-   * division of a scalar
-   *
-   * @param lhs Left Hand Side of the operator
-   * @param rhs Right Hand Side of the operator
-   *
-   * @return the value of *this / rhs
-   */
-  friend SpectrumValue operator/ (double lhs, const SpectrumValue& rhs);
-
-  /**
-   * unary plus operator
-   *
-   * @param rhs Right Hand Side of the operator
-   * @return the value of *this
-   */
-  friend SpectrumValue operator+ (const SpectrumValue& rhs);
-
-  /**
-   * unary minus operator
-   *
-   * @param rhs Right Hand Side of the operator
-   * @return the value of - *this
-   */
-  friend SpectrumValue operator- (const SpectrumValue& rhs);
-
-
   /**
    * left shift operator
    *
@@ -398,6 +306,50 @@ public:
    */
   SpectrumValue& operator/= (double rhs);
 
+  /**
+   * Add an expression to *this, component by component, evaluating the
+   * expression in the same loop
+   *
+   * @param rhs the Right Hand Side
+   *
+   * @return a reference to *this
+   */
+  template <class E>
+  SpectrumValue& operator+= (const SpectrumValueExpression<E>& rhs);
+
+  /**
+   * Subtract an expression from *this, component by component,
+   * evaluating the expression in the same loop
+   *
+   * @param rhs the Right Hand Side
+   *
+   * @return a reference to *this
+   */
+  template <class E>
+  SpectrumValue& operator-= (const SpectrumValueExpression<E>& rhs);
+
+  /**
+   * Multiply *this by an expression, component by component,
+   * evaluating the expression in the same loop
+   *
+   * @param rhs the Right Hand Side
+   *
+   * @return a reference to *this
+   */
+  template <class E>
+  SpectrumValue& operator*= (const SpectrumValueExpression<E>& rhs);
+
+  /**
+   * Divide *this by an expression, component by component, evaluating
+   * the expression in the same loop
+   *
+   * @param rhs the Right Hand Side
+   *
+   * @return a reference to *this
+   */
+  template <class E>
+  SpectrumValue& operator/= (const SpectrumValueExpression<E>& rhs);
+
 
   /**
    * Assign each component of *this to the value of the Right Hand
@@ -409,6 +361,17 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Evaluate an expression into *this. The expression may refer to
+   * *this.
+   *
+   * @param rhs the expression
+   *
+   * @return a reference to *this
+   */
+  template <class E>
+  SpectrumValue& operator= (const SpectrumValueExpression<E>& rhs);
+
 
 
   /**
@@ -555,10 +518,6 @@ private:
    * \param s flat value
    */
   void Divide (double s);
-  /**
-   * Change the values sign
-   */
-  void ChangeSign ();
   /**
    * Shift the values to the left
    */
@@ -621,6 +580,387 @@ SpectrumValue Log (const SpectrumValue& arg);
 double Integral (const SpectrumValue& arg);
 
 
+/**
+ * \ingroup spectrum
+ *
+ * \brief Leaf of an expression, referring to a SpectrumValue
+ */
+class SpectrumValueReference : public SpectrumValueExpression<SpectrumValueReference>
+{
+public:
+  /**
+   * \param value the SpectrumValue referred to
+   */
+  SpectrumValueReference (const SpectrumValue& value)
+    : m_value (&value),
+      m_values (value.ConstValuesBegin ())
+  {
+  }
+  /**
+   * \param i the band index
+   * \return the value of the band
+   */
+  double operator[] (size_t i) const
+  {
+    return m_values[i];
+  }
+  /**
+   * \return the SpectrumModel of the value referred to
+   */
+  Ptr<const SpectrumModel> GetSpectrumModel (void) const
+  {
+    return m_value->GetSpectrumModel ();
+  }
+private:
+  const SpectrumValue *m_value;    //!< the SpectrumValue referred to
+  Values::const_iterator m_values; //!< the values of m_value
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief How an expression is stored as the operand of another expression
+ *
+ * Sub-expressions are stored by value, while SpectrumValue instances are
+ * stored as a SpectrumValueReference.
+ */
+template <class E>
+struct SpectrumValueOperand
+{
+  typedef E Type; //!< the type of the stored operand
+};
+
+/// Specialization for the leaves of the expressions
+template <>
+struct SpectrumValueOperand<SpectrumValue>
+{
+  typedef SpectrumValueReference Type; //!< the type of the stored operand
+};
+
+/// Element-wise addition
+struct SpectrumValueAdd
+{
+  /**
+   * \param a the left operand
+   * \param b the right operand
+   * \return a + b
+   */
+  static double Apply (double a, double b)
+  {
+    return a + b;
+  }
+};
+
+/// Element-wise subtraction
+struct SpectrumValueSubtract
+{
+  /**
+   * \param a the left operand
+   * \param b the right operand
+   * \return a - b
+   */
+  static double Apply (double a, double b)
+  {
+    return a - b;
+  }
+};
+
+/// Element-wise multiplication
+struct SpectrumValueMultiply
+{
+  /**
+   * \param a the left operand
+   * \param b the right operand
+   * \return a * b
+   */
+  static double Apply (double a, double b)
+  {
+    return a * b;
+  }
+};
+
+/// Element-wise division
+struct SpectrumValueDivide
+{
+  /**
+   * \param a the left operand
+   * \param b the right operand
+   * \return a / b
+   */
+  static double Apply (double a, double b)
+  {
+    return a / b;
+  }
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Element-wise operation between two expressions, which must
+ * share the same SpectrumModel
+ */
+template <class L, class R, class Op>
+class SpectrumValueBinaryExpression
+  : public SpectrumValueExpression<SpectrumValueBinaryExpression<L, R, Op> >
+{
+public:
+  /**
+   * \param lhs the left operand
+   * \param rhs the right operand
+   */
+  SpectrumValueBinaryExpression (const L& lhs, const R& rhs)
+    : m_lhs (lhs),
+      m_rhs (rhs)
+  {
+    NS_ASSERT (m_lhs.GetSpectrumModel () == m_rhs.GetSpectrumModel ());
+  }
+  /**
+   * \param i the band index
+   * \return the value of the band
+   */
+  double operator[] (size_t i) const
+  {
+    return Op::Apply (m_lhs[i], m_rhs[i]);
+  }
+  /**
+   * \return the SpectrumModel of the operands
+   */
+  Ptr<const SpectrumModel> GetSpectrumModel (void) const
+  {
+    return m_lhs.GetSpectrumModel ();
+  }
+private:
+  typename SpectrumValueOperand<L>::Type m_lhs; //!< the left operand
+  typename SpectrumValueOperand<R>::Type m_rhs; //!< the right operand
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Element-wise operation between an expression and a scalar,
+ * the scalar being the right operand
+ */
+template <class E, class Op>
+class SpectrumValueScalarExpression
+  : public SpectrumValueExpression<SpectrumValueScalarExpression<E, Op> >
+{
+public:
+  /**
+   * \param expr the expression operand
+   * \param scalar the scalar operand
+   */
+  SpectrumValueScalarExpression (const E& expr, double scalar)
+    : m_expr (expr),
+      m_scalar (scalar)
+  {
+  }
+  /**
+   * \param i the band index
+   * \return the value of the band
+   */
+  double operator[] (size_t i) const
+  {
+    return Op::Apply (m_expr[i], m_scalar);
+  }
+  /**
+   * \return the SpectrumModel of the expression operand
+   */
+  Ptr<const SpectrumModel> GetSpectrumModel (void) const
+  {
+    return m_expr.GetSpectrumModel ();
+  }
+private:
+  typename SpectrumValueOperand<E>::Type m_expr; //!< the expression operand
+  double m_scalar;                              //!< the scalar operand
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Define the binary operator OP on expressions and scalars,
+ * computed element-wise with the functor FUNCTOR
+ *
+ * As with the operators defined before expressions were introduced,
+ * the scalar is always the right operand of FUNCTOR: both s - v and
+ * v - s evaluate to v - s, and both s / v and v / s to v / s.
+ */
+#define SPECTRUM_VALUE_BINARY_OPERATOR(OP, FUNCTOR)                            \
+  template <class L, class R>                                                  \
+  inline SpectrumValueBinaryExpression<L, R, FUNCTOR>                          \
+  operator OP (const SpectrumValueExpression<L>& lhs,                          \
+               const SpectrumValueExpression<R>& rhs)                          \
+  {                                                                            \
+    return SpectrumValueBinaryExpression<L, R, FUNCTOR> (lhs.GetExpression (), \
+                                                         rhs.GetExpression ()); \
+  }                                                                            \
+  template <class L>                                                           \
+  inline SpectrumValueScalarExpression<L, FUNCTOR>                             \
+  operator OP (const SpectrumValueExpression<L>& lhs, double rhs)              \
+  {                                                                            \
+    return SpectrumValueScalarExpression<L, FUNCTOR> (lhs.GetExpression (), rhs); \
+  }                                                                            \
+  template <class R>                                                           \
+  inline SpectrumValueScalarExpression<R, FUNCTOR>                             \
+  operator OP (double lhs, const SpectrumValueExpression<R>& rhs)              \
+  {                                                                            \
+    return SpectrumValueScalarExpression<R, FUNCTOR> (rhs.GetExpression (), lhs); \
+  }
+
+SPECTRUM_VALUE_BINARY_OPERATOR (+, SpectrumValueAdd)
+SPECTRUM_VALUE_BINARY_OPERATOR (-, SpectrumValueSubtract)
+SPECTRUM_VALUE_BINARY_OPERATOR (*, SpectrumValueMultiply)
+SPECTRUM_VALUE_BINARY_OPERATOR (/, SpectrumValueDivide)
+
+#undef SPECTRUM_VALUE_BINARY_OPERATOR
+
+/**
+ * unary plus operator
+ *
+ * @param rhs the operand
+ * @return the operand
+ */
+template <class E>
+inline SpectrumValueScalarExpression<E, SpectrumValueMultiply>
+operator+ (const SpectrumValueExpression<E>& rhs)
+{
+  return SpectrumValueScalarExpression<E, SpectrumValueMultiply> (rhs.GetExpression (), 1.0);
+}
+
+/**
+ * unary minus operator
+ *
+ * @param rhs the operand
+ * @return the opposite of the operand
+ */
+template <class E>
+inline SpectrumValueScalarExpression<E, SpectrumValueMultiply>
+operator- (const SpectrumValueExpression<E>& rhs)
+{
+  return SpectrumValueScalarExpression<E, SpectrumValueMultiply> (rhs.GetExpression (), -1.0);
+}
+
+/**
+ * @param x the operand
+ *
+ * @return the sum of all the values of the expression, evaluated
+ * without storing it
+ */
+template <class E>
+double
+Sum (const SpectrumValueExpression<E>& x)
+{
+  const E& e = x.GetExpression ();
+  size_t n = e.GetSpectrumModel ()->GetNumBands ();
+  double s = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      s += e[i];
+    }
+  return s;
+}
+
+/**
+ * @param arg the argument
+ *
+ * @return the value of the integral \f$\int_F g(f) df  \f$ of the
+ * expression, evaluated without storing it
+ */
+template <class E>
+double
+Integral (const SpectrumValueExpression<E>& arg)
+{
+  const E& e = arg.GetExpression ();
+  Ptr<const SpectrumModel> sm = e.GetSpectrumModel ();
+  size_t n = sm->GetNumBands ();
+  Bands::const_iterator bit = sm->Begin ();
+  double integral = 0;
+  for (size_t i = 0; i < n; ++i, ++bit)
+    {
+      integral += e[i] * (bit->fh - bit->fl);
+    }
+  return integral;
+}
+
+template <class E>
+SpectrumValue::SpectrumValue (const SpectrumValueExpression<E>& expr)
+  : m_spectrumModel (expr.GetExpression ().GetSpectrumModel ()),
+    m_values (m_spectrumModel->GetNumBands ())
+{
+  const E& e = expr.GetExpression ();
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] = e[i];
+    }
+}
+
+template <class E>
+SpectrumValue&
+SpectrumValue::operator= (const SpectrumValueExpression<E>& rhs)
+{
+  const E& e = rhs.GetExpression ();
+  // the expression may refer to *this, whose values are then
+  // overwritten band by band after being read
+  m_spectrumModel = e.GetSpectrumModel ();
+  m_values.resize (m_spectrumModel->GetNumBands ());
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] = e[i];
+    }
+  return *this;
+}
+
+template <class E>
+SpectrumValue&
+SpectrumValue::operator+= (const SpectrumValueExpression<E>& rhs)
+{
+  const E& e = rhs.GetExpression ();
+  NS_ASSERT (m_spectrumModel == e.GetSpectrumModel ());
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] += e[i];
+    }
+  return *this;
+}
+
+template <class E>
+SpectrumValue&
+SpectrumValue::operator-= (const SpectrumValueExpression<E>& rhs)
+{
+  const E& e = rhs.GetExpression ();
+  NS_ASSERT (m_spectrumModel == e.GetSpectrumModel ());
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] -= e[i];
+    }
+  return *this;
+}
+
+template <class E>
+SpectrumValue&
+SpectrumValue::operator*= (const SpectrumValueExpression<E>& rhs)
+{
+  const E& e = rhs.GetExpression ();
+  NS_ASSERT (m_spectrumModel == e.GetSpectrumModel ());
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] *= e[i];
+    }
+  return *this;
+}
+
+template <class E>
+SpectrumValue&
+SpectrumValue::operator/= (const SpectrumValueExpression<E>& rhs)
+{
+  const E& e = rhs.GetExpression ();
+  NS_ASSERT (m_spectrumModel == e.GetSpectrumModel ());
+  for (size_t i = 0; i < m_values.size (); ++i)
+    {
+      m_values[i] /= e[i];
+    }
+  return *this;
+}
+
 } // namespace ns3
 
 #endif /* SPECTRUM_VALUE_H */
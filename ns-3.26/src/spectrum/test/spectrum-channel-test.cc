@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/propagation-loss-model.h>
+
+using namespace ns3;
+
+/**
+ * A SpectrumPhy which counts the signals it receives
+ */
+class CountingSpectrumPhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param sm the SpectrumModel of the PHY
+   */
+  CountingSpectrumPhy (Ptr<const SpectrumModel> sm)
+    : m_spectrumModel (sm),
+      m_nRx (0)
+  {
+  }
+  virtual void SetDevice (Ptr<NetDevice> d)
+  {
+  }
+  virtual Ptr<NetDevice> GetDevice () const
+  {
+    return 0;
+  }
+  virtual void SetMobility (Ptr<MobilityModel> m)
+  {
+    m_mobility = m;
+  }
+  virtual Ptr<MobilityModel> GetMobility ()
+  {
+    return m_mobility;
+  }
+  virtual void SetChannel (Ptr<SpectrumChannel> c)
+  {
+  }
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const
+  {
+    return m_spectrumModel;
+  }
+  virtual Ptr<AntennaModel> GetRxAntenna ()
+  {
+    return 0;
+  }
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params)
+  {
+    m_nRx++;
+  }
+  /**
+   * \return the number of signals received so far
+   */
+  uint32_t GetNRx (void) const
+  {
+    return m_nRx;
+  }
+
+private:
+  Ptr<const SpectrumModel> m_spectrumModel; //!< the SpectrumModel
+  Ptr<MobilityModel> m_mobility;            //!< the mobility model
+  uint32_t m_nRx;                           //!< number of signals received
+};
+
+/**
+ * Check that the receivers beyond the MaxDistance attribute of a
+ * SpectrumChannel are not passed the transmitted signals, including
+ * after they move.
+ */
+class SpectrumChannelMaxDistanceTestCase : public TestCase
+{
+public:
+  /**
+   * \param channelType the TypeId name of the channel
+   */
+  SpectrumChannelMaxDistanceTestCase (std::string channelType);
+  virtual ~SpectrumChannelMaxDistanceTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a receiver and attach it to the channel
+   * \param mobility the mobility model of the receiver, or 0
+   * \return the receiver
+   */
+  Ptr<CountingSpectrumPhy> AddReceiver (Ptr<MobilityModel> mobility);
+  /**
+   * Transmit a signal from m_tx
+   */
+  void Transmit (void);
+
+  std::string m_channelType;          //!< the TypeId name of the channel
+  Ptr<SpectrumChannel> m_channel;     //!< the channel
+  Ptr<const SpectrumModel> m_model;   //!< the SpectrumModel of all the PHYs
+  Ptr<CountingSpectrumPhy> m_tx;      //!< the transmitter
+};
+
+SpectrumChannelMaxDistanceTestCase::SpectrumChannelMaxDistanceTestCase (std::string channelType)
+  : TestCase ("MaxDistance of " + channelType),
+    m_channelType (channelType)
+{
+}
+
+SpectrumChannelMaxDistanceTestCase::~SpectrumChannelMaxDistanceTestCase ()
+{
+}
+
+Ptr<CountingSpectrumPhy>
+SpectrumChannelMaxDistanceTestCase::AddReceiver (Ptr<MobilityModel> mobility)
+{
+  Ptr<CountingSpectrumPhy> phy = Create<CountingSpectrumPhy> (m_model);
+  phy->SetMobility (mobility);
+  m_channel->AddRx (phy);
+  return phy;
+}
+
+void
+SpectrumChannelMaxDistanceTestCase::Transmit (void)
+{
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MilliSeconds (1);
+  params->txPhy = m_tx;
+  params->psd = Create<SpectrumValue> (m_model);
+  *params->psd = 1e-9;
+  m_channel->StartTx (params);
+}
+
+void
+SpectrumChannelMaxDistanceTestCase::DoRun (void)
+{
+  Bands bands;
+  BandInfo bi;
+  bi.fl = 2.4e9;
+  bi.fc = 2.41e9;
+  bi.fh = 2.42e9;
+  bands.push_back (bi);
+  m_model = Create<SpectrumModel> (bands);
+
+  ObjectFactory factory;
+  factory.SetTypeId (m_channelType);
+  factory.Set ("MaxDistance", DoubleValue (100));
+  m_channel = factory.Create<SpectrumChannel> ();
+  m_channel->AddPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+
+  Ptr<ConstantPositionMobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+  txMobility->SetPosition (Vector (0, 0, 0));
+  m_tx = AddReceiver (txMobility);
+
+  Ptr<ConstantPositionMobilityModel> near = CreateObject<ConstantPositionMobilityModel> ();
+  near->SetPosition (Vector (50, 0, 0));
+  Ptr<CountingSpectrumPhy> nearRx = AddReceiver (near);
+
+  // in a neighbouring cell of the grid, but within range
+  Ptr<ConstantPositionMobilityModel> edge = CreateObject<ConstantPositionMobilityModel> ();
+  edge->SetPosition (Vector (-70, -70, 0));
+  Ptr<CountingSpectrumPhy> edgeRx = AddReceiver (edge);
+
+  // in a neighbouring cell of the grid, out of range
+  Ptr<ConstantPositionMobilityModel> corner = CreateObject<ConstantPositionMobilityModel> ();
+  corner->SetPosition (Vector (90, 90, 0));
+  Ptr<CountingSpectrumPhy> cornerRx = AddReceiver (corner);
+
+  Ptr<ConstantPositionMobilityModel> far = CreateObject<ConstantPositionMobilityModel> ();
+  far->SetPosition (Vector (1000, 0, 0));
+  Ptr<CountingSpectrumPhy> farRx = AddReceiver (far);
+
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetPosition (Vector (0, 380, 0));
+  moving->SetVelocity (Vector (0, -100, 0));
+  Ptr<CountingSpectrumPhy> movingRx = AddReceiver (moving);
+
+  // the mobility model of this receiver is set after it is attached
+  Ptr<CountingSpectrumPhy> lateRx = AddReceiver (0);
+  Ptr<ConstantPositionMobilityModel> late = CreateObject<ConstantPositionMobilityModel> ();
+  late->SetPosition (Vector (0, -500, 0));
+
+  Ptr<CountingSpectrumPhy> noMobilityRx = AddReceiver (0);
+
+  Simulator::Schedule (Seconds (1), &SpectrumChannelMaxDistanceTestCase::Transmit, this);
+  // the far receiver moves within range, the moving receiver is at
+  // 80 m, and the late receiver gets its mobility model out of range
+  Simulator::Schedule (Seconds (2), &ConstantPositionMobilityModel::SetPosition, far, Vector (0, 20, 0));
+  Simulator::Schedule (Seconds (2), &CountingSpectrumPhy::SetMobility, lateRx, late);
+  Simulator::Schedule (Seconds (3), &SpectrumChannelMaxDistanceTestCase::Transmit, this);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_tx->GetNRx (), 0, "the transmitter received its own signal");
+  NS_TEST_EXPECT_MSG_EQ (nearRx->GetNRx (), 2, "a receiver in range missed a signal");
+  NS_TEST_EXPECT_MSG_EQ (edgeRx->GetNRx (), 2, "a receiver in range missed a signal");
+  NS_TEST_EXPECT_MSG_EQ (cornerRx->GetNRx (), 0, "a receiver out of range received a signal");
+  NS_TEST_EXPECT_MSG_EQ (farRx->GetNRx (), 1, "the course change of a receiver was not accounted for");
+  NS_TEST_EXPECT_MSG_EQ (movingRx->GetNRx (), 1, "the position of a moving receiver was not accounted for");
+  NS_TEST_EXPECT_MSG_EQ (lateRx->GetNRx (), 1, "the late mobility model of a receiver was not accounted for");
+  NS_TEST_EXPECT_MSG_EQ (noMobilityRx->GetNRx (), 2, "a receiver without a mobility model missed a signal");
+
+  m_channel->Dispose ();
+  m_channel = 0;
+  m_tx = 0;
+  Simulator::Destroy ();
+}
+
+
+/**
+ * Test suite for the SpectrumChannel implementations
+ */
+class SpectrumChannelTestSuite : public TestSuite
+{
+public:
+  SpectrumChannelTestSuite ();
+};
+
+SpectrumChannelTestSuite::SpectrumChannelTestSuite ()
+  : TestSuite ("spectrum-channel", UNIT)
+{
+  AddTestCase (new SpectrumChannelMaxDistanceTestCase ("ns3::SingleModelSpectrumChannel"), TestCase::QUICK);
+  AddTestCase (new SpectrumChannelMaxDistanceTestCase ("ns3::MultiModelSpectrumChannel"), TestCase::QUICK);
+}
+
+static SpectrumChannelTestSuite g_spectrumChannelTestSuite;
@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ABSTRACTED_WIFI_HELPER_H
+#define ABSTRACTED_WIFI_HELPER_H
+
+#include "yans-wifi-helper.h"
+
+namespace ns3 {
+
+/**
+ * \brief Make it easy to create and manage PHY objects for the abstracted model.
+ *
+ * This helper creates ns3::AbstractedWifiPhy objects attached to a
+ * YansWifiChannel (see YansWifiChannelHelper). It is otherwise used
+ * exactly like YansWifiPhyHelper.
+ */
+class AbstractedWifiPhyHelper : public YansWifiPhyHelper
+{
+public:
+  /**
+   * Create a phy helper without any parameter set. The user must set
+   * them all to be able to call Install later.
+   */
+  AbstractedWifiPhyHelper ();
+
+  /**
+   * Create a phy helper in a default working state.
+   */
+  static AbstractedWifiPhyHelper Default (void);
+};
+
+} //namespace ns3
+
+#endif /* ABSTRACTED_WIFI_HELPER_H */
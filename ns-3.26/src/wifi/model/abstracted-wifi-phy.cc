@@ -0,0 +1,396 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "abstracted-wifi-phy.h"
+#include "wifi-phy-state-helper.h"
+#include "error-rate-model.h"
+#include "ampdu-tag.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AbstractedWifiPhy");
+
+NS_OBJECT_ENSURE_REGISTERED (AbstractedWifiPhy);
+
+TypeId
+AbstractedWifiPhy::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AbstractedWifiPhy")
+    .SetParent<YansWifiPhy> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<AbstractedWifiPhy> ()
+  ;
+  return tid;
+}
+
+AbstractedWifiPhy::AbstractedWifiPhy ()
+  : m_totalPowerW (0),
+    m_energyJ (0),
+    m_rxInterferenceW (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AbstractedWifiPhy::~AbstractedWifiPhy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+AbstractedWifiPhy::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  EraseSignals ();
+  YansWifiPhy::DoDispose ();
+}
+
+bool
+AbstractedWifiPhy::DoChannelSwitch (uint16_t nch)
+{
+  bool switching = YansWifiPhy::DoChannelSwitch (nch);
+  if (switching)
+    {
+      EraseSignals ();
+    }
+  return switching;
+}
+
+bool
+AbstractedWifiPhy::DoFrequencySwitch (uint32_t frequency)
+{
+  bool switching = YansWifiPhy::DoFrequencySwitch (frequency);
+  if (switching)
+    {
+      EraseSignals ();
+    }
+  return switching;
+}
+
+void
+AbstractedWifiPhy::ResumeFromSleep (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_state->GetState () == AbstractedWifiPhy::SLEEP)
+    {
+      NS_LOG_DEBUG ("resuming from sleep mode");
+      Time delayUntilCcaEnd = GetEnergyDuration (DbmToW (GetCcaMode1Threshold ()));
+      m_state->SwitchFromSleep (delayUntilCcaEnd);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("not in sleep mode, there is nothing to resume");
+    }
+}
+
+void
+AbstractedWifiPhy::AddSignal (double rxPowerW, Time duration)
+{
+  UpdateEnergy ();
+  m_signals.insert (std::make_pair (Simulator::Now () + duration, rxPowerW));
+  m_totalPowerW += rxPowerW;
+}
+
+void
+AbstractedWifiPhy::UpdateEnergy (void)
+{
+  Time now = Simulator::Now ();
+  while (!m_signals.empty () && m_signals.begin ()->first <= now)
+    {
+      Signals::iterator first = m_signals.begin ();
+      m_energyJ += m_totalPowerW * (first->first - m_lastUpdate).GetSeconds ();
+      m_lastUpdate = first->first;
+      m_totalPowerW -= first->second;
+      m_signals.erase (first);
+    }
+  if (m_signals.empty ())
+    {
+      //avoid accumulating rounding errors
+      m_totalPowerW = 0;
+    }
+  m_energyJ += m_totalPowerW * (now - m_lastUpdate).GetSeconds ();
+  m_lastUpdate = now;
+}
+
+void
+AbstractedWifiPhy::EraseSignals (void)
+{
+  m_signals.clear ();
+  m_totalPowerW = 0;
+  m_energyJ = 0;
+  m_lastUpdate = Simulator::Now ();
+}
+
+Time
+AbstractedWifiPhy::GetEnergyDuration (double energyW)
+{
+  UpdateEnergy ();
+  Time now = Simulator::Now ();
+  double powerW = m_totalPowerW;
+  if (powerW < energyW)
+    {
+      return MicroSeconds (0);
+    }
+  for (Signals::const_iterator i = m_signals.begin (); i != m_signals.end (); i++)
+    {
+      powerW -= i->second;
+      if (powerW < energyW)
+        {
+          return i->first - now;
+        }
+    }
+  return m_signals.empty () ? MicroSeconds (0) : m_signals.rbegin ()->first - now;
+}
+
+void
+AbstractedWifiPhy::MaybeCcaBusy (void)
+{
+  Time delayUntilCcaEnd = GetEnergyDuration (DbmToW (GetCcaMode1Threshold ()));
+  if (!delayUntilCcaEnd.IsZero ())
+    {
+      m_state->SwitchMaybeToCcaBusy (delayUntilCcaEnd);
+    }
+}
+
+void
+AbstractedWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
+                                                  double rxPowerDbm,
+                                                  WifiTxVector txVector,
+                                                  enum WifiPreamble preamble,
+                                                  enum mpduType mpdutype,
+                                                  Time rxDuration)
+{
+  NS_LOG_FUNCTION (this << packet << rxPowerDbm << txVector.GetMode () << preamble << (uint32_t)mpdutype);
+  AmpduTag ampduTag;
+  rxPowerDbm += GetRxGain ();
+  double rxPowerW = DbmToW (rxPowerDbm);
+  Time endRx = Simulator::Now () + rxDuration;
+
+  AddSignal (rxPowerW, rxDuration);
+
+  switch (m_state->GetState ())
+    {
+    case AbstractedWifiPhy::SWITCHING:
+      NS_LOG_DEBUG ("drop packet because of channel switching");
+      NotifyRxDrop (packet);
+      m_plcpSuccess = false;
+      if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
+        {
+          MaybeCcaBusy ();
+        }
+      break;
+    case AbstractedWifiPhy::RX:
+    case AbstractedWifiPhy::TX:
+      NS_LOG_DEBUG ("drop packet because already in Rx or Tx (power=" << rxPowerW << "W)");
+      NotifyRxDrop (packet);
+      if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
+        {
+          MaybeCcaBusy ();
+        }
+      break;
+    case AbstractedWifiPhy::CCA_BUSY:
+    case AbstractedWifiPhy::IDLE:
+      if (rxPowerW <= GetEdThresholdW ())
+        {
+          NS_LOG_DEBUG ("drop packet because signal power too Small (" <<
+                        rxPowerW << "<" << GetEdThresholdW () << ")");
+          NotifyRxDrop (packet);
+          m_plcpSuccess = false;
+          MaybeCcaBusy ();
+          break;
+        }
+      if (preamble == WIFI_PREAMBLE_NONE && (m_mpdusNum == 0 || m_plcpSuccess == false))
+        {
+          m_plcpSuccess = false;
+          m_mpdusNum = 0;
+          NS_LOG_DEBUG ("drop packet because no PLCP preamble/header has been received");
+          NotifyRxDrop (packet);
+          MaybeCcaBusy ();
+          break;
+        }
+      else if (preamble != WIFI_PREAMBLE_NONE && packet->PeekPacketTag (ampduTag) && m_mpdusNum == 0)
+        {
+          //received the first MPDU in an MPDU
+          m_mpdusNum = ampduTag.GetRemainingNbOfMpdus ();
+          m_rxMpduReferenceNumber++;
+        }
+      else if (preamble == WIFI_PREAMBLE_NONE && packet->PeekPacketTag (ampduTag) && m_mpdusNum > 0)
+        {
+          //received the other MPDUs that are part of the A-MPDU
+          if (ampduTag.GetRemainingNbOfMpdus () < (m_mpdusNum - 1))
+            {
+              NS_LOG_DEBUG ("Missing MPDU from the A-MPDU " << m_mpdusNum - ampduTag.GetRemainingNbOfMpdus ());
+              m_mpdusNum = ampduTag.GetRemainingNbOfMpdus ();
+            }
+          else
+            {
+              m_mpdusNum--;
+            }
+        }
+      else if (preamble != WIFI_PREAMBLE_NONE && packet->PeekPacketTag (ampduTag) && m_mpdusNum > 0)
+        {
+          NS_LOG_DEBUG ("New A-MPDU started while " << m_mpdusNum << " MPDUs from previous are lost");
+          m_mpdusNum = ampduTag.GetRemainingNbOfMpdus ();
+        }
+      else if (preamble != WIFI_PREAMBLE_NONE && m_mpdusNum > 0 )
+        {
+          NS_LOG_DEBUG ("Didn't receive the last MPDUs from an A-MPDU " << m_mpdusNum);
+          m_mpdusNum = 0;
+        }
+
+      NS_LOG_DEBUG ("sync to signal (power=" << rxPowerW << "W)");
+      m_state->SwitchToRx (rxDuration);
+      NotifyRxBegin (packet);
+      NS_ASSERT (m_endRxEvent.IsExpired ());
+      m_rxStart = Simulator::Now ();
+      //integrate the energy from the start of the frame only, so that the
+      //interference is not the difference of two large lifetime totals
+      UpdateEnergy ();
+      m_energyJ = 0;
+      m_rxInterferenceW = std::max (0.0, m_totalPowerW - rxPowerW);
+      m_endRxEvent = Simulator::Schedule (rxDuration, &AbstractedWifiPhy::EndReceive, this,
+                                          packet, txVector, preamble, mpdutype, rxPowerW);
+      break;
+    case AbstractedWifiPhy::SLEEP:
+      NS_LOG_DEBUG ("drop packet because in sleep mode");
+      NotifyRxDrop (packet);
+      m_plcpSuccess = false;
+      break;
+    }
+}
+
+double
+AbstractedWifiPhy::CalculateChunkSuccessRate (double snr, Time duration, WifiMode mode, WifiTxVector txVector) const
+{
+  if (duration == NanoSeconds (0))
+    {
+      return 1.0;
+    }
+  uint32_t rate = mode.GetPhyRate (txVector);
+  uint64_t nbits = (uint64_t)(rate * duration.GetSeconds ());
+  return GetErrorRateModel ()->GetChunkSuccessRate (mode, txVector, snr, (uint32_t)nbits);
+}
+
+void
+AbstractedWifiPhy::EndReceive (Ptr<Packet> packet, WifiTxVector txVector, enum WifiPreamble preamble,
+                               enum mpduType mpdutype, double rxPowerW)
+{
+  NS_LOG_FUNCTION (this << packet << preamble << (uint32_t)mpdutype << rxPowerW);
+  NS_ASSERT (IsStateRx ());
+
+  UpdateEnergy ();
+  Time rxDuration = Simulator::Now () - m_rxStart;
+  double interferenceW = 0;
+  if (rxDuration.IsStrictlyPositive ())
+    {
+      //the energy received since the start of the frame includes the frame itself
+      double interferenceJ = m_energyJ - rxPowerW * rxDuration.GetSeconds ();
+      interferenceW = std::max (0.0, interferenceJ / rxDuration.GetSeconds ());
+    }
+  //thermal noise at 290K in J/s = W
+  static const double BOLTZMANN = 1.3803e-23;
+  double noiseFloorW = DbToRatio (GetRxNoiseFigure ()) * BOLTZMANN * 290.0 * txVector.GetChannelWidth () * 1000000;
+  double snr = rxPowerW / (noiseFloorW + interferenceW);
+  //the SNR reported to the MAC is the one at the start of the frame, as in YansWifiPhy
+  double rxSnr = rxPowerW / (noiseFloorW + m_rxInterferenceW);
+
+  WifiMode payloadMode = txVector.GetMode ();
+  Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector, preamble);
+  if (preamble != WIFI_PREAMBLE_NONE)
+    {
+      Time headerDuration = GetPlcpHeaderDuration (txVector, preamble);
+      double psr = CalculateChunkSuccessRate (snr, headerDuration,
+                                              GetPlcpHeaderMode (payloadMode, preamble, txVector), txVector);
+      Time htHeaderDuration = preambleAndHeaderDuration - GetPlcpPreambleDuration (txVector, preamble) - headerDuration;
+      if (preamble == WIFI_PREAMBLE_HT_MF || preamble == WIFI_PREAMBLE_HT_GF)
+        {
+          psr *= CalculateChunkSuccessRate (snr, htHeaderDuration, GetHtPlcpHeaderMode (payloadMode), txVector);
+        }
+      else if (preamble == WIFI_PREAMBLE_VHT)
+        {
+          psr *= CalculateChunkSuccessRate (snr, htHeaderDuration, GetVhtPlcpHeaderMode (payloadMode), txVector);
+        }
+      NS_LOG_DEBUG ("snr(dB)=" << RatioToDb (snr) << ", plcp header per=" << 1 - psr);
+      if (m_random->GetValue () > 1 - psr)
+        {
+          if (IsModeSupported (payloadMode) || IsMcsSupported (payloadMode))
+            {
+              m_plcpSuccess = true;
+            }
+          else
+            {
+              NS_LOG_DEBUG ("drop packet because it was sent using an unsupported mode (" << payloadMode << ")");
+              m_plcpSuccess = false;
+            }
+        }
+      else
+        {
+          NS_LOG_DEBUG ("drop packet because plcp preamble/header reception failed");
+          m_plcpSuccess = false;
+        }
+    }
+
+  if (m_plcpSuccess == true)
+    {
+      double per = 1 - CalculateChunkSuccessRate (snr, rxDuration - preambleAndHeaderDuration, payloadMode, txVector);
+      NS_LOG_DEBUG ("mode=" << (payloadMode.GetDataRate (txVector)) <<
+                    ", snr(dB)=" << RatioToDb (snr) << ", per=" << per << ", size=" << packet->GetSize ());
+
+      if (m_random->GetValue () > per)
+        {
+          NotifyRxEnd (packet);
+          uint32_t dataRate500KbpsUnits;
+          if ((payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT) || (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_VHT))
+            {
+              dataRate500KbpsUnits = 128 + payloadMode.GetMcsValue ();
+            }
+          else
+            {
+              dataRate500KbpsUnits = payloadMode.GetDataRate (txVector.GetChannelWidth (), txVector.IsShortGuardInterval (), 1) * txVector.GetNss () / 500000;
+            }
+          struct signalNoiseDbm signalNoise;
+          signalNoise.signal = RatioToDb (rxPowerW) + 30;
+          signalNoise.noise = RatioToDb (rxPowerW / rxSnr) - GetRxNoiseFigure () + 30;
+          struct mpduInfo aMpdu;
+          aMpdu.type = mpdutype;
+          aMpdu.mpduRefNumber = m_rxMpduReferenceNumber;
+          NotifyMonitorSniffRx (packet, (uint16_t)GetFrequency (), GetChannelNumber (), dataRate500KbpsUnits, preamble, txVector, aMpdu, signalNoise);
+          m_state->SwitchFromRxEndOk (packet, rxSnr, txVector, preamble);
+        }
+      else
+        {
+          /* failure. */
+          NotifyRxDrop (packet);
+          m_state->SwitchFromRxEndError (packet, rxSnr);
+        }
+    }
+  else
+    {
+      NotifyRxDrop (packet);
+      m_state->SwitchFromRxEndError (packet, rxSnr);
+    }
+
+  if (preamble == WIFI_PREAMBLE_NONE && mpdutype == LAST_MPDU_IN_AGGREGATE)
+    {
+      m_plcpSuccess = false;
+    }
+}
+
+} //namespace ns3
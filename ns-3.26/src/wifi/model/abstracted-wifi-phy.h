@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ABSTRACTED_WIFI_PHY_H
+#define ABSTRACTED_WIFI_PHY_H
+
+#include <map>
+#include "yans-wifi-phy.h"
+
+namespace ns3 {
+
+/**
+ * \brief 802.11 PHY layer model using an effective SINR abstraction
+ * \ingroup wifi
+ *
+ * This PHY is connected to a YansWifiChannel and behaves like
+ * YansWifiPhy, except for the way the reception of a frame is evaluated.
+ * YansWifiPhy tracks every change of the interference power in an
+ * InterferenceHelper and computes the success rate of each chunk of the
+ * frame during which the interference is constant. This PHY instead
+ * keeps the aggregate power of the signals on the medium and its time
+ * integral, and maps the reception to a single effective SINR computed
+ * from the mean interference power observed over the frame duration:
+ *
+ *   SINR_eff = P / (N + E_I / T)
+ *
+ * where P is the received power, N the noise floor, E_I the interference
+ * energy received during the frame and T the frame duration. The success
+ * of the PLCP header and of the payload are then drawn once, at the end
+ * of the frame, with the configured ErrorRateModel. No event is scheduled
+ * at the end of the PLCP header.
+ *
+ * As in YansWifiPhy, the SNR reported to the MAC and to the monitor
+ * traces is the one at the start of the frame, i.e. it only accounts for
+ * the signals already on the medium when the PHY synchronized on it.
+ *
+ * When the interference is constant over the frame (including no
+ * interference at all), the error rate is identical to the one computed by
+ * YansWifiPhy. When the interference varies during the frame, averaging
+ * the interference power is optimistic for frames hit by a short burst
+ * of strong interference, since the error rate is a convex function of
+ * the SINR in the waterfall region.
+ */
+class AbstractedWifiPhy : public YansWifiPhy
+{
+public:
+  static TypeId GetTypeId (void);
+
+  AbstractedWifiPhy ();
+  virtual ~AbstractedWifiPhy ();
+
+  virtual void StartReceivePreambleAndHeader (Ptr<Packet> packet,
+                                              double rxPowerDbm,
+                                              WifiTxVector txVector,
+                                              WifiPreamble preamble,
+                                              enum mpduType mpdutype,
+                                              Time rxDuration);
+  virtual void ResumeFromSleep (void);
+
+
+protected:
+  // Inherited
+  virtual void DoDispose (void);
+  virtual bool DoChannelSwitch (uint16_t id);
+  virtual bool DoFrequencySwitch (uint32_t frequency);
+
+
+private:
+  /**
+   * The last bit of the packet has arrived.
+   *
+   * \param packet the packet that the last bit has arrived
+   * \param txVector the TXVECTOR of the arriving packet
+   * \param preamble the preamble of the arriving packet
+   * \param mpdutype the type of the MPDU as defined in WifiPhy::mpduType.
+   * \param rxPowerW the receive power in W
+   */
+  void EndReceive (Ptr<Packet> packet, WifiTxVector txVector, enum WifiPreamble preamble,
+                   enum mpduType mpdutype, double rxPowerW);
+  /**
+   * Add a signal to the aggregate power on the medium.
+   *
+   * \param rxPowerW the receive power in W
+   * \param duration the duration of the signal
+   */
+  void AddSignal (double rxPowerW, Time duration);
+  /**
+   * Remove the signals which ended and bring the aggregate energy
+   * up to date.
+   */
+  void UpdateEnergy (void);
+  /**
+   * Remove all the signals from the medium.
+   */
+  void EraseSignals (void);
+  /**
+   * \param energyW the minimum energy (W) requested
+   *
+   * \returns the expected amount of time the observed
+   *          energy on the medium will be higher than
+   *          the requested threshold.
+   */
+  Time GetEnergyDuration (double energyW);
+  /**
+   * Switch to CCA busy if the aggregate power on the medium is above
+   * the CCA mode 1 threshold.
+   */
+  void MaybeCcaBusy (void);
+  /**
+   * \param snr the SINR (linear)
+   * \param duration the duration of the chunk
+   * \param mode the mode used to transmit the chunk
+   * \param txVector the TXVECTOR of the frame
+   *
+   * \return the success rate of the chunk
+   */
+  double CalculateChunkSuccessRate (double snr, Time duration, WifiMode mode, WifiTxVector txVector) const;
+
+  /**
+   * typedef for a map of signals on the medium, indexed by end time.
+   */
+  typedef std::multimap<Time, double> Signals;
+
+  Signals m_signals;    //!< Receive power (W) of the signals on the medium, indexed by end time
+  double m_totalPowerW; //!< Sum of the receive powers of the signals on the medium
+  double m_energyJ;     //!< Integral of the aggregate receive power since the start of the last frame received
+  Time m_lastUpdate;    //!< Time up to which m_energyJ has been integrated
+  Time m_rxStart;       //!< Start time of the frame being received
+  double m_rxInterferenceW; //!< Interference power when the PHY synchronized on the frame being received
+};
+
+} //namespace ns3
+
+#endif /* ABSTRACTED_WIFI_PHY_H */
@@ -21,7 +21,9 @@
  */
 
 #include "ap-wifi-mac.h"
+#include "sta-wifi-mac.h"
 #include "ns3/assert.h"
+#include "ns3/abort.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
@@ -32,6 +34,7 @@
 #include "mac-rx-middle.h"
 #include "mac-tx-middle.h"
 #include "mgt-headers.h"
+#include "wifi-mac-trailer.h"
 #include "mac-low.h"
 #include "amsdu-subframe-header.h"
 #include "msdu-aggregator.h"
@@ -72,6 +75,14 @@ ApWifiMac::GetTypeId (void)
                    MakeBooleanAccessor (&ApWifiMac::SetBeaconGeneration,
                                         &ApWifiMac::GetBeaconGeneration),
                    MakeBooleanChecker ())
+    .AddAttribute ("EnableBeaconSuppression",
+                   "If beacons are enabled, whether to model them as periodic reservations of the medium "
+                   "instead of transmitting them. Stations must then be associated with ApWifiMac::PreAssociate, "
+                   "which also makes them defer to the beacons, or use active probing. "
+                   "This must be set before the simulation starts.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ApWifiMac::m_enableBeaconSuppression),
+                   MakeBooleanChecker ())
     .AddAttribute ("EnableNonErpProtection", "Whether or not protection mechanism should be used when non-ERP STAs are present within the BSS."
                    "This parameter is only used when ERP is supported by the AP.",
                    BooleanValue (true),
@@ -96,6 +107,8 @@ ApWifiMac::ApWifiMac ()
   SetTypeOfStation (AP);
 
   m_enableBeaconGeneration = false;
+  m_enableBeaconSuppression = false;
+  m_firstBeacon = Seconds (-1.0);
 }
 
 ApWifiMac::~ApWifiMac ()
@@ -134,7 +147,7 @@ ApWifiMac::SetBeaconGeneration (bool enable)
     {
       m_beaconEvent.Cancel ();
     }
-  else if (enable && !m_enableBeaconGeneration)
+  else if (enable && !m_enableBeaconGeneration && !m_enableBeaconSuppression)
     {
       m_beaconEvent = Simulator::ScheduleNow (&ApWifiMac::SendOneBeacon, this);
     }
@@ -556,13 +569,33 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success)
   hdr.SetAddr3 (GetAddress ());
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
+  if (m_htSupported || m_vhtSupported)
+    {
+      hdr.SetNoOrder ();
+    }
+  if (success)
+    {
+      m_staList.push_back (to);
+    }
   Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (GetAssocResp (success));
+
+  //The standard is not clear on the correct queue for management
+  //frames if we are a QoS AP. The approach taken here is to always
+  //use the DCF for these regardless of whether we have a QoS
+  //association or not.
+  m_dca->Queue (packet, hdr);
+}
+
+MgtAssocResponseHeader
+ApWifiMac::GetAssocResp (bool success) const
+{
+  NS_LOG_FUNCTION (this << success);
   MgtAssocResponseHeader assoc;
   StatusCode code;
   if (success)
     {
       code.SetSuccess ();
-      m_staList.push_back (to);
     }
   else
     {
@@ -583,19 +616,12 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success)
     {
       assoc.SetHtCapabilities (GetHtCapabilities ());
       assoc.SetHtOperations (GetHtOperations ());
-      hdr.SetNoOrder ();
     }
   if (m_vhtSupported)
     {
       assoc.SetVhtCapabilities (GetVhtCapabilities ());
     }
-  packet->AddHeader (assoc);
-
-  //The standard is not clear on the correct queue for management
-  //frames if we are a QoS AP. The approach taken here is to always
-  //use the DCF for these regardless of whether we have a QoS
-  //association or not.
-  m_dca->Queue (packet, hdr);
+  return assoc;
 }
 
 void
@@ -609,14 +635,34 @@ ApWifiMac::SendOneBeacon (void)
   hdr.SetAddr3 (GetAddress ());
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
+  if (m_htSupported || m_vhtSupported)
+    {
+      hdr.SetNoOrder ();
+    }
+  m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
+  m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
   Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (GetBeacon ());
+
+  //The beacon has it's own special queue, so we load it in there
+  m_beaconDca->Queue (packet, hdr);
+  m_beaconEvent = Simulator::Schedule (m_beaconInterval, &ApWifiMac::SendOneBeacon, this);
+
+  //If a STA that does not support Short Slot Time associates,
+  //the AP shall use long slot time beginning at the first Beacon
+  //subsequent to the association of the long slot time STA.
+  UpdateSlotTime ();
+}
+
+MgtBeaconHeader
+ApWifiMac::GetBeacon (void) const
+{
+  NS_LOG_FUNCTION (this);
   MgtBeaconHeader beacon;
   beacon.SetSsid (GetSsid ());
   beacon.SetSupportedRates (GetSupportedRates ());
   beacon.SetBeaconIntervalUs (m_beaconInterval.GetMicroSeconds ());
   beacon.SetCapabilities (GetCapabilities ());
-  m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
-  m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
   if (m_dsssSupported)
     {
       beacon.SetDsssParameterSet (GetDsssParameterSet ());
@@ -633,21 +679,51 @@ ApWifiMac::SendOneBeacon (void)
     {
       beacon.SetHtCapabilities (GetHtCapabilities ());
       beacon.SetHtOperations (GetHtOperations ());
-      hdr.SetNoOrder ();
     }
   if (m_vhtSupported)
     {
       beacon.SetVhtCapabilities (GetVhtCapabilities ());
     }
-  packet->AddHeader (beacon);
+  return beacon;
+}
 
-  //The beacon has it's own special queue, so we load it in there
-  m_beaconDca->Queue (packet, hdr);
-  m_beaconEvent = Simulator::Schedule (m_beaconInterval, &ApWifiMac::SendOneBeacon, this);
-  
-  //If a STA that does not support Short Slot Time associates,
-  //the AP shall use long slot time beginning at the first Beacon
-  //subsequent to the association of the long slot time STA.
+Time
+ApWifiMac::GetBeaconTxDuration (void) const
+{
+  NS_LOG_FUNCTION (this);
+  WifiMacHeader hdr;
+  hdr.SetBeacon ();
+  uint32_t size = hdr.GetSerializedSize () + GetBeacon ().GetSerializedSize () + WIFI_MAC_FCS_LENGTH;
+  WifiTxVector txVector = m_stationManager->GetDataTxVector (Mac48Address::GetBroadcast (), &hdr, 0);
+  WifiPreamble preamble = WIFI_PREAMBLE_LONG;
+  if (m_stationManager->GetShortPreambleEnabled ())
+    {
+      preamble = WIFI_PREAMBLE_SHORT;
+    }
+  return m_phy->CalculateTxDuration (size, txVector, preamble, m_phy->GetFrequency ());
+}
+
+Time
+ApWifiMac::GetFirstBeaconTime (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_firstBeacon.IsNegative ())
+    {
+      m_firstBeacon = Simulator::Now ();
+      if (m_enableBeaconJitter)
+        {
+          int64_t jitter = m_beaconJitter->GetValue (0, m_beaconInterval.GetMicroSeconds ());
+          m_firstBeacon += MicroSeconds (jitter);
+        }
+      NS_LOG_DEBUG ("First beacon of access point " << GetAddress () << " at time " << m_firstBeacon);
+    }
+  return m_firstBeacon;
+}
+
+void
+ApWifiMac::UpdateSlotTime (void)
+{
+  NS_LOG_FUNCTION (this);
   if (m_erpSupported)
     {
     if (GetShortSlotTimeEnabled () == true)
@@ -663,6 +739,26 @@ ApWifiMac::SendOneBeacon (void)
     }
 }
 
+void
+ApWifiMac::PreAssociate (Ptr<StaWifiMac> sta)
+{
+  NS_LOG_FUNCTION (this << sta);
+  Mac48Address address = sta->GetAddress ();
+  bool success = ProcessAssocRequest (sta->GetAssociationRequest (), address);
+  NS_ABORT_MSG_IF (!success, "Station " << address << " does not support the basic rate set of AP " << GetAddress ());
+  NS_LOG_DEBUG ("associated with sta=" << address);
+  m_stationManager->RecordGotAssocTxOk (address);
+  m_staList.push_back (address);
+  m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
+  m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
+  UpdateSlotTime ();
+  sta->SetPreAssociated (GetAddress (), GetAssocResp (true));
+  if (m_enableBeaconGeneration && m_enableBeaconSuppression)
+    {
+      sta->AddPeriodicReservation (GetFirstBeaconTime (), m_beaconInterval, GetBeaconTxDuration ());
+    }
+}
+
 void
 ApWifiMac::TxOk (const WifiMacHeader &hdr)
 {
@@ -779,153 +875,9 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
         {
           if (hdr->IsAssocReq ())
             {
-              //first, verify that the the station's supported
-              //rate set is compatible with our Basic Rate set
               MgtAssocRequestHeader assocReq;
               packet->RemoveHeader (assocReq);
-              CapabilityInformation capabilities = assocReq.GetCapabilities ();
-              m_stationManager->AddSupportedPlcpPreamble (from, capabilities.IsShortPreamble ());
-              SupportedRates rates = assocReq.GetSupportedRates ();
-              bool problem = false;
-              bool isHtStation = false;
-              bool isOfdmStation = false;
-              bool isErpStation = false;
-              bool isDsssStation = false;
-              for (uint32_t i = 0; i < m_stationManager->GetNBasicModes (); i++)
-                {
-                  WifiMode mode = m_stationManager->GetBasicMode (i);
-                  uint8_t nss = 1; // Assume 1 spatial stream in basic mode
-                  if (!rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
-                    {
-                      if ((mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS) || (mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS))
-                        {
-                          isDsssStation = false;
-                        }
-                      else if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
-                        {
-                          isErpStation = false;
-                        }
-                      else if (mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM)
-                        {
-                          isOfdmStation = false;
-                        }
-                      if (isDsssStation == false && isErpStation == false && isOfdmStation == false)
-                        {
-                          problem = true;
-                          break;
-                        }
-                    }
-                  else
-                    {
-                      if ((mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS) || (mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS))
-                        {
-                          isDsssStation = true;
-                        }
-                      else if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
-                        {
-                          isErpStation = true;
-                        }
-                      else if (mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM)
-                        {
-                          isOfdmStation = true;
-                        }
-                    }
-                }
-              m_stationManager->AddSupportedErpSlotTime (from, capabilities.IsShortSlotTime () && isErpStation);
-              if (m_htSupported)
-                {
-                  //check whether the HT STA supports all MCSs in Basic MCS Set
-                  HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
-                  if (htcapabilities.GetHtCapabilitiesInfo () != 0)
-                    {
-                      isHtStation = true;
-                      for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
-                        {
-                          WifiMode mcs = m_stationManager->GetBasicMcs (i);
-                          if (!htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
-                            {
-                              problem = true;
-                              break;
-                            }
-                        }
-                    }
-                }
-              if (m_vhtSupported)
-                {
-                  //check whether the VHT STA supports all MCSs in Basic MCS Set
-                  VhtCapabilities vhtcapabilities = assocReq.GetVhtCapabilities ();
-                  if (vhtcapabilities.GetVhtCapabilitiesInfo () != 0)
-                    {
-                      for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
-                        {
-                          WifiMode mcs = m_stationManager->GetBasicMcs (i);
-                          if (!vhtcapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
-                            {
-                              problem = true;
-                              break;
-                            }
-                        }
-                    }
-                }
-              if (problem)
-                {
-                  //One of the Basic Rate set mode is not
-                  //supported by the station. So, we return an assoc
-                  //response with an error status.
-                  SendAssocResp (hdr->GetAddr2 (), false);
-                }
-              else
-                {
-                  //station supports all rates in Basic Rate Set.
-                  //record all its supported modes in its associated WifiRemoteStation
-                  for (uint32_t j = 0; j < m_phy->GetNModes (); j++)
-                    {
-                      WifiMode mode = m_phy->GetMode (j);
-                      uint8_t nss = 1; // Assume 1 spatial stream in basic mode
-                      if (rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
-                        {
-                          m_stationManager->AddSupportedMode (from, mode);
-                        }
-                    }
-                  if (m_htSupported)
-                    {
-                      HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
-                      m_stationManager->AddStationHtCapabilities (from, htcapabilities);
-                      for (uint32_t j = 0; j < m_phy->GetNMcs (); j++)
-                        {
-                          WifiMode mcs = m_phy->GetMcs (j);
-                          if (mcs.GetModulationClass () == WIFI_MOD_CLASS_HT && htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
-                            {
-                              m_stationManager->AddSupportedMcs (from, mcs);
-                            }
-                        }
-                    }
-                  if (m_vhtSupported)
-                    {
-                      VhtCapabilities vhtCapabilities = assocReq.GetVhtCapabilities ();
-                      m_stationManager->AddStationVhtCapabilities (from, vhtCapabilities);
-                      for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
-                        {
-                          WifiMode mcs = m_phy->GetMcs (i);
-                          if (mcs.GetModulationClass () == WIFI_MOD_CLASS_VHT && vhtCapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
-                            {
-                              m_stationManager->AddSupportedMcs (hdr->GetAddr2 (), mcs);
-                              //here should add a control to add basic MCS when it is implemented
-                            }
-                        }
-                    }
-                  m_stationManager->RecordWaitAssocTxOk (from);
-                  if (!isHtStation)
-                    {
-                      m_nonHtStations.push_back (hdr->GetAddr2 ());
-                    }
-                  if (!isErpStation && isDsssStation)
-                    {
-                      m_nonErpStations.push_back (hdr->GetAddr2 ());
-                    }
-                  // send assoc response with success status.
-                  SendAssocResp (hdr->GetAddr2 (), true);
-                }
+              SendAssocResp (from, ProcessAssocRequest (assocReq, from));
               return;
             }
           else if (hdr->IsDisassociation ())
@@ -966,6 +918,157 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
   RegularWifiMac::Receive (packet, hdr);
 }
 
+bool
+ApWifiMac::ProcessAssocRequest (MgtAssocRequestHeader assocReq, Mac48Address from)
+{
+  NS_LOG_FUNCTION (this << from);
+  //first, verify that the the station's supported
+  //rate set is compatible with our Basic Rate set
+  CapabilityInformation capabilities = assocReq.GetCapabilities ();
+  m_stationManager->AddSupportedPlcpPreamble (from, capabilities.IsShortPreamble ());
+  SupportedRates rates = assocReq.GetSupportedRates ();
+  bool problem = false;
+  bool isHtStation = false;
+  bool isOfdmStation = false;
+  bool isErpStation = false;
+  bool isDsssStation = false;
+  for (uint32_t i = 0; i < m_stationManager->GetNBasicModes (); i++)
+    {
+      WifiMode mode = m_stationManager->GetBasicMode (i);
+      uint8_t nss = 1; // Assume 1 spatial stream in basic mode
+      if (!rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
+        {
+          if ((mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS) || (mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS))
+            {
+              isDsssStation = false;
+            }
+          else if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
+            {
+              isErpStation = false;
+            }
+          else if (mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM)
+            {
+              isOfdmStation = false;
+            }
+          if (isDsssStation == false && isErpStation == false && isOfdmStation == false)
+            {
+              problem = true;
+              break;
+            }
+        }
+      else
+        {
+          if ((mode.GetModulationClass () == WIFI_MOD_CLASS_DSSS) || (mode.GetModulationClass () == WIFI_MOD_CLASS_HR_DSSS))
+            {
+              isDsssStation = true;
+            }
+          else if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM)
+            {
+              isErpStation = true;
+            }
+          else if (mode.GetModulationClass () == WIFI_MOD_CLASS_OFDM)
+            {
+              isOfdmStation = true;
+            }
+        }
+    }
+  m_stationManager->AddSupportedErpSlotTime (from, capabilities.IsShortSlotTime () && isErpStation);
+  if (m_htSupported)
+    {
+      //check whether the HT STA supports all MCSs in Basic MCS Set
+      HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
+      if (htcapabilities.GetHtCapabilitiesInfo () != 0)
+        {
+          isHtStation = true;
+          for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
+            {
+              WifiMode mcs = m_stationManager->GetBasicMcs (i);
+              if (!htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
+                {
+                  problem = true;
+                  break;
+                }
+            }
+        }
+    }
+  if (m_vhtSupported)
+    {
+      //check whether the VHT STA supports all MCSs in Basic MCS Set
+      VhtCapabilities vhtcapabilities = assocReq.GetVhtCapabilities ();
+      if (vhtcapabilities.GetVhtCapabilitiesInfo () != 0)
+        {
+          for (uint32_t i = 0; i < m_stationManager->GetNBasicMcs (); i++)
+            {
+              WifiMode mcs = m_stationManager->GetBasicMcs (i);
+              if (!vhtcapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
+                {
+                  problem = true;
+                  break;
+                }
+            }
+        }
+    }
+  if (problem)
+    {
+      //One of the Basic Rate set mode is not
+      //supported by the station. So, the association
+      //is refused.
+      return false;
+    }
+  else
+    {
+      //station supports all rates in Basic Rate Set.
+      //record all its supported modes in its associated WifiRemoteStation
+      for (uint32_t j = 0; j < m_phy->GetNModes (); j++)
+        {
+          WifiMode mode = m_phy->GetMode (j);
+          uint8_t nss = 1; // Assume 1 spatial stream in basic mode
+          if (rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
+            {
+              m_stationManager->AddSupportedMode (from, mode);
+            }
+        }
+      if (m_htSupported)
+        {
+          HtCapabilities htcapabilities = assocReq.GetHtCapabilities ();
+          m_stationManager->AddStationHtCapabilities (from, htcapabilities);
+          for (uint32_t j = 0; j < m_phy->GetNMcs (); j++)
+            {
+              WifiMode mcs = m_phy->GetMcs (j);
+              if (mcs.GetModulationClass () == WIFI_MOD_CLASS_HT && htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
+                {
+                  m_stationManager->AddSupportedMcs (from, mcs);
+                }
+            }
+        }
+      if (m_vhtSupported)
+        {
+          VhtCapabilities vhtCapabilities = assocReq.GetVhtCapabilities ();
+          m_stationManager->AddStationVhtCapabilities (from, vhtCapabilities);
+          for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
+            {
+              WifiMode mcs = m_phy->GetMcs (i);
+              if (mcs.GetModulationClass () == WIFI_MOD_CLASS_VHT && vhtCapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
+                {
+                  m_stationManager->AddSupportedMcs (from, mcs);
+                  //here should add a control to add basic MCS when it is implemented
+                }
+            }
+        }
+      m_stationManager->RecordWaitAssocTxOk (from);
+      if (!isHtStation)
+        {
+          m_nonHtStations.push_back (from);
+        }
+      if (!isErpStation && isDsssStation)
+        {
+          m_nonErpStations.push_back (from);
+        }
+      //the association is accepted.
+      return true;
+    }
+}
+
 void
 ApWifiMac::DeaggregateAmsduAndForward (Ptr<Packet> aggregatedPacket,
                                        const WifiMacHeader *hdr)
@@ -1000,7 +1103,14 @@ ApWifiMac::DoInitialize (void)
   m_beaconEvent.Cancel ();
   if (m_enableBeaconGeneration)
     {
-      if (m_enableBeaconJitter)
+      if (m_enableBeaconSuppression)
+        {
+          NS_LOG_DEBUG ("Reserving the medium for the beacons of access point " << GetAddress ());
+          m_stationManager->SetShortPreambleEnabled (GetShortPreambleEnabled ());
+          m_stationManager->SetShortSlotTimeEnabled (GetShortSlotTimeEnabled ());
+          m_dcfManager->AddPeriodicReservation (GetFirstBeaconTime (), m_beaconInterval, GetBeaconTxDuration ());
+        }
+      else if (m_enableBeaconJitter)
         {
           int64_t jitter = m_beaconJitter->GetValue (0, m_beaconInterval.GetMicroSeconds ());
           NS_LOG_DEBUG ("Scheduling initial beacon for access point " << GetAddress () << " at time " << jitter << " microseconds");
@@ -37,6 +37,11 @@
 
 namespace ns3 {
 
+class StaWifiMac;
+class MgtAssocRequestHeader;
+class MgtAssocResponseHeader;
+class MgtBeaconHeader;
+
 /**
  * \brief Wi-Fi AP state machine
  * \ingroup wifi
@@ -117,6 +122,20 @@ public:
    */
   bool GetShortPreambleEnabled (void) const;
 
+  /**
+   * \param sta the MAC of the station to associate
+   *
+   * Associate the given station with this AP at the current time without
+   * exchanging any frame. The capabilities of the station and of the AP
+   * are handled as if the station had sent an association request and
+   * received a successful association response. If beacon suppression is
+   * enabled, the medium of the station is also reserved for the beacons
+   * of this AP. This is meant to be called before the simulation starts,
+   * once both devices are installed, to avoid simulating the association
+   * of static stations.
+   */
+  void PreAssociate (Ptr<StaWifiMac> sta);
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -194,10 +213,45 @@ private:
    * \param success indicates whether the association was successful or not
    */
   void SendAssocResp (Mac48Address to, bool success);
+  /**
+   * Check whether the station which sent the given association
+   * request can be associated, and record its capabilities if so.
+   *
+   * \param assocReq the association request
+   * \param from the address of the STA which sent the association request
+   *
+   * \return true if the association is accepted, false otherwise
+   */
+  bool ProcessAssocRequest (MgtAssocRequestHeader assocReq, Mac48Address from);
+  /**
+   * \param success indicates whether the association was successful or not
+   *
+   * \return the association response sent by this AP
+   */
+  MgtAssocResponseHeader GetAssocResp (bool success) const;
   /**
    * Forward a beacon packet to the beacon special DCF.
    */
   void SendOneBeacon (void);
+  /**
+   * \return the beacon sent by this AP
+   */
+  MgtBeaconHeader GetBeacon (void) const;
+  /**
+   * \return the duration of the transmission of a beacon
+   */
+  Time GetBeaconTxDuration (void) const;
+  /**
+   * Return the time of the first beacon when beacon suppression is
+   * enabled, drawing the beacon jitter on the first call.
+   *
+   * \return the time of the first beacon
+   */
+  Time GetFirstBeaconTime (void);
+  /**
+   * Use the short slot time if the BSS allows it and the long one otherwise.
+   */
+  void UpdateSlotTime (void);
   /**
    * Return the Capability information of the current AP.
    *
@@ -264,6 +318,8 @@ private:
   EventId m_beaconEvent;                     //!< Event to generate one beacon
   Ptr<UniformRandomVariable> m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
   bool m_enableBeaconJitter;                 //!< Flag whether the first beacon should be generated at random time
+  bool m_enableBeaconSuppression;            //!< Flag whether beacons are modeled as reservations of the medium
+  Time m_firstBeacon;                        //!< Time of the first beacon when beacons are suppressed
   std::list<Mac48Address> m_staList;         //!< List of all stations currently associated to the AP
   std::list<Mac48Address> m_nonErpStations;  //!< List of all non-ERP stations currently associated to the AP
   std::list<Mac48Address> m_nonHtStations;   //!< List of all non-HT stations currently associated to the AP
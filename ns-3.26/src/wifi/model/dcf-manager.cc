@@ -338,6 +338,9 @@ DcfManager::DcfManager ()
     m_lastBusyDuration (MicroSeconds (0)),
     m_lastSwitchingStart (MicroSeconds (0)),
     m_lastSwitchingDuration (MicroSeconds (0)),
+    m_nextReservationStart (Time::Max ()),
+    m_lastReservationStart (MicroSeconds (0)),
+    m_lastReservationDuration (MicroSeconds (0)),
     m_rxing (false),
     m_sleeping (false),
     m_slotTimeUs (0),
@@ -505,6 +508,12 @@ DcfManager::IsBusy (void) const
     {
       return true;
     }
+  // Reserved
+  Time lastReservationEnd = m_lastReservationStart + m_lastReservationDuration;
+  if (lastReservationEnd > Simulator::Now ())
+    {
+      return true;
+    }
   return false;
 }
 
@@ -574,12 +583,13 @@ void
 DcfManager::DoGrantAccess (void)
 {
   NS_LOG_FUNCTION (this);
+  Time accessGrantStart = GetAccessGrantStart ();
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); k++)
     {
       DcfState *state = *i;
       if (state->IsAccessRequested ()
-          && GetBackoffEndFor (state) <= Simulator::Now () )
+          && GetBackoffEndFor (state, accessGrantStart) <= Simulator::Now () )
         {
           /**
            * This is the first dcf we find with an expired backoff and which
@@ -593,7 +603,7 @@ DcfManager::DoGrantAccess (void)
             {
               DcfState *otherState = *j;
               if (otherState->IsAccessRequested ()
-                  && GetBackoffEndFor (otherState) <= Simulator::Now ())
+                  && GetBackoffEndFor (otherState, accessGrantStart) <= Simulator::Now ())
                 {
                   MY_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
                             otherState->GetBackoffSlots ());
@@ -665,6 +675,8 @@ DcfManager::GetAccessGrantStart (void) const
                                         ctsTimeoutAccessStart,
                                         switchingAccessStart
                                         );
+  Time reservationAccessStart = m_lastReservationStart + m_lastReservationDuration + m_sifs;
+  accessGrantedStart = MostRecent (accessGrantedStart, reservationAccessStart);
   NS_LOG_INFO ("access grant start=" << accessGrantedStart <<
                ", rx access start=" << rxAccessStart <<
                ", busy access start=" << busyAccessStart <<
@@ -674,38 +686,48 @@ DcfManager::GetAccessGrantStart (void) const
 }
 
 Time
-DcfManager::GetBackoffStartFor (DcfState *state)
+DcfManager::GetBackoffStartFor (DcfState *state, Time accessGrantStart) const
 {
-  NS_LOG_FUNCTION (this << state);
+  NS_LOG_FUNCTION (this << state << accessGrantStart);
   Time mostRecentEvent = MostRecent (state->GetBackoffStart (),
-                                     GetAccessGrantStart () + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
+                                     accessGrantStart + MicroSeconds (state->GetAifsn () * m_slotTimeUs));
 
   return mostRecentEvent;
 }
 
 Time
-DcfManager::GetBackoffEndFor (DcfState *state)
+DcfManager::GetBackoffEndFor (DcfState *state, Time accessGrantStart) const
 {
-  NS_LOG_FUNCTION (this << state);
-  NS_LOG_DEBUG ("Backoff start: " << GetBackoffStartFor (state).As (Time::US) <<
-    " end: " << (GetBackoffStartFor (state) + 
-    MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs)).As (Time::US)); 
-  return GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+  NS_LOG_FUNCTION (this << state << accessGrantStart);
+  Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
+  Time backoffEnd = backoffStart + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+  NS_LOG_DEBUG ("Backoff start: " << backoffStart.As (Time::US) <<
+                " end: " << backoffEnd.As (Time::US));
+  return backoffEnd;
 }
 
 void
 DcfManager::UpdateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
+  UpdateReservations ();
+  DoUpdateBackoff (Simulator::Now ());
+}
+
+void
+DcfManager::DoUpdateBackoff (Time now)
+{
+  NS_LOG_FUNCTION (this << now);
+  Time accessGrantStart = GetAccessGrantStart ();
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       DcfState *state = *i;
 
-      Time backoffStart = GetBackoffStartFor (state);
-      if (backoffStart <= Simulator::Now ())
+      Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
+      if (backoffStart <= now)
         {
-          uint32_t nus = (Simulator::Now () - backoffStart).GetMicroSeconds ();
+          uint32_t nus = (now - backoffStart).GetMicroSeconds ();
           uint32_t nIntSlots = nus / m_slotTimeUs;
           /*
            * EDCA behaves slightly different to DCA. For EDCA we
@@ -730,6 +752,70 @@ DcfManager::UpdateBackoff (void)
     }
 }
 
+void
+DcfManager::UpdateReservations (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_nextReservationStart <= Simulator::Now ())
+    {
+      Time start = m_nextReservationStart;
+      //count the slots which elapsed before the medium was reserved
+      DoUpdateBackoff (start);
+      Time end = Max (m_lastReservationStart + m_lastReservationDuration, start);
+      for (Reservations::const_iterator i = m_reservations.begin (); i != m_reservations.end (); i++)
+        {
+          if (start >= i->start
+              && (start - i->start).GetTimeStep () % i->interval.GetTimeStep () == 0)
+            {
+              end = Max (end, start + i->duration);
+            }
+        }
+      MY_DEBUG ("reservation from " << start << " to " << end);
+      m_lastReservationStart = start;
+      m_lastReservationDuration = end - start;
+      m_nextReservationStart = GetNextReservationStart (start);
+    }
+}
+
+Time
+DcfManager::GetNextReservationStart (Time after) const
+{
+  NS_LOG_FUNCTION (this << after);
+  Time next = Time::Max ();
+  for (Reservations::const_iterator i = m_reservations.begin (); i != m_reservations.end (); i++)
+    {
+      Time start = i->start;
+      if (start <= after)
+        {
+          int64_t n = (after - i->start).GetTimeStep () / i->interval.GetTimeStep () + 1;
+          start = i->start + TimeStep (n * i->interval.GetTimeStep ());
+        }
+      next = std::min (next, start);
+    }
+  return next;
+}
+
+void
+DcfManager::AddPeriodicReservation (Time start, Time interval, Time duration)
+{
+  NS_LOG_FUNCTION (this << start << interval << duration);
+  NS_ASSERT (interval.IsStrictlyPositive ());
+  NS_ASSERT (duration < interval);
+  if (start < Simulator::Now ())
+    {
+      //skip the reservations which started in the past
+      int64_t n = (Simulator::Now () - start - TimeStep (1)).GetTimeStep () / interval.GetTimeStep () + 1;
+      start += TimeStep (n * interval.GetTimeStep ());
+    }
+  Reservation reservation;
+  reservation.start = start;
+  reservation.interval = interval;
+  reservation.duration = duration;
+  m_reservations.push_back (reservation);
+  m_nextReservationStart = std::min (m_nextReservationStart, start);
+  DoRestartAccessTimeoutIfNeeded ();
+}
+
 void
 DcfManager::DoRestartAccessTimeoutIfNeeded (void)
 {
@@ -740,12 +826,13 @@ DcfManager::DoRestartAccessTimeoutIfNeeded (void)
    */
   bool accessTimeoutNeeded = false;
   Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
+  Time accessGrantStart = GetAccessGrantStart ();
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++)
     {
       DcfState *state = *i;
       if (state->IsAccessRequested ())
         {
-          Time tmp = GetBackoffEndFor (state);
+          Time tmp = GetBackoffEndFor (state, accessGrantStart);
           if (tmp > Simulator::Now ())
             {
               accessTimeoutNeeded = true;
@@ -754,6 +841,12 @@ DcfManager::DoRestartAccessTimeoutIfNeeded (void)
         }
     }
   NS_LOG_DEBUG ("Access timeout needed: " << accessTimeoutNeeded);
+  if (accessTimeoutNeeded && m_nextReservationStart < expectedBackoffEnd)
+    {
+      //wake up at the start of the reservation to count the
+      //slots which elapsed before the medium became busy
+      expectedBackoffEnd = Max (m_nextReservationStart, Simulator::Now ());
+    }
   if (accessTimeoutNeeded)
     {
       MY_DEBUG ("expected backoff end=" << expectedBackoffEnd);
@@ -430,12 +430,49 @@ public:
    */
   void NotifyCtsTimeoutResetNow ();
 
+  /**
+   * \param start the start of the first reservation
+   * \param interval the delay between the start of two reservations
+   * \param duration the duration of each reservation
+   *
+   * Reserve the medium periodically, as if a frame lasting for the
+   * specified duration was received every interval. This accounts for
+   * the airtime of frames which are not simulated, such as the beacons
+   * of an ApWifiMac which does not generate them. No event is scheduled
+   * for the reservations: a reservation is applied the next time the
+   * backoff slots are updated, and an access timeout is only scheduled
+   * at the start of a reservation if a DcfState is waiting for access
+   * at that time. The reservations which would have started before
+   * the current time are ignored.
+   */
+  void AddPeriodicReservation (Time start, Time interval, Time duration);
+
 
 private:
   /**
    * Update backoff slots for all DcfStates.
    */
   void UpdateBackoff (void);
+  /**
+   * Update backoff slots for all DcfStates, counting
+   * the slots which elapsed up to the specified time.
+   *
+   * \param now the time up to which slots are counted
+   */
+  void DoUpdateBackoff (Time now);
+  /**
+   * Apply the periodic reservations which started since the
+   * last update, counting the backoff slots which elapsed
+   * before the start of each of them.
+   */
+  void UpdateReservations (void);
+  /**
+   * \param after a time
+   *
+   * \return the start of the first periodic reservation strictly
+   *         after the specified time
+   */
+  Time GetNextReservationStart (Time after) const;
   /**
    * Return the most recent time.
    *
@@ -505,19 +542,21 @@ private:
    * started for the given DcfState.
    *
    * \param state
+   * \param accessGrantStart the value returned by GetAccessGrantStart
    *
    * \return the time when the backoff procedure started
    */
-  Time GetBackoffStartFor (DcfState *state);
+  Time GetBackoffStartFor (DcfState *state, Time accessGrantStart) const;
   /**
    * Return the time when the backoff procedure
    * ended (or will ended) for the given DcfState.
    *
    * \param state
+   * \param accessGrantStart the value returned by GetAccessGrantStart
    *
    * \return the time when the backoff procedure ended (or will ended)
    */
-  Time GetBackoffEndFor (DcfState *state);
+  Time GetBackoffEndFor (DcfState *state, Time accessGrantStart) const;
 
   void DoRestartAccessTimeoutIfNeeded (void);
 
@@ -552,6 +591,21 @@ private:
    */
   typedef std::vector<DcfState *> States;
 
+  /**
+   * A periodic reservation of the medium
+   */
+  struct Reservation
+  {
+    Time start;    //!< start of the first reservation
+    Time interval; //!< delay between the start of two reservations
+    Time duration; //!< duration of each reservation
+  };
+
+  /**
+   * typedef for a vector of Reservations
+   */
+  typedef std::vector<Reservation> Reservations;
+
   States m_states;
   Time m_lastAckTimeoutEnd;
   Time m_lastCtsTimeoutEnd;
@@ -567,6 +621,10 @@ private:
   Time m_lastBusyDuration;
   Time m_lastSwitchingStart;
   Time m_lastSwitchingDuration;
+  Reservations m_reservations;
+  Time m_nextReservationStart;
+  Time m_lastReservationStart;
+  Time m_lastReservationDuration;
   bool m_rxing;
   bool m_sleeping;
   Time m_eifsNoDifs;
@@ -223,6 +223,13 @@ RegularWifiMac::GetVhtCapabilities (void) const
   return capabilities;
 }
 
+void
+RegularWifiMac::AddPeriodicReservation (Time start, Time interval, Time duration)
+{
+  NS_LOG_FUNCTION (this << start << interval << duration);
+  m_dcfManager->AddPeriodicReservation (start, interval, duration);
+}
+
 void
 RegularWifiMac::SetVoMaxAmsduSize (uint32_t size)
 {
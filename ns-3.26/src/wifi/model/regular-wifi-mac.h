@@ -232,6 +232,18 @@ public:
    * \return the VHT capability that we support
    */
   VhtCapabilities GetVhtCapabilities (void) const;
+  /**
+   * \param start the start of the first reservation
+   * \param interval the delay between the start of two reservations
+   * \param duration the duration of each reservation
+   *
+   * Periodically reserve the medium for frames which are heard by
+   * this MAC but not simulated, e.g., the beacons of an ApWifiMac
+   * for which beacon suppression is enabled.
+   *
+   * \sa DcfManager::AddPeriodicReservation
+   */
+  void AddPeriodicReservation (Time start, Time interval, Time duration);
 
   /**
    * This type defines the callback of a higher layer that a
@@ -38,6 +38,7 @@
 #include "wifi-phy-tag.h"
 #include "ns3/antenna-model.h"
 #include <cmath>
+#include <map>
 
 namespace ns3 {
 
@@ -45,6 +46,52 @@ NS_LOG_COMPONENT_DEFINE ("SpectrumWifiPhy");
 
 NS_OBJECT_ENSURE_REGISTERED (SpectrumWifiPhy);
 
+/**
+ * Key of the cache of transmit power spectral densities normalized to 1 W
+ */
+struct WifiTxPsdTemplateId
+{
+  /**
+   * Constructor
+   * \param f center frequency (MHz)
+   * \param w channel width (MHz)
+   * \param standard the standard in use
+   */
+  WifiTxPsdTemplateId (uint32_t f, uint32_t w, enum WifiPhyStandard standard);
+  uint32_t m_centerFrequency;     //!< center frequency (MHz)
+  uint32_t m_channelWidth;        //!< channel width (MHz)
+  enum WifiPhyStandard m_standard; //!< standard
+};
+
+WifiTxPsdTemplateId::WifiTxPsdTemplateId (uint32_t f, uint32_t w, enum WifiPhyStandard standard)
+  : m_centerFrequency (f),
+    m_channelWidth (w),
+    m_standard (standard)
+{
+}
+
+/**
+ * \param a the first key
+ * \param b the second key
+ * \return true if a is less than b
+ */
+bool
+operator < (const WifiTxPsdTemplateId& a, const WifiTxPsdTemplateId& b)
+{
+  if (a.m_centerFrequency != b.m_centerFrequency)
+    {
+      return a.m_centerFrequency < b.m_centerFrequency;
+    }
+  if (a.m_channelWidth != b.m_channelWidth)
+    {
+      return a.m_channelWidth < b.m_channelWidth;
+    }
+  return a.m_standard < b.m_standard;
+}
+
+/// Transmit power spectral densities normalized to 1 W
+static std::map<WifiTxPsdTemplateId, Ptr<const SpectrumValue> > g_wifiTxPsdTemplateMap;
+
 TypeId
 SpectrumWifiPhy::GetTypeId (void)
 {
@@ -65,6 +112,7 @@ SpectrumWifiPhy::GetTypeId (void)
 }
 
 SpectrumWifiPhy::SpectrumWifiPhy ()
+  : m_txPsdPowerW (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -80,6 +128,8 @@ SpectrumWifiPhy::DoDispose (void)
   NS_LOG_FUNCTION (this);
   m_channel = 0;
   m_wifiSpectrumPhyInterface = 0;
+  m_txPsd = 0;
+  m_txPsdNormalized = 0;
 }
 
 void
@@ -648,28 +698,49 @@ Ptr<SpectrumValue>
 SpectrumWifiPhy::GetTxPowerSpectralDensity (uint32_t centerFrequency, uint32_t channelWidth, double txPowerW) const
 {
   NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW);
-  Ptr<SpectrumValue> v;
-  switch (GetStandard ())
-    {
-    case WIFI_PHY_STANDARD_80211a:
-    case WIFI_PHY_STANDARD_80211g:
-    case WIFI_PHY_STANDARD_holland:
-    case WIFI_PHY_STANDARD_80211_10MHZ:
-    case WIFI_PHY_STANDARD_80211_5MHZ:
-      v = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW);
-      break;
-    case WIFI_PHY_STANDARD_80211b:
-      v = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (centerFrequency, txPowerW);
-      break;
-    case WIFI_PHY_STANDARD_80211n_2_4GHZ:
-    case WIFI_PHY_STANDARD_80211n_5GHZ:
-    case WIFI_PHY_STANDARD_80211ac:
-      v = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW);
-      break;
-    default:
-      NS_FATAL_ERROR ("Standard unknown: " << GetStandard ());
-      break;
+  WifiTxPsdTemplateId key (centerFrequency, channelWidth, GetStandard ());
+  Ptr<const SpectrumValue> normalized;
+  std::map<WifiTxPsdTemplateId, Ptr<const SpectrumValue> >::const_iterator it = g_wifiTxPsdTemplateMap.find (key);
+  if (it != g_wifiTxPsdTemplateMap.end ())
+    {
+      normalized = it->second;
+    }
+  else
+    {
+      switch (GetStandard ())
+        {
+        case WIFI_PHY_STANDARD_80211a:
+        case WIFI_PHY_STANDARD_80211g:
+        case WIFI_PHY_STANDARD_holland:
+        case WIFI_PHY_STANDARD_80211_10MHZ:
+        case WIFI_PHY_STANDARD_80211_5MHZ:
+          normalized = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1.0);
+          break;
+        case WIFI_PHY_STANDARD_80211b:
+          normalized = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (centerFrequency, 1.0);
+          break;
+        case WIFI_PHY_STANDARD_80211n_2_4GHZ:
+        case WIFI_PHY_STANDARD_80211n_5GHZ:
+        case WIFI_PHY_STANDARD_80211ac:
+          normalized = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, 1.0);
+          break;
+        default:
+          NS_FATAL_ERROR ("Standard unknown: " << GetStandard ());
+          break;
+        }
+      g_wifiTxPsdTemplateMap.insert (std::make_pair (key, normalized));
+    }
+  if (m_txPsd != 0 && m_txPsdNormalized == normalized && m_txPsdPowerW == txPowerW)
+    {
+      NS_LOG_LOGIC ("reusing last Tx PSD");
+      return m_txPsd;
     }
+  // All the PSDs above spread the transmit power linearly over the bands
+  Ptr<SpectrumValue> v = Copy<SpectrumValue> (normalized);
+  *v *= txPowerW;
+  m_txPsd = v;
+  m_txPsdNormalized = normalized;
+  m_txPsdPowerW = txPowerW;
   return v;
 }
 
@@ -206,6 +206,13 @@ private:
    *
    * This is a helper function to create the right Tx PSD corresponding
    * to the standard in use.
+   *
+   * The PSD is obtained by scaling a template normalized to 1 W, which is
+   * built once per (center frequency, channel width, standard) and shared
+   * by all SpectrumWifiPhy instances. The last PSD returned is kept and
+   * returned again as long as the parameters do not change, hence the
+   * returned SpectrumValue must be treated as immutable (the spectrum
+   * channels only read it and copy it for each receiver).
    */
   Ptr<SpectrumValue> GetTxPowerSpectralDensity (uint32_t centerFrequency, uint32_t channelWidth, double txPowerW) const;
 
@@ -215,6 +222,9 @@ private:
   Ptr<WifiSpectrumPhyInterface> m_wifiSpectrumPhyInterface;
   Ptr<AntennaModel> m_antenna;
   mutable Ptr<const SpectrumModel> m_rxSpectrumModel;
+  mutable Ptr<SpectrumValue> m_txPsd;                 //!< last Tx PSD returned by GetTxPowerSpectralDensity
+  mutable Ptr<const SpectrumValue> m_txPsdNormalized; //!< normalized template m_txPsd was scaled from
+  mutable double m_txPsdPowerW;                       //!< transmit power (W) of m_txPsd
   RxCallback m_rxCallback;
   bool m_disableWifiReception;          //!< forces this Phy to fail to sync on any signal
   TracedCallback<bool, uint32_t, double, Time> m_signalCb;
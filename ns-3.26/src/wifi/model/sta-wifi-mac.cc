@@ -218,21 +218,12 @@ StaWifiMac::SendAssociationRequest (void)
   hdr.SetAddr3 (GetBssid ());
   hdr.SetDsNotFrom ();
   hdr.SetDsNotTo ();
-  Ptr<Packet> packet = Create<Packet> ();
-  MgtAssocRequestHeader assoc;
-  assoc.SetSsid (GetSsid ());
-  assoc.SetSupportedRates (GetSupportedRates ());
-  assoc.SetCapabilities (GetCapabilities ());
   if (m_htSupported || m_vhtSupported)
     {
-      assoc.SetHtCapabilities (GetHtCapabilities ());
       hdr.SetNoOrder ();
     }
-  if (m_vhtSupported)
-    {
-      assoc.SetVhtCapabilities (GetVhtCapabilities ());
-    }
-  packet->AddHeader (assoc);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (GetAssociationRequest ());
 
   //The standard is not clear on the correct queue for management
   //frames if we are a QoS AP. The approach taken here is to always
@@ -248,6 +239,43 @@ StaWifiMac::SendAssociationRequest (void)
                                              &StaWifiMac::AssocRequestTimeout, this);
 }
 
+MgtAssocRequestHeader
+StaWifiMac::GetAssociationRequest (void) const
+{
+  NS_LOG_FUNCTION (this);
+  MgtAssocRequestHeader assoc;
+  assoc.SetSsid (GetSsid ());
+  assoc.SetSupportedRates (GetSupportedRates ());
+  assoc.SetCapabilities (GetCapabilities ());
+  if (m_htSupported || m_vhtSupported)
+    {
+      assoc.SetHtCapabilities (GetHtCapabilities ());
+    }
+  if (m_vhtSupported)
+    {
+      assoc.SetVhtCapabilities (GetVhtCapabilities ());
+    }
+  return assoc;
+}
+
+void
+StaWifiMac::SetPreAssociated (Mac48Address bssid, MgtAssocResponseHeader assocResp)
+{
+  NS_LOG_FUNCTION (this << bssid);
+  NS_ASSERT (assocResp.GetStatusCode ().IsSuccess ());
+  m_probeRequestEvent.Cancel ();
+  m_assocRequestEvent.Cancel ();
+  m_beaconWatchdog.Cancel ();
+  SetBssid (bssid);
+  SetState (ASSOCIATED);
+  NS_LOG_DEBUG ("pre-associated with " << bssid);
+  UpdateApInfoFromAssocResp (assocResp, bssid);
+  if (!m_linkUp.IsNull ())
+    {
+      m_linkUp ();
+    }
+}
+
 void
 StaWifiMac::TryToEnsureAssociated (void)
 {
@@ -665,106 +693,7 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
             {
               SetState (ASSOCIATED);
               NS_LOG_DEBUG ("assoc completed");
-              CapabilityInformation capabilities = assocResp.GetCapabilities ();
-              SupportedRates rates = assocResp.GetSupportedRates ();
-              bool isShortPreambleEnabled = capabilities.IsShortPreamble ();
-              if (m_erpSupported)
-                {
-                  bool isErpAllowed = false;
-                  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
-                  {
-                    WifiMode mode = m_phy->GetMode (i);
-                    if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM && rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, 1)))
-                      {
-                        isErpAllowed = true;
-                        break;
-                      }
-                  }
-                  if (!isErpAllowed)
-                    {
-                      //disable short slot time and set cwMin to 31
-                      SetSlot (MicroSeconds (20));
-                      ConfigureContentionWindow (31, 1023);
-                    }
-                  else
-                    {
-                      ErpInformation erpInformation = assocResp.GetErpInformation ();
-                      isShortPreambleEnabled &= !erpInformation.GetBarkerPreambleMode ();
-                      if (m_stationManager->GetShortSlotTimeEnabled ())
-                        {
-                          //enable short slot time
-                          SetSlot (MicroSeconds (9));
-                        }
-                      else
-                        {
-                          //disable short slot time
-                          SetSlot (MicroSeconds (20));
-                        }
-                      ConfigureContentionWindow (15, 1023);
-                    }
-                }
-              m_stationManager->SetShortPreambleEnabled (isShortPreambleEnabled);
-              m_stationManager->SetShortSlotTimeEnabled (capabilities.IsShortSlotTime ());
-              if (m_qosSupported)
-                {
-                  EdcaParameterSet edcaParameters = assocResp.GetEdcaParameterSet ();
-                  //The value of the TXOP Limit field is specified as an unsigned integer, with the least significant octet transmitted first, in units of 32 μs.
-                  SetEdcaParameters (AC_BE, edcaParameters.GetBeCWmin(), edcaParameters.GetBeCWmax(), edcaParameters.GetBeAifsn(), 32 * MicroSeconds (edcaParameters.GetBeTXOPLimit()));
-                  SetEdcaParameters (AC_BK, edcaParameters.GetBkCWmin(), edcaParameters.GetBkCWmax(), edcaParameters.GetBkAifsn(), 32 * MicroSeconds (edcaParameters.GetBkTXOPLimit()));
-                  SetEdcaParameters (AC_VI, edcaParameters.GetViCWmin(), edcaParameters.GetViCWmax(), edcaParameters.GetViAifsn(), 32 * MicroSeconds (edcaParameters.GetViTXOPLimit()));
-                  SetEdcaParameters (AC_VO, edcaParameters.GetVoCWmin(), edcaParameters.GetVoCWmax(), edcaParameters.GetVoAifsn(), 32 * MicroSeconds (edcaParameters.GetVoTXOPLimit()));
-                }
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  HtOperations htOperations = assocResp.GetHtOperations ();
-                  m_stationManager->AddStationHtCapabilities (hdr->GetAddr2 (), htcapabilities);
-                }
-              if (m_vhtSupported)
-                {
-                  VhtCapabilities vhtcapabilities = assocResp.GetVhtCapabilities ();
-                  m_stationManager->AddStationVhtCapabilities (hdr->GetAddr2 (), vhtcapabilities);
-                }
-
-              for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
-                {
-                  WifiMode mode = m_phy->GetMode (i);
-                  uint8_t nss = 1; // Assume 1 spatial stream
-                  if (rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
-                    {
-                      m_stationManager->AddSupportedMode (hdr->GetAddr2 (), mode);
-                      if (rates.IsBasicRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
-                        {
-                          m_stationManager->AddBasicMode (mode);
-                        }
-                    }
-                }
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
-                    {
-                      WifiMode mcs = m_phy->GetMcs (i);
-                      if (mcs.GetModulationClass () == WIFI_MOD_CLASS_HT && htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
-                        {
-                          m_stationManager->AddSupportedMcs (hdr->GetAddr2 (), mcs);
-                          //here should add a control to add basic MCS when it is implemented
-                        }
-                    }
-                }
-              if (m_vhtSupported)
-                {
-                  VhtCapabilities vhtcapabilities = assocResp.GetVhtCapabilities ();
-                  for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
-                    {
-                      WifiMode mcs = m_phy->GetMcs (i);
-                      if (mcs.GetModulationClass () == WIFI_MOD_CLASS_VHT && vhtcapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
-                        {
-                          m_stationManager->AddSupportedMcs (hdr->GetAddr2 (), mcs);
-                          //here should add a control to add basic MCS when it is implemented
-                        }
-                    }
-                }
+              UpdateApInfoFromAssocResp (assocResp, hdr->GetAddr2 ());
               if (!m_linkUp.IsNull ())
                 {
                   m_linkUp ();
@@ -785,6 +714,112 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
   RegularWifiMac::Receive (packet, hdr);
 }
 
+void
+StaWifiMac::UpdateApInfoFromAssocResp (MgtAssocResponseHeader assocResp, Mac48Address apAddr)
+{
+  NS_LOG_FUNCTION (this << apAddr);
+  CapabilityInformation capabilities = assocResp.GetCapabilities ();
+  SupportedRates rates = assocResp.GetSupportedRates ();
+  bool isShortPreambleEnabled = capabilities.IsShortPreamble ();
+  if (m_erpSupported)
+    {
+      bool isErpAllowed = false;
+      for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+      {
+        WifiMode mode = m_phy->GetMode (i);
+        if (mode.GetModulationClass () == WIFI_MOD_CLASS_ERP_OFDM && rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, 1)))
+          {
+            isErpAllowed = true;
+            break;
+          }
+      }
+      if (!isErpAllowed)
+        {
+          //disable short slot time and set cwMin to 31
+          SetSlot (MicroSeconds (20));
+          ConfigureContentionWindow (31, 1023);
+        }
+      else
+        {
+          ErpInformation erpInformation = assocResp.GetErpInformation ();
+          isShortPreambleEnabled &= !erpInformation.GetBarkerPreambleMode ();
+          if (m_stationManager->GetShortSlotTimeEnabled ())
+            {
+              //enable short slot time
+              SetSlot (MicroSeconds (9));
+            }
+          else
+            {
+              //disable short slot time
+              SetSlot (MicroSeconds (20));
+            }
+          ConfigureContentionWindow (15, 1023);
+        }
+    }
+  m_stationManager->SetShortPreambleEnabled (isShortPreambleEnabled);
+  m_stationManager->SetShortSlotTimeEnabled (capabilities.IsShortSlotTime ());
+  if (m_qosSupported)
+    {
+      EdcaParameterSet edcaParameters = assocResp.GetEdcaParameterSet ();
+      //The value of the TXOP Limit field is specified as an unsigned integer, with the least significant octet transmitted first, in units of 32 μs.
+      SetEdcaParameters (AC_BE, edcaParameters.GetBeCWmin(), edcaParameters.GetBeCWmax(), edcaParameters.GetBeAifsn(), 32 * MicroSeconds (edcaParameters.GetBeTXOPLimit()));
+      SetEdcaParameters (AC_BK, edcaParameters.GetBkCWmin(), edcaParameters.GetBkCWmax(), edcaParameters.GetBkAifsn(), 32 * MicroSeconds (edcaParameters.GetBkTXOPLimit()));
+      SetEdcaParameters (AC_VI, edcaParameters.GetViCWmin(), edcaParameters.GetViCWmax(), edcaParameters.GetViAifsn(), 32 * MicroSeconds (edcaParameters.GetViTXOPLimit()));
+      SetEdcaParameters (AC_VO, edcaParameters.GetVoCWmin(), edcaParameters.GetVoCWmax(), edcaParameters.GetVoAifsn(), 32 * MicroSeconds (edcaParameters.GetVoTXOPLimit()));
+    }
+  if (m_htSupported)
+    {
+      HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
+      HtOperations htOperations = assocResp.GetHtOperations ();
+      m_stationManager->AddStationHtCapabilities (apAddr, htcapabilities);
+    }
+  if (m_vhtSupported)
+    {
+      VhtCapabilities vhtcapabilities = assocResp.GetVhtCapabilities ();
+      m_stationManager->AddStationVhtCapabilities (apAddr, vhtcapabilities);
+    }
+
+  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+    {
+      WifiMode mode = m_phy->GetMode (i);
+      uint8_t nss = 1; // Assume 1 spatial stream
+      if (rates.IsSupportedRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
+        {
+          m_stationManager->AddSupportedMode (apAddr, mode);
+          if (rates.IsBasicRate (mode.GetDataRate (m_phy->GetChannelWidth (), false, nss)))
+            {
+              m_stationManager->AddBasicMode (mode);
+            }
+        }
+    }
+  if (m_htSupported)
+    {
+      HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
+      for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
+        {
+          WifiMode mcs = m_phy->GetMcs (i);
+          if (mcs.GetModulationClass () == WIFI_MOD_CLASS_HT && htcapabilities.IsSupportedMcs (mcs.GetMcsValue ()))
+            {
+              m_stationManager->AddSupportedMcs (apAddr, mcs);
+              //here should add a control to add basic MCS when it is implemented
+            }
+        }
+    }
+  if (m_vhtSupported)
+    {
+      VhtCapabilities vhtcapabilities = assocResp.GetVhtCapabilities ();
+      for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
+        {
+          WifiMode mcs = m_phy->GetMcs (i);
+          if (mcs.GetModulationClass () == WIFI_MOD_CLASS_VHT && vhtcapabilities.IsSupportedTxMcs (mcs.GetMcsValue ()))
+            {
+              m_stationManager->AddSupportedMcs (apAddr, mcs);
+              //here should add a control to add basic MCS when it is implemented
+            }
+        }
+    }
+}
+
 SupportedRates
 StaWifiMac::GetSupportedRates (void) const
 {
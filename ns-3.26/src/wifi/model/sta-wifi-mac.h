@@ -33,6 +33,8 @@
 namespace ns3  {
 
 class MgtAddBaRequestHeader;
+class MgtAssocRequestHeader;
+class MgtAssocResponseHeader;
 
 /**
  * \ingroup wifi
@@ -82,6 +84,22 @@ public:
    */
   void StartActiveAssociation (void);
 
+  /**
+   * \return the association request this station sends to an AP
+   */
+  MgtAssocRequestHeader GetAssociationRequest (void) const;
+  /**
+   * \param bssid the address of the AP
+   * \param assocResp the association response of the AP
+   *
+   * Mark this station as associated with the given AP, configuring
+   * it as if the given association response had been received. No
+   * frame is exchanged and the beacon watchdog is not started, hence
+   * the station remains associated until the end of the simulation.
+   * This is used by ApWifiMac::PreAssociate.
+   */
+  void SetPreAssociated (Mac48Address bssid, MgtAssocResponseHeader assocResp);
+
 
 private:
   /**
@@ -165,6 +183,14 @@ private:
    * \return SupportedRates all rates that we support
    */
   SupportedRates GetSupportedRates (void) const;
+  /**
+   * Update the AP information and our configuration from the
+   * association response of the AP.
+   *
+   * \param assocResp the association response
+   * \param apAddr the address of the AP
+   */
+  void UpdateApInfoFromAssocResp (MgtAssocResponseHeader assocResp, Mac48Address apAddr);
   /**
    * Set the current MAC state.
    *
@@ -110,38 +110,69 @@ WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
         }
       else if (m_dropPolicy == DROP_OLDEST)
         {
-          m_queue.pop_front ();
-          m_size--;
+          DoErase (m_queue.begin ());
         }
     }
-  Time now = Simulator::Now ();
-  m_queue.push_back (Item (packet, hdr, now));
+  DoInsert (false, packet, hdr);
+}
+
+void
+WifiMacQueue::DoInsert (bool front, Ptr<const Packet> packet, const WifiMacHeader &hdr)
+{
+  PacketQueueI it;
+  if (front)
+    {
+      it = m_queue.insert (m_queue.begin (), Item (packet, hdr, Simulator::Now ()));
+    }
+  else
+    {
+      it = m_queue.insert (m_queue.end (), Item (packet, hdr, Simulator::Now ()));
+    }
   m_size++;
+  //Every packet is timestamped with the current time, hence appending
+  //to the expiry list keeps it sorted by arrival time.
+  it->expiryIt = m_expiry.insert (m_expiry.end (), it);
+  if (hdr.IsQosData ())
+    {
+      //Packets in a sub-queue keep the relative order they have in m_queue
+      PacketQueueIList &tidQueue = m_tidQueues[std::make_pair (hdr.GetAddr1 (), hdr.GetQosTid ())];
+      it->tidIt = tidQueue.insert (front ? tidQueue.begin () : tidQueue.end (), it);
+    }
 }
 
 void
-WifiMacQueue::Cleanup (void)
+WifiMacQueue::DoErase (PacketQueueI it)
 {
-  if (m_queue.empty ())
+  if (it->hdr.IsQosData ())
     {
-      return;
+      PacketQueueIList *tidQueue = FindTidQueue (it->hdr.GetQosTid (), it->hdr.GetAddr1 ());
+      NS_ASSERT (tidQueue != 0);
+      tidQueue->erase (it->tidIt);
     }
+  m_expiry.erase (it->expiryIt);
+  m_queue.erase (it);
+  m_size--;
+}
 
+WifiMacQueue::PacketQueueIList *
+WifiMacQueue::FindTidQueue (uint8_t tid, Mac48Address addr)
+{
+  TidQueuesI it = m_tidQueues.find (std::make_pair (addr, tid));
+  if (it == m_tidQueues.end ())
+    {
+      return 0;
+    }
+  return &it->second;
+}
+
+void
+WifiMacQueue::Cleanup (void)
+{
   Time now = Simulator::Now ();
-  uint32_t n = 0;
-  for (PacketQueueI i = m_queue.begin (); i != m_queue.end (); )
+  while (!m_expiry.empty () && m_expiry.front ()->tstamp + m_maxDelay <= now)
     {
-      if (i->tstamp + m_maxDelay > now)
-        {
-          i++;
-        }
-      else
-        {
-          i = m_queue.erase (i);
-          n++;
-        }
+      DoErase (m_expiry.front ());
     }
-  m_size -= n;
 }
 
 Ptr<const Packet>
@@ -151,8 +182,7 @@ WifiMacQueue::Dequeue (WifiMacHeader *hdr)
   if (!m_queue.empty ())
     {
       Item i = m_queue.front ();
-      m_queue.pop_front ();
-      m_size--;
+      DoErase (m_queue.begin ());
       *hdr = i.hdr;
       return i.packet;
     }
@@ -178,6 +208,18 @@ WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
 {
   Cleanup ();
   Ptr<const Packet> packet = 0;
+  if (type == WifiMacHeader::ADDR1)
+    {
+      PacketQueueIList *tidQueue = FindTidQueue (tid, dest);
+      if (tidQueue != 0 && !tidQueue->empty ())
+        {
+          PacketQueueI it = tidQueue->front ();
+          packet = it->packet;
+          *hdr = it->hdr;
+          DoErase (it);
+        }
+      return packet;
+    }
   if (!m_queue.empty ())
     {
       PacketQueueI it;
@@ -190,8 +232,7 @@ WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                 {
                   packet = it->packet;
                   *hdr = it->hdr;
-                  m_queue.erase (it);
-                  m_size--;
+                  DoErase (it);
                   break;
                 }
             }
@@ -205,6 +246,18 @@ WifiMacQueue::PeekByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                                    WifiMacHeader::AddressType type, Mac48Address dest, Time *timestamp)
 {
   Cleanup ();
+  if (type == WifiMacHeader::ADDR1)
+    {
+      PacketQueueIList *tidQueue = FindTidQueue (tid, dest);
+      if (tidQueue != 0 && !tidQueue->empty ())
+        {
+          PacketQueueI it = tidQueue->front ();
+          *hdr = it->hdr;
+          *timestamp = it->tstamp;
+          return it->packet;
+        }
+      return 0;
+    }
   if (!m_queue.empty ())
     {
       PacketQueueI it;
@@ -243,6 +296,8 @@ void
 WifiMacQueue::Flush (void)
 {
   m_queue.erase (m_queue.begin (), m_queue.end ());
+  m_tidQueues.clear ();
+  m_expiry.clear ();
   m_size = 0;
 }
 
@@ -272,8 +327,7 @@ WifiMacQueue::Remove (Ptr<const Packet> packet)
     {
       if (it->packet == packet)
         {
-          m_queue.erase (it);
-          m_size--;
+          DoErase (it);
           return true;
         }
     }
@@ -288,9 +342,7 @@ WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     {
       return;
     }
-  Time now = Simulator::Now ();
-  m_queue.push_front (Item (packet, hdr, now));
-  m_size++;
+  DoInsert (true, packet, hdr);
 }
 
 uint32_t
@@ -298,6 +350,11 @@ WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, WifiMacHeader::AddressTyp
                                           Mac48Address addr)
 {
   Cleanup ();
+  if (type == WifiMacHeader::ADDR1)
+    {
+      PacketQueueIList *tidQueue = FindTidQueue (tid, addr);
+      return (tidQueue != 0) ? tidQueue->size () : 0;
+    }
   uint32_t nPackets = 0;
   if (!m_queue.empty ())
     {
@@ -330,8 +387,7 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
           *hdr = it->hdr;
           timestamp = it->tstamp;
           packet = it->packet;
-          m_queue.erase (it);
-          m_size--;
+          DoErase (it);
           return packet;
         }
     }
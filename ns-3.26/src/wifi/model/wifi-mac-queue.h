@@ -24,6 +24,7 @@
 #define WIFI_MAC_QUEUE_H
 
 #include <list>
+#include <map>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
@@ -47,6 +48,14 @@ class QosBlockedDestinations;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * In addition to the global FIFO, QoS data packets are indexed in
+ * per-(receiver address, TID) sub-queues, so that the lookups performed
+ * by A-MSDU/A-MPDU aggregation and block ack handling (which always
+ * search by Address 1) do not scan the whole queue. Since every packet
+ * is timestamped upon insertion, packets are also kept in an expiry
+ * list sorted by arrival time: expired packets are always found at its
+ * head and lifetime checks do not need to visit live packets.
  */
 class WifiMacQueue : public Object
 {
@@ -121,7 +130,8 @@ public:
    * address indicated by <i>type</i> equals to <i>addr</i>, and tid
    * equals to <i>tid</i>. This method removes the packet from this queue.
    * Is typically used by ns3::EdcaTxopN in order to perform correct MSDU
-   * aggregation (A-MSDU).
+   * aggregation (A-MSDU). Lookups by WifiMacHeader::ADDR1 are served by
+   * the per-(receiver, TID) sub-queues and do not scan the queue.
    *
    * \param hdr the header of the dequeued packet
    * \param tid the given TID
@@ -139,7 +149,8 @@ public:
    * address indicated by <i>type</i> equals to <i>addr</i>, and tid
    * equals to <i>tid</i>. This method doesn't remove the packet from this queue.
    * Is typically used by ns3::EdcaTxopN in order to perform correct MSDU
-   * aggregation (A-MSDU).
+   * aggregation (A-MSDU). Lookups by WifiMacHeader::ADDR1 are served by
+   * the per-(receiver, TID) sub-queues and do not scan the queue.
    *
    * \param hdr the header of the dequeued packet
    * \param tid the given TID
@@ -166,7 +177,9 @@ public:
   bool Remove (Ptr<const Packet> packet);
   /**
    * Returns number of QoS packets having tid equals to <i>tid</i> and address
-   * specified by <i>type</i> equals to <i>addr</i>.
+   * specified by <i>type</i> equals to <i>addr</i>. Counts by
+   * WifiMacHeader::ADDR1 are given by the size of the corresponding
+   * sub-queue and do not scan the queue.
    *
    * \param tid the given TID
    * \param type the given address type
@@ -230,6 +243,38 @@ protected:
    */
   virtual void Cleanup (void);
 
+  struct Item;
+
+  /**
+   * typedef for packet (struct Item) queue.
+   */
+  typedef std::list<struct Item> PacketQueue;
+  /**
+   * typedef for packet (struct Item) queue reverse iterator.
+   */
+  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  /**
+   * typedef for packet (struct Item) queue iterator.
+   */
+  typedef std::list<struct Item>::iterator PacketQueueI;
+  /**
+   * typedef for a list of positions in the packet queue, used to build
+   * the per-(receiver, TID) sub-queues and the expiry list.
+   */
+  typedef std::list<PacketQueueI> PacketQueueIList;
+  /**
+   * typedef for the key (receiver address, TID) of a sub-queue.
+   */
+  typedef std::pair<Mac48Address, uint8_t> TidQueueKey;
+  /**
+   * typedef for the map of per-(receiver, TID) sub-queues.
+   */
+  typedef std::map<TidQueueKey, PacketQueueIList> TidQueues;
+  /**
+   * typedef for per-(receiver, TID) sub-queue iterator.
+   */
+  typedef std::map<TidQueueKey, PacketQueueIList>::iterator TidQueuesI;
+
   /**
    * A struct that holds information about a packet for putting
    * in a packet queue.
@@ -249,31 +294,48 @@ protected:
     Ptr<const Packet> packet; //!< Actual packet
     WifiMacHeader hdr;        //!< Wifi MAC header associated with the packet
     Time tstamp;              //!< timestamp when the packet arrived at the queue
+    PacketQueueIList::iterator tidIt;    //!< position in the per-(receiver, TID) sub-queue (QoS data only)
+    PacketQueueIList::iterator expiryIt; //!< position in the expiry list
   };
 
   /**
-   * typedef for packet (struct Item) queue.
+   * Return the appropriate address for the given packet (given by PacketQueue iterator).
+   *
+   * \param type
+   * \param it
+   *
+   * \return the address
    */
-  typedef std::list<struct Item> PacketQueue;
+  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
   /**
-   * typedef for packet (struct Item) queue reverse iterator.
+   * Insert a packet in the queue and in the indexes.
+   *
+   * \param front true to insert at the front of the queue, false to insert at the end
+   * \param packet the packet to be inserted
+   * \param hdr the header of the given packet
    */
-  typedef std::list<struct Item>::reverse_iterator PacketQueueRI;
+  void DoInsert (bool front, Ptr<const Packet> packet, const WifiMacHeader &hdr);
   /**
-   * typedef for packet (struct Item) queue iterator.
+   * Remove the packet pointed to by the given iterator from the queue
+   * and from the indexes.
+   *
+   * \param it the position of the packet in the queue
    */
-  typedef std::list<struct Item>::iterator PacketQueueI;
+  void DoErase (PacketQueueI it);
   /**
-   * Return the appropriate address for the given packet (given by PacketQueue iterator).
+   * Return the sub-queue of QoS data packets addressed to the given
+   * receiver with the given TID, if any.
    *
-   * \param type
-   * \param it
+   * \param tid the given TID
+   * \param addr the given receiver
    *
-   * \return the address
+   * \return the sub-queue, or 0 if no packet was ever queued for the given pair
    */
-  Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
+  PacketQueueIList * FindTidQueue (uint8_t tid, Mac48Address addr);
 
   PacketQueue m_queue; //!< Packet (struct Item) queue
+  TidQueues m_tidQueues;     //!< Per-(receiver, TID) sub-queues of QoS data packets
+  PacketQueueIList m_expiry; //!< Packets sorted by arrival time
   uint32_t m_size;     //!< Current queue size
   uint32_t m_maxSize;  //!< Queue capacity
   Time m_maxDelay;     //!< Time to live for packets in the queue
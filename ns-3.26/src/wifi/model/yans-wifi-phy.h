@@ -69,12 +69,12 @@ public:
    * \param mpdutype the type of the MPDU as defined in WifiPhy::mpduType.
    * \param rxDuration the duration needed for the reception of the packet
    */
-  void StartReceivePreambleAndHeader (Ptr<Packet> packet,
-                                      double rxPowerDbm,
-                                      WifiTxVector txVector,
-                                      WifiPreamble preamble,
-                                      enum mpduType mpdutype,
-                                      Time rxDuration);
+  virtual void StartReceivePreambleAndHeader (Ptr<Packet> packet,
+                                              double rxPowerDbm,
+                                              WifiTxVector txVector,
+                                              WifiPreamble preamble,
+                                              enum mpduType mpdutype,
+                                              Time rxDuration);
   /**
    * Starting receiving the payload of a packet (i.e. the first bit of the packet has arrived).
    *
@@ -0,0 +1,359 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/abstracted-wifi-phy.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy-standard.h"
+
+using namespace ns3;
+
+static const uint16_t CHANNEL_NUMBER = 36;
+static const uint32_t FREQUENCY = 5180; // MHz
+
+/**
+ * Base class of the tests injecting the same signals in a YansWifiPhy and
+ * in an AbstractedWifiPhy, and comparing how both PHYs react to them.
+ */
+class AbstractedWifiPhyTestBase : public TestCase
+{
+public:
+  /**
+   * \param name the name of the test case
+   */
+  AbstractedWifiPhyTestBase (std::string name);
+  virtual ~AbstractedWifiPhyTestBase ();
+
+protected:
+  /// Create and configure both PHYs
+  void CreatePhys (void);
+  /// Dispose of both PHYs and of the simulator
+  void DisposePhys (void);
+  /**
+   * \param size the size of the packet in bytes
+   * \return the duration of a signal carrying the packet
+   */
+  Time GetDuration (uint32_t size) const;
+  /**
+   * Inject a signal in both PHYs
+   * \param rxPowerDbm the receive power in dBm
+   * \param size the size of the packet carried by the signal, in bytes
+   */
+  void SendSignal (double rxPowerDbm, uint32_t size);
+
+  Ptr<YansWifiPhy> m_yans;              //!< detailed PHY
+  Ptr<AbstractedWifiPhy> m_abstracted;  //!< abstracted PHY
+
+private:
+  /**
+   * Configure a PHY
+   * \param phy the PHY
+   */
+  void ConfigurePhy (Ptr<YansWifiPhy> phy);
+};
+
+AbstractedWifiPhyTestBase::AbstractedWifiPhyTestBase (std::string name)
+  : TestCase (name)
+{
+}
+
+AbstractedWifiPhyTestBase::~AbstractedWifiPhyTestBase ()
+{
+}
+
+void
+AbstractedWifiPhyTestBase::ConfigurePhy (Ptr<YansWifiPhy> phy)
+{
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->SetChannelNumber (CHANNEL_NUMBER);
+  phy->SetFrequency (FREQUENCY);
+}
+
+void
+AbstractedWifiPhyTestBase::CreatePhys (void)
+{
+  m_yans = CreateObject<YansWifiPhy> ();
+  ConfigurePhy (m_yans);
+  m_abstracted = CreateObject<AbstractedWifiPhy> ();
+  ConfigurePhy (m_abstracted);
+}
+
+void
+AbstractedWifiPhyTestBase::DisposePhys (void)
+{
+  m_yans->Dispose ();
+  m_abstracted->Dispose ();
+  Simulator::Destroy ();
+}
+
+Time
+AbstractedWifiPhyTestBase::GetDuration (uint32_t size) const
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetOfdmRate6Mbps (), 0, 0, false, 1, 0, 20, false, false);
+  return m_yans->CalculateTxDuration (size, txVector, WIFI_PREAMBLE_LONG, FREQUENCY, NORMAL_MPDU, 0);
+}
+
+void
+AbstractedWifiPhyTestBase::SendSignal (double rxPowerDbm, uint32_t size)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetOfdmRate6Mbps (), 0, 0, false, 1, 0, 20, false, false);
+  Ptr<Packet> pkt = Create<Packet> (size);
+  Time txDuration = GetDuration (size);
+  m_yans->StartReceivePreambleAndHeader (pkt->Copy (), rxPowerDbm, txVector, WIFI_PREAMBLE_LONG, NORMAL_MPDU, txDuration);
+  m_abstracted->StartReceivePreambleAndHeader (pkt->Copy (), rxPowerDbm, txVector, WIFI_PREAMBLE_LONG, NORMAL_MPDU, txDuration);
+}
+
+/**
+ * Check that both PHYs report the same SNR to the MAC. The SNR reported
+ * by YansWifiPhy is the one at the start of the frame, so an interferer
+ * starting with the frame does not change it, whereas an interferer
+ * already on the medium does.
+ */
+class AbstractedWifiPhySnrTest : public AbstractedWifiPhyTestBase
+{
+public:
+  AbstractedWifiPhySnrTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Receive callback of the detailed PHY
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the TXVECTOR
+   * \param preamble the preamble
+   */
+  void YansReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  /**
+   * Receive callback of the abstracted PHY
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the TXVECTOR
+   * \param preamble the preamble
+   */
+  void AbstractedReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+
+  std::vector<double> m_yansSnr;        //!< SNR reported by the detailed PHY
+  std::vector<double> m_abstractedSnr;  //!< SNR reported by the abstracted PHY
+};
+
+AbstractedWifiPhySnrTest::AbstractedWifiPhySnrTest ()
+  : AbstractedWifiPhyTestBase ("AbstractedWifiPhy reports the same SNR as YansWifiPhy")
+{
+}
+
+void
+AbstractedWifiPhySnrTest::YansReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_yansSnr.push_back (snr);
+}
+
+void
+AbstractedWifiPhySnrTest::AbstractedReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_abstractedSnr.push_back (snr);
+}
+
+void
+AbstractedWifiPhySnrTest::DoRun (void)
+{
+  CreatePhys ();
+  m_yans->SetReceiveOkCallback (MakeCallback (&AbstractedWifiPhySnrTest::YansReceiveOk, this));
+  m_abstracted->SetReceiveOkCallback (MakeCallback (&AbstractedWifiPhySnrTest::AbstractedReceiveOk, this));
+
+  // A frame without interference
+  Simulator::Schedule (Seconds (1), &AbstractedWifiPhySnrTest::SendSignal, this, -70, 1000);
+  // A frame overlapped by an interferer starting at the same instant
+  Simulator::Schedule (Seconds (2), &AbstractedWifiPhySnrTest::SendSignal, this, -60, 1000);
+  Simulator::Schedule (Seconds (2), &AbstractedWifiPhySnrTest::SendSignal, this, -80, 1000);
+  // A frame overlapped by an interferer already on the medium, below the
+  // energy detection threshold so that neither PHY syncs to it
+  Simulator::Schedule (Seconds (3), &AbstractedWifiPhySnrTest::SendSignal, this, -98, 1000);
+  Simulator::Schedule (Seconds (3), &AbstractedWifiPhySnrTest::SendSignal, this, -70, 1000);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_yansSnr.size (), 3, "YansWifiPhy didn't receive the right number of packets");
+  NS_TEST_ASSERT_MSG_EQ (m_abstractedSnr.size (), 3, "AbstractedWifiPhy didn't receive the right number of packets");
+  for (uint32_t i = 0; i < m_yansSnr.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (m_abstractedSnr[i], m_yansSnr[i], m_yansSnr[i] * 1e-6, "SNR mismatch for packet " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_yansSnr[1], m_yansSnr[0] * 10, m_yansSnr[0] * 1e-5, "The SNR at the start of the frame accounts for the interferer");
+  NS_TEST_EXPECT_MSG_GT (m_yansSnr[0], m_yansSnr[2], "Interference was not accounted for");
+
+  DisposePhys ();
+}
+
+/**
+ * Check that both PHYs receive or lose the same frames when an interferer
+ * starts in the middle of the payload.
+ */
+class AbstractedWifiPhyPartialOverlapTest : public AbstractedWifiPhyTestBase
+{
+public:
+  AbstractedWifiPhyPartialOverlapTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Inject a frame and an interferer starting in the middle of its payload
+   * \param interfererDbm the receive power of the interferer in dBm
+   */
+  void SendOverlappedFrame (double interfererDbm);
+  /**
+   * Receive callback of the detailed PHY
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the TXVECTOR
+   * \param preamble the preamble
+   */
+  void YansReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  /**
+   * Receive callback of the abstracted PHY
+   * \param p the packet
+   * \param snr the SNR
+   * \param txVector the TXVECTOR
+   * \param preamble the preamble
+   */
+  void AbstractedReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+
+  std::vector<Time> m_yansRx;        //!< times of the frames received by the detailed PHY
+  std::vector<Time> m_abstractedRx;  //!< times of the frames received by the abstracted PHY
+};
+
+AbstractedWifiPhyPartialOverlapTest::AbstractedWifiPhyPartialOverlapTest ()
+  : AbstractedWifiPhyTestBase ("AbstractedWifiPhy receives the same partially overlapped frames as YansWifiPhy")
+{
+}
+
+void
+AbstractedWifiPhyPartialOverlapTest::SendOverlappedFrame (double interfererDbm)
+{
+  SendSignal (-70, 1000);
+  Simulator::Schedule (GetDuration (1000) / 2, &AbstractedWifiPhyPartialOverlapTest::SendSignal, this, interfererDbm, 1000);
+}
+
+void
+AbstractedWifiPhyPartialOverlapTest::YansReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_yansRx.push_back (Simulator::Now ());
+}
+
+void
+AbstractedWifiPhyPartialOverlapTest::AbstractedReceiveOk (Ptr<Packet> p, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_abstractedRx.push_back (Simulator::Now ());
+}
+
+void
+AbstractedWifiPhyPartialOverlapTest::DoRun (void)
+{
+  CreatePhys ();
+  m_yans->SetReceiveOkCallback (MakeCallback (&AbstractedWifiPhyPartialOverlapTest::YansReceiveOk, this));
+  m_abstracted->SetReceiveOkCallback (MakeCallback (&AbstractedWifiPhyPartialOverlapTest::AbstractedReceiveOk, this));
+
+  // A weak interferer over the second half of the frame: received
+  Simulator::Schedule (Seconds (1), &AbstractedWifiPhyPartialOverlapTest::SendOverlappedFrame, this, -90);
+  // A stronger interferer over the second half of the frame: lost
+  Simulator::Schedule (Seconds (2), &AbstractedWifiPhyPartialOverlapTest::SendOverlappedFrame, this, -65);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_yansRx.size (), 1, "YansWifiPhy didn't receive the right number of packets");
+  NS_TEST_ASSERT_MSG_EQ (m_abstractedRx.size (), 1, "AbstractedWifiPhy didn't receive the right number of packets");
+  NS_TEST_EXPECT_MSG_EQ (m_abstractedRx[0], m_yansRx[0], "The PHYs did not receive the same frame");
+
+  DisposePhys ();
+}
+
+/**
+ * Check that both PHYs report the medium CCA busy for the same time,
+ * with signals below the energy detection threshold.
+ */
+class AbstractedWifiPhyCcaTest : public AbstractedWifiPhyTestBase
+{
+public:
+  AbstractedWifiPhyCcaTest ();
+
+private:
+  virtual void DoRun (void);
+  /// Record the CCA state of both PHYs
+  void CheckCca (void);
+
+  std::vector<Time> m_yansCca;        //!< delays until idle of the detailed PHY
+  std::vector<Time> m_abstractedCca;  //!< delays until idle of the abstracted PHY
+};
+
+AbstractedWifiPhyCcaTest::AbstractedWifiPhyCcaTest ()
+  : AbstractedWifiPhyTestBase ("AbstractedWifiPhy reports the same CCA busy durations as YansWifiPhy")
+{
+}
+
+void
+AbstractedWifiPhyCcaTest::CheckCca (void)
+{
+  m_yansCca.push_back (m_yans->IsStateCcaBusy () ? m_yans->GetDelayUntilIdle () : Seconds (0));
+  m_abstractedCca.push_back (m_abstracted->IsStateCcaBusy () ? m_abstracted->GetDelayUntilIdle () : Seconds (0));
+}
+
+void
+AbstractedWifiPhyCcaTest::DoRun (void)
+{
+  CreatePhys ();
+
+  // A signal below the CCA threshold, including the 1 dB of RX gain: idle
+  Simulator::Schedule (Seconds (1), &AbstractedWifiPhyCcaTest::SendSignal, this, -101, 1000);
+  Simulator::Schedule (Seconds (1), &AbstractedWifiPhyCcaTest::CheckCca, this);
+  // A signal above the CCA threshold: busy until its end
+  Simulator::Schedule (Seconds (2), &AbstractedWifiPhyCcaTest::SendSignal, this, -98, 1000);
+  Simulator::Schedule (Seconds (2), &AbstractedWifiPhyCcaTest::CheckCca, this);
+  // A short signal above the CCA threshold over a long one below it:
+  // busy until the end of the short one
+  Simulator::Schedule (Seconds (3), &AbstractedWifiPhyCcaTest::SendSignal, this, -105, 2000);
+  Simulator::Schedule (Seconds (3) + MicroSeconds (10), &AbstractedWifiPhyCcaTest::SendSignal, this, -98, 100);
+  Simulator::Schedule (Seconds (3) + MicroSeconds (10), &AbstractedWifiPhyCcaTest::CheckCca, this);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_yansCca.size (), 3, "Wrong number of CCA checks");
+  NS_TEST_EXPECT_MSG_EQ (m_yansCca[0], Seconds (0), "YansWifiPhy is CCA busy below the CCA threshold");
+  NS_TEST_EXPECT_MSG_EQ (m_yansCca[1], GetDuration (1000), "YansWifiPhy is not CCA busy until the end of the signal");
+  NS_TEST_EXPECT_MSG_EQ (m_yansCca[2], GetDuration (100), "YansWifiPhy is not CCA busy until the end of the strong signal");
+  for (uint32_t i = 0; i < m_yansCca.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_abstractedCca[i], m_yansCca[i], "CCA busy duration mismatch for check " << i);
+    }
+
+  DisposePhys ();
+}
+
+class AbstractedWifiPhyTestSuite : public TestSuite
+{
+public:
+  AbstractedWifiPhyTestSuite ();
+};
+
+AbstractedWifiPhyTestSuite::AbstractedWifiPhyTestSuite ()
+  : TestSuite ("wifi-abstracted-phy", UNIT)
+{
+  AddTestCase (new AbstractedWifiPhySnrTest, TestCase::QUICK);
+  AddTestCase (new AbstractedWifiPhyPartialOverlapTest, TestCase::QUICK);
+  AddTestCase (new AbstractedWifiPhyCcaTest, TestCase::QUICK);
+}
+
+static AbstractedWifiPhyTestSuite abstractedWifiPhyTestSuite;
@@ -100,6 +100,7 @@ private:
   void AddCcaBusyEvt (uint64_t at, uint64_t duration);
   void AddSwitchingEvt (uint64_t at, uint64_t duration);
   void AddRxStartEvt (uint64_t at, uint64_t duration);
+  void AddReservation (uint64_t start, uint64_t interval, uint64_t duration);
 
   typedef std::vector<DcfStateTest *> DcfStates;
 
@@ -393,6 +394,13 @@ DcfManagerTest::AddRxStartEvt (uint64_t at, uint64_t duration)
                        MicroSeconds (duration));
 }
 
+void
+DcfManagerTest::AddReservation (uint64_t start, uint64_t interval, uint64_t duration)
+{
+  m_dcfManager->AddPeriodicReservation (MicroSeconds (start), MicroSeconds (interval),
+                                        MicroSeconds (duration));
+}
+
 void
 DcfManagerTest::DoRun (void)
 {
@@ -728,6 +736,39 @@ DcfManagerTest::DoRun (void)
   AddAccessRequest (101, 2, 110, 0);
   ExpectCollision (101, 0, 0); //backoff: 0 slots
   EndTest ();
+
+  // Test that periodic reservations of the medium defer access like
+  // a received frame.
+  //  20          60     66      70       74       78       82       86  88
+  //   | reserved  | sifs | aifsn | bslot0 | bslot1 | bslot2 | bslot3 | tx |
+  //        |
+  //       30 request access. backoff slots: 4
+  //
+  //  120         160    166     170  172
+  //   | reserved  | sifs | aifsn | tx |
+  //        |
+  //       130 request access. backoff slots: 0
+  StartTest (4, 6, 10);
+  AddDcfState (1);
+  AddReservation (20, 100, 40);
+  AddAccessRequest (30, 2, 86, 0);
+  ExpectCollision (30, 4, 0); //backoff: 4 slots
+  AddAccessRequest (130, 2, 170, 0);
+  ExpectCollision (130, 0, 0); //backoff: 0 slots
+  EndTest ();
+  // Test that the backoff slots which elapsed before a reservation
+  // are accounted for although no other event occurs in between.
+  //  20          60     66      70       74       78         100    106     110      114      118  120
+  //   |    rx     | sifs | aifsn | bslot0 | bslot1 | reserved  | sifs | aifsn | bslot2 | bslot3 | tx |
+  //        |
+  //       30 request access. backoff slots: 4
+  StartTest (4, 6, 10);
+  AddDcfState (1);
+  AddReservation (78, 1000, 22);
+  AddRxOkEvt (20, 40);
+  AddAccessRequest (30, 2, 118, 0);
+  ExpectCollision (30, 4, 0); //backoff: 4 slots
+  EndTest ();
 }
 
 
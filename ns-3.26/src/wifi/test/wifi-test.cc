@@ -39,6 +39,10 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/sta-wifi-mac.h"
+#include "ns3/simulator.h"
 
 using namespace ns3;
 
@@ -1090,6 +1094,284 @@ Bug2222TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_countInternalCollisions, 1, "unexpected number of internal collisions!");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the per-(receiver, TID) lookups and the lifetime handling
+ * of WifiMacQueue return the same packets as a scan of the whole queue.
+ */
+class WifiMacQueueIndexTest : public TestCase
+{
+public:
+  WifiMacQueueIndexTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Enqueue a QoS data packet
+   * \param queue the queue
+   * \param addr the receiver address
+   * \param tid the TID
+   * \param size the packet size
+   * \param front whether to push the packet at the front of the queue
+   */
+  void EnqueueQos (Ptr<WifiMacQueue> queue, Mac48Address addr, uint8_t tid, uint32_t size, bool front);
+  /**
+   * Check the queue content once the first packets have expired
+   * \param queue the queue
+   */
+  void CheckExpired (Ptr<WifiMacQueue> queue);
+};
+
+WifiMacQueueIndexTest::WifiMacQueueIndexTest ()
+  : TestCase ("Test case for the per-(receiver, TID) indexes of WifiMacQueue")
+{
+}
+
+void
+WifiMacQueueIndexTest::EnqueueQos (Ptr<WifiMacQueue> queue, Mac48Address addr, uint8_t tid, uint32_t size, bool front)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetAddr1 (addr);
+  hdr.SetQosTid (tid);
+  if (front)
+    {
+      queue->PushFront (Create<Packet> (size), hdr);
+    }
+  else
+    {
+      queue->Enqueue (Create<Packet> (size), hdr);
+    }
+}
+
+void
+WifiMacQueueIndexTest::CheckExpired (Ptr<WifiMacQueue> queue)
+{
+  Mac48Address a = Mac48Address ("00:00:00:00:00:01");
+  WifiMacHeader hdr;
+  Time tstamp;
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 1, "Only the packet enqueued last should survive");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, a), 0, "Expired packets are still counted");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (5, WifiMacHeader::ADDR1, a), 1, "Live packet is not counted");
+  Ptr<const Packet> p = queue->PeekByTidAndAddress (&hdr, 5, WifiMacHeader::ADDR1, a, &tstamp);
+  NS_TEST_ASSERT_MSG_NE (p, 0, "Live packet not found");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 500, "Wrong live packet");
+  NS_TEST_EXPECT_MSG_EQ (tstamp, MilliSeconds (5), "Wrong timestamp");
+}
+
+void
+WifiMacQueueIndexTest::DoRun (void)
+{
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  queue->SetMaxDelay (MilliSeconds (10));
+  Mac48Address a = Mac48Address ("00:00:00:00:00:01");
+  Mac48Address b = Mac48Address ("00:00:00:00:00:02");
+
+  EnqueueQos (queue, a, 0, 100, false);
+  EnqueueQos (queue, b, 0, 200, false);
+  EnqueueQos (queue, a, 0, 300, false);
+  EnqueueQos (queue, a, 5, 400, false);
+  EnqueueQos (queue, a, 0, 50, true);
+
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 5, "Wrong queue size");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, a), 3, "Wrong number of packets for (a, 0)");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, b), 1, "Wrong number of packets for (b, 0)");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (5, WifiMacHeader::ADDR1, b), 0, "Wrong number of packets for (b, 5)");
+
+  WifiMacHeader hdr;
+  Time tstamp;
+  Ptr<const Packet> p = queue->PeekByTidAndAddress (&hdr, 0, WifiMacHeader::ADDR1, a, &tstamp);
+  NS_TEST_ASSERT_MSG_NE (p, 0, "Packet for (a, 0) not found");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 50, "Packet pushed at the front should be found first");
+  NS_TEST_EXPECT_MSG_EQ (queue->Remove (p), true, "Packet not removed");
+  p = queue->DequeueByTidAndAddress (&hdr, 0, WifiMacHeader::ADDR1, a);
+  NS_TEST_ASSERT_MSG_NE (p, 0, "Packet for (a, 0) not found");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 100, "Wrong packet dequeued for (a, 0)");
+  p = queue->Dequeue (&hdr);
+  NS_TEST_ASSERT_MSG_NE (p, 0, "Queue should not be empty");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 200, "Wrong packet at the head of the queue");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 2, "Wrong queue size");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, a), 1, "Wrong number of packets for (a, 0)");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetNPacketsByTidAndAddress (0, WifiMacHeader::ADDR1, b), 0, "Wrong number of packets for (b, 0)");
+
+  Simulator::Schedule (MilliSeconds (5), &WifiMacQueueIndexTest::EnqueueQos, this, queue, a, 5, 500, true);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueIndexTest::CheckExpired, this, queue);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a station pre-associated with an AP which suppresses its
+ * beacons can exchange data with the AP without any management frame.
+ */
+class BeaconSuppressionTestCase : public TestCase
+{
+public:
+  BeaconSuppressionTestCase ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Notify a transmission by the PHY of the AP
+   * \param p the packet
+   */
+  void NotifyApPhyTxBegin (Ptr<const Packet> p);
+  /**
+   * Notify a transmission by the PHY of the STA
+   * \param p the packet
+   */
+  void NotifyStaPhyTxBegin (Ptr<const Packet> p);
+  /**
+   * Notify the association of the STA
+   * \param bssid the BSSID
+   */
+  void NotifyAssoc (Mac48Address bssid);
+  /**
+   * Notify the reception of a packet by the server
+   * \param p the packet
+   * \param adr the address of the sender
+   */
+  void Receive (Ptr<const Packet> p, const Address &adr);
+
+  uint32_t m_apTx;        //!< number of frames transmitted by the AP
+  uint32_t m_staTx;       //!< number of frames transmitted by the STA
+  uint32_t m_assoc;       //!< number of associations of the STA
+  uint32_t m_received;    //!< number of packets received by the server
+};
+
+BeaconSuppressionTestCase::BeaconSuppressionTestCase ()
+  : TestCase ("Test case for pre-associated stations and beacon suppression"),
+    m_apTx (0),
+    m_staTx (0),
+    m_assoc (0),
+    m_received (0)
+{
+}
+
+void
+BeaconSuppressionTestCase::NotifyApPhyTxBegin (Ptr<const Packet> p)
+{
+  m_apTx++;
+}
+
+void
+BeaconSuppressionTestCase::NotifyStaPhyTxBegin (Ptr<const Packet> p)
+{
+  m_staTx++;
+}
+
+void
+BeaconSuppressionTestCase::NotifyAssoc (Mac48Address bssid)
+{
+  m_assoc++;
+}
+
+void
+BeaconSuppressionTestCase::Receive (Ptr<const Packet> p, const Address &adr)
+{
+  m_received++;
+}
+
+void
+BeaconSuppressionTestCase::DoRun (void)
+{
+  NodeContainer wifiStaNode;
+  wifiStaNode.Create (1);
+
+  NodeContainer wifiApNode;
+  wifiApNode.Create (1);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+
+  NetDeviceContainer staDevices;
+  staDevices = wifi.Install (phy, mac, wifiStaNode);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconGeneration", BooleanValue (true),
+               "EnableBeaconSuppression", BooleanValue (true));
+
+  NetDeviceContainer apDevices;
+  apDevices = wifi.Install (phy, mac, wifiApNode);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (wifiApNode);
+  mobility.Install (wifiStaNode);
+
+  Ptr<WifiNetDevice> ap_device = DynamicCast<WifiNetDevice> (apDevices.Get (0));
+  Ptr<WifiNetDevice> sta_device = DynamicCast<WifiNetDevice> (staDevices.Get (0));
+  Ptr<ApWifiMac> ap_mac = DynamicCast<ApWifiMac> (ap_device->GetMac ());
+  Ptr<StaWifiMac> sta_mac = DynamicCast<StaWifiMac> (sta_device->GetMac ());
+
+  sta_mac->TraceConnectWithoutContext ("Assoc", MakeCallback (&BeaconSuppressionTestCase::NotifyAssoc, this));
+  ap_mac->PreAssociate (sta_mac);
+  NS_TEST_ASSERT_MSG_EQ (m_assoc, 1, "the station is not associated");
+
+  ap_device->GetPhy ()->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&BeaconSuppressionTestCase::NotifyApPhyTxBegin, this));
+  sta_device->GetPhy ()->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&BeaconSuppressionTestCase::NotifyStaPhyTxBegin, this));
+
+  PacketSocketAddress socket;
+  socket.SetSingleDevice (sta_device->GetIfIndex ());
+  socket.SetPhysicalAddress (ap_device->GetAddress ());
+  socket.SetProtocol (1);
+
+  // give packet socket powers to nodes.
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (wifiStaNode);
+  packetSocket.Install (wifiApNode);
+
+  Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+  client->SetAttribute ("PacketSize", UintegerValue (1000));
+  client->SetAttribute ("MaxPackets", UintegerValue (10));
+  client->SetAttribute ("Interval", TimeValue (MilliSeconds (50)));
+  client->SetRemote (socket);
+  wifiStaNode.Get (0)->AddApplication (client);
+  client->SetStartTime (Seconds (1.0));
+  client->SetStopTime (Seconds (2.0));
+
+  Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+  server->SetLocal (socket);
+  server->TraceConnectWithoutContext ("Rx", MakeCallback (&BeaconSuppressionTestCase::Receive, this));
+  wifiApNode.Get (0)->AddApplication (server);
+  server->SetStartTime (Seconds (0.0));
+  server->SetStopTime (Seconds (3.0));
+
+  Simulator::Stop (Seconds (3.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_received, 10, "not all the packets were received");
+  NS_TEST_EXPECT_MSG_EQ (m_staTx, 10, "the station transmitted other frames than data frames");
+  NS_TEST_EXPECT_MSG_EQ (m_apTx, 10, "the AP transmitted other frames than acknowledgments");
+  NS_TEST_EXPECT_MSG_EQ (m_assoc, 1, "the station lost its association");
+}
+
 //-----------------------------------------------------------------------------
 
 class WifiTestSuite : public TestSuite
@@ -1108,6 +1390,8 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
   AddTestCase (new SetChannelFrequencyTest, TestCase::QUICK);
   AddTestCase (new Bug2222TestCase, TestCase::QUICK); //Bug 2222
+  AddTestCase (new WifiMacQueueIndexTest, TestCase::QUICK);
+  AddTestCase (new BeaconSuppressionTestCase, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite;
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/abstracted-wifi-helper.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// Number of frames received by all the nodes
+static uint64_t g_received = 0;
+
+static bool
+Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from)
+{
+  g_received++;
+  return true;
+}
+
+static void
+Broadcast (Ptr<NetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x88b5);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  std::string phyModel = "abstracted";
+  uint32_t nodes = 100;
+  double spacing = 30;
+  uint32_t interval = 50;
+  uint32_t size = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the wifi PHY models with a grid of nodes broadcasting frames");
+  cmd.AddValue ("n", "number of frames broadcast by each node", n);
+  cmd.AddValue ("phy", "PHY model, yans or abstracted", phyModel);
+  cmd.AddValue ("nodes", "number of nodes, on a square grid", nodes);
+  cmd.AddValue ("spacing", "distance between the neighbouring nodes of the grid, in m", spacing);
+  cmd.AddValue ("interval", "interval between the frames of a node, in ms", interval);
+  cmd.AddValue ("size", "size of the frames, in bytes", size);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  if (phyModel != "yans" && phyModel != "abstracted")
+    {
+      std::cerr << "Error-- the PHY model must be yans or abstracted" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-abstracted-wifi-phy with n=" << n << ", " << phyModel
+            << " PHY, " << nodes << " nodes " << spacing << " m apart" << std::endl;
+
+  NodeContainer c;
+  c.Create (nodes);
+
+  MobilityHelper mobility;
+  uint32_t width = 1;
+  while (width * width < nodes)
+    {
+      width++;
+    }
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (spacing),
+                                 "DeltaY", DoubleValue (spacing),
+                                 "GridWidth", UintegerValue (width));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (c);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  YansWifiPhyHelper phy = phyModel == "yans" ? YansWifiPhyHelper::Default () : AbstractedWifiPhyHelper::Default ();
+  phy.SetChannel (YansWifiChannelHelper::Default ().Create ());
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, c);
+
+  // the nodes start at random offsets, then broadcast periodically
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < devices.GetN (); ++i)
+    {
+      Ptr<NetDevice> device = devices.Get (i);
+      device->SetReceiveCallback (MakeCallback (&Receive));
+      Time offset = MicroSeconds (start->GetInteger (0, interval * 1000));
+      for (uint32_t k = 0; k < n; ++k)
+        {
+          Simulator::Schedule (offset + MilliSeconds (k * interval), &Broadcast, device, size);
+        }
+    }
+
+  Simulator::Stop (MilliSeconds ((n + 1) * interval));
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t deltaMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << n * nodes * 1000.0 / std::max (deltaMs, (uint64_t) 1) << " frames/s"
+            << " (" << deltaMs << " ms elapsed)\tbroadcast of the frames"
+            << " (" << g_received * 1.0 / (n * nodes) << " receptions per frame)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/building.h"
+#include "ns3/building-list.h"
+#include "ns3/buildings-helper.h"
+#include "ns3/mobility-building-info.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/geometric-buildings-propagation-loss-model.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/*
+ * The city of the benchmarks: square blocks of 100 m separated by 20 m
+ * wide streets, each block with a building of 60 m by 60 m.
+ */
+static double g_citySize;
+/// Positions looked up by the benchmarks
+static std::vector<Vector> g_positions;
+/// Mobility models at g_positions
+static std::vector<Ptr<MobilityModel> > g_nodes;
+/// The model of benchGeometricLoss
+static Ptr<GeometricBuildingsPropagationLossModel> g_lossModel;
+/// Results of the benchmarks, kept so that they are not optimized out
+static volatile double g_sink = 0;
+
+static void
+Setup (uint32_t nBuildings, uint32_t nPositions)
+{
+  uint32_t side = 1;
+  while (side * side < nBuildings)
+    {
+      side++;
+    }
+  g_citySize = side * 120;
+  for (uint32_t i = 0; i < nBuildings; i++)
+    {
+      double x = (i % side) * 120 + 20;
+      double y = (i / side) * 120 + 20;
+      Ptr<Building> b = CreateObject<Building> ();
+      b->SetBoundaries (Box (x, x + 60, y, y + 60, 0, 20));
+    }
+  // a deterministic spread of positions over the whole city
+  for (uint32_t i = 0; i < nPositions; i++)
+    {
+      double x = std::fmod (i * 0.6180339887 * g_citySize, g_citySize);
+      double y = std::fmod (i * 0.7548776662 * g_citySize, g_citySize);
+      g_positions.push_back (Vector (x, y, 1.5));
+      Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel> ();
+      mm->SetPosition (g_positions.back ());
+      mm->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+      g_nodes.push_back (mm);
+    }
+  for (uint32_t i = 0; i < std::min (nPositions, (uint32_t) 10); i++)
+    {
+      g_nodes[i]->SetPosition (Vector (g_positions[i].x, g_positions[i].y, 30));
+    }
+  for (uint32_t i = 0; i < nPositions; i++)
+    {
+      BuildingsHelper::MakeConsistent (g_nodes[i]);
+    }
+  g_lossModel = CreateObject<GeometricBuildingsPropagationLossModel> ();
+}
+
+static void
+benchLinearScan (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      const Vector &p = g_positions[i % g_positions.size ()];
+      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+        {
+          if ((*bit)->IsInside (p))
+            {
+              g_sink += (*bit)->GetId ();
+            }
+        }
+    }
+}
+
+static void
+benchFindBuilding (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<Building> b = BuildingList::FindBuilding (g_positions[i % g_positions.size ()]);
+      if (b != 0)
+        {
+          g_sink += b->GetId ();
+        }
+    }
+}
+
+static void
+benchMakeConsistent (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      BuildingsHelper::MakeConsistent (g_nodes[i % g_nodes.size ()]);
+    }
+}
+
+static void
+benchBuildingsCrossed (uint32_t n)
+{
+  std::vector<Ptr<Building> > crossed;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // links of up to 1 km
+      const Vector &a = g_positions[i % g_positions.size ()];
+      const Vector &b = g_positions[(i * 7 + 1) % g_positions.size ()];
+      Vector c (a.x + std::max (-1000.0, std::min (1000.0, b.x - a.x)),
+                a.y + std::max (-1000.0, std::min (1000.0, b.y - a.y)), 30);
+      BuildingList::FindBuildingsCrossed (a, c, crossed);
+      g_sink += crossed.size ();
+    }
+}
+
+static void
+benchGeometricLoss (uint32_t n)
+{
+  // a few sites above the rooftops, each linked to all the nodes
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ptr<MobilityModel> site = g_nodes[(i / g_nodes.size ()) % 10];
+      g_sink += g_lossModel->GetLoss (site, g_nodes[i % g_nodes.size ()]);
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ps = n;
+  ps *= 1000;
+  ps /= std::max (minDelay, (uint64_t) 1);
+  std::cout << ps << " lookups/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t nBuildings = 10000;
+  uint32_t nPositions = 1000;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the lookups of the buildings containing or crossed by positions");
+  cmd.AddValue ("n", "number of iterations", n);
+  cmd.AddValue ("buildings", "number of buildings of the city", nBuildings);
+  cmd.AddValue ("positions", "number of distinct positions looked up", nPositions);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-buildings with n=" << n << ", " << nBuildings
+            << " buildings and " << nPositions << " positions" << std::endl;
+  Setup (nBuildings, nPositions);
+
+  runBench (&benchLinearScan, n, minIterations, "Linear scan of BuildingList");
+  runBench (&benchFindBuilding, n, minIterations, "BuildingList::FindBuilding");
+  runBench (&benchMakeConsistent, n, minIterations, "BuildingsHelper::MakeConsistent (static nodes)");
+  runBench (&benchBuildingsCrossed, n, minIterations, "BuildingList::FindBuildingsCrossed (1 km links)");
+  runBench (&benchGeometricLoss, n, minIterations, "GeometricBuildingsPropagationLossModel::GetLoss (static links)");
+
+  g_lossModel = 0;
+  g_nodes.clear ();
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/epc-tft.h"
+#include "ns3/epc-tft-classifier.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <vector>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t tfts = 8;
+  uint32_t flows = 100;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the classification of downlink packets by the EPC TFT classifier");
+  cmd.AddValue ("n", "number of packets", n);
+  cmd.AddValue ("tfts", "number of TFTs, including the default one", tfts);
+  cmd.AddValue ("flows", "number of flows, classified in turn", flows);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  if (tfts == 0 || tfts > 16 || flows == 0)
+    {
+      std::cerr << "Error-- the TFTs must be between 1 and 16, and the flows at least 1" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-epc-tft-classifier with n=" << n << ", " << tfts
+            << " TFTs, " << flows << " flows" << std::endl;
+
+  // the default TFT, then one TFT for each remote port from 1001,
+  // which the classifier scans first
+  EpcTftClassifier classifier;
+  classifier.Add (EpcTft::Default (), 1);
+  for (uint32_t i = 1; i < tfts; ++i)
+    {
+      Ptr<EpcTft> tft = Create<EpcTft> ();
+      EpcTft::PacketFilter filter;
+      filter.remotePortStart = 1000 + i;
+      filter.remotePortEnd = 1000 + i;
+      tft->Add (filter);
+      classifier.Add (tft, i + 1);
+    }
+
+  // the flows match the TFTs in turn
+  std::vector<Ptr<Packet> > packets;
+  for (uint32_t f = 0; f < flows; ++f)
+    {
+      Ptr<Packet> packet = Create<Packet> (100);
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (1000 + f % tfts);
+      udpHeader.SetDestinationPort (2000 + f / tfts);
+      packet->AddHeader (udpHeader);
+      Ipv4Header ipv4Header;
+      ipv4Header.SetSource (Ipv4Address ("1.0.0.1"));
+      ipv4Header.SetDestination (Ipv4Address ("7.0.0.2"));
+      ipv4Header.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+      ipv4Header.SetPayloadSize (packet->GetSize ());
+      packet->AddHeader (ipv4Header);
+      packets.push_back (packet);
+    }
+
+  uint64_t sum = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      sum += classifier.Classify (packets[i % flows], EpcTft::DOWNLINK);
+    }
+  uint64_t deltaMs = time.End ();
+
+  std::cout << n * 1000.0 / std::max (deltaMs, (uint64_t) 1) << " packets/s"
+            << " (" << deltaMs << " ms elapsed)\tTFT classification"
+            << " (checksum " << sum << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/simulator.h"
+#include "ns3/object-factory.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/lte-fr-no-op-algorithm.h"
+#include "ns3/lte-vendor-specific-parameters.h"
+#include "ns3/lte-common.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of TTIs between the HARQ feedback of a DL transmission and the transmission
+static const uint32_t HARQ_FEEDBACK_DELAY = 4;
+
+/// The scheduler under benchmark
+static Ptr<FfMacScheduler> g_scheduler;
+/// The FFR algorithm of the scheduler, which leaves all the RBs available
+static Ptr<LteFfrAlgorithm> g_ffr;
+/// The UEs of the cell
+static uint16_t g_nUes;
+/// The DL and UL bandwidth, in RBs
+static uint8_t g_bandwidth;
+/// The number of TTIs between two CQI reports of a UE
+static uint32_t g_cqiPeriod;
+/// The number of TTIs run so far
+static uint32_t g_tti = 0;
+/// Results of the benchmarks, kept so that they are not optimized out
+static volatile uint64_t g_sink = 0;
+
+/**
+ * The MAC of the eNB, as seen by the scheduler: it keeps the buffers of
+ * the UEs full, and acknowledges every DL transmission.
+ */
+class BenchMac : public FfMacSchedSapUser, public FfMacCschedSapUser
+{
+public:
+  BenchMac ()
+    : m_dlHarqFeedback (HARQ_FEEDBACK_DELAY)
+  {
+  }
+
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+  {
+    std::vector<DlInfoListElement_s> &feedback = m_dlHarqFeedback[g_tti % HARQ_FEEDBACK_DELAY];
+    for (uint32_t i = 0; i < params.m_buildDataList.size (); i++)
+      {
+        const BuildDataListElement_s &data = params.m_buildDataList[i];
+        g_sink += data.m_dci.m_tbsSize.at (0);
+        m_dlAllocated.push_back (data.m_rnti);
+        DlInfoListElement_s info;
+        info.m_rnti = data.m_rnti;
+        info.m_harqProcessId = data.m_dci.m_harqProcess;
+        info.m_harqStatus.resize (data.m_dci.m_tbsSize.size (), DlInfoListElement_s::ACK);
+        feedback.push_back (info);
+      }
+  }
+
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+  {
+    for (uint32_t i = 0; i < params.m_dciList.size (); i++)
+      {
+        g_sink += params.m_dciList[i].m_tbSize;
+        m_ulAllocated.push_back (params.m_dciList[i].m_rnti);
+      }
+  }
+
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+  {
+  }
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+  {
+  }
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+  {
+  }
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+  {
+  }
+
+  /// The HARQ feedback of the DL transmissions of the last TTIs
+  std::vector<std::vector<DlInfoListElement_s> > m_dlHarqFeedback;
+  /// The UEs allocated in DL in the last TTI
+  std::vector<uint16_t> m_dlAllocated;
+  /// The UEs allocated in UL in the last TTI
+  std::vector<uint16_t> m_ulAllocated;
+};
+
+/// The MAC of the eNB
+static BenchMac g_mac;
+
+static void
+SendRlcBufferReq (uint16_t rnti)
+{
+  FfMacSchedSapProvider::SchedDlRlcBufferReqParameters params;
+  params.m_rnti = rnti;
+  params.m_logicalChannelIdentity = 3;
+  params.m_rlcTransmissionQueueSize = 1000000;
+  params.m_rlcTransmissionQueueHolDelay = 10;
+  params.m_rlcRetransmissionQueueSize = 0;
+  params.m_rlcRetransmissionHolDelay = 0;
+  params.m_rlcStatusPduSize = 0;
+  g_scheduler->GetFfMacSchedSapProvider ()->SchedDlRlcBufferReq (params);
+}
+
+static void
+SendBsr (const std::vector<uint16_t> &rntis, uint16_t sfnSf)
+{
+  FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters params;
+  params.m_sfnSf = sfnSf;
+  for (uint32_t i = 0; i < rntis.size (); i++)
+    {
+      MacCeListElement_s bsr;
+      bsr.m_rnti = rntis[i];
+      bsr.m_macCeType = MacCeListElement_s::BSR;
+      bsr.m_macCeValue.m_bufferStatus.resize (4, 0);
+      bsr.m_macCeValue.m_bufferStatus[0] = BufferSizeLevelBsr::BufferSize2BsrId (100000);
+      params.m_macCeList.push_back (bsr);
+    }
+  g_scheduler->GetFfMacSchedSapProvider ()->SchedUlMacCtrlInfoReq (params);
+}
+
+/**
+ * Report the DL and UL CQIs of the UEs whose turn it is, with values
+ * changing from a report to the next one
+ */
+static void
+SendCqis (uint16_t sfnSf)
+{
+  // RBG size of the type 0 allocations, see table 7.1.6.1-1 of 36.213
+  uint32_t rbgSize = (g_bandwidth <= 10) ? 1 : (g_bandwidth <= 26) ? 2 : (g_bandwidth <= 63) ? 3 : 4;
+  uint32_t rbgNum = g_bandwidth / rbgSize;
+  uint32_t round = g_tti / g_cqiPeriod;
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters dlParams;
+  dlParams.m_sfnSf = sfnSf;
+  for (uint16_t rnti = 1 + g_tti % g_cqiPeriod; rnti <= g_nUes; rnti += g_cqiPeriod)
+    {
+      CqiListElement_s cqi;
+      cqi.m_rnti = rnti;
+      cqi.m_ri = 1;
+      cqi.m_cqiType = CqiListElement_s::A30;
+      cqi.m_wbCqi.push_back (1 + (rnti * 7 + round) % 15);
+      cqi.m_wbPmi = 0;
+      for (uint32_t rbg = 0; rbg < rbgNum; rbg++)
+        {
+          HigherLayerSelected_s sb;
+          sb.m_sbPmi = 0;
+          sb.m_sbCqi.push_back (1 + (rnti * 7 + rbg * 3 + round) % 15);
+          cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+        }
+      dlParams.m_cqiList.push_back (cqi);
+    }
+  g_scheduler->GetFfMacSchedSapProvider ()->SchedDlCqiInfoReq (dlParams);
+
+  for (uint16_t rnti = 1 + g_tti % g_cqiPeriod; rnti <= g_nUes; rnti += g_cqiPeriod)
+    {
+      FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulParams;
+      ulParams.m_sfnSf = sfnSf;
+      ulParams.m_ulCqi.m_type = UlCqi_s::SRS;
+      for (uint32_t rb = 0; rb < g_bandwidth; rb++)
+        {
+          double sinr = (rnti * 5 + rb + round) % 25;
+          ulParams.m_ulCqi.m_sinr.push_back (LteFfConverter::double2fpS11dot3 (sinr));
+        }
+      VendorSpecificListElement_s vsp;
+      vsp.m_type = SRS_CQI_RNTI_VSP;
+      vsp.m_length = sizeof (SrsCqiRntiVsp);
+      vsp.m_value = Create<SrsCqiRntiVsp> (rnti);
+      ulParams.m_vendorSpecificList.push_back (vsp);
+      g_scheduler->GetFfMacSchedSapProvider ()->SchedUlCqiInfoReq (ulParams);
+    }
+}
+
+static void
+Setup (std::string schedulerType)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (schedulerType);
+  g_scheduler = factory.Create<FfMacScheduler> ();
+  g_ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  g_ffr->SetDlBandwidth (g_bandwidth);
+  g_ffr->SetUlBandwidth (g_bandwidth);
+  g_scheduler->SetFfMacSchedSapUser (&g_mac);
+  g_scheduler->SetFfMacCschedSapUser (&g_mac);
+  g_scheduler->SetLteFfrSapProvider (g_ffr->GetLteFfrSapProvider ());
+  g_ffr->SetLteFfrSapUser (g_scheduler->GetLteFfrSapUser ());
+  g_scheduler->Initialize ();
+  g_ffr->Initialize ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cellParams;
+  cellParams.m_ulBandwidth = g_bandwidth;
+  cellParams.m_dlBandwidth = g_bandwidth;
+  g_scheduler->GetFfMacCschedSapProvider ()->CschedCellConfigReq (cellParams);
+
+  std::vector<uint16_t> rntis;
+  for (uint16_t rnti = 1; rnti <= g_nUes; rnti++)
+    {
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ueParams;
+      ueParams.m_rnti = rnti;
+      ueParams.m_reconfigureFlag = false;
+      ueParams.m_transmissionMode = 0;
+      g_scheduler->GetFfMacCschedSapProvider ()->CschedUeConfigReq (ueParams);
+
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcParams;
+      lcParams.m_rnti = rnti;
+      lcParams.m_reconfigureFlag = false;
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 0;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = 9;
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 0;
+      lcParams.m_logicalChannelConfigList.push_back (lc);
+      g_scheduler->GetFfMacCschedSapProvider ()->CschedLcConfigReq (lcParams);
+
+      SendRlcBufferReq (rnti);
+      rntis.push_back (rnti);
+    }
+  SendBsr (rntis, 0);
+  // a first CQI of every UE
+  for (uint32_t i = 0; i < g_cqiPeriod; i++, g_tti++)
+    {
+      SendCqis (0);
+    }
+}
+
+static void
+benchTti (uint32_t n)
+{
+  FfMacSchedSapProvider* sap = g_scheduler->GetFfMacSchedSapProvider ();
+  for (uint32_t i = 0; i < n; i++, g_tti++)
+    {
+      uint16_t frame = 1 + (g_tti / 10) % 1024;
+      uint16_t subframe = 1 + g_tti % 10;
+      uint16_t sfnSf = ((0x3FF & frame) << 4) | (0xF & subframe);
+
+      // refill the buffers drained in the last TTI
+      for (uint32_t j = 0; j < g_mac.m_dlAllocated.size (); j++)
+        {
+          SendRlcBufferReq (g_mac.m_dlAllocated[j]);
+        }
+      g_mac.m_dlAllocated.clear ();
+      SendBsr (g_mac.m_ulAllocated, sfnSf);
+      g_mac.m_ulAllocated.clear ();
+      SendCqis (sfnSf);
+
+      FfMacSchedSapProvider::SchedDlTriggerReqParameters dlParams;
+      dlParams.m_sfnSf = sfnSf;
+      dlParams.m_dlInfoList.swap (g_mac.m_dlHarqFeedback[g_tti % HARQ_FEEDBACK_DELAY]);
+      sap->SchedDlTriggerReq (dlParams);
+
+      FfMacSchedSapProvider::SchedUlTriggerReqParameters ulParams;
+      ulParams.m_sfnSf = sfnSf;
+      sap->SchedUlTriggerReq (ulParams);
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ps = n;
+  ps *= 1000;
+  ps /= std::max (minDelay, (uint64_t) 1);
+  std::cout << ps << " TTIs/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  std::string schedulerType = "ns3::PfFfMacScheduler";
+  uint32_t nUes = 500;
+  uint32_t bandwidth = 100;
+  uint32_t minIterations = 1;
+  g_cqiPeriod = 10;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark an FF MAC scheduler serving a cell of UEs with full buffers");
+  cmd.AddValue ("n", "number of TTIs", n);
+  cmd.AddValue ("scheduler", "type of the scheduler", schedulerType);
+  cmd.AddValue ("ues", "number of UEs of the cell", nUes);
+  cmd.AddValue ("bandwidth", "DL and UL bandwidth of the cell, in RBs", bandwidth);
+  cmd.AddValue ("cqi-period", "number of TTIs between two CQI reports of a UE", g_cqiPeriod);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  g_nUes = nUes;
+  g_bandwidth = bandwidth;
+  g_cqiPeriod = std::max (g_cqiPeriod, (uint32_t) 1);
+  std::cout << "Running bench-ff-mac-scheduler with n=" << n << ", " << schedulerType
+            << ", " << nUes << " UEs and " << bandwidth << " RBs" << std::endl;
+  Setup (schedulerType);
+
+  runBench (&benchTti, n, minIterations, "DL and UL scheduling of a TTI");
+
+  g_scheduler->Dispose ();
+  g_ffr->Dispose ();
+  g_scheduler = 0;
+  g_ffr = 0;
+  Simulator::Destroy ();
+  return 0;
+}
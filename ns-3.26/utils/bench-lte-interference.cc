@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-spectrum-value-helper.h"
+#include "ns3/lte-interference.h"
+#include "ns3/lte-chunk-processor.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/// Duration of the UL data signals
+static const Time UL_DATA_DURATION = NanoSeconds (1e6 - 71429 - 1);
+
+/// The interference models of the eNBs
+static std::vector<Ptr<LteInterference> > g_enbs;
+/// The PSDs of the UEs, received by each eNB, indexed by eNB then by UE
+static std::vector<std::vector<Ptr<SpectrumValue> > > g_psds;
+/// The number of UEs of each cell
+static uint32_t g_uesPerCell;
+/// Sum of the SINR chunks, kept so that they are not optimized out
+static double g_sink = 0;
+
+static void
+SinrChunk (const SpectrumValue& sinr)
+{
+  g_sink += Sum (sinr);
+}
+
+/**
+ * Start the UL data signals of all the UEs in all the eNBs, as done by
+ * LteSpectrumPhy::StartRx
+ */
+static void
+StartSubframe (void)
+{
+  for (uint32_t enb = 0; enb < g_enbs.size (); ++enb)
+    {
+      for (uint32_t ue = 0; ue < g_psds[enb].size (); ++ue)
+        {
+          g_enbs[enb]->AddSignal (g_psds[enb][ue], UL_DATA_DURATION);
+          if (ue / g_uesPerCell == enb)
+            {
+              g_enbs[enb]->StartRx (g_psds[enb][ue]);
+            }
+        }
+      Simulator::Schedule (UL_DATA_DURATION, &LteInterference::EndRx, g_enbs[enb]);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t cells = 3;
+  uint32_t ues = 100;
+  uint32_t bandwidth = 100;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the UL SINR evaluation of the LTE interference model");
+  cmd.AddValue ("n", "number of subframes", n);
+  cmd.AddValue ("cells", "number of cells", cells);
+  cmd.AddValue ("ues", "number of UEs transmitting in each cell and subframe", ues);
+  cmd.AddValue ("bandwidth", "bandwidth, in RBs", bandwidth);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  if (ues == 0 || ues > bandwidth)
+    {
+      std::cerr << "Error-- the UEs of a cell must be between 1 and the bandwidth" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-interference with n=" << n << ", " << cells
+            << " cells of " << ues << " UEs, " << bandwidth << " RBs" << std::endl;
+
+  Ptr<const SpectrumModel> model = LteSpectrumValueHelper::GetSpectrumModel (100, bandwidth);
+  Ptr<SpectrumValue> noise = Create<SpectrumValue> (model);
+  (*noise) = 1e-21;
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  g_uesPerCell = ues;
+  g_psds.resize (cells);
+  for (uint32_t enb = 0; enb < cells; ++enb)
+    {
+      Ptr<LteInterference> interference = CreateObject<LteInterference> ();
+      interference->SetNoisePowerSpectralDensity (noise);
+      Ptr<LteChunkProcessor> processor = Create<LteChunkProcessor> ();
+      processor->AddCallback (MakeCallback (&SinrChunk));
+      interference->AddSinrChunkProcessor (processor);
+      g_enbs.push_back (interference);
+      for (uint32_t ue = 0; ue < cells * ues; ++ue)
+        {
+          // the UEs of a cell share the bandwidth evenly
+          Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+          uint32_t rbs = bandwidth / ues;
+          uint32_t first = (ue % ues) * rbs;
+          double power = std::pow (10.0, random->GetValue (-190, -160) / 10);
+          for (uint32_t rb = first; rb < first + rbs; ++rb)
+            {
+              (*psd)[rb] = power;
+            }
+          g_psds[enb].push_back (psd);
+        }
+    }
+
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (i), &StartSubframe);
+    }
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  uint64_t deltaMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << n * 1000.0 / std::max (deltaMs, (uint64_t) 1) << " subframes/s"
+            << " (" << deltaMs << " ms elapsed)\tUL SINR of all the cells"
+            << " (checksum " << g_sink << ")" << std::endl;
+  return 0;
+}
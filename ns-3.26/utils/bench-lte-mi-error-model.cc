@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-spectrum-value-helper.h"
+#include "ns3/lte-mi-error-model.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of MCSs
+static const uint8_t N_MCS = 29;
+
+/// The SINR perceived in the whole bandwidth
+static SpectrumValue *g_sinr;
+/// The RBs of the TBs
+static std::vector<int> g_map;
+/// The MI of a first transmission, used as HARQ history
+static HarqProcessInfoList_t g_harqHistory;
+/// Results of the benchmarks, kept so that they are not optimized out
+static volatile double g_sink = 0;
+
+static void
+benchMib (uint32_t n)
+{
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      sum += LteMiErrorModel::Mib (*g_sinr, g_map, i % N_MCS);
+    }
+  g_sink = g_sink + sum;
+}
+
+static void
+benchTb (uint32_t n)
+{
+  HarqProcessInfoList_t noHistory;
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (*g_sinr, g_map, 100 + i % 3000, i % N_MCS, noHistory);
+      sum += stats.tbler;
+    }
+  g_sink = g_sink + sum;
+}
+
+static void
+benchTbRetx (uint32_t n)
+{
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (*g_sinr, g_map, 100 + i % 3000, i % N_MCS, g_harqHistory);
+      sum += stats.tbler;
+    }
+  g_sink = g_sink + sum;
+}
+
+static void
+benchPcfichPdcch (uint32_t n)
+{
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      sum += LteMiErrorModel::GetPcfichPdcchError (*g_sinr);
+    }
+  g_sink = g_sink + sum;
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ps = n;
+  ps *= 1000;
+  ps /= std::max (minDelay, (uint64_t) 1);
+  std::cout << ps << " evaluations/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t bandwidth = 100;
+  uint32_t rbs = 50;
+  double minSinrDb = -5;
+  double maxSinrDb = 25;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the evaluation of the MI error model of LTE");
+  cmd.AddValue ("n", "number of evaluations", n);
+  cmd.AddValue ("bandwidth", "bandwidth of the SINR, in RBs", bandwidth);
+  cmd.AddValue ("rbs", "number of RBs of a TB", rbs);
+  cmd.AddValue ("min-sinr", "minimum SINR of an RB, in dB", minSinrDb);
+  cmd.AddValue ("max-sinr", "maximum SINR of an RB, in dB", maxSinrDb);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  if (rbs == 0 || rbs > bandwidth)
+    {
+      std::cerr << "Error-- the RBs of a TB must be between 1 and the bandwidth" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-lte-mi-error-model with n=" << n << ", " << rbs
+            << " RBs per TB out of " << bandwidth << " RBs" << std::endl;
+
+  g_sinr = new SpectrumValue (LteSpectrumValueHelper::GetSpectrumModel (100, bandwidth));
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < bandwidth; i++)
+    {
+      (*g_sinr)[i] = std::pow (10.0, random->GetValue (minSinrDb, maxSinrDb) / 10);
+    }
+  // the RBs of the TB are spread over the bandwidth
+  for (uint32_t i = 0; i < rbs; i++)
+    {
+      g_map.push_back (i * bandwidth / rbs);
+    }
+  HarqProcessInfoElement_t firstTx;
+  firstTx.m_mi = LteMiErrorModel::Mib (*g_sinr, g_map, 0);
+  firstTx.m_rv = 0;
+  firstTx.m_infoBits = 800;
+  firstTx.m_codeBits = 8000;
+  g_harqHistory.push_back (firstTx);
+
+  runBench (&benchMib, n, minIterations, "MI of a TB");
+  runBench (&benchTb, n, minIterations, "decoding of a TB");
+  runBench (&benchTbRetx, n, minIterations, "decoding of a retransmitted TB");
+  runBench (&benchPcfichPdcch, n, minIterations, "decoding of the PCFICH and PDCCH");
+
+  delete g_sinr;
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/spectrum-value.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/*
+ * The operands of the benchmarks: the power spectral densities of the
+ * signals received on a 20 MHz LTE carrier, made of 100 resource blocks
+ * of 180 kHz each.
+ */
+static Ptr<SpectrumValue> g_signal;
+static Ptr<SpectrumValue> g_allSignals;
+static Ptr<SpectrumValue> g_noise;
+static Ptr<SpectrumValue> g_gain;
+/// Results of the benchmarks, kept so that they are not optimized out
+static volatile double g_sink = 0;
+
+static void
+Setup (uint32_t nRbs)
+{
+  Bands bands;
+  for (uint32_t i = 0; i < nRbs; i++)
+    {
+      BandInfo bi;
+      bi.fl = 2.12e9 + i * 180e3;
+      bi.fc = bi.fl + 90e3;
+      bi.fh = bi.fl + 180e3;
+      bands.push_back (bi);
+    }
+  Ptr<SpectrumModel> sm = Create<SpectrumModel> (bands);
+  g_signal = Create<SpectrumValue> (sm);
+  g_allSignals = Create<SpectrumValue> (sm);
+  g_noise = Create<SpectrumValue> (sm);
+  g_gain = Create<SpectrumValue> (sm);
+  for (uint32_t i = 0; i < nRbs; i++)
+    {
+      (*g_signal)[i] = 1e-16 * (1 + i % 7);
+      (*g_allSignals)[i] = 3e-16 * (1 + i % 5);
+      (*g_noise)[i] = 4e-21;
+      (*g_gain)[i] = 1e-3 * (1 + i % 3);
+    }
+}
+
+static void
+benchSinr (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sinr = (*g_signal) / ((*g_allSignals) - (*g_signal) + (*g_noise));
+      g_sink += sinr[0];
+    }
+}
+
+static void
+benchAccumulate (uint32_t n)
+{
+  SpectrumValue sum = *g_noise;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      sum += (*g_signal) * (*g_gain);
+    }
+  g_sink += sum[0];
+}
+
+static void
+benchPower (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += Integral ((*g_signal) * (*g_gain));
+    }
+}
+
+static void
+benchScale (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue rx = 0.5 * (*g_signal) + 1e-21;
+      g_sink += rx[0];
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ps = n;
+  ps *= 1000;
+  ps /= std::max (minDelay, (uint64_t) 1);
+  std::cout << ps << " operations/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t nRbs = 100;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark SpectrumValue arithmetic");
+  cmd.AddValue ("n", "number of iterations", n);
+  cmd.AddValue ("rbs", "number of bands of the SpectrumModel", nRbs);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of iterations must be specified " <<
+        "by command-line argument --n=(number of iterations)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-spectrum-value with n=" << n << " and " << nRbs << " bands" << std::endl;
+  Setup (nRbs);
+
+  runBench (&benchSinr, n, minIterations, "SINR: s / (all - s + noise)");
+  runBench (&benchAccumulate, n, minIterations, "Accumulate: sum += s * gain");
+  runBench (&benchPower, n, minIterations, "Power: Integral (s * gain)");
+  runBench (&benchScale, n, minIterations, "Scale: 0.5 * s + offset");
+
+  return 0;
+}